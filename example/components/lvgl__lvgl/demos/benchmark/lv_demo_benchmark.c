@@ -71,6 +71,8 @@ static void color_anim(lv_obj_t * obj);
 static void arc_anim(lv_obj_t * obj);
 
 static lv_obj_t * card_create(void);
+static void rebuild_timer_cb(lv_timer_t * timer);
+static void rebuild_cont_delete_event_cb(lv_event_t * e);
 
 static void empty_screen_cb(void)
 {
@@ -384,6 +386,22 @@ static void containers_with_scrolling_cb(void)
     scroll_anim(scr, lv_obj_get_scroll_bottom(scr));
 }
 
+static void rebuilding_widgets_cb(void)
+{
+    lv_obj_t * scr = lv_screen_active();
+
+    lv_obj_t * cont = lv_obj_create(scr);
+    lv_obj_remove_style_all(cont);
+    lv_obj_set_size(cont, lv_pct(100), lv_pct(100));
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_ROW_WRAP);
+    lv_obj_set_style_pad_gap(cont, 4, 0);
+
+    /*Delete all the buttons and create them again on every refresh*/
+    lv_timer_t * timer = lv_timer_create(rebuild_timer_cb, 33, cont);
+    lv_obj_add_event_cb(cont, rebuild_cont_delete_event_cb, LV_EVENT_DELETE, timer);
+    rebuild_timer_cb(timer);
+}
+
 static void widgets_demo_cb(void)
 {
     lv_obj_t * scr = lv_screen_active();
@@ -415,6 +433,7 @@ static scene_dsc_t scenes[] = {
     {.name = "Containers with opa",        .scene_time = 3000, .create_cb = containers_with_opa_cb},
     {.name = "Containers with opa_layer",  .scene_time = 3000, .create_cb = containers_with_opa_layer_cb},
     {.name = "Containers with scrolling",  .scene_time = 5000, .create_cb = containers_with_scrolling_cb},
+    {.name = "Rebuilding widgets",         .scene_time = 3000, .create_cb = rebuilding_widgets_cb},
 
     {.name = "Widgets demo",               .scene_time = 20000,           .create_cb = widgets_demo_cb},
 
@@ -764,6 +783,25 @@ static void shake_anim(lv_obj_t * obj, int32_t y_max)
     lv_anim_start(&a);
 }
 
+static void rebuild_timer_cb(lv_timer_t * timer)
+{
+    lv_obj_t * cont = lv_timer_get_user_data(timer);
+    lv_obj_clean(cont);
+
+    lv_obj_t * buttons[120];
+    uint32_t cnt = lv_obj_create_children(cont, lv_button_create, 120, buttons);
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_obj_set_size(buttons[i], 48, 32);
+        lv_obj_set_style_bg_color(buttons[i], lv_palette_main(rnd_next(0, LV_PALETTE_LAST - 1)), 0);
+    }
+}
+
+static void rebuild_cont_delete_event_cb(lv_event_t * e)
+{
+    lv_timer_delete(lv_event_get_user_data(e));
+}
+
 static lv_obj_t * card_create(void)
 {
     lv_obj_t * panel = lv_obj_create(lv_screen_active());
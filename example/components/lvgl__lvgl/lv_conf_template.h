@@ -67,6 +67,11 @@
     #endif
 #endif  /*LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN*/
 
+/*Serve the allocations of at most 256 bytes from slabs of this size, with one free list per 16 byte size class.
+ *It makes allocating the small objects (widgets, styles, event descriptors, etc.) faster
+ *and keeps them from fragmenting the heap. (1024 bytes..1 MB, 0: disable)*/
+#define LV_MEM_SLAB_SIZE 0
+
 /*====================
    HAL SETTINGS
  *====================*/
@@ -171,9 +176,13 @@
     #if LV_DRAW_SW_COMPLEX == 1
         /*Allow buffering some shadow calculation.
         *LV_DRAW_SW_SHADOW_CACHE_SIZE is the max. shadow size to buffer, where shadow size is `shadow_width + radius`
-        *Caching has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost*/
+        *Caching a shadow has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost*/
         #define LV_DRAW_SW_SHADOW_CACHE_SIZE 0
 
+        /*Max. memory used by the cached shadows in bytes.
+        *Several shadows are cached and the least recently used ones are freed first when it's full*/
+        #define LV_DRAW_SW_SHADOW_CACHE_MEM_SIZE (16 * 1024)
+
         /* Set number of maximally cached circle data.
         * The circumference of 1/4 circle are saved for anti-aliasing
         * radius * 4 bytes are used per circle (the most often used radiuses are saved)
@@ -181,6 +190,12 @@
         #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 4
     #endif
 
+    /* Use assembly or intrinsics for the blending. Possible values:
+     * - LV_DRAW_SW_ASM_NONE
+     * - LV_DRAW_SW_ASM_NEON
+     * - LV_DRAW_SW_ASM_HELIUM
+     * - LV_DRAW_SW_ASM_X86: SSE2, and AVX2 if the compiler targets it (e.g. `-mavx2`)
+     * - LV_DRAW_SW_ASM_CUSTOM: use the functions from LV_DRAW_SW_ASM_CUSTOM_INCLUDE */
     #define  LV_USE_DRAW_SW_ASM     LV_DRAW_SW_ASM_NONE
 
     #if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_CUSTOM
@@ -365,10 +380,37 @@
  *If size is 0, the cache function is not enabled and the decoded mem will be released immediately after use.*/
 #define LV_CACHE_DEF_SIZE       0
 
+/*1: Use the scan-resistant S3-FIFO policy for the image cache instead of LRU.
+ *Images shown only once (e.g. a full screen background) can't push the frequently drawn images (e.g. icons) out of the cache.*/
+#define LV_IMAGE_CACHE_S3FIFO   0
+
 /*Default number of image header cache entries. The cache is used to store the headers of images
  *The main logic is like `LV_CACHE_DEF_SIZE` but for image headers.*/
 #define LV_IMAGE_HEADER_CACHE_DEF_CNT 0
 
+/*1: Keep the headers of the image files in an index file to get them without opening the images after a reboot.
+ *The headers are used only if the size and modification time of the image are the same,
+ *so only the images on file system drivers with `stat_cb` are indexed.*/
+#define LV_USE_IMAGE_HEADER_INDEX 0
+#if LV_USE_IMAGE_HEADER_INDEX
+    /*The index file loaded in `lv_init()` and saved shortly after new headers were found.
+     *"" to load it later with `lv_image_header_index_load()`, e.g. after registering the file system driver.*/
+    #define LV_IMAGE_HEADER_INDEX_PATH ""
+#endif
+
+/*Split the image, image header and glyph caches into this many independently locked shards by the hash of the key.
+ *The draw units and decoders running in parallel threads wait less for each other.
+ *The size of the caches is split equally between the shards, so an image larger than
+ *`LV_CACHE_DEF_SIZE / LV_CACHE_SHARD_CNT` can't be cached (and the same applies to the glyphs).
+ *0 or 1: don't shard the caches*/
+#define LV_CACHE_SHARD_CNT      0
+
+/*Default size of the render cache in bytes.
+ *Objects with `LV_OBJ_FLAG_RENDER_CACHE` are rendered once into an ARGB8888 buffer stored in this cache
+ *and only the buffer is drawn until the object or one of its children changes.
+ *If size is 0, the cache is not enabled and the flag has no effect.*/
+#define LV_OBJ_RENDER_CACHE_DEF_SIZE 0
+
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
 #define LV_GRADIENT_MAX_STOPS   2
@@ -380,6 +422,16 @@
 /* Add 2 x 32 bit variables to each lv_obj_t to speed up getting style properties */
 #define LV_OBJ_STYLE_CACHE      0
 
+/* Number of style properties (power of 2) whose resolved value is stored per object for the current state.
+ * Speeds up getting the style properties while drawing. 0: disable.
+ * If enabled, lv_obj_report_style_change() needs to be called when a style already used by objects is modified. */
+#define LV_OBJ_STYLE_RESOLVED_CACHE_SIZE 0
+
+/* Size of the grid cells (in px) used to find the pressed object of pointer input devices.
+ * The clickable objects are sorted into the cells and only the objects of the pressed cell are hit tested
+ * instead of walking the whole object tree. 0: disable. */
+#define LV_INDEV_HIT_INDEX_CELL_SIZE 0
+
 /* Add `id` field to `lv_obj_t` */
 #define LV_USE_OBJ_ID           0
 
@@ -528,6 +580,11 @@
 
 /*Enables/disables support for compressed fonts.*/
 #define LV_USE_FONT_COMPRESSED 0
+#if LV_USE_FONT_COMPRESSED
+    /*Max. memory in bytes used to cache the decompressed glyph bitmaps of compressed fonts.
+     *The least recently used glyphs are freed first. 0: decompress the glyphs on every draw*/
+    #define LV_FONT_COMPRESSED_CACHE_SIZE 0
+#endif
 
 /*Enable drawing placeholders when glyph dsc is not found*/
 #define LV_USE_FONT_PLACEHOLDER 1
@@ -626,6 +683,7 @@
 #if LV_USE_LABEL
     #define LV_LABEL_TEXT_SELECTION 1 /*Enable selecting text of the label*/
     #define LV_LABEL_LONG_TXT_HINT 1  /*Store some extra info in labels to speed up drawing of very long texts*/
+    #define LV_LABEL_LINE_CACHE 1     /*Store the line breaks and line widths of the labels to speed up redrawing*/
     #define LV_LABEL_WAIT_CHAR_COUNT 3  /*The count of wait chart*/
 #endif
 
@@ -715,6 +773,11 @@
 /*Setting a default driver letter allows skipping the driver prefix in filepaths*/
 #define LV_FS_DEFAULT_DRIVE_LETTER '\0'
 
+/*1: Read ahead in a background thread on the drivers with `read_ahead` enabled.
+ *While a file is read sequentially the next part is already loaded and
+ *`lv_fs_prefetch()` can load a part of a file before it's opened. Disabled without `LV_USE_OS`.*/
+#define LV_FS_READ_AHEAD 0
+
 /*API for fopen, fread, etc*/
 #define LV_USE_FS_STDIO 0
 #if LV_USE_FS_STDIO
@@ -729,6 +792,11 @@
     #define LV_FS_POSIX_LETTER '\0'     /*Set an upper cased letter on which the drive will accessible (e.g. 'A')*/
     #define LV_FS_POSIX_PATH ""         /*Set the working directory. File/directory paths will be appended to it.*/
     #define LV_FS_POSIX_CACHE_SIZE 0    /*>0 to cache this number of bytes in lv_fs_read()*/
+
+    /*1: Map the files opened for reading to the memory with `mmap()`.
+     *The reads are served from the page cache without system calls and
+     *`lv_fs_get_buffer()` lets the decoders use the content without copying it.*/
+    #define LV_FS_POSIX_MMAP 0
 #endif
 
 /*API for CreateFile, ReadFile, etc*/
@@ -775,6 +843,12 @@
 
 /*PNG decoder(libpng) library*/
 #define LV_USE_LIBPNG 0
+#if LV_USE_LIBPNG
+    /*>0: Decode the non-interlaced PNG images taller than this in strips of this many rows while they are drawn.
+     *Only a strip is kept in memory instead of the whole image, but the image is decoded again on every redraw.
+     *Rotated and scaled images are still decoded fully. 0: decode the whole image*/
+    #define LV_LIBPNG_STRIP_HEIGHT 0
+#endif
 
 /*BMP decoder library*/
 #define LV_USE_BMP 0
@@ -786,12 +860,22 @@
 /* libjpeg-turbo decoder library.
  * Supports complete JPEG specifications and high-performance JPEG decoding. */
 #define LV_USE_LIBJPEG_TURBO 0
+#if LV_USE_LIBJPEG_TURBO
+    /*>1: Decode the JPEG images having restart markers at row boundaries on this many threads (including the caller).
+     *Every thread decodes a horizontal slice directly into the decoded image. Without `LV_USE_OS` it's always 1.
+     *1: decode on the calling thread only*/
+    #define LV_LIBJPEG_TURBO_THREAD_CNT 1
+#endif
 
 /*GIF decoder library*/
 #define LV_USE_GIF 0
 #if LV_USE_GIF
     /*GIF decoder accelerate*/
     #define LV_GIF_CACHE_DECODE_DATA 0
+    /*1: Decode the next frame of the GIFs on a background thread while the current one is shown.
+     *Without `LV_USE_OS` the frames are decoded when they are shown.
+     *Needs one more canvas (width x height x 4 bytes) per GIF*/
+    #define LV_GIF_DECODE_AHEAD 0
 #endif
 
 
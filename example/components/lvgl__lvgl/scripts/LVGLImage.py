@@ -100,6 +100,7 @@ class CompressMethod(Enum):
     NONE = 0x00
     RLE = 0x01
     LZ4 = 0x02
+    LZ4_ROWS = 0x03  # LZ4 blocks of N rows, decompressed only where drawn
 
 
 class ColorFormat(Enum):
@@ -456,13 +457,56 @@ class LVGLCompressData:
     def __init__(self,
                  cf: ColorFormat,
                  method: CompressMethod,
-                 raw_data: bytes = b''):
+                 raw_data: bytes = b'',
+                 h: int = 0,
+                 stride: int = 0,
+                 block_rows: int = 16):
         self.blk_size = (cf.bpp + 7) // 8
+        self.cf = cf
         self.compress = method
+        self.h = h
+        self.stride = stride
+        self.block_rows = block_rows
         self.raw_data = raw_data
         self.raw_data_len = len(raw_data)
         self.compressed = self._compress(raw_data)
 
+    def _compress_row_blocks(self, raw_data: bytes) -> bytearray:
+        """
+        Compress each `block_rows` rows separately so that the decoder
+        can decompress only the blocks intersecting the drawn area.
+        Layout: block_rows, offset of each block and the end of the
+        last one relative to the first block, then the LZ4 blocks.
+        The A8 rows of RGB565A8 follow the color rows in each block.
+        """
+        if self.cf.is_indexed or self.cf.is_alpha_only:
+            raise ParameterError(f"{self.cf.name} can't be compressed "
+                                 "by row blocks")
+        if self.block_rows <= 0 or self.stride <= 0:
+            raise ParameterError(f"Invalid block rows: {self.block_rows}, "
+                                 f"stride: {self.stride}")
+
+        a8_stride = self.stride // 2
+        a8_map = raw_data[self.h * self.stride:]
+        blocks = []
+        for y in range(0, self.h, self.block_rows):
+            rows = min(self.block_rows, self.h - y)
+            block = raw_data[y * self.stride:(y + rows) * self.stride]
+            if self.cf == ColorFormat.RGB565A8:
+                block += a8_map[y * a8_stride:(y + rows) * a8_stride]
+            blocks.append(lz4.block.compress(block, store_size=False))
+
+        bin = bytearray()
+        bin += uint32_t(self.block_rows)
+        offset = 0
+        for block in blocks:
+            bin += uint32_t(offset)
+            offset += len(block)
+        bin += uint32_t(offset)
+        for block in blocks:
+            bin += block
+        return bin
+
     def _compress(self, raw_data: bytes) -> bytearray:
         if self.compress == CompressMethod.NONE:
             return raw_data
@@ -473,6 +517,8 @@ class LVGLCompressData:
             compressed = RLEImage().rle_compress(raw_data + pad, self.blk_size)
         elif self.compress == CompressMethod.LZ4:
             compressed = lz4.block.compress(raw_data, store_size=False)
+        elif self.compress == CompressMethod.LZ4_ROWS:
+            compressed = self._compress_row_blocks(raw_data)
         else:
             raise ParameterError(f"Invalid compress method: {self.compress}")
 
@@ -741,7 +787,8 @@ class LVGLImage:
 
     def to_bin(self,
                filename: str,
-               compress: CompressMethod = CompressMethod.NONE):
+               compress: CompressMethod = CompressMethod.NONE,
+               block_rows: int = 16):
         """
         Write this image to file, filename should be ended with '.bin'
         """
@@ -760,7 +807,8 @@ class LVGLImage:
                                      self.stride,
                                      flags=flags)
             bin += header.binary
-            compressed = LVGLCompressData(self.cf, compress, self.data)
+            compressed = LVGLCompressData(self.cf, compress, self.data,
+                                          self.h, self.stride, block_rows)
             bin += compressed.compressed
 
             f.write(bin)
@@ -769,12 +817,14 @@ class LVGLImage:
 
     def to_c_array(self,
                    filename: str,
-                   compress: CompressMethod = CompressMethod.NONE):
+                   compress: CompressMethod = CompressMethod.NONE,
+                   block_rows: int = 16):
         self._check_ext(filename, ".c")
         self._check_dir(filename)
 
         if compress != CompressMethod.NONE:
-            data = LVGLCompressData(self.cf, compress, self.data).compressed
+            data = LVGLCompressData(self.cf, compress, self.data, self.h,
+                                    self.stride, block_rows).compressed
         else:
             data = self.data
         write_c_array_file(self.w, self.h, self.stride, self.cf, filename,
@@ -1200,6 +1250,7 @@ class PNGConverter:
                  align: int = 1,
                  premultiply: bool = False,
                  compress: CompressMethod = CompressMethod.NONE,
+                 block_rows: int = 16,
                  keep_folder=True) -> None:
         self.files = files
         self.cf = cf
@@ -1210,6 +1261,7 @@ class PNGConverter:
         self.align = align
         self.premultiply = premultiply
         self.compress = compress
+        self.block_rows = block_rows
         self.background = background
 
     def _replace_ext(self, input, ext):
@@ -1236,10 +1288,12 @@ class PNGConverter:
                 output.append((f, img))
                 if self.ofmt == OutputFormat.BIN_FILE:
                     img.to_bin(self._replace_ext(f, ".bin"),
-                               compress=self.compress)
+                               compress=self.compress,
+                               block_rows=self.block_rows)
                 elif self.ofmt == OutputFormat.C_ARRAY:
                     img.to_c_array(self._replace_ext(f, ".c"),
-                                   compress=self.compress)
+                                   compress=self.compress,
+                                   block_rows=self.block_rows)
                 elif self.ofmt == OutputFormat.PNG_FILE:
                     img.to_png(self._replace_ext(f, ".png"))
 
@@ -1269,7 +1323,13 @@ def main():
     parser.add_argument('--compress',
                         help=("Binary data compress method, default to NONE"),
                         default="NONE",
-                        choices=["NONE", "RLE", "LZ4"])
+                        choices=["NONE", "RLE", "LZ4", "LZ4_ROWS"])
+
+    parser.add_argument('--block-rows',
+                        help="rows per block for LZ4_ROWS compression",
+                        default=16,
+                        type=int,
+                        metavar='rows')
 
     parser.add_argument('--align',
                         help="stride alignment in bytes for bin image",
@@ -1322,6 +1382,7 @@ def main():
                              align=args.align,
                              premultiply=args.premultiply,
                              compress=compress,
+                             block_rows=args.block_rows,
                              keep_folder=False)
     output = converter.convert()
     for f, img in output:
@@ -49,6 +49,7 @@ fout.write(
 #define LV_DRAW_SW_ASM_NONE         0
 #define LV_DRAW_SW_ASM_NEON         1
 #define LV_DRAW_SW_ASM_HELIUM       2
+#define LV_DRAW_SW_ASM_X86          3
 #define LV_DRAW_SW_ASM_CUSTOM       255
 
 /* Handle special Kconfig options */
@@ -203,6 +204,16 @@ LV_EXPORT_CONST_INT(LV_DRAW_BUF_ALIGN);
     #define LV_USE_THORVG  (LV_USE_THORVG_INTERNAL || LV_USE_THORVG_EXTERNAL)
 #endif
 
+/*Disable the features which need a thread*/
+#if LV_USE_OS == LV_OS_NONE
+    #undef LV_FS_READ_AHEAD
+    #define LV_FS_READ_AHEAD 0
+    #undef LV_LIBJPEG_TURBO_THREAD_CNT
+    #define LV_LIBJPEG_TURBO_THREAD_CNT 1
+    #undef LV_GIF_DECODE_AHEAD
+    #define LV_GIF_DECODE_AHEAD 0
+#endif
+
 #if LV_USE_OS
     #if (LV_USE_FREETYPE || LV_USE_THORVG) && LV_DRAW_THREAD_STACK_SIZE < (32 * 1024)
         #warning "Increase LV_DRAW_THREAD_STACK_SIZE to at least 32KB for FreeType or ThorVG."
@@ -22,6 +22,7 @@ extern "C" {
 #endif
 #include "../misc/lv_anim.h"
 #include "../misc/lv_area.h"
+#include "../misc/lv_array.h"
 #include "../misc/lv_color_op.h"
 #include "../misc/lv_ll.h"
 #include "../misc/lv_log.h"
@@ -42,12 +43,14 @@ extern "C" {
 
 #include "../misc/lv_timer_private.h"
 #include "../misc/lv_anim_private.h"
+#include "../misc/lv_fs_private.h"
 #include "../tick/lv_tick_private.h"
 #include "../draw/lv_draw_buf_private.h"
 #include "../draw/lv_draw_private.h"
 #include "../draw/sw/lv_draw_sw_private.h"
 #include "../draw/sw/lv_draw_sw_mask_private.h"
 #include "../stdlib/builtin/lv_tlsf_private.h"
+#include "../stdlib/lv_mem_private.h"
 #include "../others/sysmon/lv_sysmon_private.h"
 #include "../layouts/lv_layout_private.h"
 
@@ -68,6 +71,10 @@ struct _snippet_stack;
 struct lv_freetype_context_t;
 #endif
 
+#if LV_USE_IMAGE_HEADER_INDEX
+struct lv_image_header_index_t;
+#endif
+
 #if LV_USE_PROFILER && LV_USE_PROFILER_BUILTIN
 struct lv_profiler_builtin_ctx_t;
 #endif
@@ -89,6 +96,7 @@ typedef struct lv_global_t {
     uint32_t style_custom_table_size;
     uint32_t style_last_custom_prop_id;
     uint8_t * style_custom_prop_flag_lookup_table;
+    uint32_t style_resolved_gen;
 
     lv_ll_t group_ll;
     lv_group_t * group_default;
@@ -106,6 +114,8 @@ typedef struct lv_global_t {
 
     lv_event_t * event_header;
     uint32_t event_last_register_id;
+    uint32_t obj_event_sent_cnt;
+    uint32_t obj_event_handled_cnt;
 
     lv_timer_state_t timer_state;
     lv_anim_state_t anim_state;
@@ -120,6 +130,11 @@ typedef struct lv_global_t {
 
     lv_cache_t * img_cache;
     lv_cache_t * img_header_cache;
+#if LV_USE_IMAGE_HEADER_INDEX
+    struct lv_image_header_index_t * img_header_index;
+#endif
+    lv_cache_t * obj_render_cache;
+    lv_array_t obj_render_cache_drawn;
 
     lv_draw_global_info_t draw_info;
 #if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
@@ -153,7 +168,14 @@ typedef struct lv_global_t {
     lv_tlsf_state_t tlsf_state;
 #endif
 
+#if LV_MEM_SLAB_SIZE
+    lv_mem_slab_state_t mem_slab_state;
+#endif
+
     lv_ll_t fsdrv_ll;
+#if LV_FS_READ_AHEAD
+    lv_fs_read_ahead_state_t fs_read_ahead;
+#endif
 #if LV_USE_FS_STDIO != '\0'
     lv_fs_drv_t stdio_fs_drv;
 #endif
@@ -185,8 +207,12 @@ typedef struct lv_global_t {
     struct lv_freetype_context_t * ft_context;
 #endif
 
-#if LV_USE_FONT_COMPRESSED
-    lv_font_fmt_rle_t font_fmt_rle;
+#if LV_USE_GIF && LV_GIF_DECODE_AHEAD
+    struct lv_gif_decode_ahead_t * gif_decode_ahead;
+#endif
+
+#if LV_USE_FONT_COMPRESSED && LV_FONT_COMPRESSED_CACHE_SIZE
+    lv_font_fmt_txt_glyph_cache_t font_fmt_glyph_cache;
 #endif
 
 #if LV_USE_SPAN != 0
@@ -26,6 +26,7 @@
 #include "../tick/lv_tick.h"
 #include "../stdlib/lv_string.h"
 #include "lv_obj_draw_private.h"
+#include "lv_obj_render_cache_private.h"
 
 /*********************
  *      DEFINES
@@ -239,6 +240,9 @@ void lv_obj_add_flag(lv_obj_t * obj, lv_obj_flag_t f)
 
     obj->flags |= f;
 
+    /*Setting these flags can only grow the indexed area of the object*/
+    if(f & LV_INDEV_HIT_INDEX_FLAGS) lv_indev_hit_index_invalidate_obj(obj);
+
     if(f & LV_OBJ_FLAG_HIDDEN) {
         if(lv_obj_has_state(obj, LV_STATE_FOCUSED)) {
             lv_group_t * group = lv_obj_get_group(obj);
@@ -277,6 +281,9 @@ void lv_obj_remove_flag(lv_obj_t * obj, lv_obj_flag_t f)
         lv_obj_invalidate_area(obj, &ver_area);
     }
 
+    /*Clearing these flags can only shrink the indexed area of the object*/
+    if(f & LV_INDEV_HIT_INDEX_FLAGS) lv_indev_hit_index_invalidate_obj(obj);
+
     obj->flags &= (~f);
 
     if(f & LV_OBJ_FLAG_HIDDEN) {
@@ -291,6 +298,9 @@ void lv_obj_remove_flag(lv_obj_t * obj, lv_obj_flag_t f)
         lv_obj_mark_layout_as_dirty(lv_obj_get_parent(obj));
     }
 
+    if(f & LV_OBJ_FLAG_RENDER_CACHE) {
+        lv_obj_render_cache_drop(obj);
+    }
 }
 
 void lv_obj_update_flag(lv_obj_t * obj, lv_obj_flag_t f, bool v)
@@ -522,9 +532,17 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_obj_remove_style_all(obj);
     lv_obj_enable_style_refresh(true);
 
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE
+    lv_free(obj->style_resolved);
+    obj->style_resolved = NULL;
+#endif
+
     /*Remove the animations from this object*/
     lv_anim_delete(obj, NULL);
 
+    /*Free the cached image of the object*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_RENDER_CACHE)) lv_obj_render_cache_drop(obj);
+
     /*Delete from the group*/
     lv_group_t * group = lv_obj_get_group(obj);
     if(group) lv_group_remove_obj(obj);
@@ -11,6 +11,7 @@
 #include "../themes/lv_theme.h"
 #include "../display/lv_display.h"
 #include "../display/lv_display_private.h"
+#include "../indev/lv_indev_hit_index_private.h"
 #include "../stdlib/lv_string.h"
 
 /*********************
@@ -67,15 +68,12 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
             disp->screen_cnt = 0;
         }
 
-        lv_obj_t ** screens = lv_realloc(disp->screens, sizeof(lv_obj_t *) * (disp->screen_cnt + 1));
-        LV_ASSERT_MALLOC(screens);
-        if(screens == NULL) {
+        if(lv_obj_screens_fit(disp, disp->screen_cnt + 1) != LV_RESULT_OK) {
             lv_free(obj);
             return NULL;
         }
 
         disp->screen_cnt++;
-        disp->screens = screens;
         disp->screens[disp->screen_cnt - 1] = obj;
 
         /*Set coordinates to full screen size*/
@@ -92,9 +90,12 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
             lv_obj_allocate_spec_attr(parent);
         }
 
+        if(lv_obj_children_fit(parent, parent->spec_attr->child_cnt + 1) != LV_RESULT_OK) {
+            lv_free(obj);
+            return NULL;
+        }
+
         parent->spec_attr->child_cnt++;
-        parent->spec_attr->children = lv_realloc(parent->spec_attr->children,
-                                                 sizeof(lv_obj_t *) * parent->spec_attr->child_cnt);
         parent->spec_attr->children[parent->spec_attr->child_cnt - 1] = obj;
     }
 
@@ -110,6 +111,7 @@ void lv_obj_class_init_obj(lv_obj_t * obj)
 
     lv_theme_apply(obj);
     lv_obj_construct(obj->class_p, obj);
+    lv_indev_hit_index_invalidate_obj(obj);
 
     lv_obj_enable_style_refresh(true);
     lv_obj_refresh_style(obj, LV_PART_ANY, LV_STYLE_PROP_ANY);
@@ -11,6 +11,7 @@
 #include "lv_obj_style.h"
 #include "../display/lv_display.h"
 #include "../indev/lv_indev.h"
+#include "../indev/lv_indev_hit_index_private.h"
 #include "../stdlib/lv_string.h"
 #include "../draw/lv_draw_arc.h"
 
@@ -294,6 +295,12 @@ void lv_obj_refresh_ext_draw_size(lv_obj_t * obj)
     int32_t s_new = 0;
     lv_obj_send_event(obj, LV_EVENT_REFR_EXT_DRAW_SIZE, &s_new);
 
+#if LV_INDEV_HIT_INDEX_CELL_SIZE
+    /*The children can be clicked on the extended area too*/
+    bool hit_index_changed = s_new != s_old && lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE);
+    if(hit_index_changed) lv_indev_hit_index_invalidate_obj(obj);
+#endif
+
     /*Store the result if the special attrs already allocated*/
     if(obj->spec_attr) {
         obj->spec_attr->ext_draw_size = s_new;
@@ -306,6 +313,9 @@ void lv_obj_refresh_ext_draw_size(lv_obj_t * obj)
     }
 
     if(s_new != s_old) lv_obj_invalidate(obj);
+#if LV_INDEV_HIT_INDEX_CELL_SIZE
+    if(hit_index_changed) lv_indev_hit_index_invalidate_obj(obj);
+#endif
 }
 
 int32_t lv_obj_get_ext_draw_size(const lv_obj_t * obj)
@@ -12,12 +12,16 @@
 #include "lv_obj_private.h"
 #include "../indev/lv_indev.h"
 #include "../indev/lv_indev_private.h"
+#include "lv_global.h"
 
 /*********************
  *      DEFINES
  *********************/
 #define MY_CLASS (&lv_obj_class)
 
+#define event_sent_cnt LV_GLOBAL_DEFAULT()->obj_event_sent_cnt
+#define event_handled_cnt LV_GLOBAL_DEFAULT()->obj_event_handled_cnt
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -26,6 +30,7 @@
  *  STATIC PROTOTYPES
  **********************/
 static lv_result_t event_send_core(lv_event_t * e);
+static void event_filter_update(lv_obj_t * obj);
 static bool event_is_bubbled(lv_event_t * e);
 
 /**********************
@@ -100,7 +105,9 @@ lv_event_dsc_t * lv_obj_add_event_cb(lv_obj_t * obj, lv_event_cb_t event_cb, lv_
     LV_ASSERT_OBJ(obj, MY_CLASS);
     lv_obj_allocate_spec_attr(obj);
 
-    return lv_event_add(&obj->spec_attr->event_list, event_cb, filter, user_data);
+    lv_event_dsc_t * dsc = lv_event_add(&obj->spec_attr->event_list, event_cb, filter, user_data);
+    event_filter_update(obj);
+    return dsc;
 }
 
 uint32_t lv_obj_get_event_count(lv_obj_t * obj)
@@ -121,7 +128,9 @@ bool lv_obj_remove_event(lv_obj_t * obj, uint32_t index)
 {
     LV_ASSERT_NULL(obj);
     if(obj->spec_attr == NULL) return false;
-    return lv_event_remove(&obj->spec_attr->event_list, index);
+    bool res = lv_event_remove(&obj->spec_attr->event_list, index);
+    event_filter_update(obj);
+    return res;
 }
 
 bool lv_obj_remove_event_cb(lv_obj_t * obj, lv_event_cb_t event_cb)
@@ -146,7 +155,9 @@ bool lv_obj_remove_event_dsc(lv_obj_t * obj, lv_event_dsc_t * dsc)
     LV_ASSERT_NULL(obj);
     LV_ASSERT_NULL(dsc);
     if(obj->spec_attr == NULL) return false;
-    return lv_event_remove_dsc(&obj->spec_attr->event_list, dsc);
+    bool res = lv_event_remove_dsc(&obj->spec_attr->event_list, dsc);
+    event_filter_update(obj);
+    return res;
 }
 
 uint32_t lv_obj_remove_event_cb_with_user_data(lv_obj_t * obj, lv_event_cb_t event_cb, void * user_data)
@@ -168,6 +179,18 @@ uint32_t lv_obj_remove_event_cb_with_user_data(lv_obj_t * obj, lv_event_cb_t eve
     return removed_count;
 }
 
+void lv_obj_get_event_stats(uint32_t * sent_cnt, uint32_t * handled_cnt)
+{
+    if(sent_cnt) *sent_cnt = event_sent_cnt;
+    if(handled_cnt) *handled_cnt = event_handled_cnt;
+}
+
+void lv_obj_reset_event_stats(void)
+{
+    event_sent_cnt = 0;
+    event_handled_cnt = 0;
+}
+
 lv_obj_t * lv_event_get_current_target_obj(lv_event_t * e)
 {
     return lv_event_get_current_target(e);
@@ -356,7 +379,14 @@ static lv_result_t event_send_core(lv_event_t * e)
 
     lv_obj_t * target = e->current_target;
     lv_result_t res = LV_RESULT_OK;
-    lv_event_list_t * list = target->spec_attr ?  &target->spec_attr->event_list : NULL;
+
+    /*Skip the event list if none of its callbacks listen to this event*/
+    lv_event_list_t * list = NULL;
+    if(target->spec_attr && (target->spec_attr->event_filter & lv_event_get_filter_bit(e->code))) {
+        list = &target->spec_attr->event_list;
+        event_handled_cnt++;
+    }
+    event_sent_cnt++;
 
     res = lv_event_send(list, e, true);
     if(res != LV_RESULT_OK || e->stop_processing) return res;
@@ -417,3 +447,8 @@ static bool event_is_bubbled(lv_event_t * e)
             return true;
     }
 }
+
+static void event_filter_update(lv_obj_t * obj)
+{
+    obj->spec_attr->event_filter = lv_event_get_filter_mask(&obj->spec_attr->event_list);
+}
@@ -99,6 +99,20 @@ bool lv_obj_remove_event_dsc(lv_obj_t * obj, lv_event_dsc_t * dsc);
  */
 uint32_t lv_obj_remove_event_cb_with_user_data(lv_obj_t * obj, lv_event_cb_t event_cb, void * user_data);
 
+/**
+ * Get how many times events were sent to objects and how many of them reached an event callback.
+ * Events sent to the parents by bubbling are counted for each parent.
+ * Objects without a callback for an event code skip their event list.
+ * @param sent_cnt      store the number of events sent here (can be NULL)
+ * @param handled_cnt   store the number of events with a callback listening to them here (can be NULL)
+ */
+void lv_obj_get_event_stats(uint32_t * sent_cnt, uint32_t * handled_cnt);
+
+/**
+ * Reset the counters of `lv_obj_get_event_stats`.
+ */
+void lv_obj_reset_event_stats(void);
+
 /**
  * Get the input device passed as parameter to indev related events.
  * @param e     pointer to an event
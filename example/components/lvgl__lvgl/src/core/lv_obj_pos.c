@@ -14,6 +14,8 @@
 #include "../display/lv_display.h"
 #include "../display/lv_display_private.h"
 #include "lv_refr_private.h"
+#include "lv_obj_render_cache_private.h"
+#include "../indev/lv_indev_hit_index_private.h"
 #include "../core/lv_global.h"
 
 /*********************
@@ -31,6 +33,8 @@
  **********************/
 static int32_t calc_content_width(lv_obj_t * obj);
 static int32_t calc_content_height(lv_obj_t * obj);
+static void mark_child_layout_as_dirty(lv_obj_t * obj);
+static void move_children_by_core(lv_obj_t * obj, int32_t x_diff, int32_t y_diff, bool ignore_floating);
 static void layout_update_core(lv_obj_t * obj);
 static void transform_point_array(const lv_obj_t * obj, lv_point_t * p, size_t p_count, bool inv);
 
@@ -163,6 +167,7 @@ bool lv_obj_refr_size(lv_obj_t * obj)
 
     /*Invalidate the original area*/
     lv_obj_invalidate(obj);
+    lv_indev_hit_index_invalidate_obj(obj);
 
     /*Save the original coordinates*/
     lv_area_t ori;
@@ -195,8 +200,10 @@ bool lv_obj_refr_size(lv_obj_t * obj)
 
     /*Invalidate the new area*/
     lv_obj_invalidate(obj);
+    lv_indev_hit_index_invalidate_obj(obj);
 
     obj->readjust_scroll_after_layout = 1;
+    mark_child_layout_as_dirty(obj);
 
     /*If the object was out of the parent invalidate the new scrollbar area too.
      *If it wasn't out of the parent but out now, also invalidate the scrollbars*/
@@ -280,6 +287,7 @@ bool lv_obj_is_layout_positioned(const lv_obj_t * obj)
 void lv_obj_mark_layout_as_dirty(lv_obj_t * obj)
 {
     obj->layout_inv = 1;
+    mark_child_layout_as_dirty(obj);
 
     /*Mark the screen as dirty too to mark that there is something to do on this screen*/
     lv_obj_t * scr = lv_obj_get_screen(obj);
@@ -715,6 +723,7 @@ void lv_obj_move_to(lv_obj_t * obj, int32_t x, int32_t y)
 
     /*Invalidate the original area*/
     lv_obj_invalidate(obj);
+    lv_indev_hit_index_invalidate_obj(obj);
 
     /*Save the original coordinates*/
     lv_area_t ori;
@@ -744,6 +753,7 @@ void lv_obj_move_to(lv_obj_t * obj, int32_t x, int32_t y)
 
     /*Invalidate the new area*/
     lv_obj_invalidate(obj);
+    lv_indev_hit_index_invalidate_obj(obj);
 
     /*If the object was out of the parent invalidate the new scrollbar area too.
      *If it wasn't out of the parent but out now, also invalidate the scrollbars*/
@@ -755,18 +765,10 @@ void lv_obj_move_to(lv_obj_t * obj, int32_t x, int32_t y)
 
 void lv_obj_move_children_by(lv_obj_t * obj, int32_t x_diff, int32_t y_diff, bool ignore_floating)
 {
-    uint32_t i;
-    uint32_t child_cnt = lv_obj_get_child_count(obj);
-    for(i = 0; i < child_cnt; i++) {
-        lv_obj_t * child = obj->spec_attr->children[i];
-        if(ignore_floating && lv_obj_has_flag(child, LV_OBJ_FLAG_FLOATING)) continue;
-        child->coords.x1 += x_diff;
-        child->coords.y1 += y_diff;
-        child->coords.x2 += x_diff;
-        child->coords.y2 += y_diff;
+    /*The children are clipped to the object so its area covers their old and new positions*/
+    lv_indev_hit_index_invalidate_obj(obj);
 
-        lv_obj_move_children_by(child, x_diff, y_diff, false);
-    }
+    move_children_by_core(obj, x_diff, y_diff, ignore_floating);
 }
 
 void lv_obj_transform_point(const lv_obj_t * obj, lv_point_t * p, lv_obj_point_transform_flag_t flags)
@@ -814,6 +816,9 @@ void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    /*The cached images are outdated even if the change is not visible now*/
+    lv_obj_render_cache_invalidate(obj);
+
     lv_display_t * disp   = lv_obj_get_display(obj);
     if(!lv_display_is_invalidation_enabled(disp)) return;
 
@@ -922,7 +927,9 @@ void lv_obj_set_ext_click_area(lv_obj_t * obj, int32_t size)
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
     lv_obj_allocate_spec_attr(obj);
+    lv_indev_hit_index_invalidate_obj(obj);
     obj->spec_attr->ext_click_pad = size;
+    lv_indev_hit_index_invalidate_obj(obj);
 }
 
 void lv_obj_get_click_area(const lv_obj_t * obj, lv_area_t * area)
@@ -1123,13 +1130,50 @@ static int32_t calc_content_height(lv_obj_t * obj)
     return LV_MAX(self_h, child_res + space_bottom);
 }
 
-static void layout_update_core(lv_obj_t * obj)
+/**
+ * Mark the parents of an object to show that there is a layout update to do in their subtree
+ * @param obj       pointer to an object whose layout or scroll position needs to be updated
+ */
+static void mark_child_layout_as_dirty(lv_obj_t * obj)
+{
+    lv_obj_t * parent = obj->parent;
+    while(parent && !parent->layout_child_inv) {
+        parent->layout_child_inv = 1;
+        parent = parent->parent;
+    }
+}
+
+static void move_children_by_core(lv_obj_t * obj, int32_t x_diff, int32_t y_diff, bool ignore_floating)
 {
     uint32_t i;
     uint32_t child_cnt = lv_obj_get_child_count(obj);
     for(i = 0; i < child_cnt; i++) {
         lv_obj_t * child = obj->spec_attr->children[i];
-        layout_update_core(child);
+        if(ignore_floating && lv_obj_has_flag(child, LV_OBJ_FLAG_FLOATING)) continue;
+        child->coords.x1 += x_diff;
+        child->coords.y1 += y_diff;
+        child->coords.x2 += x_diff;
+        child->coords.y2 += y_diff;
+
+        move_children_by_core(child, x_diff, y_diff, false);
+    }
+}
+
+static void layout_update_core(lv_obj_t * obj)
+{
+    uint32_t i;
+    uint32_t child_cnt = lv_obj_get_child_count(obj);
+
+    /*Only the subtrees with something to update are visited.
+     *Clear the flag first as it's set again if the children get dirty meanwhile.*/
+    if(obj->layout_child_inv) {
+        obj->layout_child_inv = 0;
+        for(i = 0; i < child_cnt; i++) {
+            lv_obj_t * child = obj->spec_attr->children[i];
+            if(child->layout_inv || child->layout_child_inv || child->readjust_scroll_after_layout) {
+                layout_update_core(child);
+            }
+        }
     }
 
     if(obj->layout_inv) {
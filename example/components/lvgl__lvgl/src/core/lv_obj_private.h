@@ -32,12 +32,14 @@ struct lv_obj_spec_attr_t {
     lv_obj_t ** children;           /**< Store the pointer of the children in an array.*/
     lv_group_t * group_p;
     lv_event_list_t event_list;
+    uint64_t event_filter;          /**< Bitmap of the event codes `event_list` listens to, see `lv_event_get_filter_mask`*/
 
     lv_point_t scroll;              /**< The current X/Y scroll offset*/
 
     int32_t ext_click_pad;          /**< Extra click padding in all direction*/
     int32_t ext_draw_size;          /**< EXTend the size in every direction for drawing.*/
 
+    uint32_t child_size;            /**< Number of children `children` has memory for*/
     uint16_t child_cnt;             /**< Number of children*/
     uint16_t scrollbar_mode : 2;    /**< How to display scrollbars, see `lv_scrollbar_mode_t`*/
     uint16_t scroll_snap_x : 2;     /**< Where to align the snappable children horizontally, see `lv_scroll_snap_t`*/
@@ -54,6 +56,9 @@ struct lv_obj_t {
 #if LV_OBJ_STYLE_CACHE
     uint32_t style_main_prop_is_set;
     uint32_t style_other_prop_is_set;
+#endif
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE
+    lv_obj_style_resolved_t * style_resolved;
 #endif
     void * user_data;
 #if LV_USE_OBJ_ID
@@ -63,6 +68,7 @@ struct lv_obj_t {
     lv_obj_flag_t flags;
     lv_state_t state;
     uint16_t layout_inv : 1;
+    uint16_t layout_child_inv : 1;  /**< A descendant has `layout_inv` or `readjust_scroll_after_layout` set*/
     uint16_t readjust_scroll_after_layout : 1;
     uint16_t scr_layout_inv : 1;
     uint16_t skip_trans : 1;
@@ -77,6 +83,24 @@ struct lv_obj_t {
  * GLOBAL PROTOTYPES
  **********************/
 
+/**
+ * Resize the child array of an object to hold `cnt` children.
+ * The array grows geometrically. After removing children (`cnt` is not more than the current child count)
+ * it shrinks if it's less than quarter full and it's freed if there are no children.
+ * @param obj       pointer to an object
+ * @param cnt       the new number of children
+ * @return          LV_RESULT_OK: the children fit into the array
+ */
+lv_result_t lv_obj_children_fit(lv_obj_t * obj, uint32_t cnt);
+
+/**
+ * Resize the screen array of a display to hold `cnt` screens the same way as the child arrays.
+ * @param disp      pointer to a display
+ * @param cnt       the new number of screens
+ * @return          LV_RESULT_OK: the screens fit into the array
+ */
+lv_result_t lv_obj_screens_fit(lv_display_t * disp, uint32_t cnt);
+
 /**********************
  *      MACROS
  **********************/
@@ -0,0 +1,264 @@
+/**
+ * @file lv_obj_render_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_obj_render_cache_private.h"
+#include "lv_obj_private.h"
+#include "lv_obj_draw_private.h"
+#include "lv_refr_private.h"
+#include "lv_global.h"
+#include "../display/lv_display_private.h"
+#include "../draw/lv_draw_private.h"
+#include "../draw/lv_draw_image.h"
+#include "../misc/lv_area_private.h"
+#include "../stdlib/lv_string.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define CACHE_NAME  "OBJ_RENDER"
+
+#define render_cache_p (LV_GLOBAL_DEFAULT()->obj_render_cache)
+#define render_cache_drawn (LV_GLOBAL_DEFAULT()->obj_render_cache_drawn)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_cache_compare_res_t render_cache_compare_cb(const lv_obj_render_cache_data_t * lhs,
+                                                      const lv_obj_render_cache_data_t * rhs);
+static void render_cache_free_cb(lv_obj_render_cache_data_t * data, void * user_data);
+static lv_cache_entry_t * render_cache_add(lv_obj_t * obj, const lv_area_t * area);
+static void render_obj(lv_obj_t * obj, lv_draw_buf_t * draw_buf, const lv_area_t * area);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_result_t lv_obj_render_cache_init(uint32_t size)
+{
+    if(render_cache_p != NULL) {
+        return LV_RESULT_OK;
+    }
+
+    render_cache_p = lv_cache_create(&lv_cache_class_lru_rb_size,
+    sizeof(lv_obj_render_cache_data_t), size, (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t) render_cache_compare_cb,
+        .create_cb = NULL,
+        .free_cb = (lv_cache_free_cb_t) render_cache_free_cb,
+    });
+
+    lv_cache_set_name(render_cache_p, CACHE_NAME);
+    lv_array_init(&render_cache_drawn, 4, sizeof(lv_cache_entry_t *));
+    return render_cache_p != NULL ? LV_RESULT_OK : LV_RESULT_INVALID;
+}
+
+void lv_obj_render_cache_deinit(void)
+{
+    lv_obj_render_cache_release_drawn();
+    lv_array_deinit(&render_cache_drawn);
+    lv_cache_destroy(render_cache_p, NULL);
+    render_cache_p = NULL;
+}
+
+void lv_obj_render_cache_resize(uint32_t new_size, bool evict_now)
+{
+    lv_cache_set_max_size(render_cache_p, new_size, NULL);
+    if(evict_now) {
+        lv_cache_reserve(render_cache_p, new_size, NULL);
+    }
+}
+
+void lv_obj_render_cache_drop(const lv_obj_t * obj)
+{
+    if(obj == NULL) {
+        lv_cache_drop_all(render_cache_p, NULL);
+        return;
+    }
+
+    lv_obj_render_cache_data_t search_key;
+    search_key.obj = obj;
+    lv_cache_drop(render_cache_p, &search_key, NULL);
+}
+
+bool lv_obj_render_cache_is_enabled(void)
+{
+    return lv_cache_is_enabled(render_cache_p);
+}
+
+void lv_obj_render_cache_invalidate(const lv_obj_t * obj)
+{
+    /*Called on every invalidation so don't walk the parents if nothing is cached*/
+    if(render_cache_p == NULL || lv_cache_get_size(render_cache_p, NULL) == 0) return;
+
+    while(obj) {
+        if(lv_obj_has_flag(obj, LV_OBJ_FLAG_RENDER_CACHE)) lv_obj_render_cache_drop(obj);
+        obj = obj->parent;
+    }
+}
+
+bool lv_obj_render_cache_draw(lv_layer_t * layer, lv_obj_t * obj)
+{
+    if(!lv_cache_is_enabled(render_cache_p)) return false;
+
+    lv_area_t area;
+    int32_t ext_size = lv_obj_get_ext_draw_size(obj);
+    lv_obj_get_coords(obj, &area);
+    lv_area_increase(&area, ext_size, ext_size);
+
+    /*Not visible, nothing to draw*/
+    lv_area_t clip_area;
+    if(!lv_area_intersect(&clip_area, &area, &layer->_clip_area)) return true;
+
+    lv_obj_render_cache_data_t search_key;
+    search_key.obj = obj;
+    lv_cache_entry_t * entry = lv_cache_acquire(render_cache_p, &search_key, NULL);
+    if(entry) {
+        /*The object was moved with its parent (e.g. scrolled) but it was resized in an other way*/
+        lv_obj_render_cache_data_t * data = lv_cache_entry_get_data(entry);
+        if(data->draw_buf->header.w != lv_area_get_width(&area) ||
+           data->draw_buf->header.h != lv_area_get_height(&area)) {
+            lv_cache_release(render_cache_p, entry, NULL);
+            lv_cache_drop(render_cache_p, &search_key, NULL);
+            entry = NULL;
+        }
+    }
+
+    if(entry == NULL) entry = render_cache_add(obj, &area);
+    if(entry == NULL) return false;
+
+    /*The draw task uses the buffer so release the entry only when it's finished*/
+    if(lv_array_push_back(&render_cache_drawn, &entry) != LV_RESULT_OK) {
+        lv_cache_release(render_cache_p, entry, NULL);
+        return false;
+    }
+
+    lv_obj_render_cache_data_t * data = lv_cache_entry_get_data(entry);
+    lv_draw_image_dsc_t draw_dsc;
+    lv_draw_image_dsc_init(&draw_dsc);
+    draw_dsc.src = data->draw_buf;
+    lv_draw_image(layer, &draw_dsc, &area);
+
+    return true;
+}
+
+void lv_obj_render_cache_release_drawn(void)
+{
+    uint32_t i;
+    uint32_t cnt = lv_array_size(&render_cache_drawn);
+    for(i = 0; i < cnt; i++) {
+        lv_cache_entry_t ** entry = lv_array_at(&render_cache_drawn, i);
+        lv_cache_release(render_cache_p, *entry, NULL);
+    }
+    lv_array_clear(&render_cache_drawn);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static lv_cache_compare_res_t render_cache_compare_cb(const lv_obj_render_cache_data_t * lhs,
+                                                      const lv_obj_render_cache_data_t * rhs)
+{
+    if(lhs->obj != rhs->obj) {
+        return lhs->obj > rhs->obj ? 1 : -1;
+    }
+
+    return 0;
+}
+
+static void render_cache_free_cb(lv_obj_render_cache_data_t * data, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_image_cache_drop(data->draw_buf);
+    lv_draw_buf_destroy(data->draw_buf);
+}
+
+/**
+ * Render an object into a new draw buffer and add it to the cache
+ * @param obj       pointer to an object
+ * @param area      the area of the object with its ext. draw size
+ * @return          the acquired cache entry or NULL if the image doesn't fit into the cache
+ */
+static lv_cache_entry_t * render_cache_add(lv_obj_t * obj, const lv_area_t * area)
+{
+    int32_t w = lv_area_get_width(area);
+    int32_t h = lv_area_get_height(area);
+    uint32_t data_size = lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_ARGB8888) * h;
+
+    if(data_size > lv_cache_get_max_size(render_cache_p, NULL)) return NULL;
+
+    /*Free space first to not have the old and the new images in the memory at the same time*/
+    lv_cache_reserve(render_cache_p, data_size, NULL);
+    if(lv_cache_get_size(render_cache_p, NULL) + data_size > lv_cache_get_max_size(render_cache_p, NULL)) return NULL;
+
+    lv_draw_buf_t * draw_buf = lv_draw_buf_create(w, h, LV_COLOR_FORMAT_ARGB8888, LV_STRIDE_AUTO);
+    if(draw_buf == NULL) return NULL;
+
+    render_obj(obj, draw_buf, area);
+
+    lv_obj_render_cache_data_t search_key;
+    search_key.slot.size = draw_buf->data_size;
+    search_key.obj = obj;
+    search_key.draw_buf = draw_buf;
+
+    lv_cache_entry_t * entry = lv_cache_add(render_cache_p, &search_key, NULL);
+    if(entry == NULL) lv_draw_buf_destroy(draw_buf);
+
+    return entry;
+}
+
+/**
+ * Render an object and its children into a draw buffer without clipping them to the display
+ * @param obj       pointer to an object
+ * @param draw_buf  the buffer to render to. Its size should be equal to `area`
+ * @param area      the area of the object with its ext. draw size
+ */
+static void render_obj(lv_obj_t * obj, lv_draw_buf_t * draw_buf, const lv_area_t * area)
+{
+    lv_draw_buf_clear(draw_buf, NULL);
+
+    lv_layer_t layer;
+    lv_memzero(&layer, sizeof(layer));
+    layer.draw_buf = draw_buf;
+    layer.buf_area = *area;
+    layer.color_format = LV_COLOR_FORMAT_ARGB8888;
+    layer._clip_area = *area;
+    layer.phy_clip_area = *area;
+#if LV_DRAW_TRANSFORM_USE_MATRIX
+    lv_matrix_identity(&layer.matrix);
+#endif
+
+    /*Render only this layer until it's ready. The tasks of the display's layers are dispatched later.*/
+    lv_display_t * disp_old = lv_refr_get_disp_refreshing();
+    lv_display_t * disp = lv_obj_get_display(obj);
+    lv_layer_t * layer_old = disp->layer_head;
+    disp->layer_head = &layer;
+    lv_refr_set_disp_refreshing(disp);
+
+    lv_obj_redraw(&layer, obj);
+
+    while(layer.draw_task_head) {
+        lv_draw_dispatch_wait_for_request();
+        lv_draw_dispatch();
+    }
+
+    disp->layer_head = layer_old;
+    lv_refr_set_disp_refreshing(disp_old);
+}
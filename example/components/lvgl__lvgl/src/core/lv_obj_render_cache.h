@@ -0,0 +1,59 @@
+/**
+ * @file lv_obj_render_cache.h
+ *
+ */
+
+#ifndef LV_OBJ_RENDER_CACHE_H
+#define LV_OBJ_RENDER_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../misc/lv_types.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Set the maximum size of the render cache.
+ * Objects with `LV_OBJ_FLAG_RENDER_CACHE` are drawn normally if the cache is disabled or full.
+ * @param new_size      the new size in bytes, 0 to disable the cache
+ * @param evict_now     true: evict the entries that don't fit now, false: evict them only when new entries are added
+ */
+void lv_obj_render_cache_resize(uint32_t new_size, bool evict_now);
+
+/**
+ * Drop the cached image of an object. It will be rendered again the next time it's drawn.
+ * Normally it's not required as the image is dropped when the object or its children are invalidated.
+ * @param obj           pointer to an object, or NULL to drop all the cached images
+ */
+void lv_obj_render_cache_drop(const lv_obj_t * obj);
+
+/**
+ * Check if the render cache is enabled.
+ * @return              true: the cache is enabled, false: its size is 0
+ */
+bool lv_obj_render_cache_is_enabled(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_OBJ_RENDER_CACHE_H*/
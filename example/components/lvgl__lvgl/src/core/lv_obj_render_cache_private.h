@@ -0,0 +1,79 @@
+/**
+ * @file lv_obj_render_cache_private.h
+ *
+ */
+
+#ifndef LV_OBJ_RENDER_CACHE_PRIVATE_H
+#define LV_OBJ_RENDER_CACHE_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_obj_render_cache.h"
+#include "../misc/cache/lv_cache.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    lv_cache_slot_size_t slot;
+
+    const lv_obj_t * obj;
+    lv_draw_buf_t * draw_buf;   /**< The object rendered with its ext. draw size in ARGB8888 format*/
+} lv_obj_render_cache_data_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the render cache.
+ * @param size          the maximum size of the cache in bytes
+ * @return              LV_RESULT_OK: the cache is created
+ */
+lv_result_t lv_obj_render_cache_init(uint32_t size);
+
+/**
+ * Free all the cached images and delete the render cache.
+ */
+void lv_obj_render_cache_deinit(void);
+
+/**
+ * Drop the cached images of the object and its parents as the object's content has changed.
+ * @param obj           pointer to an object
+ */
+void lv_obj_render_cache_invalidate(const lv_obj_t * obj);
+
+/**
+ * Draw an object with `LV_OBJ_FLAG_RENDER_CACHE` from the render cache.
+ * If the object is not cached yet it's rendered into a new cache entry first.
+ * @param layer         the layer to draw to
+ * @param obj           pointer to an object
+ * @return              true: the object is drawn; false: it couldn't be cached, draw it normally
+ */
+bool lv_obj_render_cache_draw(lv_layer_t * layer, lv_obj_t * obj);
+
+/**
+ * Release the cache entries used by the draw tasks of the last refresh.
+ * Should be called when all the draw tasks are finished.
+ */
+void lv_obj_render_cache_release_drawn(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_OBJ_RENDER_CACHE_PRIVATE_H*/
@@ -9,10 +9,14 @@
 #include "lv_obj_scroll_private.h"
 #include "../misc/lv_anim_private.h"
 #include "lv_obj_private.h"
+#include "lv_obj_draw_private.h"
+#include "lv_obj_class_private.h"
+#include "lv_refr_private.h"
 #include "../indev/lv_indev.h"
 #include "../indev/lv_indev_scroll.h"
 #include "../display/lv_display.h"
-#include "../misc/lv_area.h"
+#include "../misc/lv_area_private.h"
+#include "../misc/lv_event_private.h"
 
 /*********************
  *      DEFINES
@@ -38,6 +42,8 @@ static void scroll_y_anim(void * obj, int32_t v);
 static void scroll_end_cb(lv_anim_t * a);
 static void scroll_area_into_view(const lv_area_t * area, lv_obj_t * child, lv_point_t * scroll_value,
                                   lv_anim_enable_t anim_en);
+static bool scroll_move_area_get(lv_obj_t * obj, lv_area_t * area);
+static void scroll_move_invalidate_fixed(lv_obj_t * obj, const lv_area_t * area);
 
 /**********************
  *  STATIC VARIABLES
@@ -416,13 +422,33 @@ lv_result_t lv_obj_scroll_by_raw(lv_obj_t * obj, int32_t x, int32_t y)
 
     lv_obj_allocate_spec_attr(obj);
 
+    /*If possible, move the rendered pixels instead of redrawing the whole object.
+     *What doesn't move with the content needs to be redrawn before and after scrolling.*/
+    lv_area_t move_area;
+    bool move = scroll_move_area_get(obj, &move_area);
+    if(move) scroll_move_invalidate_fixed(obj, &move_area);
+
     obj->spec_attr->scroll.x += x;
     obj->spec_attr->scroll.y += y;
 
     lv_obj_move_children_by(obj, x, y, true);
     lv_result_t res = lv_obj_send_event(obj, LV_EVENT_SCROLL, NULL);
     if(res != LV_RESULT_OK) return res;
-    lv_obj_invalidate(obj);
+
+    if(move && lv_refr_move_area(lv_obj_get_display(obj), &move_area, x, y)) {
+        scroll_move_invalidate_fixed(obj, &move_area);
+
+        /*The children are visible on the border too*/
+        lv_area_t res_areas[4];
+        int8_t res_c = lv_area_diff(res_areas, &obj->coords, &move_area);
+        int8_t i;
+        for(i = 0; i < res_c; i++) {
+            lv_obj_invalidate_area(obj, &res_areas[i]);
+        }
+    }
+    else {
+        lv_obj_invalidate(obj);
+    }
     return LV_RESULT_OK;
 }
 
@@ -797,3 +823,109 @@ static void scroll_area_into_view(const lv_area_t * area, lv_obj_t * child, lv_p
     scroll_value->y += anim_en == LV_ANIM_OFF ? 0 : y_scroll;
     lv_obj_scroll_by(parent, x_scroll, y_scroll, anim_en);
 }
+
+/**
+ * Get the area whose pixels can be simply moved when the object is scrolled
+ * @param obj       pointer to an object
+ * @param area      store the visible area of the content here
+ * @return          true: the pixels can be moved
+ */
+static bool scroll_move_area_get(lv_obj_t * obj, lv_area_t * area)
+{
+    if(!lv_display_get_scroll_blit(lv_obj_get_display(obj))) return false;
+
+    /*Derived widgets might draw something which doesn't scroll with the content*/
+    const lv_obj_class_t * class_p = obj->class_p;
+    while(class_p && class_p != &lv_obj_class) {
+        if(class_p->event_cb) return false;
+        class_p = class_p->base_class;
+    }
+
+    uint32_t event_cnt = lv_obj_get_event_count(obj);
+    uint32_t i;
+    for(i = 0; i < event_cnt; i++) {
+        uint32_t filter = lv_obj_get_event_dsc(obj, i)->filter & ~LV_EVENT_PREPROCESS;
+        if(filter == LV_EVENT_ALL || (filter >= LV_EVENT_COVER_CHECK && filter <= LV_EVENT_DRAW_TASK_ADDED)) return false;
+    }
+
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) return false;
+
+    /*The background needs to look the same everywhere*/
+    if(lv_obj_get_style_bg_opa(obj, LV_PART_MAIN) < LV_OPA_COVER) return false;
+    if(lv_obj_get_style_bg_grad_dir(obj, LV_PART_MAIN) != LV_GRAD_DIR_NONE) return false;
+    if(lv_obj_get_style_bg_image_src(obj, LV_PART_MAIN) != NULL) return false;
+
+    /*Transformed and semi transparent objects are not rendered directly to the display.
+     *The cached images of the render cache would show the old scroll position as the moved
+     *area might not be invalidated at all.*/
+    lv_obj_t * parent;
+    for(parent = obj; parent; parent = lv_obj_get_parent(parent)) {
+        if(lv_obj_get_layer_type(parent) != LV_LAYER_TYPE_NONE) return false;
+        if(lv_obj_has_flag(parent, LV_OBJ_FLAG_RENDER_CACHE)) return false;
+    }
+
+    /*Leave out the border and the rounded corners*/
+    int32_t inset = LV_MAX(lv_obj_get_style_border_width(obj, LV_PART_MAIN), lv_obj_get_style_radius(obj, LV_PART_MAIN));
+    *area = obj->coords;
+    lv_area_increase(area, -inset, -inset);
+    if(lv_area_get_width(area) <= 0 || lv_area_get_height(area) <= 0) return false;
+
+    return lv_obj_area_is_visible(obj, area);
+}
+
+/**
+ * Invalidate what is drawn on the moved area but doesn't scroll with the content
+ * @param obj       pointer to the scrolled object
+ * @param area      the area whose pixels are moved
+ */
+static void scroll_move_invalidate_fixed(lv_obj_t * obj, const lv_area_t * area)
+{
+    lv_obj_scrollbar_invalidate(obj);
+
+    uint32_t i;
+    uint32_t child_cnt = lv_obj_get_child_count(obj);
+    for(i = 0; i < child_cnt; i++) {
+        lv_obj_t * child = obj->spec_attr->children[i];
+        if(lv_obj_has_flag(child, LV_OBJ_FLAG_FLOATING)) lv_obj_invalidate(child);
+    }
+
+    /*The objects drawn later on the area and the scrollbars of the parents*/
+    lv_area_t obj_area;
+    lv_obj_t * cur = obj;
+    lv_obj_t * parent = lv_obj_get_parent(cur);
+    while(parent) {
+        child_cnt = lv_obj_get_child_count(parent);
+        for(i = lv_obj_get_index(cur) + 1; i < child_cnt; i++) {
+            lv_obj_t * sibling = parent->spec_attr->children[i];
+            if(lv_obj_has_flag(sibling, LV_OBJ_FLAG_HIDDEN)) continue;
+
+            int32_t ext_size = lv_obj_get_ext_draw_size(sibling);
+            obj_area = sibling->coords;
+            lv_area_increase(&obj_area, ext_size, ext_size);
+            if(lv_area_is_on(&obj_area, area)) lv_obj_invalidate(sibling);
+        }
+
+        lv_obj_scrollbar_invalidate(parent);
+        cur = parent;
+        parent = lv_obj_get_parent(cur);
+    }
+
+    /*The layers above the screen*/
+    lv_display_t * disp = lv_obj_get_display(obj);
+    lv_obj_t * layers[2] = {lv_display_get_layer_top(disp), lv_display_get_layer_sys(disp)};
+    for(i = 0; i < 2; i++) {
+        if(layers[i] == NULL || layers[i] == cur) continue;
+
+        uint32_t j;
+        child_cnt = lv_obj_get_child_count(layers[i]);
+        for(j = 0; j < child_cnt; j++) {
+            lv_obj_t * child = layers[i]->spec_attr->children[j];
+            if(lv_obj_has_flag(child, LV_OBJ_FLAG_HIDDEN)) continue;
+
+            int32_t ext_size = lv_obj_get_ext_draw_size(child);
+            obj_area = child->coords;
+            lv_area_increase(&obj_area, ext_size, ext_size);
+            if(lv_area_is_on(&obj_area, area)) lv_obj_invalidate(child);
+        }
+    }
+}
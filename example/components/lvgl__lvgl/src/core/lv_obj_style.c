@@ -10,8 +10,10 @@
 #include "../misc/lv_anim_private.h"
 #include "lv_obj_style_private.h"
 #include "lv_obj_class_private.h"
+#include "lv_obj_draw_private.h"
 #include "../display/lv_display.h"
 #include "../display/lv_display_private.h"
+#include "../indev/lv_indev_hit_index_private.h"
 #include "../misc/lv_color.h"
 #include "../stdlib/lv_string.h"
 #include "../core/lv_global.h"
@@ -23,6 +25,14 @@
 #define style_trans_ll_p &(LV_GLOBAL_DEFAULT()->style_trans_ll)
 #define _style_custom_prop_flag_lookup_table LV_GLOBAL_DEFAULT()->style_custom_prop_flag_lookup_table
 #define STYLE_PROP_SHIFTED(prop) ((uint32_t)1 << ((prop) >> 3))
+#define style_resolved_gen LV_GLOBAL_DEFAULT()->style_resolved_gen
+
+/*Number of entries to check after the home slot of a property in the resolved style cache*/
+#define STYLE_RESOLVED_PROBE_CNT 4
+
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE & (LV_OBJ_STYLE_RESOLVED_CACHE_SIZE - 1)
+#error "LV_OBJ_STYLE_RESOLVED_CACHE_SIZE needs to be a power of 2"
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -55,6 +65,9 @@ static lv_style_t * get_local_style(lv_obj_t * obj, lv_style_selector_t selector
 static lv_obj_style_t * get_trans_style(lv_obj_t * obj, lv_part_t part);
 static lv_style_res_t get_prop_core(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop,
                                     lv_style_value_t * v);
+static lv_style_res_t get_prop_resolved(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop,
+                                        lv_style_value_t * v);
+static void style_resolved_invalidate(lv_obj_t * obj);
 static void report_style_change_core(void * style, lv_obj_t * obj);
 static void refresh_children_style(lv_obj_t * obj);
 static bool trans_delete(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, trans_t * tr_limit);
@@ -84,6 +97,7 @@ static lv_style_res_t get_selector_style_prop(const lv_obj_t * obj, lv_style_sel
 void lv_obj_style_init(void)
 {
     lv_ll_init(style_trans_ll_p, sizeof(trans_t));
+    style_resolved_gen = 1;
 }
 
 void lv_obj_style_deinit(void)
@@ -260,6 +274,10 @@ void lv_obj_remove_style_all(lv_obj_t * obj)
 
 void lv_obj_report_style_change(lv_style_t * style)
 {
+    /*Invalidate the resolved style properties of all objects. 0 is reserved for invalidated caches.*/
+    style_resolved_gen++;
+    if(style_resolved_gen == 0) style_resolved_gen = 1;
+
     if(!style_refr) return;
     lv_display_t * d = lv_display_get_next(NULL);
 
@@ -276,6 +294,8 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    style_resolved_invalidate(obj);
+
     if(!style_refr) return;
 
     lv_obj_invalidate(obj);
@@ -611,11 +631,23 @@ lv_opa_t lv_obj_get_style_opa_recursive(const lv_obj_t * obj, lv_part_t part)
 void lv_obj_update_layer_type(lv_obj_t * obj)
 {
     lv_layer_type_t layer_type = calculate_layer_type(obj);
+
+#if LV_INDEV_HIT_INDEX_CELL_SIZE
+    /*Transformed objects are indexed differently*/
+    bool hit_index_changed = (layer_type == LV_LAYER_TYPE_TRANSFORM) !=
+                             (lv_obj_get_layer_type(obj) == LV_LAYER_TYPE_TRANSFORM);
+    if(hit_index_changed) lv_indev_hit_index_invalidate_obj(obj);
+#endif
+
     if(obj->spec_attr) obj->spec_attr->layer_type = layer_type;
     else if(layer_type != LV_LAYER_TYPE_NONE) {
         lv_obj_allocate_spec_attr(obj);
         obj->spec_attr->layer_type = layer_type;
     }
+
+#if LV_INDEV_HIT_INDEX_CELL_SIZE
+    if(hit_index_changed) lv_indev_hit_index_invalidate_obj(obj);
+#endif
 }
 
 /**********************
@@ -748,6 +780,78 @@ static lv_style_res_t get_prop_core(const lv_obj_t * obj, lv_style_selector_t se
     else return LV_STYLE_RES_NOT_FOUND;
 }
 
+/**
+ * Get a property from the styles of an object like `get_prop_core` but
+ * return the result stored for the object's current state if available.
+ */
+static lv_style_res_t get_prop_resolved(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop,
+                                        lv_style_value_t * v)
+{
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE
+    /*Only the current state is stored. `skip_trans` is used only while creating a transition.*/
+    if(obj->skip_trans || lv_obj_style_get_selector_state(selector) != obj->state) {
+        return get_prop_core(obj, selector, prop, v);
+    }
+
+    lv_obj_t * obj_mutable = (lv_obj_t *)obj;
+    lv_obj_style_resolved_t * resolved = obj_mutable->style_resolved;
+    if(resolved == NULL) {
+        resolved = lv_malloc(sizeof(lv_obj_style_resolved_t));
+        if(resolved == NULL) return get_prop_core(obj, selector, prop, v);
+        resolved->gen = 0;
+        obj_mutable->style_resolved = resolved;
+    }
+
+    if(resolved->gen != style_resolved_gen || resolved->state != obj->state) {
+        lv_memzero(resolved->entries, sizeof(resolved->entries));
+        resolved->gen = style_resolved_gen;
+        resolved->state = obj->state;
+    }
+
+    const uint32_t part = lv_obj_style_get_selector_part(selector) >> 16;
+    const uint32_t mask = LV_OBJ_STYLE_RESOLVED_CACHE_SIZE - 1;
+    const uint32_t home = (prop + part * 61) & mask;
+    lv_obj_style_resolved_entry_t * entry = NULL;
+    uint32_t i;
+    for(i = 0; i < STYLE_RESOLVED_PROBE_CNT && i < LV_OBJ_STYLE_RESOLVED_CACHE_SIZE; i++) {
+        entry = &resolved->entries[(home + i) & mask];
+        if(entry->prop == LV_STYLE_PROP_INV) break;
+
+        if(entry->prop == prop && entry->part == part) {
+            if(!entry->found) return LV_STYLE_RES_NOT_FOUND;
+            *v = entry->value;
+            return LV_STYLE_RES_FOUND;
+        }
+    }
+
+    /*Not stored yet. Use the free entry or replace the property in the home slot*/
+    if(entry == NULL || entry->prop != LV_STYLE_PROP_INV) entry = &resolved->entries[home];
+
+    lv_style_res_t found = get_prop_core(obj, selector, prop, v);
+    entry->prop = prop;
+    entry->part = (uint8_t)part;
+    entry->found = found == LV_STYLE_RES_FOUND;
+    if(entry->found) entry->value = *v;
+    return found;
+#else
+    return get_prop_core(obj, selector, prop, v);
+#endif
+}
+
+/**
+ * Forget the resolved style properties of an object.
+ * Needs to be called when the styles of the object are changed.
+ * @param obj pointer to an object
+ */
+static void style_resolved_invalidate(lv_obj_t * obj)
+{
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE
+    if(obj->style_resolved) obj->style_resolved->gen = 0;
+#else
+    LV_UNUSED(obj);
+#endif
+}
+
 /**
  * Refresh the style of all children of an object. (Called recursively)
  * @param style refresh objects only with this
@@ -819,6 +923,7 @@ static bool trans_delete(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, t
                     lv_style_remove_prop((lv_style_t *)obj->styles[i].style, tr->prop);
                 }
             }
+            style_resolved_invalidate(obj);
 
             /*Free the transition descriptor too*/
             lv_anim_delete(tr, NULL);
@@ -946,6 +1051,7 @@ static void trans_anim_completed_cb(lv_anim_t * a)
 
                 lv_obj_style_t * obj_style = &obj->styles[i];
                 lv_style_remove_prop((lv_style_t *)obj_style->style, prop);
+                style_resolved_invalidate(obj);
 
                 if(lv_style_is_empty(obj->styles[i].style)) {
                     lv_obj_remove_style(obj, (lv_style_t *)obj_style->style, obj_style->selector);
@@ -1065,7 +1171,7 @@ static lv_style_res_t get_selector_style_prop(const lv_obj_t * obj, lv_style_sel
     if((part == LV_PART_MAIN ? obj->style_main_prop_is_set : obj->style_other_prop_is_set) & prop_shifted)
 #endif
     {
-        found = get_prop_core(obj, selector, prop, value_act);
+        found = get_prop_resolved(obj, selector, prop, value_act);
         if(found == LV_STYLE_RES_FOUND) return LV_STYLE_RES_FOUND;
     }
 
@@ -1092,7 +1198,7 @@ static lv_style_res_t get_selector_style_prop(const lv_obj_t * obj, lv_style_sel
 #endif
             {
                 selector = part | obj->state;
-                found = get_prop_core(obj, selector, prop, value_act);
+                found = get_prop_resolved(obj, selector, prop, value_act);
                 if(found == LV_STYLE_RES_FOUND) return LV_STYLE_RES_FOUND;
             }
             /*Check the parent too.*/
@@ -31,6 +31,25 @@ struct lv_obj_style_t {
     uint32_t is_trans : 1;
 };
 
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE
+typedef struct {
+    lv_style_value_t value;
+    lv_style_prop_t prop;       /**< `LV_STYLE_PROP_INV` if the entry is free*/
+    uint8_t part;               /**< The part shifted to the right by 16 bits*/
+    uint8_t found;              /**< 1: the object's styles set the property; 0: they don't*/
+} lv_obj_style_resolved_entry_t;
+
+/**
+ * The style properties resolved from the styles of an object in its current state.
+ * Valid only if `gen` is the current global generation and `state` is the object's state.
+ */
+struct lv_obj_style_resolved_t {
+    uint32_t gen;
+    lv_state_t state;
+    lv_obj_style_resolved_entry_t entries[LV_OBJ_STYLE_RESOLVED_CACHE_SIZE];
+};
+#endif
+
 struct lv_obj_style_transition_dsc_t {
     uint16_t time;
     uint16_t delay;
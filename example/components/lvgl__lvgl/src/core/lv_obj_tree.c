@@ -15,6 +15,8 @@
 #include "../misc/lv_anim_private.h"
 #include "../misc/lv_async.h"
 #include "../core/lv_global.h"
+#include "../misc/lv_profiler.h"
+#include "../stdlib/lv_string.h"
 
 /*********************
  *      DEFINES
@@ -24,6 +26,9 @@
 
 #define OBJ_DUMP_STRING_LEN 128
 
+/*The first allocation of the child and screen arrays*/
+#define CHILD_ARRAY_MIN_SIZE 4
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -35,7 +40,8 @@ static void lv_obj_delete_async_cb(void * obj);
 static void obj_delete_core(lv_obj_t * obj);
 static lv_obj_tree_walk_res_t walk_core(lv_obj_t * obj, lv_obj_tree_walk_cb_t cb, void * user_data);
 static void dump_tree_core(lv_obj_t * obj, int32_t depth);
-static lv_obj_t * lv_obj_get_first_not_deleting_child(lv_obj_t * obj);
+static lv_obj_t * lv_obj_get_last_not_deleting_child(lv_obj_t * obj);
+static lv_result_t obj_array_fit(lv_obj_t *** array, uint32_t * size, uint32_t cnt, bool shrink);
 
 /**********************
  *  STATIC VARIABLES
@@ -57,6 +63,7 @@ void lv_obj_delete(lv_obj_t * obj)
     LV_LOG_TRACE("begin (delete %p)", (void *)obj);
     LV_ASSERT_OBJ(obj, MY_CLASS);
     lv_obj_invalidate(obj);
+    lv_indev_hit_index_invalidate_obj(obj);
 
     lv_obj_t * par = lv_obj_get_parent(obj);
 
@@ -93,12 +100,14 @@ void lv_obj_clean(lv_obj_t * obj)
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
     lv_obj_invalidate(obj);
+    lv_indev_hit_index_invalidate_obj(obj);
 
+    /*Delete the children from the last one so that the others needn't be moved in the child array*/
     uint32_t cnt = lv_obj_get_child_count(obj);
-    lv_obj_t * child = lv_obj_get_first_not_deleting_child(obj);
+    lv_obj_t * child = lv_obj_get_last_not_deleting_child(obj);
     while(child) {
         obj_delete_core(child);
-        child = lv_obj_get_first_not_deleting_child(obj);
+        child = lv_obj_get_last_not_deleting_child(obj);
     }
     /*Just to remove scroll animations if any*/
     lv_obj_scroll_to(obj, 0, 0, LV_ANIM_OFF);
@@ -117,6 +126,56 @@ void lv_obj_clean(lv_obj_t * obj)
     LV_LOG_TRACE("finished (clean %p)", (void *)obj);
 }
 
+lv_result_t lv_obj_reserve_children(lv_obj_t * obj, uint32_t cnt)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_obj_allocate_spec_attr(obj);
+    if(obj->spec_attr == NULL) return LV_RESULT_INVALID;
+    if(cnt <= obj->spec_attr->child_size) return LV_RESULT_OK;
+
+    lv_obj_t ** children = lv_realloc(obj->spec_attr->children, cnt * sizeof(lv_obj_t *));
+    LV_ASSERT_MALLOC(children);
+    if(children == NULL) return LV_RESULT_INVALID;
+
+    obj->spec_attr->children = children;
+    obj->spec_attr->child_size = cnt;
+    return LV_RESULT_OK;
+}
+
+uint32_t lv_obj_create_children(lv_obj_t * parent, lv_obj_create_cb_t create_cb, uint32_t cnt,
+                                lv_obj_t ** children)
+{
+    LV_ASSERT_OBJ(parent, MY_CLASS);
+    LV_ASSERT_NULL(create_cb);
+    LV_PROFILER_BEGIN;
+
+    lv_obj_reserve_children(parent, lv_obj_get_child_count(parent) + cnt);
+
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_obj_t * child = create_cb(parent);
+        if(child == NULL) break;
+        if(children) children[i] = child;
+    }
+
+    LV_PROFILER_END;
+    return i;
+}
+
+lv_result_t lv_obj_children_fit(lv_obj_t * obj, uint32_t cnt)
+{
+    /*Shrink only after removing children, not while adding them to a reserved array*/
+    bool shrink = cnt <= obj->spec_attr->child_cnt;
+    return obj_array_fit(&obj->spec_attr->children, &obj->spec_attr->child_size, cnt, shrink);
+}
+
+lv_result_t lv_obj_screens_fit(lv_display_t * disp, uint32_t cnt)
+{
+    bool shrink = cnt <= disp->screen_cnt;
+    return obj_array_fit(&disp->screens, &disp->screen_size, cnt, shrink);
+}
+
 void lv_obj_delete_delayed(lv_obj_t * obj, uint32_t delay_ms)
 {
     lv_anim_t a;
@@ -160,9 +219,13 @@ void lv_obj_set_parent(lv_obj_t * obj, lv_obj_t * parent)
     }
 
     lv_obj_invalidate(obj);
+    lv_indev_hit_index_invalidate_obj(obj);
 
     lv_obj_allocate_spec_attr(parent);
 
+    /*Make room in the new parent first to keep the object in the old parent on error*/
+    if(lv_obj_children_fit(parent, lv_obj_get_child_count(parent) + 1) != LV_RESULT_OK) return;
+
     lv_obj_t * old_parent = obj->parent;
     /*Remove the object from the old parent's child list*/
     int32_t i;
@@ -170,20 +233,11 @@ void lv_obj_set_parent(lv_obj_t * obj, lv_obj_t * parent)
         old_parent->spec_attr->children[i] = old_parent->spec_attr->children[i + 1];
     }
     old_parent->spec_attr->child_cnt--;
-    if(old_parent->spec_attr->child_cnt) {
-        old_parent->spec_attr->children = lv_realloc(old_parent->spec_attr->children,
-                                                     old_parent->spec_attr->child_cnt * (sizeof(lv_obj_t *)));
-    }
-    else {
-        lv_free(old_parent->spec_attr->children);
-        old_parent->spec_attr->children = NULL;
-    }
+    lv_obj_children_fit(old_parent, old_parent->spec_attr->child_cnt);
 
     /*Add the child to the new parent as the last (newest child)*/
+    parent->spec_attr->children[parent->spec_attr->child_cnt] = obj;
     parent->spec_attr->child_cnt++;
-    parent->spec_attr->children = lv_realloc(parent->spec_attr->children,
-                                             parent->spec_attr->child_cnt * (sizeof(lv_obj_t *)));
-    parent->spec_attr->children[lv_obj_get_child_count(parent) - 1] = obj;
 
     obj->parent = parent;
 
@@ -199,6 +253,7 @@ void lv_obj_set_parent(lv_obj_t * obj, lv_obj_t * parent)
     lv_obj_mark_layout_as_dirty(obj);
 
     lv_obj_invalidate(obj);
+    lv_indev_hit_index_invalidate_obj(obj);
 }
 
 void lv_obj_move_to_index(lv_obj_t * obj, int32_t index)
@@ -246,6 +301,7 @@ void lv_obj_move_to_index(lv_obj_t * obj, int32_t index)
     }
 
     parent->spec_attr->children[index] = obj;
+    lv_indev_hit_index_invalidate_obj(obj);
     lv_obj_send_event(parent, LV_EVENT_CHILD_CHANGED, NULL);
     lv_obj_invalidate(parent);
 }
@@ -264,6 +320,9 @@ void lv_obj_swap(lv_obj_t * obj1, lv_obj_t * obj2)
     lv_obj_send_event(parent2, LV_EVENT_CHILD_DELETED, obj2);
     lv_obj_send_event(parent, LV_EVENT_CHILD_DELETED, obj1);
 
+    lv_indev_hit_index_invalidate_obj(obj1);
+    lv_indev_hit_index_invalidate_obj(obj2);
+
     parent->spec_attr->children[index1] = obj2;
     obj2->parent = parent;
 
@@ -275,6 +334,9 @@ void lv_obj_swap(lv_obj_t * obj1, lv_obj_t * obj2)
     lv_obj_send_event(parent2, LV_EVENT_CHILD_CHANGED, obj1);
     lv_obj_send_event(parent2, LV_EVENT_CHILD_CREATED, obj1);
 
+    lv_indev_hit_index_invalidate_obj(obj1);
+    lv_indev_hit_index_invalidate_obj(obj2);
+
     lv_obj_invalidate(parent);
 
     if(parent != parent2) {
@@ -516,13 +578,16 @@ static void obj_delete_core(lv_obj_t * obj)
     }
 
     /*Clean registered event_cb*/
-    if(obj->spec_attr) lv_event_remove_all(&(obj->spec_attr->event_list));
+    if(obj->spec_attr) {
+        lv_event_remove_all(&(obj->spec_attr->event_list));
+        obj->spec_attr->event_filter = 0;
+    }
 
-    /*Recursively delete the children*/
-    lv_obj_t * child = lv_obj_get_child(obj, 0);
+    /*Recursively delete the children from the last one*/
+    lv_obj_t * child = lv_obj_get_child(obj, -1);
     while(child) {
         obj_delete_core(child);
-        child = lv_obj_get_child(obj, 0);
+        child = lv_obj_get_child(obj, -1);
     }
 
     lv_group_t * group = lv_obj_get_group(obj);
@@ -572,18 +637,23 @@ static void obj_delete_core(lv_obj_t * obj)
             disp->screens[i] = disp->screens[i + 1];
         }
         disp->screen_cnt--;
-        disp->screens = lv_realloc(disp->screens, disp->screen_cnt * sizeof(lv_obj_t *));
+        lv_obj_screens_fit(disp, disp->screen_cnt);
     }
     /*Remove the object from the child list of its parent*/
     else {
-        int32_t id = lv_obj_get_index(obj);
-        uint16_t i;
-        for(i = id; i < obj->parent->spec_attr->child_cnt - 1; i++) {
-            obj->parent->spec_attr->children[i] = obj->parent->spec_attr->children[i + 1];
+        lv_obj_spec_attr_t * spec_attr = obj->parent->spec_attr;
+
+        /*Search from the end as the children are usually deleted from the last one*/
+        int32_t id;
+        for(id = (int32_t)spec_attr->child_cnt - 1; id >= 0; id--) {
+            if(spec_attr->children[id] == obj) break;
         }
-        obj->parent->spec_attr->child_cnt--;
-        obj->parent->spec_attr->children = lv_realloc(obj->parent->spec_attr->children,
-                                                      obj->parent->spec_attr->child_cnt * sizeof(lv_obj_t *));
+        LV_ASSERT(id >= 0);
+
+        lv_memmove(&spec_attr->children[id], &spec_attr->children[id + 1],
+                   (spec_attr->child_cnt - id - 1) * sizeof(lv_obj_t *));
+        spec_attr->child_cnt--;
+        lv_obj_children_fit(obj->parent, spec_attr->child_cnt);
     }
 
     /*Free the object itself*/
@@ -644,7 +714,7 @@ static void dump_tree_core(lv_obj_t * obj, int32_t depth)
     }
 }
 
-static lv_obj_t * lv_obj_get_first_not_deleting_child(lv_obj_t * obj)
+static lv_obj_t * lv_obj_get_last_not_deleting_child(lv_obj_t * obj)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
@@ -652,7 +722,7 @@ static lv_obj_t * lv_obj_get_first_not_deleting_child(lv_obj_t * obj)
 
     int32_t i;
     int32_t cnt = (int32_t)obj->spec_attr->child_cnt;
-    for(i = 0; i < cnt; i++) {
+    for(i = cnt - 1; i >= 0; i--) {
         if(!obj->spec_attr->children[i]->is_deleting) {
             return obj->spec_attr->children[i];
         }
@@ -660,3 +730,38 @@ static lv_obj_t * lv_obj_get_first_not_deleting_child(lv_obj_t * obj)
 
     return NULL;
 }
+
+static lv_result_t obj_array_fit(lv_obj_t *** array, uint32_t * size, uint32_t cnt, bool shrink)
+{
+    uint32_t new_size = *size;
+    if(cnt > new_size) {
+        if(new_size < CHILD_ARRAY_MIN_SIZE) new_size = CHILD_ARRAY_MIN_SIZE;
+        while(new_size < cnt) new_size *= 2;
+    }
+    else if(shrink && cnt == 0) {
+        new_size = 0;
+    }
+    else if(shrink && cnt < new_size / 4) {
+        new_size /= 2;
+    }
+
+    if(new_size == *size) return LV_RESULT_OK;
+
+    if(new_size == 0) {
+        lv_free(*array);
+        *array = NULL;
+        *size = 0;
+        return LV_RESULT_OK;
+    }
+
+    lv_obj_t ** new_array = lv_realloc(*array, new_size * sizeof(lv_obj_t *));
+    LV_ASSERT_MALLOC(new_array);
+    if(new_array == NULL) {
+        /*It's not a problem if it couldn't shrink*/
+        return cnt <= *size ? LV_RESULT_OK : LV_RESULT_INVALID;
+    }
+
+    *array = new_array;
+    *size = new_size;
+    return LV_RESULT_OK;
+}
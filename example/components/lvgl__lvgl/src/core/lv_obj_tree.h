@@ -33,6 +33,8 @@ typedef enum {
 
 typedef lv_obj_tree_walk_res_t (*lv_obj_tree_walk_cb_t)(lv_obj_t *, void *);
 
+typedef lv_obj_t * (*lv_obj_create_cb_t)(lv_obj_t * parent);
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -53,6 +55,26 @@ void lv_obj_delete(lv_obj_t * obj);
  */
 void lv_obj_clean(lv_obj_t * obj);
 
+/**
+ * Allocate memory for the children of an object in advance
+ * to avoid growing the child array while many children are added.
+ * @param obj       pointer to an object
+ * @param cnt       the number of children to have memory for, including the existing children
+ * @return          LV_RESULT_OK: the memory is allocated
+ */
+lv_result_t lv_obj_reserve_children(lv_obj_t * obj, uint32_t cnt);
+
+/**
+ * Create several children of the same type.
+ * @param parent    pointer to the parent object
+ * @param create_cb the create function of the widget, e.g. `lv_button_create`
+ * @param cnt       the number of children to create
+ * @param children  store the created children here if not NULL (it needs to have space for `cnt` objects)
+ * @return          the number of children created
+ */
+uint32_t lv_obj_create_children(lv_obj_t * parent, lv_obj_create_cb_t create_cb, uint32_t cnt,
+                                lv_obj_t ** children);
+
 /**
  * Delete an object after some delay
  * @param obj       pointer to an object
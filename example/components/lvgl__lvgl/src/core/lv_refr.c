@@ -13,6 +13,7 @@
 #include "../draw/lv_draw_mask_private.h"
 #include "lv_obj_private.h"
 #include "lv_obj_event_private.h"
+#include "lv_obj_render_cache_private.h"
 #include "../display/lv_display.h"
 #include "../display/lv_display_private.h"
 #include "../tick/lv_tick.h"
@@ -42,6 +43,12 @@
 static void lv_refr_join_area(void);
 static void refr_invalid_areas(void);
 static void refr_sync_areas(void);
+static void sync_areas_add(lv_display_t * disp, const lv_area_t * area);
+static void sync_areas_collapse(lv_display_t * disp);
+static void sync_areas_subtract(lv_display_t * disp, const lv_area_t * area);
+static void sync_areas_optimize(lv_display_t * disp);
+static void refr_move_areas(void);
+static void move_area_pixels(lv_display_t * disp, const lv_area_t * dest, int32_t dx, int32_t dy);
 static void refr_area(const lv_area_t * area_p);
 static void refr_area_part(lv_layer_t * layer);
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
@@ -276,6 +283,7 @@ void lv_inv_area(lv_display_t * disp, const lv_area_t * area_p)
     /*Clear the invalidate buffer if the parameter is NULL*/
     if(area_p == NULL) {
         disp->inv_p = 0;
+        disp->move_area_p = 0;
         return;
     }
 
@@ -327,6 +335,52 @@ void lv_inv_area(lv_display_t * disp, const lv_area_t * area_p)
     lv_display_send_event(disp, LV_EVENT_REFR_REQUEST, NULL);
 }
 
+bool lv_refr_move_area(lv_display_t * disp, const lv_area_t * area, int32_t dx, int32_t dy)
+{
+    if(!disp) disp = lv_display_get_default();
+    if(!disp) return false;
+    if(!disp->scroll_blit) return false;
+    if(!lv_display_is_invalidation_enabled(disp)) return false;
+    if(disp->rendering_in_progress) return false;
+
+    /*The pixels need to be available in LVGL's buffer or moved by the driver*/
+    if(disp->render_mode == LV_DISPLAY_RENDER_MODE_FULL) return false;
+    if(disp->render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL && disp->move_area_cb == NULL) return false;
+    if(disp->rotation != LV_DISPLAY_ROTATION_0) return false;
+    if(lv_color_format_get_bpp(disp->color_format) < 8) return false;
+
+    /*During screen load animations the other screen might be drawn on the area too*/
+    if(disp->prev_scr) return false;
+
+    uint32_t i;
+    for(i = 0; i < disp->move_area_p; i++) {
+        lv_display_move_area_t * move_area = &disp->move_areas[i];
+        if(lv_area_is_equal(&move_area->area, area)) {
+            move_area->diff.x += dx;
+            move_area->diff.y += dy;
+            return true;
+        }
+
+        /*Nested scrolled areas: simply redraw both*/
+        if(lv_area_is_on(&move_area->area, area)) {
+            lv_inv_area(disp, &move_area->area);
+            disp->move_area_p--;
+            disp->move_areas[i] = disp->move_areas[disp->move_area_p];
+            return false;
+        }
+    }
+
+    if(disp->move_area_p >= LV_MOVE_AREA_BUF_SIZE) return false;
+
+    disp->move_areas[disp->move_area_p].area = *area;
+    disp->move_areas[disp->move_area_p].diff.x = dx;
+    disp->move_areas[disp->move_area_p].diff.y = dy;
+    disp->move_area_p++;
+
+    lv_display_send_event(disp, LV_EVENT_REFR_REQUEST, NULL);
+    return true;
+}
+
 /**
  * Get the display which is being refreshed
  * @return the display being refreshed
@@ -345,6 +399,21 @@ void lv_refr_set_disp_refreshing(lv_display_t * disp)
     disp_refr = disp;
 }
 
+void lv_refr_wait_for_syncing(lv_display_t * disp)
+{
+    if(!disp->syncing) return;
+
+    LV_PROFILER_BEGIN;
+    if(disp->sync_wait_cb) {
+        disp->sync_wait_cb(disp);
+        disp->syncing = 0;
+    }
+    else {
+        while(disp->syncing);
+    }
+    LV_PROFILER_END;
+}
+
 void lv_display_refr_timer(lv_timer_t * tmr)
 {
     LV_PROFILER_BEGIN;
@@ -389,14 +458,19 @@ void lv_display_refr_timer(lv_timer_t * tmr)
     /*Do nothing if there is no active screen*/
     if(disp_refr->act_scr == NULL) {
         disp_refr->inv_p = 0;
+        disp_refr->move_area_p = 0;
         LV_LOG_WARN("there is no active screen");
         goto refr_finish;
     }
 
     lv_refr_join_area();
     refr_sync_areas();
+    refr_move_areas();
     refr_invalid_areas();
 
+    /*The cached images of the objects are not used by the draw tasks anymore*/
+    lv_obj_render_cache_release_drawn();
+
     if(disp_refr->inv_p == 0) goto refr_finish;
 
     /*If refresh happened ...*/
@@ -410,8 +484,7 @@ void lv_display_refr_timer(lv_timer_t * tmr)
             if(disp_refr->inv_area_joined[i])
                 continue;
 
-            lv_area_t * sync_area = lv_ll_ins_tail(&disp_refr->sync_areas);
-            *sync_area = disp_refr->inv_areas[i];
+            sync_areas_add(disp_refr, &disp_refr->inv_areas[i]);
         }
     }
 
@@ -486,72 +559,266 @@ static void refr_sync_areas(void)
     if(!lv_display_is_double_buffered(disp_refr)) return;
 
     /*Do not sync if no sync areas*/
-    if(lv_ll_is_empty(&disp_refr->sync_areas)) return;
+    if(disp_refr->sync_p == 0) return;
 
     LV_PROFILER_BEGIN;
     /*With double buffered direct mode synchronize the rendered areas to the other buffer*/
     /*We need to wait for ready here to not mess up the active screen*/
     wait_for_flushing(disp_refr);
+    lv_refr_wait_for_syncing(disp_refr);
 
     /*The buffers are already swapped.
      *So the active buffer is the off screen buffer where LVGL will render*/
     lv_draw_buf_t * off_screen = disp_refr->buf_act;
     lv_draw_buf_t * on_screen = disp_refr->buf_act == disp_refr->buf_1 ? disp_refr->buf_2 : disp_refr->buf_1;
 
-    uint32_t hor_res = lv_display_get_horizontal_resolution(disp_refr);
-    uint32_t ver_res = lv_display_get_vertical_resolution(disp_refr);
-
-    /*Iterate through invalidated areas to see if sync area should be copied*/
-    uint16_t i;
-    int8_t j;
-    lv_area_t res[4] = {0};
-    int8_t res_c;
-    lv_area_t * sync_area, * new_area, * next_area;
+    /*The areas which will be redrawn now don't need to be copied*/
+    uint32_t i;
     for(i = 0; i < disp_refr->inv_p; i++) {
         /*Skip joined areas*/
         if(disp_refr->inv_area_joined[i]) continue;
 
-        /*Iterate over sync areas*/
-        sync_area = lv_ll_get_head(&disp_refr->sync_areas);
-        while(sync_area != NULL) {
-            /*Get next sync area*/
-            next_area = lv_ll_get_next(&disp_refr->sync_areas, sync_area);
-
-            /*Remove intersect of redraw area from sync area and get remaining areas*/
-            res_c = lv_area_diff(res, sync_area, &disp_refr->inv_areas[i]);
-
-            /*New sub areas created after removing intersect*/
-            if(res_c != -1) {
-                /*Replace old sync area with new areas*/
-                for(j = 0; j < res_c; j++) {
-                    new_area = lv_ll_ins_prev(&disp_refr->sync_areas, sync_area);
-                    *new_area = res[j];
-                }
-                lv_ll_remove(&disp_refr->sync_areas, sync_area);
-                lv_free(sync_area);
-            }
+        sync_areas_subtract(disp_refr, &disp_refr->inv_areas[i]);
+    }
+
+    sync_areas_optimize(disp_refr);
 
-            /*Move on to next sync area*/
-            sync_area = next_area;
+    /*Copy sync areas (if any remaining)*/
+    if(disp_refr->sync_p) {
+        if(disp_refr->sync_cb) {
+            /*The redrawn areas don't overlap with the sync areas so rendering can start
+             *while they are copied. Wait for them only before flushing.*/
+            disp_refr->syncing = 1;
+            disp_refr->sync_cb(disp_refr, off_screen, on_screen, disp_refr->sync_areas, disp_refr->sync_p);
+        }
+        else {
+            lv_draw_buf_copy_areas(off_screen, on_screen, disp_refr->sync_areas, disp_refr->sync_p);
         }
     }
 
-    lv_area_t disp_area = {0, 0, (int32_t)hor_res - 1, (int32_t)ver_res - 1};
-    /*Copy sync areas (if any remaining)*/
-    for(sync_area = lv_ll_get_head(&disp_refr->sync_areas); sync_area != NULL;
-        sync_area = lv_ll_get_next(&disp_refr->sync_areas, sync_area)) {
+    /*Clear sync areas*/
+    disp_refr->sync_p = 0;
+    LV_PROFILER_END;
+}
+
+/**
+ * Save an area to be synchronized to the other buffer on the next refresh
+ * @param disp      pointer to a display
+ * @param area      the area to save
+ */
+static void sync_areas_add(lv_display_t * disp, const lv_area_t * area)
+{
+    if(disp->sync_p < LV_SYNC_AREA_BUF_SIZE) {
+        disp->sync_areas[disp->sync_p] = *area;
+        disp->sync_p++;
+        return;
+    }
+
+    /*No more space: copying more than needed is still correct*/
+    sync_areas_collapse(disp);
+    lv_area_join(&disp->sync_areas[0], &disp->sync_areas[0], area);
+}
+
+/**
+ * Merge all the sync areas into their bounding area
+ * @param disp      pointer to a display
+ */
+static void sync_areas_collapse(lv_display_t * disp)
+{
+    uint32_t i;
+    for(i = 1; i < disp->sync_p; i++) {
+        lv_area_join(&disp->sync_areas[0], &disp->sync_areas[0], &disp->sync_areas[i]);
+    }
+    if(disp->sync_p > 1) disp->sync_p = 1;
+}
+
+/**
+ * Remove an area from the sync areas. The remaining parts are stored in place without allocation.
+ * @param disp      pointer to a display
+ * @param area      the area to remove
+ */
+static void sync_areas_subtract(lv_display_t * disp, const lv_area_t * area)
+{
+    lv_area_t res[4];
+    /*The areas after `unchecked_end` are parts added here so they are already outside of `area`*/
+    uint32_t unchecked_end = disp->sync_p;
+    uint32_t i = 0;
+    while(i < unchecked_end) {
+        int8_t res_c = lv_area_diff(res, &disp->sync_areas[i], area);
+        if(res_c == -1) {
+            i++;
+            continue;
+        }
+
+        if(disp->sync_p - 1 + res_c > LV_SYNC_AREA_BUF_SIZE) {
+            sync_areas_collapse(disp);
+            unchecked_end = disp->sync_p;
+            i = 0;
+            continue;
+        }
+
+        /*Replace the area with the last unchecked area and that one with the last new part*/
+        unchecked_end--;
+        disp->sync_p--;
+        disp->sync_areas[i] = disp->sync_areas[unchecked_end];
+        disp->sync_areas[unchecked_end] = disp->sync_areas[disp->sync_p];
+
+        int8_t j;
+        for(j = 0; j < res_c; j++) {
+            disp->sync_areas[disp->sync_p] = res[j];
+            disp->sync_p++;
+        }
+    }
+}
+
+/**
+ * Clip the sync areas to the display, merge the neighboring areas into wider or taller ones
+ * and sort them from top to bottom to copy the rows sequentially
+ * @param disp      pointer to a display
+ */
+static void sync_areas_optimize(lv_display_t * disp)
+{
+    lv_area_t disp_area = {0, 0, lv_display_get_horizontal_resolution(disp) - 1,
+                           lv_display_get_vertical_resolution(disp) - 1
+                          };
+    lv_area_t * areas = disp->sync_areas;
+
+    uint32_t i;
+    uint32_t j;
+    for(i = 0; i < disp->sync_p;) {
         /**
          * @todo Resize SDL window will trigger crash because of sync_area is larger than disp_area
          */
-        lv_area_intersect(sync_area, sync_area, &disp_area);
-        lv_draw_buf_copy(off_screen, sync_area, on_screen, sync_area);
+        if(lv_area_intersect(&areas[i], &areas[i], &disp_area)) {
+            i++;
+        }
+        else {
+            disp->sync_p--;
+            areas[i] = areas[disp->sync_p];
+        }
     }
 
-    /*Clear sync areas*/
-    lv_ll_clear(&disp_refr->sync_areas);
+    bool merged = true;
+    while(merged) {
+        merged = false;
+        for(i = 0; i < disp->sync_p; i++) {
+            for(j = i + 1; j < disp->sync_p;) {
+                bool same_rows = areas[i].y1 == areas[j].y1 && areas[i].y2 == areas[j].y2;
+                bool same_cols = areas[i].x1 == areas[j].x1 && areas[i].x2 == areas[j].x2;
+                if((same_rows && (areas[i].x2 + 1 == areas[j].x1 || areas[j].x2 + 1 == areas[i].x1)) ||
+                   (same_cols && (areas[i].y2 + 1 == areas[j].y1 || areas[j].y2 + 1 == areas[i].y1)) ||
+                   lv_area_is_in(&areas[j], &areas[i], 0) || lv_area_is_in(&areas[i], &areas[j], 0)) {
+                    lv_area_join(&areas[i], &areas[i], &areas[j]);
+                    disp->sync_p--;
+                    areas[j] = areas[disp->sync_p];
+                    merged = true;
+                }
+                else {
+                    j++;
+                }
+            }
+        }
+    }
+
+    /*Insertion sort, there are only a few areas*/
+    for(i = 1; i < disp->sync_p; i++) {
+        lv_area_t tmp = areas[i];
+        j = i;
+        while(j > 0 && (areas[j - 1].y1 > tmp.y1 || (areas[j - 1].y1 == tmp.y1 && areas[j - 1].x1 > tmp.x1))) {
+            areas[j] = areas[j - 1];
+            j--;
+        }
+        areas[j] = tmp;
+    }
+}
+
+/**
+ * Move the pixels of the scrolled areas and invalidate the parts which can't be moved
+ */
+static void refr_move_areas(void)
+{
+    if(disp_refr->move_area_p == 0) return;
+
+    LV_PROFILER_BEGIN;
+    /*The buffer or the display can't be used by the previous flush or sync while moving the pixels*/
+    wait_for_flushing(disp_refr);
+    lv_refr_wait_for_syncing(disp_refr);
+
+    /*Only the areas invalidated before moving can contain outdated pixels*/
+    uint32_t inv_p = disp_refr->inv_p;
+    uint32_t i;
+    for(i = 0; i < disp_refr->move_area_p; i++) {
+        const lv_area_t * area = &disp_refr->move_areas[i].area;
+        int32_t dx = disp_refr->move_areas[i].diff.x;
+        int32_t dy = disp_refr->move_areas[i].diff.y;
+
+        lv_area_t dest = *area;
+        lv_area_move(&dest, dx, dy);
+        if(!lv_area_intersect(&dest, &dest, area)) {
+            lv_inv_area(disp_refr, area);
+            continue;
+        }
+
+        /*The outdated pixels are moved too so redraw them where they land*/
+        uint32_t j;
+        for(j = 0; j < inv_p; j++) {
+            if(disp_refr->inv_area_joined[j]) continue;
+
+            lv_area_t outdated;
+            if(!lv_area_intersect(&outdated, &disp_refr->inv_areas[j], area)) continue;
+            lv_area_move(&outdated, dx, dy);
+            if(lv_area_intersect(&outdated, &outdated, &dest)) lv_inv_area(disp_refr, &outdated);
+        }
+
+        /*Redraw the exposed parts*/
+        lv_area_t res[4];
+        int8_t res_c = lv_area_diff(res, area, &dest);
+        int8_t k;
+        for(k = 0; k < res_c; k++) {
+            lv_inv_area(disp_refr, &res[k]);
+        }
+
+        if(disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL) {
+            lv_area_t offset_area = *area;
+            lv_area_move(&offset_area, disp_refr->offset_x, disp_refr->offset_y);
+            disp_refr->move_area_cb(disp_refr, &offset_area, dx, dy);
+        }
+        else {
+            move_area_pixels(disp_refr, &dest, dx, dy);
+        }
+    }
+
+    disp_refr->move_area_p = 0;
+    lv_refr_join_area();
     LV_PROFILER_END;
 }
 
+/**
+ * Move pixels in the active draw buffer in direct mode
+ * @param disp      pointer to a display
+ * @param dest      the area where the pixels are moved
+ * @param dx        the pixels are moved horizontally by this many pixels
+ * @param dy        the pixels are moved vertically by this many pixels
+ */
+static void move_area_pixels(lv_display_t * disp, const lv_area_t * dest, int32_t dx, int32_t dy)
+{
+    lv_draw_buf_t * buf = disp->buf_act;
+    uint32_t line_bytes = lv_area_get_width(dest) * lv_color_format_get_size(buf->header.cf);
+    int32_t h = lv_area_get_height(dest);
+
+    /*Start from the side where the source doesn't overlap with the destination*/
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        int32_t row = dy > 0 ? dest->y2 - y : dest->y1 + y;
+        uint8_t * dest_row = lv_draw_buf_goto_xy(buf, dest->x1, row);
+        uint8_t * src_row = lv_draw_buf_goto_xy(buf, dest->x1 - dx, row - dy);
+        lv_memmove(dest_row, src_row, line_bytes);
+    }
+
+    /*The other buffer needs to be updated too on the next refresh*/
+    if(lv_display_is_double_buffered(disp)) sync_areas_add(disp, dest);
+}
+
 /**
  * Refresh the joined areas
  */
@@ -1029,7 +1296,9 @@ static void refr_obj(lv_layer_t * layer, lv_obj_t * obj)
 
     lv_layer_type_t layer_type = lv_obj_get_layer_type(obj);
     if(layer_type == LV_LAYER_TYPE_NONE) {
-        lv_obj_redraw(layer, obj);
+        if(!lv_obj_has_flag(obj, LV_OBJ_FLAG_RENDER_CACHE) || !lv_obj_render_cache_draw(layer, obj)) {
+            lv_obj_redraw(layer, obj);
+        }
     }
     else {
         lv_area_t layer_area_full;
@@ -1165,6 +1434,9 @@ static void draw_buf_flush(lv_display_t * disp)
      * and other buffer already contains the new rendered image. */
     if(lv_display_is_double_buffered(disp)) {
         wait_for_flushing(disp_refr);
+
+        /*The buffer can be shown only if the not redrawn areas are already copied into it*/
+        if(disp->last_area && disp->last_part) lv_refr_wait_for_syncing(disp_refr);
     }
 
     disp->flushing = 1;
@@ -1237,3 +1509,4 @@ static void wait_for_flushing(lv_display_t * disp)
     LV_LOG_TRACE("end");
     LV_PROFILER_END;
 }
+
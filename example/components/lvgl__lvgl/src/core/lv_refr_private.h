@@ -46,6 +46,18 @@ void lv_refr_deinit(void);
  */
 void lv_inv_area(lv_display_t * disp, const lv_area_t * area_p);
 
+/**
+ * Move the already rendered pixels of an area on the next refresh instead of redrawing it.
+ * The exposed parts and the areas invalidated in the meantime will be redrawn.
+ * Objects drawn on the area which don't move with the content need to be invalidated too.
+ * @param disp  pointer to display where the area should be moved (NULL: use the default display)
+ * @param area  the area whose content is moved
+ * @param dx    move the content horizontally by this many pixels
+ * @param dy    move the content vertically by this many pixels
+ * @return      true: the area will be moved; false: moving is not possible, invalidate the area instead
+ */
+bool lv_refr_move_area(lv_display_t * disp, const lv_area_t * area, int32_t dx, int32_t dy);
+
 /**
  * Get the display which is being refreshed
  * @return the display being refreshed
@@ -58,6 +70,13 @@ lv_display_t * lv_refr_get_disp_refreshing(void);
  */
 void lv_refr_set_disp_refreshing(lv_display_t * disp);
 
+/**
+ * Wait until `sync_cb` has copied the sync areas of a display.
+ * Uses `sync_wait_cb` if set, else polls the `syncing` flag.
+ * @param disp  pointer to a display
+ */
+void lv_refr_wait_for_syncing(lv_display_t * disp);
+
 /**
  * Called periodically to handle the refreshing
  * @param timer pointer to the timer itself
@@ -17,6 +17,7 @@
 #include "../stdlib/lv_string.h"
 #include "../themes/lv_theme.h"
 #include "../core/lv_global.h"
+#include "../indev/lv_indev_hit_index_private.h"
 #include "../others/sysmon/lv_sysmon.h"
 
 #if LV_USE_DRAW_SW
@@ -91,8 +92,6 @@ lv_display_t * lv_display_create(int32_t hor_res, int32_t ver_res)
     disp->inv_en_cnt = 1;
     disp->last_activity_time = lv_tick_get();
 
-    lv_ll_init(&disp->sync_areas, sizeof(lv_area_t));
-
     lv_display_t * disp_def_tmp = disp_def;
     disp_def                 = disp; /*Temporarily change the default screen to create the default screens on the
                                         new display*/
@@ -197,13 +196,19 @@ void lv_display_delete(lv_display_t * disp)
         lv_obj_delete(disp->screens[0]);
     }
 
-    lv_ll_clear(&disp->sync_areas);
+    /*Don't free the display while its buffers are still being synchronized*/
+    lv_refr_wait_for_syncing(disp);
+
     lv_ll_remove(disp_ll_p, disp);
     if(disp->refr_timer) lv_timer_delete(disp->refr_timer);
 
     if(disp->layer_deinit) disp->layer_deinit(disp, disp->layer_head);
     lv_free(disp->layer_head);
 
+#if LV_INDEV_HIT_INDEX_CELL_SIZE
+    lv_indev_hit_index_delete(disp);
+#endif
+
     lv_free(disp);
 
     if(was_default) lv_display_set_default(lv_ll_get_head(disp_ll_p));
@@ -467,6 +472,22 @@ void lv_display_set_flush_wait_cb(lv_display_t * disp, lv_display_flush_wait_cb_
     disp->flush_wait_cb = wait_cb;
 }
 
+void lv_display_set_sync_cb(lv_display_t * disp, lv_display_sync_cb_t sync_cb)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return;
+
+    disp->sync_cb = sync_cb;
+}
+
+void lv_display_set_sync_wait_cb(lv_display_t * disp, lv_display_sync_wait_cb_t wait_cb)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return;
+
+    disp->sync_wait_cb = wait_cb;
+}
+
 void lv_display_set_color_format(lv_display_t * disp, lv_color_format_t color_format)
 {
     if(disp == NULL) disp = lv_display_get_default();
@@ -504,6 +525,30 @@ bool lv_display_get_antialiasing(lv_display_t * disp)
     return disp->antialiasing;
 }
 
+void lv_display_set_scroll_blit(lv_display_t * disp, bool en)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return;
+
+    disp->scroll_blit = en;
+}
+
+bool lv_display_get_scroll_blit(lv_display_t * disp)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return false;
+
+    return disp->scroll_blit;
+}
+
+void lv_display_set_move_area_cb(lv_display_t * disp, lv_display_move_area_cb_t move_area_cb)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return;
+
+    disp->move_area_cb = move_area_cb;
+}
+
 LV_ATTRIBUTE_FLUSH_READY void lv_display_flush_ready(lv_display_t * disp)
 {
     disp->flushing = 0;
@@ -514,6 +559,11 @@ LV_ATTRIBUTE_FLUSH_READY bool lv_display_flush_is_last(lv_display_t * disp)
     return disp->flushing_last;
 }
 
+LV_ATTRIBUTE_FLUSH_READY void lv_display_sync_ready(lv_display_t * disp)
+{
+    disp->syncing = 0;
+}
+
 bool lv_display_is_double_buffered(lv_display_t * disp)
 {
     return disp->buf_2 != NULL;
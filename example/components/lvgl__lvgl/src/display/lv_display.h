@@ -80,6 +80,10 @@ typedef enum {
 
 typedef void (*lv_display_flush_cb_t)(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map);
 typedef void (*lv_display_flush_wait_cb_t)(lv_display_t * disp);
+typedef void (*lv_display_move_area_cb_t)(lv_display_t * disp, const lv_area_t * area, int32_t dx, int32_t dy);
+typedef void (*lv_display_sync_cb_t)(lv_display_t * disp, lv_draw_buf_t * dest, const lv_draw_buf_t * src,
+                                     const lv_area_t * areas, uint32_t area_cnt);
+typedef void (*lv_display_sync_wait_cb_t)(lv_display_t * disp);
 
 /**********************
  * GLOBAL PROTOTYPES
@@ -273,6 +277,26 @@ void lv_display_set_flush_cb(lv_display_t * disp, lv_display_flush_cb_t flush_cb
  */
 void lv_display_set_flush_wait_cb(lv_display_t * disp, lv_display_flush_wait_cb_t wait_cb);
 
+/**
+ * Set a callback to copy the areas which were not redrawn from the on screen buffer to the off screen buffer
+ * in double buffered direct mode. E.g. a DMA engine can be started here to copy the areas in the background.
+ * If not set the areas are copied by `lv_draw_buf_copy_areas()`.
+ * @param disp      pointer to a display
+ * @param sync_cb   the sync callback. `areas` is valid only while the callback is running
+ *                  and `lv_display_sync_ready()` needs to be called when all the areas are copied.
+ */
+void lv_display_set_sync_cb(lv_display_t * disp, lv_display_sync_cb_t sync_cb);
+
+/**
+ * Set a callback to be used while LVGL is waiting for `sync_cb` to copy the areas.
+ * It can e.g. take a semaphore given by the DMA interrupt instead of polling.
+ * If not set the `disp->syncing` flag is polled which can be cleared with `lv_display_sync_ready()`
+ * @param disp      pointer to a display
+ * @param wait_cb   a callback to call while LVGL is waiting for sync ready.
+ *                  If NULL `lv_display_sync_ready()` can be used to signal that syncing is ready.
+ */
+void lv_display_set_sync_wait_cb(lv_display_t * disp, lv_display_sync_wait_cb_t wait_cb);
+
 /**
  * Set the color format of the display.
  * @param disp              pointer to a display
@@ -307,6 +331,32 @@ void lv_display_set_antialiasing(lv_display_t * disp, bool en);
  */
 bool lv_display_get_antialiasing(lv_display_t * disp);
 
+/**
+ * Move the already rendered pixels when a plain container with opaque background is scrolled
+ * and redraw only the newly exposed parts.
+ * Works in `LV_DISPLAY_RENDER_MODE_DIRECT` and, if `move_area_cb` is set, in `LV_DISPLAY_RENDER_MODE_PARTIAL`.
+ * @param disp      pointer to a display
+ * @param en        true/false
+ */
+void lv_display_set_scroll_blit(lv_display_t * disp, bool en);
+
+/**
+ * Get if moving the scrolled pixels is enabled for a display or not
+ * @param disp      pointer to a display (NULL to use the default display)
+ * @return          true/false
+ */
+bool lv_display_get_scroll_blit(lv_display_t * disp);
+
+/**
+ * Set a callback to move an area of the image already sent to the display.
+ * Required to move the scrolled pixels in `LV_DISPLAY_RENDER_MODE_PARTIAL`.
+ * It's called before rendering, after the previous flush is ready.
+ * @param disp          pointer to a display
+ * @param move_area_cb  the callback. The pixels of `area` need to be moved by `dx` and `dy`.
+ *                      The pixels moved out of `area` are discarded.
+ */
+void lv_display_set_move_area_cb(lv_display_t * disp, lv_display_move_area_cb_t move_area_cb);
+
 //! @cond Doxygen_Suppress
 
 /**
@@ -324,6 +374,12 @@ LV_ATTRIBUTE_FLUSH_READY void lv_display_flush_ready(lv_display_t * disp);
  */
 LV_ATTRIBUTE_FLUSH_READY bool lv_display_flush_is_last(lv_display_t * disp);
 
+/**
+ * Call from the display driver when the areas passed to `sync_cb` are copied
+ * @param disp      pointer to display whose `sync_cb` was called
+ */
+LV_ATTRIBUTE_FLUSH_READY void lv_display_sync_ready(lv_display_t * disp);
+
 //! @endcond
 
 bool lv_display_is_double_buffered(lv_display_t * disp);
@@ -29,10 +29,24 @@ extern "C" {
 #define LV_INV_BUF_SIZE 32 /**< Buffer size for invalid areas */
 #endif
 
+#ifndef LV_MOVE_AREA_BUF_SIZE
+#define LV_MOVE_AREA_BUF_SIZE 4 /**< Number of scrolled areas to move on the next refresh */
+#endif
+
+#ifndef LV_SYNC_AREA_BUF_SIZE
+#define LV_SYNC_AREA_BUF_SIZE (LV_INV_BUF_SIZE * 2) /**< Buffer size for double buffer sync areas */
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+/** An area whose rendered pixels will be moved on the next refresh instead of redrawing them */
+typedef struct {
+    lv_area_t area;     /**< The pixels of this area are moved and the exposed parts are redrawn*/
+    lv_point_t diff;    /**< Move by this many pixels*/
+} lv_display_move_area_t;
+
 struct lv_display_t {
 
     /*---------------------
@@ -91,6 +105,7 @@ struct lv_display_t {
 
     lv_display_render_mode_t render_mode;
     uint32_t antialiasing : 1;       /**< 1: anti-aliasing is enabled on this display.*/
+    uint32_t scroll_blit : 1;        /**< 1: move the scrolled pixels instead of redrawing them*/
 
     /** 1: The current screen rendering is in progress*/
     uint32_t rendering_in_progress : 1;
@@ -103,8 +118,22 @@ struct lv_display_t {
     uint32_t inv_p;
     int32_t inv_en_cnt;
 
-    /** Double buffer sync areas (redrawn during last refresh) */
-    lv_ll_t sync_areas;
+    /** Double buffer sync areas (redrawn during last refresh).
+     * If they don't fit they are merged into one area.*/
+    lv_area_t sync_areas[LV_SYNC_AREA_BUF_SIZE];
+    uint32_t sync_p;
+    lv_display_sync_cb_t sync_cb;
+
+    /** Used to wait while syncing is ready. If not set `syncing` flag is polled */
+    lv_display_sync_wait_cb_t sync_wait_cb;
+
+    /** 1: `sync_cb` is copying the sync areas. (Not a bit field as it's cleared from IRQ) */
+    volatile int syncing;
+
+    /** Scrolled areas to move on the next refresh*/
+    lv_display_move_area_t move_areas[LV_MOVE_AREA_BUF_SIZE];
+    uint32_t move_area_p;
+    lv_display_move_area_cb_t move_area_cb;
 
     lv_draw_buf_t _static_buf1; /**< Used when user pass in a raw buffer as display draw buffer */
     lv_draw_buf_t _static_buf2;
@@ -128,9 +157,14 @@ struct lv_display_t {
     lv_obj_t * prev_scr;    /**< Previous screen. Used during screen animations*/
     lv_obj_t * scr_to_load; /**< The screen prepared to load in lv_screen_load_anim*/
     uint32_t screen_cnt;
+    uint32_t screen_size;   /**< Number of screens `screens` has memory for*/
     uint8_t draw_prev_over_act  : 1;/** 1: Draw previous screen over active screen*/
     uint8_t del_prev  : 1;  /** 1: Automatically delete the previous screen when the screen load animation is ready*/
 
+#if LV_INDEV_HIT_INDEX_CELL_SIZE
+    lv_indev_hit_index_t * hit_index;   /**< Grid of the clickable objects to find the pressed object*/
+#endif
+
     /*---------------------
      * Others
      *--------------------*/
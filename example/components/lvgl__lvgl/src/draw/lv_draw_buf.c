@@ -243,6 +243,40 @@ void lv_draw_buf_copy(lv_draw_buf_t * dest, const lv_area_t * dest_area,
     }
 }
 
+void lv_draw_buf_copy_areas(lv_draw_buf_t * dest, const lv_draw_buf_t * src, const lv_area_t * areas,
+                            uint32_t area_cnt)
+{
+    LV_ASSERT_FORMAT_MSG(dest->header.cf == src->header.cf, "Color format mismatch: %d != %d",
+                         dest->header.cf, src->header.cf);
+
+    uint32_t bpp = lv_color_format_get_bpp(dest->header.cf);
+    uint32_t dest_stride = dest->header.stride;
+    uint32_t src_stride = src->header.stride;
+    bool same_stride = dest_stride == src_stride;
+
+    uint32_t i;
+    for(i = 0; i < area_cnt; i++) {
+        const lv_area_t * a = &areas[i];
+        uint8_t * dest_bufc = lv_draw_buf_goto_xy(dest, a->x1, a->y1);
+        uint8_t * src_bufc = lv_draw_buf_goto_xy(src, a->x1, a->y1);
+        uint32_t line_bytes = (lv_area_get_width(a) * bpp + 7) >> 3;
+        int32_t h = lv_area_get_height(a);
+
+        /*Full width rows are contiguous so copy them in one step*/
+        if(same_stride && a->x1 == 0 && lv_area_get_width(a) == (int32_t)dest->header.w) {
+            lv_memcpy(dest_bufc, src_bufc, (h - 1) * dest_stride + line_bytes);
+            continue;
+        }
+
+        int32_t y;
+        for(y = 0; y < h; y++) {
+            lv_memcpy(dest_bufc, src_bufc, line_bytes);
+            dest_bufc += dest_stride;
+            src_bufc += src_stride;
+        }
+    }
+}
+
 lv_result_t lv_draw_buf_init(lv_draw_buf_t * draw_buf, uint32_t w, uint32_t h, lv_color_format_t cf, uint32_t stride,
                              void * data, uint32_t data_size)
 {
@@ -204,6 +204,18 @@ void lv_draw_buf_clear(lv_draw_buf_t * draw_buf, const lv_area_t * a);
 void lv_draw_buf_copy(lv_draw_buf_t * dest, const lv_area_t * dest_area,
                       const lv_draw_buf_t * src, const lv_area_t * src_area);
 
+/**
+ * Copy the same areas from a buffer to another with the same size and color format.
+ * Areas spanning the whole width are copied with a single `lv_memcpy` if the strides are the same.
+ * @param dest      pointer to the destination draw buffer
+ * @param src       pointer to the source draw buffer
+ * @param areas     array of areas to copy. Sort them from top to bottom for sequential memory access.
+ * @param area_cnt  number of areas
+ * @note  `dest` and `src` should have same color format. Color converting is not supported fow now.
+ */
+void lv_draw_buf_copy_areas(lv_draw_buf_t * dest, const lv_draw_buf_t * src, const lv_area_t * areas,
+                            uint32_t area_cnt);
+
 /**
  * Note: Eventually, lv_draw_buf_malloc/free will be kept as private.
  *       For now, we use `create` to distinguish with malloc.
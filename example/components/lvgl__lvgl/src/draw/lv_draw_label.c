@@ -38,6 +38,10 @@
  **********************/
 static void draw_letter(lv_draw_unit_t * draw_unit, lv_draw_glyph_dsc_t * dsc,  const lv_point_t * pos,
                         const lv_font_t * font, uint32_t letter, lv_draw_glyph_cb_t cb);
+static uint32_t get_line_end(const lv_draw_label_dsc_t * dsc, const lv_text_layout_t * layout, uint32_t line_idx,
+                             uint32_t line_start, int32_t w);
+static int32_t get_line_width(const lv_draw_label_dsc_t * dsc, const lv_text_layout_t * layout, uint32_t line_idx,
+                              uint32_t line_start, uint32_t line_end);
 
 /**********************
  *  STATIC VARIABLES
@@ -162,16 +166,26 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
 
     lv_bidi_calculate_align(&align, &base_dir, dsc->text);
 
-    if((dsc->flag & LV_TEXT_FLAG_EXPAND) == 0) {
-        /*Normally use the label's width as width*/
-        w = lv_area_get_width(coords);
+    /*Normally use the label's width as width*/
+    w = lv_area_get_width(coords);
+
+    /*Use the line breaks calculated earlier if they are still valid*/
+    const lv_text_layout_t * layout = NULL;
+    if(dsc->layout && lv_text_layout_is_valid(dsc->layout, dsc->text, font, dsc->letter_space, w, dsc->flag)) {
+        layout = dsc->layout;
     }
-    else {
+
+    if(dsc->flag & LV_TEXT_FLAG_EXPAND) {
         /*If EXPAND is enabled then not limit the text's width to the object's width*/
-        lv_point_t p;
-        lv_text_get_size(&p, dsc->text, dsc->font, dsc->letter_space, dsc->line_space, LV_COORD_MAX,
-                         dsc->flag);
-        w = p.x;
+        if(layout) {
+            w = layout->max_line_width;
+        }
+        else {
+            lv_point_t p;
+            lv_text_get_size(&p, dsc->text, dsc->font, dsc->letter_space, dsc->line_space, LV_COORD_MAX,
+                             dsc->flag);
+            w = p.x;
+        }
     }
 
     int32_t line_height_font = lv_font_get_line_height(font);
@@ -189,10 +203,24 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
     pos.y += y_ofs;
 
     uint32_t line_start     = 0;
+    uint32_t line_idx       = 0;
     int32_t last_line_start = -1;
 
+    if(layout) {
+        /*Jump to the first visible line*/
+        uint32_t line_cnt = lv_text_layout_get_line_count(layout);
+        int32_t hidden_h = draw_unit->clip_area->y1 - (pos.y + line_height_font);
+        if(hidden_h > 0) {
+            if(line_height <= 0) return;
+            line_idx = (hidden_h + line_height - 1) / line_height;
+            pos.y += (int32_t)line_idx * line_height;
+        }
+        if(line_idx >= line_cnt) return;
+
+        line_start = lv_text_layout_get_line(layout, line_idx)->start;
+    }
     /*Check the hint to use the cached info*/
-    if(dsc->hint && y_ofs == 0 && coords->y1 < 0) {
+    else if(dsc->hint && y_ofs == 0 && coords->y1 < 0) {
         /*If the label changed too much recalculate the hint.*/
         if(LV_ABS(dsc->hint->coord_y - coords->y1) > LV_LABEL_HINT_UPDATE_TH - 2 * line_height) {
             dsc->hint->line_start = -1;
@@ -206,11 +234,10 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
         pos.y += dsc->hint->y;
     }
 
-    uint32_t line_end = line_start + lv_text_get_next_line(&dsc->text[line_start], font, dsc->letter_space, w, NULL,
-                                                           dsc->flag);
+    uint32_t line_end = get_line_end(dsc, layout, line_idx, line_start, w);
 
     /*Go the first visible line*/
-    while(pos.y + line_height_font < draw_unit->clip_area->y1) {
+    while(layout == NULL && pos.y + line_height_font < draw_unit->clip_area->y1) {
         /*Go to next line*/
         line_start = line_end;
         line_end += lv_text_get_next_line(&dsc->text[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
@@ -228,14 +255,14 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
 
     /*Align to middle*/
     if(align == LV_TEXT_ALIGN_CENTER) {
-        line_width = lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
+        line_width = get_line_width(dsc, layout, line_idx, line_start, line_end);
 
         pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
     }
     /*Align to the right*/
     else if(align == LV_TEXT_ALIGN_RIGHT) {
-        line_width = lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
+        line_width = get_line_width(dsc, layout, line_idx, line_start, line_end);
         pos.x += lv_area_get_width(coords) - line_width;
     }
 
@@ -345,21 +372,20 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
         bidi_txt = NULL;
 #endif
         /*Go to next line*/
+        line_idx++;
         line_start = line_end;
-        line_end += lv_text_get_next_line(&dsc->text[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+        line_end = get_line_end(dsc, layout, line_idx, line_start, w);
 
         pos.x = coords->x1;
         /*Align to middle*/
         if(align == LV_TEXT_ALIGN_CENTER) {
-            line_width =
-                lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
+            line_width = get_line_width(dsc, layout, line_idx, line_start, line_end);
 
             pos.x += (lv_area_get_width(coords) - line_width) / 2;
         }
         /*Align to the right*/
         else if(align == LV_TEXT_ALIGN_RIGHT) {
-            line_width =
-                lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
+            line_width = get_line_width(dsc, layout, line_idx, line_start, line_end);
             pos.x += lv_area_get_width(coords) - line_width;
         }
 
@@ -444,3 +470,43 @@ static void draw_letter(lv_draw_unit_t * draw_unit, lv_draw_glyph_dsc_t * dsc,
 
     LV_PROFILER_END;
 }
+
+/**
+ * Get the byte index where a line ends
+ * @param dsc           the label draw descriptor
+ * @param layout        the valid layout of the text or NULL to break the line now
+ * @param line_idx      index of the line
+ * @param line_start    byte index of the first character of the line
+ * @param w             max width of the line
+ * @return              byte index of the first character of the next line
+ */
+static uint32_t get_line_end(const lv_draw_label_dsc_t * dsc, const lv_text_layout_t * layout, uint32_t line_idx,
+                             uint32_t line_start, int32_t w)
+{
+    if(layout) {
+        if(line_idx >= lv_text_layout_get_line_count(layout)) return line_start;
+        return lv_text_layout_get_line(layout, line_idx + 1)->start;
+    }
+
+    return line_start + lv_text_get_next_line(&dsc->text[line_start], dsc->font, dsc->letter_space, w, NULL, dsc->flag);
+}
+
+/**
+ * Get the width of a line
+ * @param dsc           the label draw descriptor
+ * @param layout        the valid layout of the text or NULL to measure the line now
+ * @param line_idx      index of the line
+ * @param line_start    byte index of the first character of the line
+ * @param line_end      byte index of the first character of the next line
+ * @return              width of the line in pixels
+ */
+static int32_t get_line_width(const lv_draw_label_dsc_t * dsc, const lv_text_layout_t * layout, uint32_t line_idx,
+                              uint32_t line_start, uint32_t line_end)
+{
+    if(layout) {
+        if(line_idx >= lv_text_layout_get_line_count(layout)) return 0;
+        return lv_text_layout_get_line(layout, line_idx)->width;
+    }
+
+    return lv_text_get_width(&dsc->text[line_start], line_end - line_start, dsc->font, dsc->letter_space);
+}
@@ -54,6 +54,10 @@ typedef struct {
      * 0: `text` is const and it's pointer will be valid during rendering.*/
     uint8_t text_local : 1;
     lv_draw_label_hint_t * hint;
+    /**
+     * The line breaks and line widths of `text` calculated earlier (optional).
+     * Used only if it was calculated with the same parameters. It's not modified while drawing.*/
+    const lv_text_layout_t * layout;
 } lv_draw_label_dsc_t;
 
 /**
@@ -38,6 +38,7 @@ static uint32_t img_width_to_stride(lv_image_header_t * header);
  * @return The decoder that can open the image source or NULL if not found (or can't open it).
  */
 static lv_image_decoder_t * image_decoder_get_info(lv_image_decoder_dsc_t * dsc, lv_image_header_t * header);
+static lv_result_t header_cache_add(const char * src, const lv_image_header_t * header, lv_image_decoder_t * decoder);
 
 static lv_result_t try_cache(lv_image_decoder_dsc_t * dsc);
 
@@ -119,6 +120,7 @@ lv_result_t lv_image_decoder_open(lv_image_decoder_dsc_t * dsc, const void * src
         .no_cache = false,
         .use_indexed = false,
         .flush_cache = false,
+        .partial = false,
     };
 
     /*
@@ -326,6 +328,15 @@ static lv_image_decoder_t * image_decoder_get_info(lv_image_decoder_dsc_t * dsc,
         }
     }
 
+#if LV_USE_IMAGE_HEADER_INDEX
+    /*Saved in an earlier run, so the file doesn't need to be opened*/
+    if(src_type == LV_IMAGE_SRC_FILE && lv_image_header_index_get(src, header, &decoder)) {
+        LV_LOG_TRACE("Found decoder %s in header index", decoder->name);
+        if(is_header_cache_enabled && header_cache_add(src, header, decoder) != LV_RESULT_OK) return NULL;
+        return decoder;
+    }
+#endif
+
     if(src_type == LV_IMAGE_SRC_FILE) {
         lv_fs_res_t fs_res = lv_fs_open(&dsc->file, src, LV_FS_MODE_RD);
         if(fs_res != LV_FS_RES_OK) {
@@ -363,24 +374,34 @@ static lv_image_decoder_t * image_decoder_get_info(lv_image_decoder_dsc_t * dsc,
         lv_fs_close(&dsc->file);
     }
 
+#if LV_USE_IMAGE_HEADER_INDEX
+    if(src_type == LV_IMAGE_SRC_FILE && decoder) lv_image_header_index_set(src, header, decoder);
+#endif
+
     if(is_header_cache_enabled && src_type == LV_IMAGE_SRC_FILE && decoder) {
-        lv_cache_entry_t * entry;
-        lv_image_header_cache_data_t search_key;
-        search_key.src_type = src_type;
-        search_key.src = lv_strdup(src);
-        search_key.decoder = decoder;
-        search_key.header = *header;
-        entry = lv_cache_add(img_header_cache_p, &search_key, NULL);
+        if(header_cache_add(src, header, decoder) != LV_RESULT_OK) return NULL;
+    }
 
-        if(entry == NULL) {
-            if(src_type == LV_IMAGE_SRC_FILE) lv_free((void *)search_key.src);
-            return NULL;
-        }
+    return decoder;
+}
 
-        lv_cache_release(img_header_cache_p, entry, NULL);
+static lv_result_t header_cache_add(const char * src, const lv_image_header_t * header, lv_image_decoder_t * decoder)
+{
+    lv_cache_entry_t * entry;
+    lv_image_header_cache_data_t search_key;
+    search_key.src_type = LV_IMAGE_SRC_FILE;
+    search_key.src = lv_strdup(src);
+    search_key.decoder = decoder;
+    search_key.header = *header;
+    entry = lv_cache_add(img_header_cache_p, &search_key, NULL);
+
+    if(entry == NULL) {
+        lv_free((void *)search_key.src);
+        return LV_RESULT_INVALID;
     }
 
-    return decoder;
+    lv_cache_release(img_header_cache_p, entry, NULL);
+    return LV_RESULT_OK;
 }
 
 static uint32_t img_width_to_stride(lv_image_header_t * header)
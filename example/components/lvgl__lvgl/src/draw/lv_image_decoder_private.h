@@ -39,6 +39,8 @@ struct lv_image_decoder_args_t {
     bool no_cache;          /**< When set, decoded image won't be put to cache, and decoder open will also ignore cache. */
     bool use_indexed;       /**< Decoded indexed image as is. Convert to ARGB8888 if false. */
     bool flush_cache;       /**< Whether to flush the data cache after decoding */
+    bool partial;           /**< The caller can draw the parts returned by `lv_image_decoder_get_area()`
+                             *   so the decoder may skip decoding the whole image */
 };
 
 struct lv_image_decoder_t {
@@ -131,6 +133,14 @@ void lv_image_decoder_init(uint32_t image_cache_size, uint32_t image_header_coun
  */
 void lv_image_decoder_deinit(void);
 
+/**
+ * Hash an image source with FNV-1a. Used as `hash_cb` of the image caches.
+ * @param src_type  the type of the source
+ * @param src       the file name or the address of the image descriptor
+ * @return          the hash of the source
+ */
+uint32_t lv_image_cache_hash_src(lv_image_src_t src_type, const void * src);
+
 /**********************
  *      MACROS
  **********************/
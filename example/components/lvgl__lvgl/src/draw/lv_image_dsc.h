@@ -72,6 +72,8 @@ typedef enum {
     LV_IMAGE_COMPRESS_NONE = 0,
     LV_IMAGE_COMPRESS_RLE,      /**< LVGL custom RLE compression */
     LV_IMAGE_COMPRESS_LZ4,
+    LV_IMAGE_COMPRESS_LZ4_ROWS, /**< Separate LZ4 blocks of a few rows. The blocks intersecting the drawn area
+                                 *   can be decompressed without decompressing the whole image */
 } lv_image_compress_t;
 
 #if LV_BIG_ENDIAN_SYSTEM
@@ -0,0 +1,1223 @@
+/**
+ * @file lv_blend_x86.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_blend_x86.h"
+
+#if LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86 && LV_BLEND_X86_SSE2
+
+#include "../../../../misc/lv_color.h"
+#include "../../../../stdlib/lv_string.h"
+
+#include <emmintrin.h>
+#if LV_BLEND_X86_AVX2
+    #include <immintrin.h>
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#if LV_BLEND_X86_AVX2
+    #define AVX2_ATTR   __attribute__((target("avx2")))
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef enum {
+    SRC_COLOR,
+    SRC_RGB565,
+    SRC_RGB888,
+    SRC_XRGB8888,
+    SRC_ARGB8888,
+} src_type_t;
+
+/*The common parameters of all blend functions. The blended alpha of a pixel is the product of
+ *the source's alpha (only for ARGB8888), the mask (if any) and `opa` (if `use_opa` is set)*/
+typedef struct {
+    uint8_t * dest_buf;
+    int32_t dest_stride;
+    int32_t w;
+    int32_t h;
+    const uint8_t * src_buf;
+    int32_t src_stride;
+    uint32_t src_px_size;
+    src_type_t src_type;
+    const lv_opa_t * mask_buf;
+    int32_t mask_stride;
+    uint32_t color32;
+    uint16_t color16;
+    lv_opa_t opa;
+    bool use_opa;
+} blend_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static void blend_init_fill(blend_t * b, lv_draw_sw_blend_fill_dsc_t * dsc, bool use_opa);
+static void blend_init_image(blend_t * b, lv_draw_sw_blend_image_dsc_t * dsc, src_type_t src_type, bool use_opa);
+
+static void blend_to_argb8888(const blend_t * b);
+static void blend_to_rgb565(const blend_t * b);
+static void blend_to_xrgb8888(const blend_t * b);
+static void fill_argb8888(lv_draw_sw_blend_fill_dsc_t * dsc, uint32_t color32);
+static void fill_rgb565(lv_draw_sw_blend_fill_dsc_t * dsc);
+static void fill_rgb888(lv_draw_sw_blend_fill_dsc_t * dsc);
+static void blend_color_to_rgb888_with_opa(lv_draw_sw_blend_fill_dsc_t * dsc);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+static bool avx2_supported;
+static bool avx2_enabled = true;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_blend_x86_init(void)
+{
+#if LV_BLEND_X86_AVX2
+    __builtin_cpu_init();
+    avx2_supported = __builtin_cpu_supports("avx2");
+#endif
+}
+
+bool lv_blend_x86_has_avx2(void)
+{
+    return avx2_supported && avx2_enabled;
+}
+
+void lv_blend_x86_set_avx2(bool en)
+{
+    avx2_enabled = en;
+}
+
+lv_result_t lv_color_blend_to_rgb565_x86(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    fill_rgb565(dsc);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_rgb565_with_opa_x86(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    blend_t b;
+    blend_init_fill(&b, dsc, true);
+    blend_to_rgb565(&b);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_rgb565_with_mask_x86(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    blend_t b;
+    blend_init_fill(&b, dsc, false);
+    blend_to_rgb565(&b);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_rgb565_mix_mask_opa_x86(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    blend_t b;
+    blend_init_fill(&b, dsc, true);
+    blend_to_rgb565(&b);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb565_blend_normal_to_rgb565_with_opa_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    blend_t b;
+    blend_init_image(&b, dsc, SRC_RGB565, true);
+    blend_to_rgb565(&b);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb565_blend_normal_to_rgb565_with_mask_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    blend_t b;
+    blend_init_image(&b, dsc, SRC_RGB565, false);
+    blend_to_rgb565(&b);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb565_blend_normal_to_rgb565_mix_mask_opa_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    blend_t b;
+    blend_init_image(&b, dsc, SRC_RGB565, true);
+    blend_to_rgb565(&b);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb565_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    blend_t b;
+    blend_init_image(&b, dsc, SRC_ARGB8888, false);
+    blend_to_rgb565(&b);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb565_with_opa_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    blend_t b;
+    blend_init_image(&b, dsc, SRC_ARGB8888, true);
+    blend_to_rgb565(&b);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb565_with_mask_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    blend_t b;
+    blend_init_image(&b, dsc, SRC_ARGB8888, false);
+    blend_to_rgb565(&b);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb565_mix_mask_opa_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    blend_t b;
+    blend_init_image(&b, dsc, SRC_ARGB8888, true);
+    blend_to_rgb565(&b);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_rgb888_x86(lv_draw_sw_blend_fill_dsc_t * dsc, uint32_t dst_px_size)
+{
+    if(dst_px_size == 3) fill_rgb888(dsc);
+    else fill_argb8888(dsc, lv_color_to_u32(dsc->color));
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_rgb888_with_opa_x86(lv_draw_sw_blend_fill_dsc_t * dsc, uint32_t dst_px_size)
+{
+    if(dst_px_size == 3) {
+        blend_color_to_rgb888_with_opa(dsc);
+        return LV_RESULT_OK;
+    }
+
+    blend_t b;
+    blend_init_fill(&b, dsc, true);
+    blend_to_xrgb8888(&b);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_rgb888_with_mask_x86(lv_draw_sw_blend_fill_dsc_t * dsc, uint32_t dst_px_size)
+{
+    if(dst_px_size == 3) return LV_RESULT_INVALID;
+
+    blend_t b;
+    blend_init_fill(&b, dsc, false);
+    blend_to_xrgb8888(&b);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_rgb888_mix_mask_opa_x86(lv_draw_sw_blend_fill_dsc_t * dsc, uint32_t dst_px_size)
+{
+    if(dst_px_size == 3) return LV_RESULT_INVALID;
+
+    blend_t b;
+    blend_init_fill(&b, dsc, true);
+    blend_to_xrgb8888(&b);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb888_x86(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dst_px_size)
+{
+    if(dst_px_size == 3) return LV_RESULT_INVALID;
+
+    blend_t b;
+    blend_init_image(&b, dsc, SRC_ARGB8888, false);
+    blend_to_xrgb8888(&b);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb888_with_opa_x86(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dst_px_size)
+{
+    if(dst_px_size == 3) return LV_RESULT_INVALID;
+
+    blend_t b;
+    blend_init_image(&b, dsc, SRC_ARGB8888, true);
+    blend_to_xrgb8888(&b);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb888_with_mask_x86(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dst_px_size)
+{
+    if(dst_px_size == 3) return LV_RESULT_INVALID;
+
+    blend_t b;
+    blend_init_image(&b, dsc, SRC_ARGB8888, false);
+    blend_to_xrgb8888(&b);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb888_mix_mask_opa_x86(lv_draw_sw_blend_image_dsc_t * dsc,
+                                                                 uint32_t dst_px_size)
+{
+    if(dst_px_size == 3) return LV_RESULT_INVALID;
+
+    blend_t b;
+    blend_init_image(&b, dsc, SRC_ARGB8888, true);
+    blend_to_xrgb8888(&b);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_argb8888_x86(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    fill_argb8888(dsc, lv_color_to_u32(dsc->color));
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_argb8888_with_opa_x86(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    blend_t b;
+    blend_init_fill(&b, dsc, true);
+    blend_to_argb8888(&b);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_argb8888_with_mask_x86(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    blend_t b;
+    blend_init_fill(&b, dsc, false);
+    blend_to_argb8888(&b);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_argb8888_mix_mask_opa_x86(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    blend_t b;
+    blend_init_fill(&b, dsc, true);
+    blend_to_argb8888(&b);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb565_blend_normal_to_argb8888_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    /*The result's alpha is `opa` even if it's only LV_OPA_MAX*/
+    blend_t b;
+    blend_init_image(&b, dsc, SRC_RGB565, true);
+    blend_to_argb8888(&b);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb565_blend_normal_to_argb8888_with_opa_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    blend_t b;
+    blend_init_image(&b, dsc, SRC_RGB565, true);
+    blend_to_argb8888(&b);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb565_blend_normal_to_argb8888_with_mask_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    blend_t b;
+    blend_init_image(&b, dsc, SRC_RGB565, false);
+    blend_to_argb8888(&b);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb565_blend_normal_to_argb8888_mix_mask_opa_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    blend_t b;
+    blend_init_image(&b, dsc, SRC_RGB565, true);
+    blend_to_argb8888(&b);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb888_blend_normal_to_argb8888_x86(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t src_px_size)
+{
+    /*A simple memcpy is used for XRGB8888*/
+    if(src_px_size == 4) return LV_RESULT_INVALID;
+
+    blend_t b;
+    blend_init_image(&b, dsc, SRC_RGB888, false);
+    blend_to_argb8888(&b);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb888_blend_normal_to_argb8888_with_opa_x86(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t src_px_size)
+{
+    blend_t b;
+    blend_init_image(&b, dsc, src_px_size == 3 ? SRC_RGB888 : SRC_XRGB8888, true);
+    blend_to_argb8888(&b);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb888_blend_normal_to_argb8888_with_mask_x86(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t src_px_size)
+{
+    blend_t b;
+    blend_init_image(&b, dsc, src_px_size == 3 ? SRC_RGB888 : SRC_XRGB8888, false);
+    blend_to_argb8888(&b);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb888_blend_normal_to_argb8888_mix_mask_opa_x86(lv_draw_sw_blend_image_dsc_t * dsc,
+                                                                 uint32_t src_px_size)
+{
+    blend_t b;
+    blend_init_image(&b, dsc, src_px_size == 3 ? SRC_RGB888 : SRC_XRGB8888, true);
+    blend_to_argb8888(&b);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_argb8888_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    blend_t b;
+    blend_init_image(&b, dsc, SRC_ARGB8888, false);
+    blend_to_argb8888(&b);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_argb8888_with_opa_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    blend_t b;
+    blend_init_image(&b, dsc, SRC_ARGB8888, true);
+    blend_to_argb8888(&b);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_argb8888_with_mask_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    blend_t b;
+    blend_init_image(&b, dsc, SRC_ARGB8888, false);
+    blend_to_argb8888(&b);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_argb8888_mix_mask_opa_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    blend_t b;
+    blend_init_image(&b, dsc, SRC_ARGB8888, true);
+    blend_to_argb8888(&b);
+    return LV_RESULT_OK;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void blend_init_fill(blend_t * b, lv_draw_sw_blend_fill_dsc_t * dsc, bool use_opa)
+{
+    lv_memzero(b, sizeof(blend_t));
+    b->dest_buf = dsc->dest_buf;
+    b->dest_stride = dsc->dest_stride;
+    b->w = dsc->dest_w;
+    b->h = dsc->dest_h;
+    b->src_type = SRC_COLOR;
+    b->mask_buf = dsc->mask_buf;
+    b->mask_stride = dsc->mask_stride;
+    b->color32 = lv_color_to_u32(dsc->color);
+    b->color16 = lv_color_to_u16(dsc->color);
+    b->opa = dsc->opa;
+    b->use_opa = use_opa;
+}
+
+static void blend_init_image(blend_t * b, lv_draw_sw_blend_image_dsc_t * dsc, src_type_t src_type, bool use_opa)
+{
+    lv_memzero(b, sizeof(blend_t));
+    b->dest_buf = dsc->dest_buf;
+    b->dest_stride = dsc->dest_stride;
+    b->w = dsc->dest_w;
+    b->h = dsc->dest_h;
+    b->src_buf = dsc->src_buf;
+    b->src_stride = dsc->src_stride;
+    b->src_type = src_type;
+    switch(src_type) {
+        case SRC_RGB565:
+            b->src_px_size = 2;
+            break;
+        case SRC_RGB888:
+            b->src_px_size = 3;
+            break;
+        default:
+            b->src_px_size = 4;
+            break;
+    }
+    b->mask_buf = dsc->mask_buf;
+    b->mask_stride = dsc->mask_stride;
+    b->opa = dsc->opa;
+    b->use_opa = use_opa;
+}
+
+/*Multiply 32 bit lanes holding values < 0x10000 with 32 bit lanes holding values < 0x100*/
+static inline __m128i mul_u32_sse2(__m128i a, __m128i b)
+{
+    __m128i lo = _mm_mullo_epi16(a, b);
+    __m128i hi = _mm_mulhi_epu16(a, b);
+    return _mm_or_si128(lo, _mm_slli_epi32(hi, 16));
+}
+
+static inline __m128i load_mask_4px_sse2(const lv_opa_t * mask)
+{
+    int32_t m;
+    lv_memcpy(&m, mask, 4);
+    __m128i zero = _mm_setzero_si128();
+    return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(m), zero), zero);
+}
+
+static inline __m128i load_mask_8px_sse2(const lv_opa_t * mask)
+{
+    return _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)mask), _mm_setzero_si128());
+}
+
+/**
+ * Get the blended alpha of 4 pixels in 32 bit lanes
+ * @param b         the blend parameters
+ * @param src_a     the alpha of the source pixels (used only with ARGB8888 sources)
+ * @param mask      pointer to 4 mask values or NULL
+ * @return          LV_OPA_MIX2/LV_OPA_MIX3 of the source alpha, mask and opa
+ */
+static inline __m128i alpha_4px_sse2(const blend_t * b, __m128i src_a, const lv_opa_t * mask)
+{
+    __m128i opa = _mm_set1_epi32(b->opa);
+    if(b->src_type == SRC_ARGB8888) {
+        if(mask) {
+            __m128i a = _mm_mullo_epi16(src_a, load_mask_4px_sse2(mask));
+            if(b->use_opa) return _mm_srli_epi32(mul_u32_sse2(a, opa), 16);
+            else return _mm_srli_epi32(a, 8);
+        }
+        if(b->use_opa) return _mm_srli_epi32(_mm_mullo_epi16(src_a, opa), 8);
+        return src_a;
+    }
+
+    if(mask) {
+        __m128i m = load_mask_4px_sse2(mask);
+        if(b->use_opa) return _mm_srli_epi32(_mm_mullo_epi16(m, opa), 8);
+        return m;
+    }
+    if(b->use_opa) return opa;
+    return _mm_set1_epi32(0xff);
+}
+
+/*The same as `alpha_4px_sse2` but for 8 pixels in 16 bit lanes*/
+static inline __m128i alpha_8px_sse2(const blend_t * b, __m128i src_a, const lv_opa_t * mask)
+{
+    __m128i opa = _mm_set1_epi16(b->opa);
+    if(b->src_type == SRC_ARGB8888) {
+        if(mask) {
+            __m128i a = _mm_mullo_epi16(src_a, load_mask_8px_sse2(mask));
+            if(b->use_opa) return _mm_mulhi_epu16(a, opa);
+            else return _mm_srli_epi16(a, 8);
+        }
+        if(b->use_opa) return _mm_srli_epi16(_mm_mullo_epi16(src_a, opa), 8);
+        return src_a;
+    }
+
+    if(mask) {
+        __m128i m = load_mask_8px_sse2(mask);
+        if(b->use_opa) return _mm_srli_epi16(_mm_mullo_epi16(m, opa), 8);
+        return m;
+    }
+    if(b->use_opa) return opa;
+    return _mm_set1_epi16(0xff);
+}
+
+static inline __m128i rgb565_to_argb8888_4px_sse2(const uint8_t * src)
+{
+    __m128i zero = _mm_setzero_si128();
+    __m128i px = _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i *)src), zero);
+    __m128i mask5 = _mm_set1_epi32(0x1f);
+    /*The same rounding as in the C implementation*/
+    __m128i r = _mm_srli_epi32(_mm_mullo_epi16(_mm_srli_epi32(px, 11), _mm_set1_epi32(2106)), 8);
+    __m128i g = _mm_srli_epi32(_mm_mullo_epi16(_mm_and_si128(_mm_srli_epi32(px, 5), _mm_set1_epi32(0x3f)),
+                                               _mm_set1_epi32(1037)), 8);
+    __m128i b = _mm_srli_epi32(_mm_mullo_epi16(_mm_and_si128(px, mask5), _mm_set1_epi32(2106)), 8);
+    return _mm_or_si128(_mm_or_si128(_mm_slli_epi32(r, 16), _mm_slli_epi32(g, 8)), b);
+}
+
+static inline __m128i rgb888_to_argb8888_4px_sse2(const uint8_t * src)
+{
+    return _mm_setr_epi32(src[0] | (src[1] << 8) | (src[2] << 16),
+                          src[3] | (src[4] << 8) | (src[5] << 16),
+                          src[6] | (src[7] << 8) | (src[8] << 16),
+                          src[9] | (src[10] << 8) | (src[11] << 16));
+}
+
+/**
+ * Load 4 source pixels as ARGB8888 with the blended alpha
+ * @param b         the blend parameters
+ * @param src       pointer to the first source pixel (not used for SRC_COLOR)
+ * @param mask      pointer to 4 mask values or NULL
+ * @return          4 ARGB8888 pixels
+ */
+static inline __m128i load_fg_4px_sse2(const blend_t * b, const uint8_t * src, const lv_opa_t * mask)
+{
+    __m128i fg;
+    __m128i src_a = _mm_setzero_si128();
+    switch(b->src_type) {
+        case SRC_COLOR:
+            fg = _mm_set1_epi32(b->color32);
+            break;
+        case SRC_RGB565:
+            fg = rgb565_to_argb8888_4px_sse2(src);
+            break;
+        case SRC_RGB888:
+            fg = rgb888_to_argb8888_4px_sse2(src);
+            break;
+        case SRC_XRGB8888:
+            fg = _mm_loadu_si128((const __m128i *)src);
+            break;
+        case SRC_ARGB8888:
+        default:
+            fg = _mm_loadu_si128((const __m128i *)src);
+            src_a = _mm_srli_epi32(fg, 24);
+            break;
+    }
+
+    __m128i a = alpha_4px_sse2(b, src_a, mask);
+    return _mm_or_si128(_mm_and_si128(fg, _mm_set1_epi32(0x00ffffff)), _mm_slli_epi32(a, 24));
+}
+
+/**
+ * Mix the color channels of 4 pixels: `(fg * a + bg * (255 - a)) >> 8` where `a` is the alpha of `fg`.
+ * The alpha channel of the result is undefined.
+ */
+static inline __m128i mix_channels_4px_sse2(__m128i fg, __m128i bg)
+{
+    __m128i zero = _mm_setzero_si128();
+    __m128i c255 = _mm_set1_epi16(255);
+
+    __m128i fg_lo = _mm_unpacklo_epi8(fg, zero);
+    __m128i fg_hi = _mm_unpackhi_epi8(fg, zero);
+    __m128i bg_lo = _mm_unpacklo_epi8(bg, zero);
+    __m128i bg_hi = _mm_unpackhi_epi8(bg, zero);
+    __m128i a_lo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(fg_lo, 0xff), 0xff);
+    __m128i a_hi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(fg_hi, 0xff), 0xff);
+
+    __m128i res_lo = _mm_add_epi16(_mm_mullo_epi16(fg_lo, a_lo), _mm_mullo_epi16(bg_lo, _mm_sub_epi16(c255, a_lo)));
+    __m128i res_hi = _mm_add_epi16(_mm_mullo_epi16(fg_hi, a_hi), _mm_mullo_epi16(bg_hi, _mm_sub_epi16(c255, a_hi)));
+    return _mm_packus_epi16(_mm_srli_epi16(res_lo, 8), _mm_srli_epi16(res_hi, 8));
+}
+
+/*The same as `lv_color_32_32_mix` in the C implementation*/
+static lv_color32_t argb8888_mix_px(lv_color32_t fg, lv_color32_t bg)
+{
+    if(fg.alpha >= LV_OPA_MAX || bg.alpha <= LV_OPA_MIN) return fg;
+    if(fg.alpha <= LV_OPA_MIN) return bg;
+    if(bg.alpha == 255) return lv_color_mix32(fg, bg);
+
+    lv_opa_t res_alpha = 255 - LV_OPA_MIX2(255 - fg.alpha, 255 - bg.alpha);
+    fg.alpha = (uint32_t)((uint32_t)fg.alpha * 255) / res_alpha;
+    lv_color32_t res = lv_color_mix32(fg, bg);
+    res.alpha = res_alpha;
+    return res;
+}
+
+/*Blend the pixels where both colors are semi-transparent. It's rare so it's done in C.*/
+static void argb8888_mix_slow(uint32_t * dest, const lv_color32_t * fg, const lv_color32_t * bg, uint32_t slow_mask,
+                              int32_t px_cnt)
+{
+    int32_t i;
+    for(i = 0; i < px_cnt; i++) {
+        if(slow_mask & (1 << i)) {
+            lv_color32_t res = argb8888_mix_px(fg[i], bg[i]);
+            lv_memcpy(&dest[i], &res, 4);
+        }
+    }
+}
+
+/**
+ * Blend 4 ARGB8888 pixels on 4 ARGB8888 pixels as `lv_color_32_32_mix` does
+ * @param fg            the foreground pixels
+ * @param bg            the background pixels
+ * @param slow_mask     the bits of the pixels which are not handled because both colors are semi-transparent
+ * @return              the blended pixels
+ */
+static inline __m128i argb8888_mix_4px_sse2(__m128i fg, __m128i bg, uint32_t * slow_mask)
+{
+    __m128i fa = _mm_srli_epi32(fg, 24);
+    __m128i ba = _mm_srli_epi32(bg, 24);
+    __m128i keep_fg = _mm_or_si128(_mm_cmpgt_epi32(fa, _mm_set1_epi32(LV_OPA_MAX - 1)),
+                                   _mm_cmplt_epi32(ba, _mm_set1_epi32(LV_OPA_MIN + 1)));
+    __m128i keep_bg = _mm_andnot_si128(keep_fg, _mm_cmplt_epi32(fa, _mm_set1_epi32(LV_OPA_MIN + 1)));
+    __m128i mix = _mm_andnot_si128(_mm_or_si128(keep_fg, keep_bg), _mm_set1_epi32(-1));
+    __m128i slow = _mm_andnot_si128(_mm_cmpeq_epi32(ba, _mm_set1_epi32(0xff)), mix);
+    *slow_mask = _mm_movemask_ps(_mm_castsi128_ps(slow));
+
+    /*The background is opaque so the result is opaque too*/
+    __m128i mixed = _mm_or_si128(mix_channels_4px_sse2(fg, bg), _mm_set1_epi32((int32_t)0xff000000));
+    return _mm_or_si128(_mm_or_si128(_mm_and_si128(fg, keep_fg), _mm_and_si128(bg, keep_bg)),
+                        _mm_and_si128(mixed, mix));
+}
+
+static inline void argb8888_4px_sse2(const blend_t * b, uint32_t * dest, const uint8_t * src, const lv_opa_t * mask)
+{
+    __m128i fg = load_fg_4px_sse2(b, src, mask);
+    __m128i bg = _mm_loadu_si128((const __m128i *)dest);
+    uint32_t slow_mask;
+    _mm_storeu_si128((__m128i *)dest, argb8888_mix_4px_sse2(fg, bg, &slow_mask));
+    if(slow_mask) {
+        lv_color32_t fg_c[4];
+        lv_color32_t bg_c[4];
+        _mm_storeu_si128((__m128i *)fg_c, fg);
+        _mm_storeu_si128((__m128i *)bg_c, bg);
+        argb8888_mix_slow(dest, fg_c, bg_c, slow_mask, 4);
+    }
+}
+
+/**
+ * Load 8 source pixels as RGB565 and their blended alpha
+ * @param b         the blend parameters
+ * @param src       pointer to the first source pixel (not used for SRC_COLOR)
+ * @param mask      pointer to 8 mask values or NULL
+ * @param mix       store the blended alpha of the pixels in 16 bit lanes here
+ * @return          8 RGB565 pixels
+ */
+static inline __m128i load_fg_8px_sse2(const blend_t * b, const uint8_t * src, const lv_opa_t * mask, __m128i * mix)
+{
+    __m128i fg;
+    __m128i src_a = _mm_setzero_si128();
+    if(b->src_type == SRC_COLOR) {
+        fg = _mm_set1_epi16((int16_t)b->color16);
+    }
+    else if(b->src_type == SRC_RGB565) {
+        fg = _mm_loadu_si128((const __m128i *)src);
+    }
+    else {
+        /*ARGB8888: truncate the channels to RGB565*/
+        __m128i px1 = _mm_loadu_si128((const __m128i *)src);
+        __m128i px2 = _mm_loadu_si128((const __m128i *)(src + 16));
+        __m128i c1 = _mm_or_si128(_mm_or_si128(_mm_and_si128(_mm_srli_epi32(px1, 8), _mm_set1_epi32(0xf800)),
+                                               _mm_and_si128(_mm_srli_epi32(px1, 5), _mm_set1_epi32(0x07e0))),
+                                  _mm_and_si128(_mm_srli_epi32(px1, 3), _mm_set1_epi32(0x001f)));
+        __m128i c2 = _mm_or_si128(_mm_or_si128(_mm_and_si128(_mm_srli_epi32(px2, 8), _mm_set1_epi32(0xf800)),
+                                               _mm_and_si128(_mm_srli_epi32(px2, 5), _mm_set1_epi32(0x07e0))),
+                                  _mm_and_si128(_mm_srli_epi32(px2, 3), _mm_set1_epi32(0x001f)));
+        /*Sign extend to keep the values by the signed saturation of the pack*/
+        c1 = _mm_srai_epi32(_mm_slli_epi32(c1, 16), 16);
+        c2 = _mm_srai_epi32(_mm_slli_epi32(c2, 16), 16);
+        fg = _mm_packs_epi32(c1, c2);
+        src_a = _mm_packs_epi32(_mm_srli_epi32(px1, 24), _mm_srli_epi32(px2, 24));
+    }
+
+    *mix = alpha_8px_sse2(b, src_a, mask);
+    return fg;
+}
+
+/*The same as `lv_color_16_16_mix` for 8 pixels. The packed version of the C implementation can be computed by
+ *channels as `bg + (((fg - bg) * ((mix + 4) >> 3)) >> 5)`*/
+static inline __m128i rgb565_mix_16_16_8px_sse2(__m128i fg, __m128i bg, __m128i mix)
+{
+    __m128i mask5 = _mm_set1_epi16(0x1f);
+    __m128i mask6 = _mm_set1_epi16(0x3f);
+    __m128i m = _mm_srli_epi16(_mm_add_epi16(mix, _mm_set1_epi16(4)), 3);
+
+    __m128i fr = _mm_srli_epi16(fg, 11);
+    __m128i fgr = _mm_and_si128(_mm_srli_epi16(fg, 5), mask6);
+    __m128i fb = _mm_and_si128(fg, mask5);
+    __m128i br = _mm_srli_epi16(bg, 11);
+    __m128i bgr = _mm_and_si128(_mm_srli_epi16(bg, 5), mask6);
+    __m128i bb = _mm_and_si128(bg, mask5);
+
+    __m128i r = _mm_add_epi16(br, _mm_srai_epi16(_mm_mullo_epi16(_mm_sub_epi16(fr, br), m), 5));
+    __m128i g = _mm_add_epi16(bgr, _mm_srai_epi16(_mm_mullo_epi16(_mm_sub_epi16(fgr, bgr), m), 5));
+    __m128i b = _mm_add_epi16(bb, _mm_srai_epi16(_mm_mullo_epi16(_mm_sub_epi16(fb, bb), m), 5));
+    return _mm_or_si128(_mm_or_si128(_mm_slli_epi16(r, 11), _mm_slli_epi16(g, 5)), b);
+}
+
+/*The same as `lv_color_24_16_mix` for 8 pixels where `fg` is the truncated source color*/
+static inline __m128i rgb565_mix_24_16_8px_sse2(__m128i fg, __m128i bg, __m128i mix)
+{
+    __m128i mask5 = _mm_set1_epi16(0x1f);
+    __m128i mask6 = _mm_set1_epi16(0x3f);
+    __m128i mix_inv = _mm_sub_epi16(_mm_set1_epi16(255), mix);
+
+    __m128i fr = _mm_srli_epi16(fg, 11);
+    __m128i fgr = _mm_and_si128(_mm_srli_epi16(fg, 5), mask6);
+    __m128i fb = _mm_and_si128(fg, mask5);
+    __m128i br = _mm_srli_epi16(bg, 11);
+    __m128i bgr = _mm_and_si128(_mm_srli_epi16(bg, 5), mask6);
+    __m128i bb = _mm_and_si128(bg, mask5);
+
+    __m128i r = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(fr, mix), _mm_mullo_epi16(br, mix_inv)), 8);
+    __m128i g = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(fgr, mix), _mm_mullo_epi16(bgr, mix_inv)), 8);
+    __m128i b = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(fb, mix), _mm_mullo_epi16(bb, mix_inv)), 8);
+    __m128i res = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(r, 11), _mm_slli_epi16(g, 5)), b);
+
+    __m128i is_cover = _mm_cmpeq_epi16(mix, _mm_set1_epi16(255));
+    __m128i is_transp = _mm_cmpeq_epi16(mix, _mm_setzero_si128());
+    res = _mm_or_si128(_mm_andnot_si128(is_cover, res), _mm_and_si128(is_cover, fg));
+    return _mm_or_si128(_mm_andnot_si128(is_transp, res), _mm_and_si128(is_transp, bg));
+}
+
+static inline void rgb565_8px_sse2(const blend_t * b, uint16_t * dest, const uint8_t * src, const lv_opa_t * mask)
+{
+    __m128i mix;
+    __m128i fg = load_fg_8px_sse2(b, src, mask, &mix);
+    __m128i bg = _mm_loadu_si128((const __m128i *)dest);
+    __m128i res;
+    if(b->src_type == SRC_ARGB8888) res = rgb565_mix_24_16_8px_sse2(fg, bg, mix);
+    else res = rgb565_mix_16_16_8px_sse2(fg, bg, mix);
+    _mm_storeu_si128((__m128i *)dest, res);
+}
+
+/*The same as `lv_color_24_24_mix` for 4 pixels. The alpha of `fg` is the mix ratio and the 4th byte of `bg` is kept.*/
+static inline __m128i xrgb8888_mix_4px_sse2(__m128i fg, __m128i bg)
+{
+    __m128i a = _mm_srli_epi32(fg, 24);
+    __m128i keep_fg = _mm_cmpgt_epi32(a, _mm_set1_epi32(LV_OPA_MAX - 1));
+    __m128i keep_bg = _mm_cmpeq_epi32(a, _mm_setzero_si128());
+    __m128i rgb = _mm_andnot_si128(keep_bg, _mm_or_si128(_mm_and_si128(keep_fg, fg),
+                                                         _mm_andnot_si128(keep_fg, mix_channels_4px_sse2(fg, bg))));
+    rgb = _mm_or_si128(rgb, _mm_and_si128(keep_bg, bg));
+
+    __m128i alpha_mask = _mm_set1_epi32((int32_t)0xff000000);
+    return _mm_or_si128(_mm_andnot_si128(alpha_mask, rgb), _mm_and_si128(alpha_mask, bg));
+}
+
+static inline void xrgb8888_4px_sse2(const blend_t * b, uint32_t * dest, const uint8_t * src, const lv_opa_t * mask)
+{
+    __m128i fg = load_fg_4px_sse2(b, src, mask);
+    __m128i bg = _mm_loadu_si128((const __m128i *)dest);
+    _mm_storeu_si128((__m128i *)dest, xrgb8888_mix_4px_sse2(fg, bg));
+}
+
+#if LV_BLEND_X86_AVX2
+
+static inline AVX2_ATTR __m256i combine_avx2(__m128i lo, __m128i hi)
+{
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+}
+
+/*The same as `mix_channels_4px_sse2` for 8 pixels*/
+static inline AVX2_ATTR __m256i mix_channels_8px_avx2(__m256i fg, __m256i bg)
+{
+    __m256i zero = _mm256_setzero_si256();
+    __m256i c255 = _mm256_set1_epi16(255);
+
+    __m256i fg_lo = _mm256_unpacklo_epi8(fg, zero);
+    __m256i fg_hi = _mm256_unpackhi_epi8(fg, zero);
+    __m256i bg_lo = _mm256_unpacklo_epi8(bg, zero);
+    __m256i bg_hi = _mm256_unpackhi_epi8(bg, zero);
+    __m256i a_lo = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(fg_lo, 0xff), 0xff);
+    __m256i a_hi = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(fg_hi, 0xff), 0xff);
+
+    __m256i res_lo = _mm256_add_epi16(_mm256_mullo_epi16(fg_lo, a_lo),
+                                      _mm256_mullo_epi16(bg_lo, _mm256_sub_epi16(c255, a_lo)));
+    __m256i res_hi = _mm256_add_epi16(_mm256_mullo_epi16(fg_hi, a_hi),
+                                      _mm256_mullo_epi16(bg_hi, _mm256_sub_epi16(c255, a_hi)));
+    return _mm256_packus_epi16(_mm256_srli_epi16(res_lo, 8), _mm256_srli_epi16(res_hi, 8));
+}
+
+/*The same as `argb8888_mix_4px_sse2` for 8 pixels*/
+static inline AVX2_ATTR __m256i argb8888_mix_8px_avx2(__m256i fg, __m256i bg, uint32_t * slow_mask)
+{
+    __m256i fa = _mm256_srli_epi32(fg, 24);
+    __m256i ba = _mm256_srli_epi32(bg, 24);
+    __m256i keep_fg = _mm256_or_si256(_mm256_cmpgt_epi32(fa, _mm256_set1_epi32(LV_OPA_MAX - 1)),
+                                      _mm256_cmpgt_epi32(_mm256_set1_epi32(LV_OPA_MIN + 1), ba));
+    __m256i keep_bg = _mm256_andnot_si256(keep_fg, _mm256_cmpgt_epi32(_mm256_set1_epi32(LV_OPA_MIN + 1), fa));
+    __m256i mix = _mm256_andnot_si256(_mm256_or_si256(keep_fg, keep_bg), _mm256_set1_epi32(-1));
+    __m256i slow = _mm256_andnot_si256(_mm256_cmpeq_epi32(ba, _mm256_set1_epi32(0xff)), mix);
+    *slow_mask = _mm256_movemask_ps(_mm256_castsi256_ps(slow));
+
+    __m256i mixed = _mm256_or_si256(mix_channels_8px_avx2(fg, bg), _mm256_set1_epi32((int32_t)0xff000000));
+    return _mm256_or_si256(_mm256_or_si256(_mm256_and_si256(fg, keep_fg), _mm256_and_si256(bg, keep_bg)),
+                           _mm256_and_si256(mixed, mix));
+}
+
+static inline AVX2_ATTR void argb8888_8px_avx2(const blend_t * b, uint32_t * dest, const uint8_t * src,
+                                               const lv_opa_t * mask)
+{
+    __m256i fg;
+    if(b->src_type == SRC_ARGB8888 && mask == NULL && !b->use_opa) {
+        fg = _mm256_loadu_si256((const __m256i *)src);
+    }
+    else {
+        fg = combine_avx2(load_fg_4px_sse2(b, src, mask),
+                          load_fg_4px_sse2(b, src ? src + 4 * b->src_px_size : NULL, mask ? mask + 4 : NULL));
+    }
+
+    __m256i bg = _mm256_loadu_si256((const __m256i *)dest);
+    uint32_t slow_mask;
+    _mm256_storeu_si256((__m256i *)dest, argb8888_mix_8px_avx2(fg, bg, &slow_mask));
+    if(slow_mask) {
+        lv_color32_t fg_c[8];
+        lv_color32_t bg_c[8];
+        _mm256_storeu_si256((__m256i *)fg_c, fg);
+        _mm256_storeu_si256((__m256i *)bg_c, bg);
+        argb8888_mix_slow(dest, fg_c, bg_c, slow_mask, 8);
+    }
+}
+
+/*The same as `rgb565_mix_16_16_8px_sse2` for 16 pixels*/
+static inline AVX2_ATTR __m256i rgb565_mix_16_16_16px_avx2(__m256i fg, __m256i bg, __m256i mix)
+{
+    __m256i mask5 = _mm256_set1_epi16(0x1f);
+    __m256i mask6 = _mm256_set1_epi16(0x3f);
+    __m256i m = _mm256_srli_epi16(_mm256_add_epi16(mix, _mm256_set1_epi16(4)), 3);
+
+    __m256i fr = _mm256_srli_epi16(fg, 11);
+    __m256i fgr = _mm256_and_si256(_mm256_srli_epi16(fg, 5), mask6);
+    __m256i fb = _mm256_and_si256(fg, mask5);
+    __m256i br = _mm256_srli_epi16(bg, 11);
+    __m256i bgr = _mm256_and_si256(_mm256_srli_epi16(bg, 5), mask6);
+    __m256i bb = _mm256_and_si256(bg, mask5);
+
+    __m256i r = _mm256_add_epi16(br, _mm256_srai_epi16(_mm256_mullo_epi16(_mm256_sub_epi16(fr, br), m), 5));
+    __m256i g = _mm256_add_epi16(bgr, _mm256_srai_epi16(_mm256_mullo_epi16(_mm256_sub_epi16(fgr, bgr), m), 5));
+    __m256i b = _mm256_add_epi16(bb, _mm256_srai_epi16(_mm256_mullo_epi16(_mm256_sub_epi16(fb, bb), m), 5));
+    return _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi16(r, 11), _mm256_slli_epi16(g, 5)), b);
+}
+
+/*The same as `rgb565_mix_24_16_8px_sse2` for 16 pixels*/
+static inline AVX2_ATTR __m256i rgb565_mix_24_16_16px_avx2(__m256i fg, __m256i bg, __m256i mix)
+{
+    __m256i mask5 = _mm256_set1_epi16(0x1f);
+    __m256i mask6 = _mm256_set1_epi16(0x3f);
+    __m256i mix_inv = _mm256_sub_epi16(_mm256_set1_epi16(255), mix);
+
+    __m256i fr = _mm256_srli_epi16(fg, 11);
+    __m256i fgr = _mm256_and_si256(_mm256_srli_epi16(fg, 5), mask6);
+    __m256i fb = _mm256_and_si256(fg, mask5);
+    __m256i br = _mm256_srli_epi16(bg, 11);
+    __m256i bgr = _mm256_and_si256(_mm256_srli_epi16(bg, 5), mask6);
+    __m256i bb = _mm256_and_si256(bg, mask5);
+
+    __m256i r = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(fr, mix), _mm256_mullo_epi16(br, mix_inv)), 8);
+    __m256i g = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(fgr, mix), _mm256_mullo_epi16(bgr, mix_inv)), 8);
+    __m256i b = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(fb, mix), _mm256_mullo_epi16(bb, mix_inv)), 8);
+    __m256i res = _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi16(r, 11), _mm256_slli_epi16(g, 5)), b);
+
+    __m256i is_cover = _mm256_cmpeq_epi16(mix, _mm256_set1_epi16(255));
+    __m256i is_transp = _mm256_cmpeq_epi16(mix, _mm256_setzero_si256());
+    res = _mm256_blendv_epi8(res, fg, is_cover);
+    return _mm256_blendv_epi8(res, bg, is_transp);
+}
+
+static inline AVX2_ATTR void rgb565_16px_avx2(const blend_t * b, uint16_t * dest, const uint8_t * src,
+                                              const lv_opa_t * mask)
+{
+    __m128i mix1;
+    __m128i mix2;
+    __m128i fg1 = load_fg_8px_sse2(b, src, mask, &mix1);
+    __m128i fg2 = load_fg_8px_sse2(b, src ? src + 8 * b->src_px_size : NULL, mask ? mask + 8 : NULL, &mix2);
+    __m256i fg = combine_avx2(fg1, fg2);
+    __m256i mix = combine_avx2(mix1, mix2);
+    __m256i bg = _mm256_loadu_si256((const __m256i *)dest);
+    __m256i res;
+    if(b->src_type == SRC_ARGB8888) res = rgb565_mix_24_16_16px_avx2(fg, bg, mix);
+    else res = rgb565_mix_16_16_16px_avx2(fg, bg, mix);
+    _mm256_storeu_si256((__m256i *)dest, res);
+}
+
+/*The same as `xrgb8888_mix_4px_sse2` for 8 pixels*/
+static inline AVX2_ATTR void xrgb8888_8px_avx2(const blend_t * b, uint32_t * dest, const uint8_t * src,
+                                               const lv_opa_t * mask)
+{
+    __m256i fg = combine_avx2(load_fg_4px_sse2(b, src, mask),
+                              load_fg_4px_sse2(b, src ? src + 4 * b->src_px_size : NULL, mask ? mask + 4 : NULL));
+    __m256i bg = _mm256_loadu_si256((const __m256i *)dest);
+
+    __m256i a = _mm256_srli_epi32(fg, 24);
+    __m256i keep_fg = _mm256_cmpgt_epi32(a, _mm256_set1_epi32(LV_OPA_MAX - 1));
+    __m256i keep_bg = _mm256_cmpeq_epi32(a, _mm256_setzero_si256());
+    __m256i rgb = _mm256_blendv_epi8(mix_channels_8px_avx2(fg, bg), fg, keep_fg);
+    rgb = _mm256_blendv_epi8(rgb, bg, keep_bg);
+    rgb = _mm256_blendv_epi8(rgb, bg, _mm256_set1_epi32((int32_t)0xff000000));
+    _mm256_storeu_si256((__m256i *)dest, rgb);
+}
+
+static AVX2_ATTR void fill_32_avx2(uint32_t * dest, int32_t w, uint32_t color32)
+{
+    __m256i c = _mm256_set1_epi32((int32_t)color32);
+    int32_t x = 0;
+    for(; x <= w - 8; x += 8) {
+        _mm256_storeu_si256((__m256i *)&dest[x], c);
+    }
+    for(; x < w; x++) {
+        dest[x] = color32;
+    }
+}
+
+static AVX2_ATTR void fill_16_avx2(uint16_t * dest, int32_t w, uint16_t color16)
+{
+    __m256i c = _mm256_set1_epi16((int16_t)color16);
+    int32_t x = 0;
+    for(; x <= w - 16; x += 16) {
+        _mm256_storeu_si256((__m256i *)&dest[x], c);
+    }
+    for(; x < w; x++) {
+        dest[x] = color16;
+    }
+}
+
+#endif /*LV_BLEND_X86_AVX2*/
+
+static inline const uint8_t * src_px(const blend_t * b, const uint8_t * src_row, int32_t x)
+{
+    return src_row ? src_row + x * b->src_px_size : NULL;
+}
+
+static inline const lv_opa_t * mask_px(const lv_opa_t * mask_row, int32_t x)
+{
+    return mask_row ? mask_row + x : NULL;
+}
+
+static void blend_to_argb8888(const blend_t * b)
+{
+    uint8_t * dest_row = b->dest_buf;
+    const uint8_t * src_row = b->src_buf;
+    const lv_opa_t * mask_row = b->mask_buf;
+#if LV_BLEND_X86_AVX2
+    bool avx2 = lv_blend_x86_has_avx2();
+#endif
+    int32_t y;
+    for(y = 0; y < b->h; y++) {
+        uint32_t * dest = (uint32_t *)dest_row;
+        int32_t x = 0;
+#if LV_BLEND_X86_AVX2
+        if(avx2) {
+            for(; x <= b->w - 8; x += 8) {
+                argb8888_8px_avx2(b, &dest[x], src_px(b, src_row, x), mask_px(mask_row, x));
+            }
+        }
+#endif
+        for(; x <= b->w - 4; x += 4) {
+            argb8888_4px_sse2(b, &dest[x], src_px(b, src_row, x), mask_px(mask_row, x));
+        }
+
+        /*Blend the last few pixels in a temporary buffer*/
+        if(x < b->w) {
+            int32_t px_cnt = b->w - x;
+            uint32_t dest_tmp[4] = {0};
+            uint8_t src_tmp[16] = {0};
+            lv_opa_t mask_tmp[4] = {0};
+            lv_memcpy(dest_tmp, &dest[x], px_cnt * 4);
+            if(src_row) lv_memcpy(src_tmp, src_px(b, src_row, x), px_cnt * b->src_px_size);
+            if(mask_row) lv_memcpy(mask_tmp, &mask_row[x], px_cnt);
+            argb8888_4px_sse2(b, dest_tmp, src_tmp, mask_row ? mask_tmp : NULL);
+            lv_memcpy(&dest[x], dest_tmp, px_cnt * 4);
+        }
+
+        dest_row += b->dest_stride;
+        if(src_row) src_row += b->src_stride;
+        if(mask_row) mask_row += b->mask_stride;
+    }
+}
+
+static void blend_to_rgb565(const blend_t * b)
+{
+    uint8_t * dest_row = b->dest_buf;
+    const uint8_t * src_row = b->src_buf;
+    const lv_opa_t * mask_row = b->mask_buf;
+#if LV_BLEND_X86_AVX2
+    bool avx2 = lv_blend_x86_has_avx2();
+#endif
+    int32_t y;
+    for(y = 0; y < b->h; y++) {
+        uint16_t * dest = (uint16_t *)dest_row;
+        int32_t x = 0;
+#if LV_BLEND_X86_AVX2
+        if(avx2) {
+            for(; x <= b->w - 16; x += 16) {
+                rgb565_16px_avx2(b, &dest[x], src_px(b, src_row, x), mask_px(mask_row, x));
+            }
+        }
+#endif
+        for(; x <= b->w - 8; x += 8) {
+            rgb565_8px_sse2(b, &dest[x], src_px(b, src_row, x), mask_px(mask_row, x));
+        }
+
+        if(x < b->w) {
+            int32_t px_cnt = b->w - x;
+            uint16_t dest_tmp[8] = {0};
+            uint8_t src_tmp[32] = {0};
+            lv_opa_t mask_tmp[8] = {0};
+            lv_memcpy(dest_tmp, &dest[x], px_cnt * 2);
+            if(src_row) lv_memcpy(src_tmp, src_px(b, src_row, x), px_cnt * b->src_px_size);
+            if(mask_row) lv_memcpy(mask_tmp, &mask_row[x], px_cnt);
+            rgb565_8px_sse2(b, dest_tmp, src_tmp, mask_row ? mask_tmp : NULL);
+            lv_memcpy(&dest[x], dest_tmp, px_cnt * 2);
+        }
+
+        dest_row += b->dest_stride;
+        if(src_row) src_row += b->src_stride;
+        if(mask_row) mask_row += b->mask_stride;
+    }
+}
+
+static void blend_to_xrgb8888(const blend_t * b)
+{
+    uint8_t * dest_row = b->dest_buf;
+    const uint8_t * src_row = b->src_buf;
+    const lv_opa_t * mask_row = b->mask_buf;
+#if LV_BLEND_X86_AVX2
+    bool avx2 = lv_blend_x86_has_avx2();
+#endif
+    int32_t y;
+    for(y = 0; y < b->h; y++) {
+        uint32_t * dest = (uint32_t *)dest_row;
+        int32_t x = 0;
+#if LV_BLEND_X86_AVX2
+        if(avx2) {
+            for(; x <= b->w - 8; x += 8) {
+                xrgb8888_8px_avx2(b, &dest[x], src_px(b, src_row, x), mask_px(mask_row, x));
+            }
+        }
+#endif
+        for(; x <= b->w - 4; x += 4) {
+            xrgb8888_4px_sse2(b, &dest[x], src_px(b, src_row, x), mask_px(mask_row, x));
+        }
+
+        if(x < b->w) {
+            int32_t px_cnt = b->w - x;
+            uint32_t dest_tmp[4] = {0};
+            uint8_t src_tmp[16] = {0};
+            lv_opa_t mask_tmp[4] = {0};
+            lv_memcpy(dest_tmp, &dest[x], px_cnt * 4);
+            if(src_row) lv_memcpy(src_tmp, src_px(b, src_row, x), px_cnt * b->src_px_size);
+            if(mask_row) lv_memcpy(mask_tmp, &mask_row[x], px_cnt);
+            xrgb8888_4px_sse2(b, dest_tmp, src_tmp, mask_row ? mask_tmp : NULL);
+            lv_memcpy(&dest[x], dest_tmp, px_cnt * 4);
+        }
+
+        dest_row += b->dest_stride;
+        if(src_row) src_row += b->src_stride;
+        if(mask_row) mask_row += b->mask_stride;
+    }
+}
+
+static void fill_argb8888(lv_draw_sw_blend_fill_dsc_t * dsc, uint32_t color32)
+{
+    uint8_t * dest_row = dsc->dest_buf;
+    __m128i c = _mm_set1_epi32((int32_t)color32);
+    int32_t y;
+    for(y = 0; y < dsc->dest_h; y++) {
+        uint32_t * dest = (uint32_t *)dest_row;
+#if LV_BLEND_X86_AVX2
+        if(lv_blend_x86_has_avx2()) {
+            fill_32_avx2(dest, dsc->dest_w, color32);
+            dest_row += dsc->dest_stride;
+            continue;
+        }
+#endif
+        int32_t x = 0;
+        for(; x <= dsc->dest_w - 4; x += 4) {
+            _mm_storeu_si128((__m128i *)&dest[x], c);
+        }
+        for(; x < dsc->dest_w; x++) {
+            dest[x] = color32;
+        }
+        dest_row += dsc->dest_stride;
+    }
+}
+
+static void fill_rgb565(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    uint16_t color16 = lv_color_to_u16(dsc->color);
+    uint8_t * dest_row = dsc->dest_buf;
+    __m128i c = _mm_set1_epi16((int16_t)color16);
+    int32_t y;
+    for(y = 0; y < dsc->dest_h; y++) {
+        uint16_t * dest = (uint16_t *)dest_row;
+#if LV_BLEND_X86_AVX2
+        if(lv_blend_x86_has_avx2()) {
+            fill_16_avx2(dest, dsc->dest_w, color16);
+            dest_row += dsc->dest_stride;
+            continue;
+        }
+#endif
+        int32_t x = 0;
+        for(; x <= dsc->dest_w - 8; x += 8) {
+            _mm_storeu_si128((__m128i *)&dest[x], c);
+        }
+        for(; x < dsc->dest_w; x++) {
+            dest[x] = color16;
+        }
+        dest_row += dsc->dest_stride;
+    }
+}
+
+/*Prepare 16 RGB888 pixels (48 bytes) of a color in 3 vectors*/
+static void rgb888_pattern(lv_color_t color, __m128i pattern[3])
+{
+    uint8_t bytes[48];
+    uint32_t i;
+    for(i = 0; i < 48; i += 3) {
+        bytes[i + 0] = color.blue;
+        bytes[i + 1] = color.green;
+        bytes[i + 2] = color.red;
+    }
+    pattern[0] = _mm_loadu_si128((const __m128i *)&bytes[0]);
+    pattern[1] = _mm_loadu_si128((const __m128i *)&bytes[16]);
+    pattern[2] = _mm_loadu_si128((const __m128i *)&bytes[32]);
+}
+
+static void fill_rgb888(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    __m128i pattern[3];
+    rgb888_pattern(dsc->color, pattern);
+
+    int32_t w = dsc->dest_w * 3;
+    uint8_t * dest = dsc->dest_buf;
+    int32_t y;
+    for(y = 0; y < dsc->dest_h; y++) {
+        int32_t x = 0;
+        for(; x <= w - 48; x += 48) {
+            _mm_storeu_si128((__m128i *)&dest[x + 0], pattern[0]);
+            _mm_storeu_si128((__m128i *)&dest[x + 16], pattern[1]);
+            _mm_storeu_si128((__m128i *)&dest[x + 32], pattern[2]);
+        }
+        for(; x < w; x += 3) {
+            dest[x + 0] = dsc->color.blue;
+            dest[x + 1] = dsc->color.green;
+            dest[x + 2] = dsc->color.red;
+        }
+        dest += dsc->dest_stride;
+    }
+}
+
+/*The opacity is the same for all bytes so RGB888 can be blended byte by byte*/
+static inline __m128i mix_bytes_sse2(__m128i fg, __m128i bg, __m128i mix, __m128i mix_inv)
+{
+    __m128i zero = _mm_setzero_si128();
+    __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(fg, zero), mix),
+                               _mm_mullo_epi16(_mm_unpacklo_epi8(bg, zero), mix_inv));
+    __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(fg, zero), mix),
+                               _mm_mullo_epi16(_mm_unpackhi_epi8(bg, zero), mix_inv));
+    return _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8));
+}
+
+static void blend_color_to_rgb888_with_opa(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    lv_opa_t opa = dsc->opa;
+    if(opa == LV_OPA_TRANSP) return;
+
+    __m128i pattern[3];
+    rgb888_pattern(dsc->color, pattern);
+    __m128i mix = _mm_set1_epi16(opa);
+    __m128i mix_inv = _mm_set1_epi16(255 - opa);
+    uint8_t color[3] = {dsc->color.blue, dsc->color.green, dsc->color.red};
+
+    int32_t w = dsc->dest_w * 3;
+    uint8_t * dest = dsc->dest_buf;
+    int32_t y;
+    for(y = 0; y < dsc->dest_h; y++) {
+        int32_t x = 0;
+        for(; x <= w - 48; x += 48) {
+            int32_t i;
+            for(i = 0; i < 3; i++) {
+                __m128i * d = (__m128i *)&dest[x + i * 16];
+                _mm_storeu_si128(d, mix_bytes_sse2(pattern[i], _mm_loadu_si128(d), mix, mix_inv));
+            }
+        }
+        for(; x < w; x++) {
+            dest[x] = (uint32_t)((uint32_t)color[x % 3] * opa + dest[x] * (255 - opa)) >> 8;
+        }
+        dest += dsc->dest_stride;
+    }
+}
+
+#endif /*LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86 && LV_BLEND_X86_SSE2*/
@@ -8,6 +8,7 @@
  *********************/
 #include "../../misc/lv_area_private.h"
 #include "lv_draw_sw_mask_private.h"
+#include "lv_draw_sw_private.h"
 #include "../lv_draw_private.h"
 #include "lv_draw_sw.h"
 #if LV_USE_DRAW_SW
@@ -30,6 +31,7 @@
 
 #if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
     #define shadow_cache LV_GLOBAL_DEFAULT()->sw_shadow_cache
+    #define CACHE_NAME  "SW_SHADOW"
 #endif
 
 /**********************
@@ -42,6 +44,12 @@
 static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_draw_corner_buf(const lv_area_t * coords, uint16_t * sh_buf, int32_t s,
                                                                int32_t r);
 static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_blur_corner(int32_t size, int32_t sw, uint16_t * sh_ups_buf);
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+static lv_cache_compare_res_t shadow_cache_compare_cb(const lv_draw_sw_shadow_cache_data_t * lhs,
+                                                      const lv_draw_sw_shadow_cache_data_t * rhs);
+static bool shadow_cache_create_cb(lv_draw_sw_shadow_cache_data_t * data, void * user_data);
+static void shadow_cache_free_cb(lv_draw_sw_shadow_cache_data_t * data, void * user_data);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -55,6 +63,35 @@ static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_blur_corner(int32_t size, int32_t
  *   GLOBAL FUNCTIONS
  **********************/
 
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+void lv_draw_sw_shadow_cache_init(void)
+{
+    if(shadow_cache.cache != NULL) return;
+
+    shadow_cache.cache = lv_cache_create(&lv_cache_class_lru_rb_size,
+    sizeof(lv_draw_sw_shadow_cache_data_t), LV_DRAW_SW_SHADOW_CACHE_MEM_SIZE, (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t) shadow_cache_compare_cb,
+        .create_cb = (lv_cache_create_cb_t) shadow_cache_create_cb,
+        .free_cb = (lv_cache_free_cb_t) shadow_cache_free_cb,
+    });
+    lv_cache_set_name(shadow_cache.cache, CACHE_NAME);
+}
+
+void lv_draw_sw_shadow_cache_deinit(void)
+{
+    if(shadow_cache.cache == NULL) return;
+
+    lv_cache_destroy(shadow_cache.cache, NULL);
+    shadow_cache.cache = NULL;
+}
+
+void lv_draw_sw_shadow_cache_resize(uint32_t new_size)
+{
+    lv_cache_set_max_size(shadow_cache.cache, new_size, NULL);
+    lv_cache_reserve(shadow_cache.cache, 0, NULL);
+}
+#endif /*LV_DRAW_SW_SHADOW_CACHE_SIZE*/
+
 void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_dsc_t * dsc, const lv_area_t * coords)
 {
     /*Calculate the rectangle which is blurred to get the shadow in `shadow_area`*/
@@ -100,28 +137,36 @@ void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_
     lv_opa_t * sh_buf;
 
 #if LV_DRAW_SW_SHADOW_CACHE_SIZE
-    lv_draw_sw_shadow_cache_t * cache = &shadow_cache;
-    if(cache->cache_size == corner_size && cache->cache_r == r_sh) {
-        /*Use the cache if available*/
-        sh_buf = lv_malloc(corner_size * corner_size);
-        lv_memcpy(sh_buf, cache->cache, corner_size * corner_size);
+    lv_cache_entry_t * cache_entry = NULL;
+    uint32_t corner_data_size = corner_size * corner_size;
+    if(corner_size <= LV_DRAW_SW_SHADOW_CACHE_SIZE &&
+       corner_data_size <= lv_cache_get_max_size(shadow_cache.cache, NULL)) {
+        /*The size of the blurred rectangle matters only if it's small enough to be visible on the corner*/
+        lv_draw_sw_shadow_cache_data_t search_key;
+        search_key.slot.size = corner_data_size;
+        search_key.width = dsc->width;
+        search_key.radius = r_sh;
+        search_key.core_w = LV_MIN(lv_area_get_width(&core_area), corner_size * 2);
+        search_key.core_h = LV_MIN(lv_area_get_height(&core_area), corner_size * 2);
+        search_key.buf = NULL;
+
+        cache_entry = lv_cache_acquire_or_create(shadow_cache.cache, &search_key, NULL);
+    }
+
+    if(cache_entry) {
+        /*The buffer is mirrored later so copy the corner shared by the draw units*/
+        lv_draw_sw_shadow_cache_data_t * cache_data = lv_cache_entry_get_data(cache_entry);
+        sh_buf = lv_malloc(corner_data_size);
+        lv_memcpy(sh_buf, cache_data->buf, corner_data_size);
+        lv_cache_release(shadow_cache.cache, cache_entry, NULL);
     }
-    else {
+    else
+#endif /*LV_DRAW_SW_SHADOW_CACHE_SIZE*/
+    {
         /*A larger buffer is required for calculation*/
         sh_buf = lv_malloc(corner_size * corner_size * sizeof(uint16_t));
         shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->width, r_sh);
-
-        /*Cache the corner if it fits into the cache size*/
-        if((uint32_t)corner_size * corner_size < sizeof(cache->cache)) {
-            lv_memcpy(cache->cache, sh_buf, corner_size * corner_size);
-            cache->cache_size = corner_size;
-            cache->cache_r = r_sh;
-        }
     }
-#else
-    sh_buf = lv_malloc(corner_size * corner_size * sizeof(uint16_t));
-    shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->width, r_sh);
-#endif /*LV_DRAW_SW_SHADOW_CACHE_SIZE*/
 
     /*Skip a lot of masking if the background will cover the shadow that would be masked out*/
     bool simple = dsc->bg_cover;
@@ -727,6 +772,53 @@ static void LV_ATTRIBUTE_FAST_MEM shadow_blur_corner(int32_t size, int32_t sw, u
     lv_free(sh_ups_blur_buf);
 }
 
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+static lv_cache_compare_res_t shadow_cache_compare_cb(const lv_draw_sw_shadow_cache_data_t * lhs,
+                                                      const lv_draw_sw_shadow_cache_data_t * rhs)
+{
+    if(lhs->width != rhs->width) return lhs->width > rhs->width ? 1 : -1;
+    if(lhs->radius != rhs->radius) return lhs->radius > rhs->radius ? 1 : -1;
+    if(lhs->core_w != rhs->core_w) return lhs->core_w > rhs->core_w ? 1 : -1;
+    if(lhs->core_h != rhs->core_h) return lhs->core_h > rhs->core_h ? 1 : -1;
+
+    return 0;
+}
+
+/**
+ * Calculate the blurred corner of a new cache entry
+ * @param data          the cache entry with the key already set
+ * @param user_data     unused
+ * @return              true: the corner is calculated; false: out of memory
+ */
+static bool shadow_cache_create_cb(lv_draw_sw_shadow_cache_data_t * data, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    int32_t corner_size = data->width + data->radius;
+
+    /*A larger buffer is required for calculation*/
+    uint16_t * buf = lv_malloc(corner_size * corner_size * sizeof(uint16_t));
+    if(buf == NULL) return false;
+
+    lv_area_t core_area;
+    lv_area_set(&core_area, 0, 0, data->core_w - 1, data->core_h - 1);
+    shadow_draw_corner_buf(&core_area, buf, data->width, data->radius);
+
+    /*Keep only the lv_opa_t result*/
+    data->buf = lv_realloc(buf, corner_size * corner_size);
+    if(data->buf == NULL) data->buf = (lv_opa_t *)buf;
+
+    return true;
+}
+
+static void shadow_cache_free_cb(lv_draw_sw_shadow_cache_data_t * data, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_free(data->buf);
+}
+#endif /*LV_DRAW_SW_SHADOW_CACHE_SIZE*/
+
 #else /*LV_DRAW_SW_COMPLEX*/
 
 void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_dsc_t * dsc, const lv_area_t * coords)
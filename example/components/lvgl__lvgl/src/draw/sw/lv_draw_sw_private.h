@@ -16,6 +16,8 @@ extern "C" {
 
 #include "lv_draw_sw.h"
 #include "../lv_draw_private.h"
+#include "../../misc/cache/lv_cache.h"
+#include "../../osal/lv_os.h"
 
 #if LV_USE_DRAW_SW
 
@@ -45,9 +47,17 @@ struct lv_draw_sw_unit_t {
 
 #if LV_DRAW_SW_SHADOW_CACHE_SIZE
 typedef struct {
-    uint8_t cache[LV_DRAW_SW_SHADOW_CACHE_SIZE * LV_DRAW_SW_SHADOW_CACHE_SIZE];
-    int32_t cache_size;
-    int32_t cache_r;
+    lv_cache_slot_size_t slot;
+
+    int32_t width;          /**< Width of the shadow*/
+    int32_t radius;         /**< The clamped radius of the shadow*/
+    int32_t core_w;         /**< Width of the blurred rectangle. Limited to 2 * corner size as it doesn't matter above it*/
+    int32_t core_h;         /**< Height of the blurred rectangle. Limited to 2 * corner size as it doesn't matter above it*/
+    lv_opa_t * buf;         /**< The blurred corner with `(width + radius)^2` size*/
+} lv_draw_sw_shadow_cache_data_t;
+
+typedef struct {
+    lv_cache_t * cache;     /**< Its hits and misses can be read by `lv_cache_get_stats()`*/
 } lv_draw_sw_shadow_cache_t;
 #endif
 
@@ -55,6 +65,18 @@ typedef struct {
  * GLOBAL PROTOTYPES
  **********************/
 
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+/**
+ * Create the cache of the blurred shadow corners. Called internally.
+ */
+void lv_draw_sw_shadow_cache_init(void);
+
+/**
+ * Free the cached shadow corners and delete the cache. Called internally.
+ */
+void lv_draw_sw_shadow_cache_deinit(void);
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -9,6 +9,7 @@
 #include "lv_font_fmt_txt_private.h"
 #include "../lvgl.h"
 #include "../misc/lv_fs_private.h"
+#include "../misc/lv_text_private.h"
 #include "../misc/lv_types.h"
 #include "../stdlib/lv_string.h"
 #include "lv_binfont_loader.h"
@@ -59,16 +60,44 @@ typedef struct cmap_table_bin {
     uint8_t padding;
 } cmap_table_bin_t;
 
+typedef struct {
+    lv_font_fmt_txt_dsc_t dsc;  /*Keep it first as `lv_binfont_destroy` frees this struct as the descriptor*/
+    lv_fs_file_t file;
+    bool file_opened;
+    lv_mutex_t lock;            /*Protects the file as the draw units can load glyphs in parallel*/
+    lv_cache_t * cache;
+    uint32_t * glyph_offset;    /*Offset of each glyph in the `glyf` table and the length of the table at the end*/
+    uint32_t glyph_start;
+    uint32_t glyph_header_bits; /*Size of the metrics before the bitmap of each glyph*/
+} binfont_lazy_t;
+
+typedef struct {
+    lv_cache_slot_size_t slot;
+    binfont_lazy_t * lazy;
+    uint32_t gid;
+    uint8_t * bitmap;           /*The A8 bitmap with the stride of the draw buffers*/
+} binfont_glyph_cache_data_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static bit_iterator_t init_bit_iterator(lv_fs_file_t * fp);
-static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font);
+static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font, binfont_lazy_t * lazy);
+static bool read_glyph_bitmap(lv_fs_file_t * fp, uint32_t pos, int nbits, uint8_t * bmp, int bmp_size);
 int32_t load_kern(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t format, uint32_t start);
 
 static int read_bits_signed(bit_iterator_t * it, int n_bits, lv_fs_res_t * res);
 static unsigned int read_bits(bit_iterator_t * it, int n_bits, lv_fs_res_t * res);
 
+static const void * lazy_get_glyph_bitmap(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf_t * draw_buf);
+static bool lazy_glyph_load(binfont_lazy_t * lazy, uint32_t gid, uint8_t * bitmap_out);
+static lv_cache_entry_t * lazy_glyph_cache_acquire(binfont_lazy_t * lazy, uint32_t gid, bool * created);
+static lv_cache_compare_res_t lazy_cache_compare_cb(const binfont_glyph_cache_data_t * lhs,
+                                                    const binfont_glyph_cache_data_t * rhs);
+static bool lazy_cache_create_cb(binfont_glyph_cache_data_t * data, void * user_data);
+static void lazy_cache_free_cb(binfont_glyph_cache_data_t * data, void * user_data);
+static uint32_t lazy_cache_hash_cb(const binfont_glyph_cache_data_t * key);
+
 /**********************
  *      MACROS
  **********************/
@@ -88,7 +117,7 @@ lv_font_t * lv_binfont_create(const char * path)
     lv_font_t * font = lv_malloc_zeroed(sizeof(lv_font_t));
     LV_ASSERT_MALLOC(font);
 
-    if(!lvgl_load_font(&file, font)) {
+    if(!lvgl_load_font(&file, font, NULL)) {
         LV_LOG_WARN("Error loading font file: %s", path);
         /*
         * When `lvgl_load_font` fails it can leak some pointers.
@@ -114,6 +143,74 @@ lv_font_t * lv_binfont_create_from_buffer(void * buffer, uint32_t size)
 }
 #endif
 
+lv_font_t * lv_binfont_create_lazy(const char * path, uint32_t cache_size)
+{
+    LV_ASSERT_NULL(path);
+
+    lv_font_t * font = lv_malloc_zeroed(sizeof(lv_font_t));
+    LV_ASSERT_MALLOC(font);
+    binfont_lazy_t * lazy = lv_malloc_zeroed(sizeof(binfont_lazy_t));
+    LV_ASSERT_MALLOC(lazy);
+
+    font->dsc = lazy;
+    font->get_glyph_bitmap = lazy_get_glyph_bitmap;
+    lv_mutex_init(&lazy->lock);
+
+    if(cache_size > 0) {
+        lazy->cache = lv_cache_create_sharded(&lv_cache_class_lru_rb_size, sizeof(binfont_glyph_cache_data_t), cache_size,
+        (lv_cache_ops_t) {
+            .compare_cb = (lv_cache_compare_cb_t) lazy_cache_compare_cb,
+            .create_cb = (lv_cache_create_cb_t) lazy_cache_create_cb,
+            .free_cb = (lv_cache_free_cb_t) lazy_cache_free_cb,
+            .hash_cb = (lv_cache_hash_cb_t) lazy_cache_hash_cb,
+        }, LV_CACHE_SHARD_CNT);
+        lv_cache_set_name(lazy->cache, "BINFONT_GLYPH");
+    }
+
+    /*Keep the file open to read the bitmaps later*/
+    lazy->file_opened = lv_fs_open(&lazy->file, path, LV_FS_MODE_RD) == LV_FS_RES_OK;
+    if(!lazy->file_opened) {
+        lv_binfont_destroy(font);
+        return NULL;
+    }
+
+    if(!lvgl_load_font(&lazy->file, font, lazy)) {
+        LV_LOG_WARN("Error loading font file: %s", path);
+        lv_binfont_destroy(font);
+        return NULL;
+    }
+
+    return font;
+}
+
+uint32_t lv_binfont_prefetch(lv_font_t * font, const char * txt)
+{
+    LV_ASSERT_NULL(font);
+    LV_ASSERT_NULL(txt);
+
+    if(font->get_glyph_bitmap != lazy_get_glyph_bitmap) return 0;
+
+    binfont_lazy_t * lazy = (binfont_lazy_t *)font->dsc;
+    if(lazy->cache == NULL) return 0;
+
+    uint32_t loaded_cnt = 0;
+    uint32_t i = 0;
+    while(txt[i] != '\0') {
+        uint32_t letter = lv_text_encoded_next(txt, &i);
+        lv_font_glyph_dsc_t g_dsc;
+        if(!font->get_glyph_dsc(font, &g_dsc, letter, 0)) continue;
+
+        bool created = false;
+        lv_cache_entry_t * entry = lazy_glyph_cache_acquire(lazy, g_dsc.gid.index, &created);
+        if(entry == NULL) continue;
+
+        lv_cache_release(lazy->cache, entry, NULL);
+        if(created) loaded_cnt++;
+    }
+
+    return loaded_cnt;
+}
+
 void lv_binfont_destroy(lv_font_t * font)
 {
     if(font == NULL) return;
@@ -121,6 +218,18 @@ void lv_binfont_destroy(lv_font_t * font)
     const lv_font_fmt_txt_dsc_t * dsc = font->dsc;
     if(dsc == NULL) return;
 
+    if(font->get_glyph_bitmap == lazy_get_glyph_bitmap) {
+        binfont_lazy_t * lazy = (binfont_lazy_t *)dsc;
+        if(lazy->cache) lv_cache_destroy(lazy->cache, NULL);
+        if(lazy->file_opened) lv_fs_close(&lazy->file);
+        lv_mutex_delete(&lazy->lock);
+        lv_free(lazy->glyph_offset);
+    }
+
+#if LV_USE_FONT_COMPRESSED && LV_FONT_COMPRESSED_CACHE_SIZE
+    if(dsc->bitmap_format != LV_FONT_FMT_TXT_PLAIN) lv_font_fmt_txt_glyph_cache_drop_all();
+#endif
+
     if(dsc->kern_classes == 0) {
         const lv_font_fmt_txt_kern_pair_t * kern_dsc = dsc->kern_dsc;
         if(NULL != kern_dsc) {
@@ -311,8 +420,8 @@ static int32_t load_cmaps(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, u
     return success ? cmaps_length : -1;
 }
 
-static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
-                          uint32_t start, uint32_t * glyph_offset, uint32_t loca_count, font_header_bin_t * header)
+static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint32_t start,
+                          uint32_t * glyph_offset, uint32_t loca_count, font_header_bin_t * header, binfont_lazy_t * lazy)
 {
     int32_t glyph_length = read_label(fp, start, "glyf");
     if(glyph_length < 0) {
@@ -390,6 +499,16 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
         }
     }
 
+    int nbits = header->advance_width_bits + 2 * header->xy_bits + 2 * header->wh_bits;
+
+    /*Only remember where the bitmaps are and read them on first use*/
+    if(lazy) {
+        glyph_offset[loca_count] = glyph_length;
+        lazy->glyph_start = start;
+        lazy->glyph_header_bits = nbits;
+        return glyph_length;
+    }
+
     uint8_t * glyph_bmp = (uint8_t *)lv_malloc(sizeof(uint8_t) * cur_bmp_size);
 
     font_dsc->glyph_bitmap = glyph_bmp;
@@ -397,19 +516,6 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
     cur_bmp_size = 0;
 
     for(unsigned int i = 1; i < loca_count; ++i) {
-        lv_fs_res_t res = lv_fs_seek(fp, start + glyph_offset[i], LV_FS_SEEK_SET);
-        if(res != LV_FS_RES_OK) {
-            return -1;
-        }
-        bit_iterator_t bit_it = init_bit_iterator(fp);
-
-        int nbits = header->advance_width_bits + 2 * header->xy_bits + 2 * header->wh_bits;
-
-        read_bits(&bit_it, nbits, &res);
-        if(res != LV_FS_RES_OK) {
-            return -1;
-        }
-
         if(glyph_dsc[i].box_w * glyph_dsc[i].box_h == 0) {
             continue;
         }
@@ -417,26 +523,8 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
         int next_offset = (i < loca_count - 1) ? glyph_offset[i + 1] : (uint32_t)glyph_length;
         int bmp_size = next_offset - glyph_offset[i] - nbits / 8;
 
-        if(nbits % 8 == 0) {  /*Fast path*/
-            if(lv_fs_read(fp, &glyph_bmp[cur_bmp_size], bmp_size, NULL) != LV_FS_RES_OK) {
-                return -1;
-            }
-        }
-        else {
-            for(int k = 0; k < bmp_size - 1; ++k) {
-                glyph_bmp[cur_bmp_size + k] = read_bits(&bit_it, 8, &res);
-                if(res != LV_FS_RES_OK) {
-                    return -1;
-                }
-            }
-            glyph_bmp[cur_bmp_size + bmp_size - 1] = read_bits(&bit_it, 8 - nbits % 8, &res);
-            if(res != LV_FS_RES_OK) {
-                return -1;
-            }
-
-            /*The last fragment should be on the MSB but read_bits() will place it to the LSB*/
-            glyph_bmp[cur_bmp_size + bmp_size - 1] = glyph_bmp[cur_bmp_size + bmp_size - 1] << (nbits % 8);
-
+        if(!read_glyph_bitmap(fp, start + glyph_offset[i], nbits, &glyph_bmp[cur_bmp_size], bmp_size)) {
+            return -1;
         }
 
         cur_bmp_size += bmp_size;
@@ -456,14 +544,17 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
  * `lv_binfont_destroy` will assume that all non-null pointers are allocated and
  * should be freed.
  */
-static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
+static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font, binfont_lazy_t * lazy)
 {
-    lv_font_fmt_txt_dsc_t * font_dsc = (lv_font_fmt_txt_dsc_t *)
-                                       lv_malloc(sizeof(lv_font_fmt_txt_dsc_t));
-
-    lv_memset(font_dsc, 0, sizeof(lv_font_fmt_txt_dsc_t));
-
-    font->dsc = font_dsc;
+    lv_font_fmt_txt_dsc_t * font_dsc;
+    if(lazy) {
+        font_dsc = &lazy->dsc;
+    }
+    else {
+        font_dsc = (lv_font_fmt_txt_dsc_t *)lv_malloc(sizeof(lv_font_fmt_txt_dsc_t));
+        lv_memset(font_dsc, 0, sizeof(lv_font_fmt_txt_dsc_t));
+        font->dsc = font_dsc;
+    }
 
     /*header*/
     int32_t header_length = read_label(fp, 0, "head");
@@ -479,7 +570,7 @@ static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
     font->base_line = -font_header.descent;
     font->line_height = font_header.ascent - font_header.descent;
     font->get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt;
-    font->get_glyph_bitmap = lv_font_get_bitmap_fmt_txt;
+    if(lazy == NULL) font->get_glyph_bitmap = lv_font_get_bitmap_fmt_txt;
     font->subpx = font_header.subpixels_mode;
     font->underline_position = (int8_t) font_header.underline_position;
     font->underline_thickness = (int8_t) font_header.underline_thickness;
@@ -538,9 +629,10 @@ static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
     /*glyph*/
     uint32_t glyph_start = loca_start + loca_length;
     int32_t glyph_length = load_glyph(
-                               fp, font_dsc, glyph_start, glyph_offset, loca_count, &font_header);
+                               fp, font_dsc, glyph_start, glyph_offset, loca_count, &font_header, lazy);
 
-    lv_free(glyph_offset);
+    if(lazy) lazy->glyph_offset = glyph_offset;
+    else lv_free(glyph_offset);
 
     if(glyph_length < 0) {
         return false;
@@ -656,3 +748,157 @@ int32_t load_kern(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t f
 
     return kern_length;
 }
+
+static bool read_glyph_bitmap(lv_fs_file_t * fp, uint32_t pos, int nbits, uint8_t * bmp, int bmp_size)
+{
+    lv_fs_res_t res = lv_fs_seek(fp, pos, LV_FS_SEEK_SET);
+    if(res != LV_FS_RES_OK) {
+        return false;
+    }
+    bit_iterator_t bit_it = init_bit_iterator(fp);
+
+    /*Skip the metrics*/
+    read_bits(&bit_it, nbits, &res);
+    if(res != LV_FS_RES_OK) {
+        return false;
+    }
+
+    if(nbits % 8 == 0) {  /*Fast path*/
+        if(lv_fs_read(fp, bmp, bmp_size, NULL) != LV_FS_RES_OK) {
+            return false;
+        }
+    }
+    else {
+        for(int k = 0; k < bmp_size - 1; ++k) {
+            bmp[k] = read_bits(&bit_it, 8, &res);
+            if(res != LV_FS_RES_OK) {
+                return false;
+            }
+        }
+        bmp[bmp_size - 1] = read_bits(&bit_it, 8 - nbits % 8, &res);
+        if(res != LV_FS_RES_OK) {
+            return false;
+        }
+
+        /*The last fragment should be on the MSB but read_bits() will place it to the LSB*/
+        bmp[bmp_size - 1] = bmp[bmp_size - 1] << (nbits % 8);
+    }
+
+    return true;
+}
+
+static const void * lazy_get_glyph_bitmap(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf_t * draw_buf)
+{
+    binfont_lazy_t * lazy = (binfont_lazy_t *)g_dsc->resolved_font->dsc;
+    uint32_t gid = g_dsc->gid.index;
+    if(!gid) return NULL;
+
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &lazy->dsc.glyph_dsc[gid];
+    if(gdsc->box_w * gdsc->box_h == 0) return NULL;
+
+    lv_cache_entry_t * entry = lazy_glyph_cache_acquire(lazy, gid, NULL);
+    if(entry) {
+        /*The entry can be evicted by an other draw unit so copy the glyph to the draw buffer*/
+        binfont_glyph_cache_data_t * data = lv_cache_entry_get_data(entry);
+        lv_memcpy(draw_buf->data, data->bitmap, data->slot.size);
+        lv_cache_release(lazy->cache, entry, NULL);
+        return draw_buf;
+    }
+
+    /*Not cached: too large for the cache or out of memory*/
+    if(!lazy_glyph_load(lazy, gid, draw_buf->data)) return NULL;
+
+    return draw_buf;
+}
+
+static bool lazy_glyph_load(binfont_lazy_t * lazy, uint32_t gid, uint8_t * bitmap_out)
+{
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &lazy->dsc.glyph_dsc[gid];
+    uint32_t ofs = lazy->glyph_offset[gid];
+    int bmp_size = (int)(lazy->glyph_offset[gid + 1] - ofs - lazy->glyph_header_bits / 8);
+    if(bmp_size <= 0) return false;
+
+    /*The decompressor can look one byte ahead*/
+    uint8_t * bmp = lv_malloc_zeroed(bmp_size + 1);
+    if(bmp == NULL) return false;
+
+    lv_mutex_lock(&lazy->lock);
+    bool res = read_glyph_bitmap(&lazy->file, lazy->glyph_start + ofs, lazy->glyph_header_bits, bmp, bmp_size);
+    lv_mutex_unlock(&lazy->lock);
+
+    if(res) res = lv_font_fmt_txt_glyph_bitmap_decode(&lazy->dsc, gdsc, bmp, bitmap_out);
+    else LV_LOG_WARN("Couldn't read the bitmap of glyph %" LV_PRIu32, gid);
+
+    lv_free(bmp);
+    return res;
+}
+
+/**
+ * Get the cached A8 bitmap of a glyph, loading it if needed
+ * @param lazy      the lazy font
+ * @param gid       index of the glyph having a non-zero size
+ * @param created   set to true when the glyph was loaded now. Can be NULL.
+ * @return          the cache entry to release or NULL if the glyph can't be cached
+ */
+static lv_cache_entry_t * lazy_glyph_cache_acquire(binfont_lazy_t * lazy, uint32_t gid, bool * created)
+{
+    if(lazy->cache == NULL) return NULL;
+
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &lazy->dsc.glyph_dsc[gid];
+    uint32_t stride = lv_draw_buf_width_to_stride(gdsc->box_w, LV_COLOR_FORMAT_A8);
+    uint32_t data_size = stride * gdsc->box_h;
+    if(data_size == 0 || data_size > lv_cache_get_max_size(lazy->cache, NULL)) return NULL;
+
+    binfont_glyph_cache_data_t search_key;
+    search_key.slot.size = data_size;
+    search_key.lazy = lazy;
+    search_key.gid = gid;
+    search_key.bitmap = NULL;
+
+    bool created_local = false;
+    lv_cache_entry_t * entry = lv_cache_acquire_or_create(lazy->cache, &search_key, &created_local);
+    if(created) *created = created_local;
+    return entry;
+}
+
+static lv_cache_compare_res_t lazy_cache_compare_cb(const binfont_glyph_cache_data_t * lhs,
+                                                    const binfont_glyph_cache_data_t * rhs)
+{
+    if(lhs->gid != rhs->gid) return lhs->gid > rhs->gid ? 1 : -1;
+
+    return 0;
+}
+
+/**
+ * Read the glyph of a new cache entry
+ * @param data          the cache entry with the key already set
+ * @param user_data     pointer to a `bool` to set to true when the glyph is loaded
+ * @return              true: the glyph is loaded; false: out of memory or read error
+ */
+static bool lazy_cache_create_cb(binfont_glyph_cache_data_t * data, void * user_data)
+{
+    data->bitmap = lv_malloc_zeroed(data->slot.size);
+    if(data->bitmap == NULL) return false;
+
+    if(!lazy_glyph_load(data->lazy, data->gid, data->bitmap)) {
+        lv_free(data->bitmap);
+        data->bitmap = NULL;
+        return false;
+    }
+
+    *(bool *)user_data = true;
+    return true;
+}
+
+static void lazy_cache_free_cb(binfont_glyph_cache_data_t * data, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_free(data->bitmap);
+}
+
+static uint32_t lazy_cache_hash_cb(const binfont_glyph_cache_data_t * key)
+{
+    /*The cache belongs to one font so the glyph index is enough*/
+    return lv_utils_fnv1a(LV_UTILS_FNV1A_INIT, &key->gid, sizeof(key->gid));
+}
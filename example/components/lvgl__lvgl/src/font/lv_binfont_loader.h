@@ -44,9 +44,29 @@ lv_font_t * lv_binfont_create(const char * path);
 lv_font_t * lv_binfont_create_from_buffer(void * buffer, uint32_t size);
 #endif
 
+/**
+ * Loads a `lv_font_t` object from a binary font file but reads only the metrics at load time.
+ * The file is kept open and the bitmap of a glyph is read when it's drawn the first time.
+ * The loaded glyphs are kept in an LRU cache of the font.
+ * @param path          path to font file
+ * @param cache_size    size of the glyph cache in bytes. With 0 the glyphs are read on every draw.
+ *                      It's split between `LV_CACHE_SHARD_CNT` shards if that is larger than 1.
+ * @return              pointer to the loaded font or NULL on error
+ */
+lv_font_t * lv_binfont_create_lazy(const char * path, uint32_t cache_size);
+
+/**
+ * Load the glyphs of the letters of a text into the cache of a font created
+ * by `lv_binfont_create_lazy()`. E.g. call it with the texts of a screen before showing it.
+ * @param font          a font created by `lv_binfont_create_lazy()`
+ * @param txt           UTF-8 text with the letters to load
+ * @return              number of glyphs loaded now (the cached ones are not counted)
+ */
+uint32_t lv_binfont_prefetch(lv_font_t * font, const char * txt);
+
 /**
  * Frees the memory allocated by the `lv_binfont_create()` function
- * @param font          lv_font_t object created by the lv_binfont_create function
+ * @param font          lv_font_t object created by the lv_binfont_create or lv_binfont_create_lazy function
  */
 void lv_binfont_destroy(lv_font_t * font);
 
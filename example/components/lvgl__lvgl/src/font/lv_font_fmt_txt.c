@@ -19,7 +19,10 @@
  *      DEFINES
  *********************/
 #if LV_USE_FONT_COMPRESSED
-    #define font_rle LV_GLOBAL_DEFAULT()->font_fmt_rle
+#if LV_FONT_COMPRESSED_CACHE_SIZE
+    #define glyph_cache LV_GLOBAL_DEFAULT()->font_fmt_glyph_cache
+    #define CACHE_NAME  "FONT_GLYPH"
+#endif
 #endif /*LV_USE_FONT_COMPRESSED*/
 
 /**********************
@@ -41,10 +44,17 @@ static int kern_pair_16_compare(const void * ref, const void * element);
 
 #if LV_USE_FONT_COMPRESSED
     static void decompress(const uint8_t * in, uint8_t * out, int32_t w, int32_t h, uint8_t bpp, bool prefilter);
-    static inline void decompress_line(uint8_t * out, int32_t w);
+    static inline void decompress_line(lv_font_fmt_rle_t * rle, uint8_t * out, int32_t w);
     static inline uint8_t get_bits(const uint8_t * in, uint32_t bit_pos, uint8_t len);
-    static inline void rle_init(const uint8_t * in,  uint8_t bpp);
-    static inline uint8_t rle_next(void);
+    static inline void rle_init(lv_font_fmt_rle_t * rle, const uint8_t * in,  uint8_t bpp);
+    static inline uint8_t rle_next(lv_font_fmt_rle_t * rle);
+#if LV_FONT_COMPRESSED_CACHE_SIZE
+    static lv_cache_compare_res_t glyph_cache_compare_cb(const lv_font_fmt_txt_glyph_cache_data_t * lhs,
+                                                         const lv_font_fmt_txt_glyph_cache_data_t * rhs);
+    static bool glyph_cache_create_cb(lv_font_fmt_txt_glyph_cache_data_t * data, void * user_data);
+    static void glyph_cache_free_cb(lv_font_fmt_txt_glyph_cache_data_t * data, void * user_data);
+    static uint32_t glyph_cache_hash_cb(const lv_font_fmt_txt_glyph_cache_data_t * key);
+#endif
 #endif /*LV_USE_FONT_COMPRESSED*/
 
 /**********************
@@ -75,6 +85,44 @@ static const uint8_t opa2_table[4] = {0, 85, 170, 255};
  *   GLOBAL FUNCTIONS
  **********************/
 
+#if LV_USE_FONT_COMPRESSED && LV_FONT_COMPRESSED_CACHE_SIZE
+void lv_font_fmt_txt_glyph_cache_init(void)
+{
+    if(glyph_cache.cache != NULL) return;
+
+    /*All the draw units use it so shard it like the image caches*/
+    glyph_cache.cache = lv_cache_create_sharded(&lv_cache_class_lru_rb_size,
+    sizeof(lv_font_fmt_txt_glyph_cache_data_t), LV_FONT_COMPRESSED_CACHE_SIZE, (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t) glyph_cache_compare_cb,
+        .create_cb = (lv_cache_create_cb_t) glyph_cache_create_cb,
+        .free_cb = (lv_cache_free_cb_t) glyph_cache_free_cb,
+        .hash_cb = (lv_cache_hash_cb_t) glyph_cache_hash_cb,
+    }, LV_CACHE_SHARD_CNT);
+    lv_cache_set_name(glyph_cache.cache, CACHE_NAME);
+}
+
+void lv_font_fmt_txt_glyph_cache_deinit(void)
+{
+    if(glyph_cache.cache == NULL) return;
+
+    lv_cache_destroy(glyph_cache.cache, NULL);
+    glyph_cache.cache = NULL;
+}
+
+void lv_font_fmt_txt_glyph_cache_drop_all(void)
+{
+    if(glyph_cache.cache == NULL) return;
+
+    lv_cache_drop_all(glyph_cache.cache, NULL);
+}
+
+void lv_font_fmt_txt_glyph_cache_resize(uint32_t new_size)
+{
+    lv_cache_set_max_size(glyph_cache.cache, new_size, NULL);
+    lv_cache_reserve(glyph_cache.cache, 0, NULL);
+}
+#endif /*LV_USE_FONT_COMPRESSED && LV_FONT_COMPRESSED_CACHE_SIZE*/
+
 const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf_t * draw_buf)
 {
     const lv_font_t * font = g_dsc->resolved_font;
@@ -89,8 +137,40 @@ const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf
     int32_t gsize = (int32_t) gdsc->box_w * gdsc->box_h;
     if(gsize == 0) return NULL;
 
+#if LV_USE_FONT_COMPRESSED && LV_FONT_COMPRESSED_CACHE_SIZE
+    if(fdsc->bitmap_format != LV_FONT_FMT_TXT_PLAIN) {
+        uint32_t stride = lv_draw_buf_width_to_stride(gdsc->box_w, LV_COLOR_FORMAT_A8);
+        uint32_t data_size = stride * gdsc->box_h;
+        if(data_size <= lv_cache_get_max_size(glyph_cache.cache, NULL)) {
+            lv_font_fmt_txt_glyph_cache_data_t search_key;
+            search_key.slot.size = data_size;
+            search_key.font_dsc = fdsc;
+            search_key.gid = gid;
+            search_key.bitmap = NULL;
+
+            lv_cache_entry_t * cache_entry = lv_cache_acquire_or_create(glyph_cache.cache, &search_key, NULL);
+            if(cache_entry) {
+                /*The entry can be evicted by an other draw unit so copy the glyph to the draw buffer*/
+                lv_font_fmt_txt_glyph_cache_data_t * cache_data = lv_cache_entry_get_data(cache_entry);
+                lv_memcpy(bitmap_out, cache_data->bitmap, data_size);
+                lv_cache_release(glyph_cache.cache, cache_entry, NULL);
+                return draw_buf;
+            }
+        }
+    }
+#endif /*LV_USE_FONT_COMPRESSED && LV_FONT_COMPRESSED_CACHE_SIZE*/
+
+    if(!lv_font_fmt_txt_glyph_bitmap_decode(fdsc, gdsc, &fdsc->glyph_bitmap[gdsc->bitmap_index], bitmap_out)) {
+        return NULL;
+    }
+
+    return draw_buf;
+}
+
+bool lv_font_fmt_txt_glyph_bitmap_decode(const lv_font_fmt_txt_dsc_t * fdsc, const lv_font_fmt_txt_glyph_dsc_t * gdsc,
+                                         const uint8_t * bitmap_in, uint8_t * bitmap_out)
+{
     if(fdsc->bitmap_format == LV_FONT_FMT_TXT_PLAIN) {
-        const uint8_t * bitmap_in = &fdsc->glyph_bitmap[gdsc->bitmap_index];
         uint8_t * bitmap_out_tmp = bitmap_out;
         int32_t i = 0;
         int32_t x, y;
@@ -146,23 +226,21 @@ const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf
                 bitmap_out_tmp += stride;
             }
         }
-        return draw_buf;
+        return true;
     }
     /*Handle compressed bitmap*/
     else {
 #if LV_USE_FONT_COMPRESSED
         bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED;
-        decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], bitmap_out, gdsc->box_w, gdsc->box_h,
-                   (uint8_t)fdsc->bpp, prefilter);
-        return draw_buf;
+        decompress(bitmap_in, bitmap_out, gdsc->box_w, gdsc->box_h, (uint8_t)fdsc->bpp, prefilter);
+        return true;
 #else /*!LV_USE_FONT_COMPRESSED*/
+        LV_UNUSED(bitmap_in);
+        LV_UNUSED(bitmap_out);
         LV_LOG_WARN("Compressed fonts is used but LV_USE_FONT_COMPRESSED is not enabled in lv_conf.h");
-        return NULL;
+        return false;
 #endif
     }
-
-    /*If not returned earlier then the letter is not found in this font*/
-    return NULL;
 }
 
 bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
@@ -367,7 +445,9 @@ static void decompress(const uint8_t * in, uint8_t * out, int32_t w, int32_t h,
             return;
     }
 
-    rle_init(in, bpp);
+    /*The state is on the stack so the draw units can decompress glyphs in parallel*/
+    lv_font_fmt_rle_t rle;
+    rle_init(&rle, in, bpp);
 
     uint8_t * line_buf1 = lv_malloc(w);
 
@@ -377,7 +457,7 @@ static void decompress(const uint8_t * in, uint8_t * out, int32_t w, int32_t h,
         line_buf2 = lv_malloc(w);
     }
 
-    decompress_line(line_buf1, w);
+    decompress_line(&rle, line_buf1, w);
 
     int32_t y;
     int32_t x;
@@ -390,7 +470,7 @@ static void decompress(const uint8_t * in, uint8_t * out, int32_t w, int32_t h,
 
     for(y = 1; y < h; y++) {
         if(prefilter) {
-            decompress_line(line_buf2, w);
+            decompress_line(&rle, line_buf2, w);
 
             for(x = 0; x < w; x++) {
                 line_buf1[x] = line_buf2[x] ^ line_buf1[x];
@@ -398,7 +478,7 @@ static void decompress(const uint8_t * in, uint8_t * out, int32_t w, int32_t h,
             }
         }
         else {
-            decompress_line(line_buf1, w);
+            decompress_line(&rle, line_buf1, w);
 
             for(x = 0; x < w; x++) {
                 out[x] = opa_table[line_buf1[x]];
@@ -411,16 +491,64 @@ static void decompress(const uint8_t * in, uint8_t * out, int32_t w, int32_t h,
     lv_free(line_buf2);
 }
 
+#if LV_FONT_COMPRESSED_CACHE_SIZE
+static lv_cache_compare_res_t glyph_cache_compare_cb(const lv_font_fmt_txt_glyph_cache_data_t * lhs,
+                                                     const lv_font_fmt_txt_glyph_cache_data_t * rhs)
+{
+    if(lhs->font_dsc != rhs->font_dsc) return lhs->font_dsc > rhs->font_dsc ? 1 : -1;
+    if(lhs->gid != rhs->gid) return lhs->gid > rhs->gid ? 1 : -1;
+
+    return 0;
+}
+
+/**
+ * Decompress the glyph of a new cache entry
+ * @param data          the cache entry with the key already set
+ * @param user_data     unused
+ * @return              true: the glyph is decompressed; false: out of memory
+ */
+static bool glyph_cache_create_cb(lv_font_fmt_txt_glyph_cache_data_t * data, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    const lv_font_fmt_txt_dsc_t * fdsc = data->font_dsc;
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[data->gid];
+
+    data->bitmap = lv_malloc_zeroed(data->slot.size);
+    if(data->bitmap == NULL) return false;
+
+    bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED;
+    decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], data->bitmap, gdsc->box_w, gdsc->box_h,
+               (uint8_t)fdsc->bpp, prefilter);
+
+    return true;
+}
+
+static void glyph_cache_free_cb(lv_font_fmt_txt_glyph_cache_data_t * data, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_free(data->bitmap);
+}
+
+static uint32_t glyph_cache_hash_cb(const lv_font_fmt_txt_glyph_cache_data_t * key)
+{
+    uint32_t hash = lv_utils_fnv1a(LV_UTILS_FNV1A_INIT, &key->font_dsc, sizeof(key->font_dsc));
+    return lv_utils_fnv1a(hash, &key->gid, sizeof(key->gid));
+}
+#endif /*LV_FONT_COMPRESSED_CACHE_SIZE*/
+
 /**
  * Decompress one line. Store one pixel per byte
+ * @param rle the state of the decompression
  * @param out output buffer
  * @param w width of the line in pixel count
  */
-static inline void decompress_line(uint8_t * out, int32_t w)
+static inline void decompress_line(lv_font_fmt_rle_t * rle, uint8_t * out, int32_t w)
 {
     int32_t i;
     for(i = 0; i < w; i++) {
-        out[i] = rle_next();
+        out[i] = rle_next(rle);
     }
 }
 
@@ -466,9 +594,8 @@ static inline uint8_t get_bits(const uint8_t * in, uint32_t bit_pos, uint8_t len
     }
 }
 
-static inline void rle_init(const uint8_t * in,  uint8_t bpp)
+static inline void rle_init(lv_font_fmt_rle_t * rle, const uint8_t * in,  uint8_t bpp)
 {
-    lv_font_fmt_rle_t * rle = &font_rle;
     rle->in = in;
     rle->bpp = bpp;
     rle->state = RLE_STATE_SINGLE;
@@ -477,11 +604,10 @@ static inline void rle_init(const uint8_t * in,  uint8_t bpp)
     rle->count = 0;
 }
 
-static inline uint8_t rle_next(void)
+static inline uint8_t rle_next(lv_font_fmt_rle_t * rle)
 {
     uint8_t v = 0;
     uint8_t ret = 0;
-    lv_font_fmt_rle_t * rle = &font_rle;
 
     if(rle->state == RLE_STATE_SINGLE) {
         ret = get_bits(rle->in, rle->rdp, rle->bpp);
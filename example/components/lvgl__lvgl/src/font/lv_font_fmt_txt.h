@@ -209,6 +209,14 @@ const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf
 bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
                                    uint32_t unicode_letter_next);
 
+#if LV_USE_FONT_COMPRESSED && LV_FONT_COMPRESSED_CACHE_SIZE
+/**
+ * Set the max. memory used by the decompressed glyphs of the compressed fonts.
+ * @param new_size      the new size in bytes, 0 to disable the cache
+ */
+void lv_font_fmt_txt_glyph_cache_resize(uint32_t new_size);
+#endif
+
 /**********************
  *      MACROS
  **********************/
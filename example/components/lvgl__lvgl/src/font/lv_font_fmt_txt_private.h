@@ -15,6 +15,8 @@ extern "C" {
  *********************/
 
 #include "lv_font_fmt_txt.h"
+#include "../misc/cache/lv_cache.h"
+#include "../osal/lv_os.h"
 
 /*********************
  *      DEFINES
@@ -39,12 +41,56 @@ typedef struct {
     uint8_t count;
     lv_font_fmt_rle_state_t state;
 } lv_font_fmt_rle_t;
-#endif
+
+#if LV_FONT_COMPRESSED_CACHE_SIZE
+typedef struct {
+    lv_cache_slot_size_t slot;
+
+    const lv_font_fmt_txt_dsc_t * font_dsc;     /**< The font the glyph belongs to*/
+    uint32_t gid;                               /**< Index of the glyph in `font_dsc->glyph_dsc`*/
+    uint8_t * bitmap;                           /**< The decompressed A8 bitmap with the stride of the draw buffers*/
+} lv_font_fmt_txt_glyph_cache_data_t;
+
+typedef struct {
+    lv_cache_t * cache;
+} lv_font_fmt_txt_glyph_cache_t;
+#endif /*LV_FONT_COMPRESSED_CACHE_SIZE*/
+#endif /*LV_USE_FONT_COMPRESSED*/
 
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
+#if LV_USE_FONT_COMPRESSED && LV_FONT_COMPRESSED_CACHE_SIZE
+/**
+ * Create the cache of the decompressed glyphs. Called internally.
+ */
+void lv_font_fmt_txt_glyph_cache_init(void);
+
+/**
+ * Free the cached glyphs and delete the cache. Called internally.
+ */
+void lv_font_fmt_txt_glyph_cache_deinit(void);
+
+/**
+ * Free all the cached glyphs. Called when a compressed font is deleted
+ * as its descriptor's address can be reused by a new font.
+ */
+void lv_font_fmt_txt_glyph_cache_drop_all(void);
+#endif
+
+/**
+ * Convert the bitmap of a glyph to A8 format with the stride of the draw buffers.
+ * Used by the font loaders which don't keep the bitmaps in `fdsc->glyph_bitmap`.
+ * @param fdsc          the font descriptor telling the bpp and compression of the bitmap
+ * @param gdsc          the descriptor of the glyph
+ * @param bitmap_in     the bitmap of the glyph as stored in the font
+ * @param bitmap_out    buffer for the A8 bitmap
+ * @return              true: converted; false: unsupported format
+ */
+bool lv_font_fmt_txt_glyph_bitmap_decode(const lv_font_fmt_txt_dsc_t * fdsc, const lv_font_fmt_txt_glyph_dsc_t * gdsc,
+                                         const uint8_t * bitmap_in, uint8_t * bitmap_out);
+
 /**********************
  *      MACROS
  **********************/
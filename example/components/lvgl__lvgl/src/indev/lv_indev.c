@@ -1437,6 +1437,10 @@ static void indev_proc_pointer_diff(lv_indev_t * indev)
 
 static lv_obj_t * pointer_search_obj(lv_display_t * disp, lv_point_t * p)
 {
+#if LV_INDEV_HIT_INDEX_CELL_SIZE
+    if(lv_indev_hit_index_search(disp, p, &indev_obj_act)) return indev_obj_act;
+#endif
+
     indev_obj_act = lv_indev_search_obj(lv_display_get_layer_sys(disp), p);
     if(indev_obj_act) return indev_obj_act;
 
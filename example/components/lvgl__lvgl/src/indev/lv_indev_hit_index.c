@@ -0,0 +1,391 @@
+/**
+ * @file lv_indev_hit_index.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_indev_hit_index_private.h"
+#include "lv_indev.h"
+#include "../display/lv_display_private.h"
+#include "../core/lv_obj_private.h"
+#include "../core/lv_obj_draw_private.h"
+#include "../misc/lv_area_private.h"
+#include "../misc/lv_profiler.h"
+#include "../stdlib/lv_mem.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define CELL_SIZE LV_INDEV_HIT_INDEX_CELL_SIZE
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_INDEV_HIT_INDEX_CELL_SIZE
+    static bool index_update(lv_display_t * disp, lv_indev_hit_index_t * index);
+    static bool grid_reset(lv_indev_hit_index_t * index, int32_t hor_res, int32_t ver_res);
+    static void grid_free(lv_indev_hit_index_t * index);
+    static bool cells_update(lv_display_t * disp, lv_indev_hit_index_t * index, const lv_area_t * cell_area);
+    static bool collect(lv_indev_hit_index_t * index, lv_obj_t * obj, const lv_area_t * clip);
+    static bool item_add(lv_indev_hit_index_t * index, lv_obj_t * obj, const lv_area_t * area, bool subtree);
+    static void obj_get_index_area(const lv_indev_hit_index_t * index, const lv_obj_t * obj, lv_area_t * area);
+    static void dirty_add(lv_indev_hit_index_t * index, const lv_area_t * cell_area);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+#if LV_INDEV_HIT_INDEX_CELL_SIZE
+
+void lv_indev_hit_index_invalidate_obj(const lv_obj_t * obj)
+{
+    lv_display_t * disp = lv_obj_get_display(obj);
+    if(disp == NULL || disp->hit_index == NULL) return;
+
+    /*It will be rebuilt anyway*/
+    lv_indev_hit_index_t * index = disp->hit_index;
+    if(!index->valid) return;
+
+    /*Only the active screen and the layers are indexed*/
+    lv_obj_t * scr = lv_obj_get_screen(obj);
+    if(scr != index->act_scr && scr != disp->top_layer && scr != disp->sys_layer && scr != disp->bottom_layer) return;
+
+    lv_area_t area;
+    obj_get_index_area(index, obj, &area);
+
+    lv_area_t disp_area;
+    lv_area_set(&disp_area, 0, 0, index->hor_res - 1, index->ver_res - 1);
+    if(!lv_area_intersect(&area, &area, &disp_area)) return;
+
+    lv_area_t cell_area;
+    lv_area_set(&cell_area, area.x1 / CELL_SIZE, area.y1 / CELL_SIZE, area.x2 / CELL_SIZE, area.y2 / CELL_SIZE);
+    dirty_add(index, &cell_area);
+}
+
+bool lv_indev_hit_index_search(lv_display_t * disp, lv_point_t * point, lv_obj_t ** obj_res)
+{
+    int32_t hor_res = lv_display_get_horizontal_resolution(disp);
+    int32_t ver_res = lv_display_get_vertical_resolution(disp);
+
+    /*Only the display area is indexed*/
+    if(point->x < 0 || point->y < 0 || point->x >= hor_res || point->y >= ver_res) return false;
+
+    if(disp->hit_index == NULL) {
+        disp->hit_index = lv_malloc_zeroed(sizeof(lv_indev_hit_index_t));
+        LV_ASSERT_MALLOC(disp->hit_index);
+        if(disp->hit_index == NULL) return false;
+    }
+
+    lv_indev_hit_index_t * index = disp->hit_index;
+    if(!index_update(disp, index)) return false;
+
+    lv_indev_hit_index_cell_t * cell = &index->cells[(point->y / CELL_SIZE) * index->col_cnt + point->x / CELL_SIZE];
+    uint32_t i;
+    for(i = 0; i < cell->item_cnt; i++) {
+        lv_indev_hit_index_item_t * item = &cell->items[i];
+        if(!lv_area_is_point_on(&item->area, point, 0)) continue;
+
+        lv_obj_t * found;
+        if(item->subtree) found = lv_indev_search_obj(item->obj, point);
+        else found = lv_obj_hit_test(item->obj, point) ? item->obj : NULL;
+
+        if(found) {
+            *obj_res = found;
+            return true;
+        }
+    }
+
+    *obj_res = NULL;
+    return true;
+}
+
+void lv_indev_hit_index_delete(lv_display_t * disp)
+{
+    lv_indev_hit_index_t * index = disp->hit_index;
+    if(index == NULL) return;
+
+    grid_free(index);
+    lv_free(index);
+    disp->hit_index = NULL;
+}
+
+#endif /*LV_INDEV_HIT_INDEX_CELL_SIZE*/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_INDEV_HIT_INDEX_CELL_SIZE
+
+/**
+ * Update the outdated cells of the index, or all the cells if the screen or the resolution changed
+ * @param disp      pointer to a display
+ * @param index     pointer to the hit index of `disp`
+ * @return          false: out of memory
+ */
+static bool index_update(lv_display_t * disp, lv_indev_hit_index_t * index)
+{
+    int32_t hor_res = lv_display_get_horizontal_resolution(disp);
+    int32_t ver_res = lv_display_get_vertical_resolution(disp);
+
+    if(index->valid && index->act_scr == disp->act_scr && index->hor_res == hor_res && index->ver_res == ver_res) {
+        if(index->dirty_cnt == 0) return true;
+    }
+    else {
+        if(!grid_reset(index, hor_res, ver_res)) return false;
+        index->act_scr = disp->act_scr;
+    }
+
+    LV_PROFILER_BEGIN;
+
+    /*Stay invalid on error to rebuild everything on the next search*/
+    index->valid = 0;
+
+    uint32_t i;
+    for(i = 0; i < index->dirty_cnt; i++) {
+        if(!cells_update(disp, index, &index->dirty_areas[i])) {
+            LV_PROFILER_END;
+            return false;
+        }
+    }
+
+    index->dirty_cnt = 0;
+    index->valid = 1;
+
+    LV_PROFILER_END;
+    return true;
+}
+
+/**
+ * Set the size of the grid for a resolution and mark all cells outdated
+ * @param index     pointer to a hit index
+ * @param hor_res   horizontal resolution of the display
+ * @param ver_res   vertical resolution of the display
+ * @return          false: out of memory
+ */
+static bool grid_reset(lv_indev_hit_index_t * index, int32_t hor_res, int32_t ver_res)
+{
+    int32_t col_cnt = (hor_res + CELL_SIZE - 1) / CELL_SIZE;
+    int32_t row_cnt = (ver_res + CELL_SIZE - 1) / CELL_SIZE;
+
+    if(index->cells == NULL || index->col_cnt != col_cnt || index->row_cnt != row_cnt) {
+        grid_free(index);
+        index->cells = lv_malloc_zeroed(col_cnt * row_cnt * sizeof(lv_indev_hit_index_cell_t));
+        LV_ASSERT_MALLOC(index->cells);
+        if(index->cells == NULL) return false;
+        index->col_cnt = col_cnt;
+        index->row_cnt = row_cnt;
+    }
+
+    index->hor_res = hor_res;
+    index->ver_res = ver_res;
+
+    lv_area_set(&index->dirty_areas[0], 0, 0, col_cnt - 1, row_cnt - 1);
+    index->dirty_cnt = 1;
+    return true;
+}
+
+static void grid_free(lv_indev_hit_index_t * index)
+{
+    if(index->cells) {
+        int32_t i;
+        for(i = 0; i < index->col_cnt * index->row_cnt; i++) {
+            lv_free(index->cells[i].items);
+        }
+        lv_free(index->cells);
+    }
+
+    index->cells = NULL;
+    index->col_cnt = 0;
+    index->row_cnt = 0;
+}
+
+/**
+ * Collect the items of some cells again
+ * @param disp      pointer to a display
+ * @param index     pointer to the hit index of `disp`
+ * @param cell_area the cells to update, in cell units
+ * @return          false: out of memory
+ */
+static bool cells_update(lv_display_t * disp, lv_indev_hit_index_t * index, const lv_area_t * cell_area)
+{
+    int32_t row;
+    int32_t col;
+    for(row = cell_area->y1; row <= cell_area->y2; row++) {
+        for(col = cell_area->x1; col <= cell_area->x2; col++) {
+            index->cells[row * index->col_cnt + col].item_cnt = 0;
+        }
+    }
+
+    /*The items are clipped to the cells so they are added only to these cells*/
+    lv_area_t clip;
+    lv_area_set(&clip, cell_area->x1 * CELL_SIZE, cell_area->y1 * CELL_SIZE,
+                (cell_area->x2 + 1) * CELL_SIZE - 1, (cell_area->y2 + 1) * CELL_SIZE - 1);
+
+    /*Collect the objects in the same order as the layers are searched*/
+    lv_obj_t * roots[4] = {disp->sys_layer, disp->top_layer, disp->act_scr, disp->bottom_layer};
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        if(roots[i] == NULL) continue;
+        if(!collect(index, roots[i], &clip)) return false;
+    }
+
+    return true;
+}
+
+/**
+ * Add the items of an object and its children in the order `lv_indev_search_obj()` tests them
+ * @param index     pointer to a hit index
+ * @param obj       pointer to an object
+ * @param clip      the area where the point can be found on `obj`
+ * @return          false: out of memory
+ */
+static bool collect(lv_indev_hit_index_t * index, lv_obj_t * obj, const lv_area_t * clip)
+{
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return true;
+
+    /*The point needs to be transformed so let `lv_indev_search_obj()` handle the whole subtree*/
+    if(lv_obj_get_layer_type(obj) == LV_LAYER_TYPE_TRANSFORM) {
+        return item_add(index, obj, clip, true);
+    }
+
+    /*The children are searched only if the point is on the object*/
+    lv_area_t obj_coords = obj->coords;
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) {
+        int32_t ext_draw_size = lv_obj_get_ext_draw_size(obj);
+        lv_area_increase(&obj_coords, ext_draw_size, ext_draw_size);
+    }
+
+    lv_area_t child_clip;
+    if(lv_area_intersect(&child_clip, clip, &obj_coords)) {
+        int32_t i;
+        int32_t child_cnt = (int32_t)lv_obj_get_child_count(obj);
+        for(i = child_cnt - 1; i >= 0; i--) {
+            if(!collect(index, obj->spec_attr->children[i], &child_clip)) return false;
+        }
+    }
+
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_CLICKABLE)) {
+        lv_area_t click_area;
+        lv_obj_get_click_area(obj, &click_area);
+        if(lv_area_intersect(&click_area, &click_area, clip)) {
+            return item_add(index, obj, &click_area, false);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Append an item to the cells it overlaps
+ * @param index     pointer to a hit index
+ * @param obj       the object to hit test
+ * @param area      the area where `obj` can be hit, inside the cells being updated
+ * @param subtree   true: search the subtree of `obj` too
+ * @return          false: out of memory
+ */
+static bool item_add(lv_indev_hit_index_t * index, lv_obj_t * obj, const lv_area_t * area, bool subtree)
+{
+    int32_t row;
+    int32_t col;
+    for(row = area->y1 / CELL_SIZE; row <= area->y2 / CELL_SIZE; row++) {
+        for(col = area->x1 / CELL_SIZE; col <= area->x2 / CELL_SIZE; col++) {
+            lv_indev_hit_index_cell_t * cell = &index->cells[row * index->col_cnt + col];
+            if(cell->item_cnt == cell->item_size) {
+                uint32_t new_size = cell->item_size ? cell->item_size * 2 : 4;
+                lv_indev_hit_index_item_t * new_items = lv_realloc(cell->items,
+                                                                   new_size * sizeof(lv_indev_hit_index_item_t));
+                LV_ASSERT_MALLOC(new_items);
+                if(new_items == NULL) return false;
+                cell->items = new_items;
+                cell->item_size = new_size;
+            }
+
+            lv_indev_hit_index_item_t * item = &cell->items[cell->item_cnt];
+            item->obj = obj;
+            item->area = *area;
+            item->subtree = subtree;
+            cell->item_cnt++;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Get the area where the items of an object and its children can be in the index
+ * @param index     pointer to a hit index
+ * @param obj       pointer to an object
+ * @param area      store the area here
+ */
+static void obj_get_index_area(const lv_indev_hit_index_t * index, const lv_obj_t * obj, lv_area_t * area)
+{
+    /*The item of a transformed object covers the area of its parent*/
+    if(lv_obj_get_layer_type(obj) == LV_LAYER_TYPE_TRANSFORM) {
+        if(obj->parent) obj_get_index_area(index, obj->parent, area);
+        else lv_area_set(area, 0, 0, index->hor_res - 1, index->ver_res - 1);
+        return;
+    }
+
+    /*The children are clipped to the object, but the object itself can be clicked outside*/
+    int32_t ext = obj->spec_attr ? obj->spec_attr->ext_click_pad : 0;
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) {
+        ext = LV_MAX(ext, lv_obj_get_ext_draw_size(obj));
+    }
+
+    *area = obj->coords;
+    lv_area_increase(area, ext, ext);
+}
+
+/**
+ * Mark some cells outdated
+ * @param index     pointer to a hit index
+ * @param cell_area the cells to mark, in cell units
+ */
+static void dirty_add(lv_indev_hit_index_t * index, const lv_area_t * cell_area)
+{
+    uint32_t i;
+    for(i = 0; i < index->dirty_cnt; i++) {
+        if(lv_area_is_in(cell_area, &index->dirty_areas[i], 0)) return;
+    }
+
+    /*Merge the overlapping areas to not add the items of a cell twice*/
+    lv_area_t a = *cell_area;
+    i = 0;
+    while(i < index->dirty_cnt) {
+        if(lv_area_is_on(&a, &index->dirty_areas[i])) {
+            lv_area_join(&a, &a, &index->dirty_areas[i]);
+            index->dirty_cnt--;
+            index->dirty_areas[i] = index->dirty_areas[index->dirty_cnt];
+            i = 0;
+        }
+        else {
+            i++;
+        }
+    }
+
+    if(index->dirty_cnt == LV_INDEV_HIT_INDEX_DIRTY_MAX) {
+        index->valid = 0;
+        return;
+    }
+
+    index->dirty_areas[index->dirty_cnt] = a;
+    index->dirty_cnt++;
+}
+
+#endif /*LV_INDEV_HIT_INDEX_CELL_SIZE*/
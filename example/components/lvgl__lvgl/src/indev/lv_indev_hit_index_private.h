@@ -0,0 +1,115 @@
+/**
+ * @file lv_indev_hit_index_private.h
+ *
+ */
+
+#ifndef LV_INDEV_HIT_INDEX_PRIVATE_H
+#define LV_INDEV_HIT_INDEX_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../misc/lv_types.h"
+#include "../misc/lv_area.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/** The flags which change where the objects can be found*/
+#define LV_INDEV_HIT_INDEX_FLAGS (LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_OVERFLOW_VISIBLE)
+
+/** If more areas are outdated than this, the whole index is rebuilt*/
+#define LV_INDEV_HIT_INDEX_DIRTY_MAX 8
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+#if LV_INDEV_HIT_INDEX_CELL_SIZE
+
+/** An object to hit test, in the order `lv_indev_search_obj()` would test them*/
+typedef struct {
+    lv_obj_t * obj;
+    lv_area_t area;         /**< The click area of `obj` clipped by its parents*/
+    uint32_t subtree : 1;   /**< 1: `obj` is transformed, search its whole subtree with `lv_indev_search_obj()`*/
+} lv_indev_hit_index_item_t;
+
+/** The items overlapping a cell of the grid*/
+typedef struct {
+    lv_indev_hit_index_item_t * items;
+    uint32_t item_cnt;
+    uint32_t item_size;
+} lv_indev_hit_index_cell_t;
+
+/** The clickable objects of a display sorted into a uniform grid*/
+struct lv_indev_hit_index_t {
+    lv_obj_t * act_scr;     /**< The active screen when the index was built*/
+    int32_t hor_res;
+    int32_t ver_res;
+    uint32_t valid : 1;     /**< 0: rebuild all the cells on the next search*/
+
+    int32_t col_cnt;
+    int32_t row_cnt;
+    lv_indev_hit_index_cell_t * cells;
+
+    /** The cells to update on the next search, in cell units. They don't overlap.*/
+    lv_area_t dirty_areas[LV_INDEV_HIT_INDEX_DIRTY_MAX];
+    uint32_t dirty_cnt;
+};
+
+#endif /*LV_INDEV_HIT_INDEX_CELL_SIZE*/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+#if LV_INDEV_HIT_INDEX_CELL_SIZE
+
+/**
+ * Mark the area of an object outdated in the hit index of its display.
+ * Only the cells of this area are updated on the next search.
+ * Should be called before and after the position, size, flags, order, parent or
+ * layer type of an object change.
+ * @param obj       pointer to an object
+ */
+void lv_indev_hit_index_invalidate_obj(const lv_obj_t * obj);
+
+/**
+ * Find the top-most clickable object on a point of a display the same way as
+ * searching the layers of the display with `lv_indev_search_obj()`.
+ * @param disp      pointer to a display
+ * @param point     the point to search in display coordinates
+ * @param obj_res   store the found object here (NULL if there is no object on the point)
+ * @return          true: `obj_res` is set; false: the index can't be used, walk the object tree instead
+ */
+bool lv_indev_hit_index_search(lv_display_t * disp, lv_point_t * point, lv_obj_t ** obj_res);
+
+/**
+ * Free the hit index of a display.
+ * @param disp      pointer to a display
+ */
+void lv_indev_hit_index_delete(lv_display_t * disp);
+
+#else
+
+static inline void lv_indev_hit_index_invalidate_obj(const lv_obj_t * obj)
+{
+    LV_UNUSED(obj);
+}
+
+#endif /*LV_INDEV_HIT_INDEX_CELL_SIZE*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_INDEV_HIT_INDEX_PRIVATE_H*/
@@ -15,6 +15,7 @@ extern "C" {
  *********************/
 #include "lv_indev.h"
 #include "../misc/lv_anim.h"
+#include "lv_indev_hit_index_private.h"
 /*********************
  *      DEFINES
  *********************/
@@ -9,6 +9,7 @@
 #include "lv_flex.h"
 #include "../lv_layout.h"
 #include "../../core/lv_obj_private.h"
+#include "../../indev/lv_indev_hit_index_private.h"
 
 #if LV_USE_FLEX
 
@@ -398,6 +399,7 @@ static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, i
 
             if(s != area_get_main_size(&item->coords)) {
                 lv_obj_invalidate(item);
+                lv_indev_hit_index_invalidate_obj(item);
 
                 lv_area_t old_coords;
                 lv_area_copy(&old_coords, &item->coords);
@@ -405,6 +407,7 @@ static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, i
                 lv_obj_send_event(item, LV_EVENT_SIZE_CHANGED, &old_coords);
                 lv_obj_send_event(lv_obj_get_parent(item), LV_EVENT_CHILD_CHANGED, item);
                 lv_obj_invalidate(item);
+                lv_indev_hit_index_invalidate_obj(item);
             }
         }
         else {
@@ -446,6 +449,7 @@ static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, i
 
         if(diff_x || diff_y) {
             lv_obj_invalidate(item);
+            lv_indev_hit_index_invalidate_obj(item);
             item->coords.x1 += diff_x;
             item->coords.x2 += diff_x;
             item->coords.y1 += diff_y;
@@ -13,6 +13,7 @@
 #include "../../stdlib/lv_string.h"
 #include "../lv_layout.h"
 #include "../../core/lv_obj_private.h"
+#include "../../indev/lv_indev_hit_index_private.h"
 #include "../../core/lv_global.h"
 /*********************
  *      DEFINES
@@ -541,9 +542,11 @@ static void item_repos(lv_obj_t * item, lv_grid_calc_t * c, item_repos_hint_t *
         lv_area_t old_coords;
         lv_area_copy(&old_coords, &item->coords);
         lv_obj_invalidate(item);
+        lv_indev_hit_index_invalidate_obj(item);
         lv_area_set_width(&item->coords, item_w);
         lv_area_set_height(&item->coords, item_h);
         lv_obj_invalidate(item);
+        lv_indev_hit_index_invalidate_obj(item);
         lv_obj_send_event(item, LV_EVENT_SIZE_CHANGED, &old_coords);
         lv_obj_send_event(lv_obj_get_parent(item), LV_EVENT_CHILD_CHANGED, item);
 
@@ -564,6 +567,7 @@ static void item_repos(lv_obj_t * item, lv_grid_calc_t * c, item_repos_hint_t *
     int32_t diff_y = hint->grid_abs.y + y - item->coords.y1;
     if(diff_x || diff_y) {
         lv_obj_invalidate(item);
+        lv_indev_hit_index_invalidate_obj(item);
         item->coords.x1 += diff_x;
         item->coords.x2 += diff_x;
         item->coords.y1 += diff_y;
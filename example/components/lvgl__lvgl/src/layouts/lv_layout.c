@@ -9,6 +9,7 @@
 #include "lv_layout_private.h"
 #include "../core/lv_global.h"
 #include "../core/lv_obj.h"
+#include "../misc/lv_profiler.h"
 
 /*********************
  *      DEFINES
@@ -69,8 +70,10 @@ void lv_layout_apply(lv_obj_t * obj)
 {
     lv_layout_t layout_id = lv_obj_get_style_layout(obj, LV_PART_MAIN);
     if(layout_id > 0 && layout_id <= layout_cnt) {
+        LV_PROFILER_BEGIN;
         void  * user_data = layout_list_def[layout_id].user_data;
         layout_list_def[layout_id].cb(obj, user_data);
+        LV_PROFILER_END;
     }
 }
 
@@ -56,6 +56,10 @@ typedef struct {
     lv_draw_buf_t * decompressed;       /*Decompressed data could be used directly, thus must also be draw buf*/
     lv_draw_buf_t c_array;              /*An C-array image that need to be converted to a draw buf*/
     lv_draw_buf_t * decoded_partial;    /*A draw buf for decoded image via get_area_cb*/
+    uint32_t * row_block_ofs;           /*Offset of the LZ4 row blocks and the end of the last one if drawn by blocks*/
+    uint32_t row_block_h;               /*Number of rows in a block*/
+    uint32_t row_blocks_pos;            /*Position of the first block in the file or in the image data*/
+    uint8_t * row_block_in;             /*Buffer to read a compressed block from the file*/
 } decoder_data_t;
 
 /**********************
@@ -68,6 +72,7 @@ static lv_result_t load_indexed(lv_image_decoder_t * decoder, lv_image_decoder_d
 #if LV_BIN_DECODER_RAM_LOAD
     static lv_result_t decode_rgb(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
 #endif
+static lv_result_t load_mapped(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
 static lv_result_t decode_alpha_only(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
 static lv_result_t decode_indexed_line(lv_color_format_t color_format, const lv_color32_t * palette, int32_t x,
                                        int32_t w_px, const uint8_t * in, lv_color32_t * out);
@@ -76,6 +81,14 @@ static lv_result_t decode_compressed(lv_image_decoder_t * decoder, lv_image_deco
 static lv_fs_res_t fs_read_file_at(lv_fs_file_t * f, uint32_t pos, void * buff, uint32_t btr, uint32_t * br);
 
 static lv_result_t decompress_image(lv_image_decoder_dsc_t * dsc, const lv_image_compressed_t * compressed);
+static lv_result_t open_row_blocks(lv_image_decoder_dsc_t * dsc);
+static lv_result_t get_area_row_blocks(lv_image_decoder_dsc_t * dsc, const lv_area_t * full_area,
+                                       lv_area_t * decoded_area);
+static lv_result_t decompress_row_blocks(const lv_image_header_t * header, const uint8_t * in, uint32_t in_len,
+                                         uint8_t * out);
+static bool decompress_row_block(const lv_image_header_t * header, int32_t rows, const uint8_t * in, uint32_t in_len,
+                                 uint8_t * out);
+static uint32_t row_block_size(const lv_image_header_t * header, int32_t rows);
 
 /**********************
  *  STATIC VARIABLES
@@ -216,7 +229,9 @@ lv_result_t lv_bin_decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
         lv_color_format_t cf = dsc->header.cf;
 
         if(dsc->header.flags & LV_IMAGE_FLAGS_COMPRESSED) {
-            res = decode_compressed(decoder, dsc);
+            /*Decompress only the row blocks to draw in get_area_cb if possible*/
+            res = open_row_blocks(dsc);
+            if(res != LV_RESULT_OK) res = decode_compressed(decoder, dsc);
         }
         else if(LV_COLOR_FORMAT_IS_INDEXED(cf)) {
             if(dsc->args.use_indexed) {
@@ -230,6 +245,17 @@ lv_result_t lv_bin_decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
         else if(LV_COLOR_FORMAT_IS_ALPHA_ONLY(cf)) {
             res = decode_alpha_only(decoder, dsc);
         }
+        else if((cf == LV_COLOR_FORMAT_ARGB8888      \
+                 || cf == LV_COLOR_FORMAT_XRGB8888   \
+                 || cf == LV_COLOR_FORMAT_RGB888     \
+                 || cf == LV_COLOR_FORMAT_RGB565     \
+                 || cf == LV_COLOR_FORMAT_RGB565A8   \
+                 || cf == LV_COLOR_FORMAT_ARGB8565)  \
+                && load_mapped(decoder, dsc) == LV_RESULT_OK) {
+            /*The pixels are used from the memory of the file, like a variable image*/
+            res = LV_RESULT_OK;
+            use_directly = true;
+        }
 #if LV_BIN_DECODER_RAM_LOAD
         else if(cf == LV_COLOR_FORMAT_ARGB8888      \
                 || cf == LV_COLOR_FORMAT_XRGB8888   \
@@ -256,7 +282,8 @@ lv_result_t lv_bin_decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
 
         lv_color_format_t cf = image->header.cf;
         if(dsc->header.flags & LV_IMAGE_FLAGS_COMPRESSED) {
-            res = decode_compressed(decoder, dsc);
+            res = open_row_blocks(dsc);
+            if(res != LV_RESULT_OK) res = decode_compressed(decoder, dsc);
         }
         else if(LV_COLOR_FORMAT_IS_INDEXED(cf)) {
             /*Need decoder data to store converted image*/
@@ -380,6 +407,11 @@ lv_result_t lv_bin_decoder_get_area(lv_image_decoder_t * decoder, lv_image_decod
 {
     LV_UNUSED(decoder); /*Unused*/
 
+    decoder_data_t * row_blocks_data = dsc->user_data;
+    if(row_blocks_data && row_blocks_data->row_block_ofs) {
+        return get_area_row_blocks(dsc, full_area, decoded_area);
+    }
+
     lv_color_format_t cf = dsc->header.cf;
     /*Check if cf is supported*/
 
@@ -546,6 +578,8 @@ static void free_decoder_data(lv_image_decoder_dsc_t * dsc)
 
     if(decoder_data->decoded) lv_draw_buf_destroy(decoder_data->decoded);
     if(decoder_data->decompressed) lv_draw_buf_destroy(decoder_data->decompressed);
+    lv_free(decoder_data->row_block_ofs);
+    lv_free(decoder_data->row_block_in);
     lv_free(decoder_data->palette);
     lv_free(decoder_data);
     dsc->user_data = NULL;
@@ -803,6 +837,42 @@ static lv_result_t decode_rgb(lv_image_decoder_t * decoder, lv_image_decoder_dsc
 }
 #endif
 
+/**
+ * Use the pixels of an uncompressed image directly if the file system
+ * can give the content of the file in memory (see `lv_fs_get_buffer()`).
+ * The pixels are valid until the decoder is closed.
+ */
+static lv_result_t load_mapped(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(decoder);
+    decoder_data_t * decoder_data = dsc->user_data;
+
+    uint32_t file_size;
+    const uint8_t * file_data = lv_fs_get_buffer(decoder_data->f, &file_size);
+    if(file_data == NULL) return LV_RESULT_INVALID;
+
+    uint32_t len = dsc->header.stride * dsc->header.h;
+    if(dsc->header.cf == LV_COLOR_FORMAT_RGB565A8) {
+        len += (dsc->header.stride / 2) * dsc->header.h; /*A8 mask*/
+    }
+
+    if(file_size < sizeof(lv_image_header_t) + len) {
+        LV_LOG_WARN("The file is too small for the image");
+        return LV_RESULT_INVALID;
+    }
+
+    lv_image_dsc_t image;
+    lv_memzero(&image, sizeof(image));
+    image.header = dsc->header;
+    image.header.flags &= ~(LV_IMAGE_FLAGS_ALLOCATED | LV_IMAGE_FLAGS_MODIFIABLE);  /*The memory is read-only*/
+    image.data = file_data + sizeof(lv_image_header_t);
+    image.data_size = len;
+
+    lv_draw_buf_from_image(&decoder_data->c_array, &image);
+    dsc->decoded = &decoder_data->c_array;
+    return LV_RESULT_OK;
+}
+
 /**
  * Extend A1/2/4 to A8 with interpolation to reduce rounding error.
  */
@@ -1145,6 +1215,13 @@ static lv_result_t decompress_image(lv_image_decoder_dsc_t * dsc, const lv_image
         return LV_RESULT_INVALID;
 #endif
     }
+    else if(compressed->method == LV_IMAGE_COMPRESS_LZ4_ROWS) {
+        if(decompress_row_blocks(&decompressed->header, compressed->data, input_len, img_data) != LV_RESULT_OK) {
+            LV_LOG_WARN("Decompress failed");
+            lv_draw_buf_destroy(decompressed);
+            return LV_RESULT_INVALID;
+        }
+    }
     else {
         LV_UNUSED(img_data);
         LV_LOG_WARN("Unknown compression method: %d", compressed->method);
@@ -1155,3 +1232,273 @@ static lv_result_t decompress_image(lv_image_decoder_dsc_t * dsc, const lv_image
     decoder_data->decompressed = decompressed; /*Free on decoder close*/
     return LV_RESULT_OK;
 }
+
+/**
+ * Prepare to decompress the LZ4 row blocks of an image one by one in get_area_cb.
+ * The block table is loaded and nothing is decompressed yet.
+ * @param dsc       pointer to the decoder descriptor
+ * @return          LV_RESULT_OK: the image will be drawn by blocks;
+ *                  LV_RESULT_INVALID: it's not an LZ4 row block image or it needs to be decoded fully
+ */
+static lv_result_t open_row_blocks(lv_image_decoder_dsc_t * dsc)
+{
+#if LV_USE_LZ4
+    const lv_image_header_t * header = &dsc->header;
+    lv_color_format_t cf = header->cf;
+
+    /*Only if the caller can draw the parts and the blocks can be drawn as they are*/
+    if(!dsc->args.partial || dsc->args.use_indexed || header->stride == 0) return LV_RESULT_INVALID;
+    if(cf != LV_COLOR_FORMAT_ARGB8888 && cf != LV_COLOR_FORMAT_XRGB8888 && cf != LV_COLOR_FORMAT_RGB888 &&
+       cf != LV_COLOR_FORMAT_RGB565 && cf != LV_COLOR_FORMAT_RGB565A8 && cf != LV_COLOR_FORMAT_ARGB8565) {
+        return LV_RESULT_INVALID;
+    }
+    if(dsc->args.stride_align && cf != LV_COLOR_FORMAT_RGB565A8 &&
+       header->stride != lv_draw_buf_width_to_stride(header->w, cf)) {
+        return LV_RESULT_INVALID;
+    }
+    if(dsc->args.premultiply && lv_color_format_has_alpha(cf) && !(header->flags & LV_IMAGE_FLAGS_PREMULTIPLIED)) {
+        return LV_RESULT_INVALID;
+    }
+
+    decoder_data_t * decoder_data = get_decoder_data(dsc);
+    if(decoder_data == NULL) return LV_RESULT_INVALID;
+
+    /*The compression header and the rows per block*/
+    uint32_t pos = dsc->src_type == LV_IMAGE_SRC_FILE ? sizeof(lv_image_header_t) : 0;
+    uint32_t info[4];
+    const lv_image_dsc_t * image = dsc->src;
+    if(dsc->src_type == LV_IMAGE_SRC_FILE) {
+        uint32_t rn;
+        lv_fs_res_t fs_res = fs_read_file_at(decoder_data->f, pos, info, sizeof(info), &rn);
+        if(fs_res != LV_FS_RES_OK || rn != sizeof(info)) return LV_RESULT_INVALID;
+    }
+    else {
+        if(image->data_size < sizeof(info)) return LV_RESULT_INVALID;
+        lv_memcpy(info, image->data, sizeof(info));
+    }
+
+    lv_image_compressed_t compressed;
+    lv_memcpy(&compressed, info, 12);
+    uint32_t block_h = info[3];
+    if(compressed.method != LV_IMAGE_COMPRESS_LZ4_ROWS || block_h == 0) return LV_RESULT_INVALID;
+    if(dsc->src_type == LV_IMAGE_SRC_VARIABLE && compressed.compressed_size != image->data_size - 12) {
+        return LV_RESULT_INVALID;
+    }
+
+    uint32_t block_cnt = (header->h + block_h - 1) / block_h;
+    uint32_t table_size = (block_cnt + 1) * sizeof(uint32_t);
+    if(compressed.compressed_size < sizeof(uint32_t) + table_size) return LV_RESULT_INVALID;
+
+    uint32_t * block_ofs = lv_malloc(table_size);
+    if(block_ofs == NULL) return LV_RESULT_INVALID;
+
+    pos += sizeof(info);
+    if(dsc->src_type == LV_IMAGE_SRC_FILE) {
+        uint32_t rn;
+        lv_fs_res_t fs_res = fs_read_file_at(decoder_data->f, pos, block_ofs, table_size, &rn);
+        if(fs_res != LV_FS_RES_OK || rn != table_size) {
+            lv_free(block_ofs);
+            return LV_RESULT_INVALID;
+        }
+    }
+    else {
+        if(image->data_size < pos + table_size) {
+            lv_free(block_ofs);
+            return LV_RESULT_INVALID;
+        }
+        lv_memcpy(block_ofs, image->data + pos, table_size);
+    }
+
+    /*The blocks need to follow each other and fill the compressed data*/
+    uint32_t max_block_len = 0;
+    uint32_t i;
+    for(i = 0; i < block_cnt; i++) {
+        if(block_ofs[i + 1] < block_ofs[i]) break;
+        max_block_len = LV_MAX(max_block_len, block_ofs[i + 1] - block_ofs[i]);
+    }
+    if(i < block_cnt || block_ofs[0] != 0 ||
+       block_ofs[block_cnt] != compressed.compressed_size - sizeof(uint32_t) - table_size) {
+        LV_LOG_WARN("Invalid LZ4 row block table");
+        lv_free(block_ofs);
+        return LV_RESULT_INVALID;
+    }
+
+    /*The blocks of the variables are decompressed from their place*/
+    if(dsc->src_type == LV_IMAGE_SRC_FILE) {
+        decoder_data->row_block_in = lv_malloc(max_block_len);
+        if(decoder_data->row_block_in == NULL) {
+            lv_free(block_ofs);
+            return LV_RESULT_INVALID;
+        }
+    }
+
+    decoder_data->row_block_ofs = block_ofs;
+    decoder_data->row_block_h = block_h;
+    decoder_data->row_blocks_pos = pos + table_size;
+    dsc->decoded = NULL;
+
+    return LV_RESULT_OK;
+#else
+    LV_UNUSED(dsc);
+    return LV_RESULT_INVALID;
+#endif
+}
+
+/**
+ * Decompress the row block containing the next rows of the area to draw
+ * @param dsc           pointer to the decoder descriptor
+ * @param full_area     the area of the image to draw
+ * @param decoded_area  in: the previously decoded area, `LV_COORD_MIN` for the first call.
+ *                      out: the area of the decompressed block
+ * @return              LV_RESULT_OK: a block is decompressed; LV_RESULT_INVALID: the whole area is decoded or error
+ */
+static lv_result_t get_area_row_blocks(lv_image_decoder_dsc_t * dsc, const lv_area_t * full_area,
+                                       lv_area_t * decoded_area)
+{
+    decoder_data_t * decoder_data = dsc->user_data;
+    const lv_image_header_t * header = &dsc->header;
+    int32_t block_h = (int32_t)decoder_data->row_block_h;
+
+    int32_t y;
+    if(decoded_area->y1 == LV_COORD_MIN) y = (full_area->y1 / block_h) * block_h;
+    else y = decoded_area->y1 + block_h;
+
+    if(y > full_area->y2 || y >= (int32_t)header->h) return LV_RESULT_INVALID;
+
+    uint32_t block = y / block_h;
+    int32_t rows = LV_MIN(block_h, (int32_t)header->h - y);
+
+    lv_draw_buf_t * decoded = lv_draw_buf_reshape(decoder_data->decoded_partial, header->cf, header->w, rows,
+                                                  header->stride);
+    if(decoded == NULL) {
+        if(decoder_data->decoded_partial) lv_draw_buf_destroy(decoder_data->decoded_partial);
+        decoded = lv_draw_buf_create_ex(image_cache_draw_buf_handlers, header->w, block_h, header->cf, header->stride);
+        decoder_data->decoded_partial = decoded; /*Free on decoder close*/
+        if(decoded == NULL) return LV_RESULT_INVALID;
+        lv_draw_buf_reshape(decoded, header->cf, header->w, rows, header->stride);
+    }
+
+    uint32_t pos = decoder_data->row_blocks_pos + decoder_data->row_block_ofs[block];
+    uint32_t len = decoder_data->row_block_ofs[block + 1] - decoder_data->row_block_ofs[block];
+    const uint8_t * in;
+    if(dsc->src_type == LV_IMAGE_SRC_FILE) {
+        uint32_t rn;
+        lv_fs_res_t fs_res = fs_read_file_at(decoder_data->f, pos, decoder_data->row_block_in, len, &rn);
+        if(fs_res != LV_FS_RES_OK || rn != len) return LV_RESULT_INVALID;
+        in = decoder_data->row_block_in;
+    }
+    else {
+        const lv_image_dsc_t * image = dsc->src;
+        in = image->data + pos;
+    }
+
+    if(!decompress_row_block(header, rows, in, len, decoded->data)) {
+        LV_LOG_WARN("Decompressing the row block %" LV_PRIu32 " failed", block);
+        return LV_RESULT_INVALID;
+    }
+
+    if(header->flags & LV_IMAGE_FLAGS_PREMULTIPLIED) lv_draw_buf_set_flag(decoded, LV_IMAGE_FLAGS_PREMULTIPLIED);
+    else lv_draw_buf_clear_flag(decoded, LV_IMAGE_FLAGS_PREMULTIPLIED);
+
+    decoded_area->x1 = 0;
+    decoded_area->x2 = header->w - 1;
+    decoded_area->y1 = y;
+    decoded_area->y2 = y + rows - 1;
+    dsc->decoded = decoded;
+
+    return LV_RESULT_OK;
+}
+
+/**
+ * Decompress all the LZ4 row blocks of an image
+ * @param header    header of the image with the stride
+ * @param in        the rows per block, the block table and the blocks
+ * @param in_len    size of `in`
+ * @param out       buffer for the whole image
+ * @return          LV_RESULT_OK: decompressed; LV_RESULT_INVALID: invalid data
+ */
+static lv_result_t decompress_row_blocks(const lv_image_header_t * header, const uint8_t * in, uint32_t in_len,
+                                         uint8_t * out)
+{
+    uint32_t block_h;
+    if(in_len < sizeof(uint32_t)) return LV_RESULT_INVALID;
+    lv_memcpy(&block_h, in, sizeof(uint32_t));
+    if(block_h == 0) return LV_RESULT_INVALID;
+
+    uint32_t block_cnt = (header->h + block_h - 1) / block_h;
+    uint32_t table_size = (block_cnt + 1) * sizeof(uint32_t);
+    if(in_len < sizeof(uint32_t) + table_size) return LV_RESULT_INVALID;
+
+    const uint8_t * table = in + sizeof(uint32_t);
+    const uint8_t * blocks = table + table_size;
+    uint32_t blocks_len = in_len - sizeof(uint32_t) - table_size;
+
+    /*RGB565A8 blocks contain the alpha rows after the color rows so they need to be separated*/
+    uint8_t * tmp = NULL;
+    if(header->cf == LV_COLOR_FORMAT_RGB565A8) {
+        tmp = lv_malloc(row_block_size(header, block_h));
+        if(tmp == NULL) return LV_RESULT_INVALID;
+    }
+
+    lv_result_t res = LV_RESULT_OK;
+    uint32_t block;
+    for(block = 0; block < block_cnt; block++) {
+        uint32_t ofs[2];
+        lv_memcpy(ofs, table + block * sizeof(uint32_t), sizeof(ofs));
+        if(ofs[1] < ofs[0] || ofs[1] > blocks_len) {
+            res = LV_RESULT_INVALID;
+            break;
+        }
+
+        uint32_t y = block * block_h;
+        int32_t rows = LV_MIN(block_h, header->h - y);
+        uint8_t * block_out = tmp ? tmp : out + y * header->stride;
+        if(!decompress_row_block(header, rows, blocks + ofs[0], ofs[1] - ofs[0], block_out)) {
+            res = LV_RESULT_INVALID;
+            break;
+        }
+
+        if(tmp) {
+            uint32_t stride_a8 = header->stride / 2;
+            lv_memcpy(out + y * header->stride, tmp, rows * header->stride);
+            lv_memcpy(out + header->h * header->stride + y * stride_a8, tmp + rows * header->stride, rows * stride_a8);
+        }
+    }
+
+    lv_free(tmp);
+    return res;
+}
+
+/**
+ * Decompress an LZ4 row block. The result is laid out like an image with `rows` height.
+ * @param header    header of the image with the stride
+ * @param rows      number of rows in the block
+ * @param in        the compressed block
+ * @param in_len    size of the compressed block
+ * @param out       buffer for the rows
+ * @return          true: decompressed; false: invalid data
+ */
+static bool decompress_row_block(const lv_image_header_t * header, int32_t rows, const uint8_t * in, uint32_t in_len,
+                                 uint8_t * out)
+{
+#if LV_USE_LZ4
+    uint32_t out_len = row_block_size(header, rows);
+    int len = LZ4_decompress_safe((const char *)in, (char *)out, in_len, out_len);
+    return len >= 0 && (uint32_t)len == out_len;
+#else
+    LV_UNUSED(header);
+    LV_UNUSED(rows);
+    LV_UNUSED(in);
+    LV_UNUSED(in_len);
+    LV_UNUSED(out);
+    LV_LOG_WARN("LZ4 decompress is not enabled");
+    return false;
+#endif
+}
+
+static uint32_t row_block_size(const lv_image_header_t * header, int32_t rows)
+{
+    uint32_t size = rows * header->stride;
+    if(header->cf == LV_COLOR_FORMAT_RGB565A8) size += rows * (header->stride / 2);
+    return size;
+}
@@ -48,6 +48,7 @@ static lv_fs_res_t fs_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_
 static lv_fs_res_t fs_write(lv_fs_drv_t * drv, void * file_p, const void * buf, uint32_t btw, uint32_t * bw);
 static lv_fs_res_t fs_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence);
 static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
+static lv_fs_res_t fs_stat(lv_fs_drv_t * drv, const char * path, lv_fs_stat_t * stat_p);
 static void * fs_dir_open(lv_fs_drv_t * drv, const char * path);
 static lv_fs_res_t fs_dir_read(lv_fs_drv_t * drv, void * dir_p, char * fn, uint32_t fn_len);
 static lv_fs_res_t fs_dir_close(lv_fs_drv_t * drv, void * dir_p);
@@ -88,6 +89,7 @@ void lv_fs_fatfs_init(void)
     fs_drv_p->write_cb = fs_write;
     fs_drv_p->seek_cb = fs_seek;
     fs_drv_p->tell_cb = fs_tell;
+    fs_drv_p->stat_cb = fs_stat;
 
     fs_drv_p->dir_close_cb = fs_dir_close;
     fs_drv_p->dir_open_cb = fs_dir_open;
@@ -229,6 +231,27 @@ static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p)
     return LV_FS_RES_OK;
 }
 
+/**
+ * Get the size and modification time of a file
+ * @param drv       pointer to a driver where this function belongs
+ * @param path      path to the file
+ * @param stat_p    pointer to store the information
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_stat(lv_fs_drv_t * drv, const char * path, lv_fs_stat_t * stat_p)
+{
+    LV_UNUSED(drv);
+
+    FILINFO fno;
+    FRESULT res = f_stat(path, &fno);
+    if(res == FR_NO_FILE || res == FR_NO_PATH) return LV_FS_RES_NOT_EX;
+    if(res != FR_OK) return LV_FS_RES_UNKNOWN;
+
+    stat_p->size = (uint32_t)fno.fsize;
+    stat_p->mtime = ((uint32_t)fno.fdate << 16) | fno.ftime;
+    return LV_FS_RES_OK;
+}
+
 /**
  * Initialize a 'DIR' variable for directory reading
  * @param drv   pointer to a driver where this function belongs
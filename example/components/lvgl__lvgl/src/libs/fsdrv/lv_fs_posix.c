@@ -16,6 +16,10 @@
 #include <dirent.h>
 #include <unistd.h>
 #include <errno.h>
+#include <sys/stat.h>
+#if LV_FS_POSIX_MMAP
+    #include <sys/mman.h>
+#endif
 #include "../../core/lv_global.h"
 
 /*********************
@@ -35,16 +39,29 @@
     #endif
 #endif
 
-/** The reason for 'fd + 1' is because open() may return a legal fd with a value of 0,
-  * preventing it from being judged as NULL when converted to a pointer type.
-  */
-#define FILEP2FD(file_p) ((lv_uintptr_t)file_p - 1)
-#define FD2FILEP(fd) ((void *)(lv_uintptr_t)(fd + 1))
+#if LV_FS_POSIX_MMAP
+    #define FILEP2FD(file_p) (((posix_file_t *)file_p)->fd)
+#else
+    /** The reason for 'fd + 1' is because open() may return a legal fd with a value of 0,
+    * preventing it from being judged as NULL when converted to a pointer type.
+    */
+    #define FILEP2FD(file_p) ((lv_uintptr_t)file_p - 1)
+    #define FD2FILEP(fd) ((void *)(lv_uintptr_t)(fd + 1))
+#endif
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_FS_POSIX_MMAP
+typedef struct {
+    int fd;
+    uint8_t * map;      /**< The content of the file if it's opened for reading, else NULL*/
+    uint32_t size;
+    uint32_t pos;       /**< The read position in `map`*/
+} posix_file_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -54,6 +71,10 @@ static lv_fs_res_t fs_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_
 static lv_fs_res_t fs_write(lv_fs_drv_t * drv, void * file_p, const void * buf, uint32_t btw, uint32_t * bw);
 static lv_fs_res_t fs_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence);
 static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
+#if LV_FS_POSIX_MMAP
+    static const void * fs_get_buffer(lv_fs_drv_t * drv, void * file_p, uint32_t * size);
+#endif
+static lv_fs_res_t fs_stat(lv_fs_drv_t * drv, const char * path, lv_fs_stat_t * stat_p);
 static void * fs_dir_open(lv_fs_drv_t * drv, const char * path);
 static lv_fs_res_t fs_dir_read(lv_fs_drv_t * drv, void * dir_p, char * fn, uint32_t fn_len);
 static lv_fs_res_t fs_dir_close(lv_fs_drv_t * drv, void * dir_p);
@@ -92,6 +113,10 @@ void lv_fs_posix_init(void)
     fs_drv_p->write_cb = fs_write;
     fs_drv_p->seek_cb = fs_seek;
     fs_drv_p->tell_cb = fs_tell;
+    fs_drv_p->stat_cb = fs_stat;
+#if LV_FS_POSIX_MMAP
+    fs_drv_p->get_buffer_cb = fs_get_buffer;
+#endif
 
     fs_drv_p->dir_close_cb = fs_dir_close;
     fs_drv_p->dir_open_cb = fs_dir_open;
@@ -130,7 +155,34 @@ static void * fs_open(lv_fs_drv_t * drv, const char * path, lv_fs_mode_t mode)
         return NULL;
     }
 
+#if LV_FS_POSIX_MMAP
+    posix_file_t * file = lv_malloc_zeroed(sizeof(posix_file_t));
+    LV_ASSERT_MALLOC(file);
+    if(file == NULL) {
+        close(fd);
+        return NULL;
+    }
+
+    file->fd = fd;
+    if(mode == LV_FS_MODE_RD) {
+        /*Empty or special files can't be mapped, they are read normally*/
+        struct stat st;
+        if(fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 && st.st_size <= UINT32_MAX) {
+            file->map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(file->map == MAP_FAILED) {
+                LV_LOG_WARN("Could not map file: %s, errno: %d", buf, errno);
+                file->map = NULL;
+            }
+            else {
+                file->size = (uint32_t)st.st_size;
+            }
+        }
+    }
+
+    return file;
+#else
     return FD2FILEP(fd);
+#endif
 }
 
 /**
@@ -145,6 +197,12 @@ static lv_fs_res_t fs_close(lv_fs_drv_t * drv, void * file_p)
     LV_UNUSED(drv);
 
     int fd = FILEP2FD(file_p);
+#if LV_FS_POSIX_MMAP
+    posix_file_t * file = file_p;
+    if(file->map) munmap(file->map, file->size);
+    lv_free(file);
+#endif
+
     int ret = close(fd);
     if(ret < 0) {
         LV_LOG_WARN("Could not close file: %d, errno: %d", fd, errno);
@@ -168,6 +226,17 @@ static lv_fs_res_t fs_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_
 {
     LV_UNUSED(drv);
 
+#if LV_FS_POSIX_MMAP
+    posix_file_t * file = file_p;
+    if(file->map) {
+        uint32_t remaining = file->pos < file->size ? file->size - file->pos : 0;
+        *br = LV_MIN(btr, remaining);
+        lv_memcpy(buf, file->map + file->pos, *br);
+        file->pos += *br;
+        return LV_FS_RES_OK;
+    }
+#endif
+
     int fd = FILEP2FD(file_p);
     ssize_t ret = read(fd, buf, btr);
     if(ret < 0) {
@@ -214,6 +283,27 @@ static lv_fs_res_t fs_write(lv_fs_drv_t * drv, void * file_p, const void * buf,
 static lv_fs_res_t fs_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence)
 {
     LV_UNUSED(drv);
+
+#if LV_FS_POSIX_MMAP
+    posix_file_t * file = file_p;
+    if(file->map) {
+        switch(whence) {
+            case LV_FS_SEEK_SET:
+                file->pos = pos;
+                break;
+            case LV_FS_SEEK_CUR:
+                file->pos += pos;
+                break;
+            case LV_FS_SEEK_END:
+                file->pos = file->size + pos;
+                break;
+            default:
+                return LV_FS_RES_INV_PARAM;
+        }
+        return LV_FS_RES_OK;
+    }
+#endif
+
     int w;
     switch(whence) {
         case LV_FS_SEEK_SET:
@@ -251,6 +341,14 @@ static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p)
 {
     LV_UNUSED(drv);
 
+#if LV_FS_POSIX_MMAP
+    posix_file_t * file = file_p;
+    if(file->map) {
+        *pos_p = file->pos;
+        return LV_FS_RES_OK;
+    }
+#endif
+
     int fd = FILEP2FD(file_p);
     off_t offset = lseek(fd, 0, SEEK_CUR);
     if(offset < 0) {
@@ -262,6 +360,46 @@ static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p)
     return LV_FS_RES_OK;
 }
 
+#if LV_FS_POSIX_MMAP
+/**
+ * Give the content of a file opened for reading
+ * @param drv       pointer to a driver where this function belongs
+ * @param file_p    a file handle variable
+ * @param size      pointer to store the size of the file
+ * @return          pointer to the mapped content of the file or NULL if it's not mapped
+ */
+static const void * fs_get_buffer(lv_fs_drv_t * drv, void * file_p, uint32_t * size)
+{
+    LV_UNUSED(drv);
+
+    posix_file_t * file = file_p;
+    *size = file->size;
+    return file->map;
+}
+#endif
+
+/**
+ * Get the size and modification time of a file
+ * @param drv   pointer to a driver where this function belongs
+ * @param path  path to the file
+ * @param stat_p  pointer to store the information
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_stat(lv_fs_drv_t * drv, const char * path, lv_fs_stat_t * stat_p)
+{
+    LV_UNUSED(drv);
+
+    char buf[256];
+    lv_snprintf(buf, sizeof(buf), LV_FS_POSIX_PATH "%s", path);
+
+    struct stat st;
+    if(stat(buf, &st) != 0) return errno == ENOENT ? LV_FS_RES_NOT_EX : LV_FS_RES_FS_ERR;
+
+    stat_p->size = (uint32_t)st.st_size;
+    stat_p->mtime = (uint32_t)st.st_mtime;
+    return LV_FS_RES_OK;
+}
+
 /**
  * Initialize a 'fs_read_dir_t' variable for directory reading
  * @param drv   pointer to a driver where this function belongs
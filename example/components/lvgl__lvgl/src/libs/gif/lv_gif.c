@@ -8,19 +8,38 @@
  *********************/
 #include "../../misc/lv_timer_private.h"
 #include "../../core/lv_obj_class_private.h"
+#include "../../misc/lv_area_private.h"
 #include "lv_gif_private.h"
 #if LV_USE_GIF
 
 #include "gifdec.h"
+#include "../../core/lv_global.h"
 
 /*********************
  *      DEFINES
  *********************/
 #define MY_CLASS (&lv_gif_class)
 
+#if LV_GIF_DECODE_AHEAD
+    #define decode_ahead LV_GLOBAL_DEFAULT()->gif_decode_ahead
+    #define THREAD_STACK_SIZE   (16 * 1024)
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_GIF_DECODE_AHEAD
+/** A thread decoding the next frame of the GIFs*/
+typedef struct lv_gif_decode_ahead_t {
+    lv_thread_t thread;
+    lv_thread_sync_t sync;          /**< Signaled when a job is added or on exit*/
+    lv_thread_sync_t done_sync;     /**< Signaled when a frame is decoded*/
+    lv_mutex_t lock;
+    lv_ll_t jobs;                   /**< `lv_gif_t *`s waiting for decoding*/
+    uint32_t ref_cnt;               /**< Number of GIFs using the thread*/
+    bool exit;
+} lv_gif_decode_ahead_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -28,6 +47,20 @@
 static void lv_gif_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_gif_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void next_frame_task_cb(lv_timer_t * t);
+static int frame_decode(lv_gif_t * gifobj, uint8_t * canvas, lv_area_t * frame_area);
+static void invalidate_frame_area(lv_obj_t * obj, const lv_area_t * frame_area);
+
+#if LV_GIF_DECODE_AHEAD
+    static void decode_ahead_start(lv_gif_t * gifobj);
+    static void decode_ahead_stop(lv_gif_t * gifobj);
+    static bool decode_ahead_ref(void);
+    static void decode_ahead_unref(void);
+    static void decode_ahead_thread_cb(void * user_data);
+    static void job_queue(lv_gif_t * gifobj);
+    static void job_wait(lv_gif_t * gifobj);
+    static void next_frame_prepare(lv_gif_t * gifobj);
+    static int next_frame_show(lv_gif_t * gifobj);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -65,6 +98,9 @@ void lv_gif_set_src(lv_obj_t * obj, const void * src)
 
     /*Close previous gif if any*/
     if(gif != NULL) {
+#if LV_GIF_DECODE_AHEAD
+        decode_ahead_stop(gifobj);
+#endif
         lv_image_cache_drop(lv_image_get_src(obj));
 
         gd_close_gif(gif);
@@ -96,6 +132,10 @@ void lv_gif_set_src(lv_obj_t * obj, const void * src)
 
     gifobj->last_call = lv_tick_get();
 
+#if LV_GIF_DECODE_AHEAD
+    decode_ahead_start(gifobj);
+#endif
+
     lv_image_set_src(obj, &gifobj->imgdsc);
 
     lv_timer_resume(gifobj->timer);
@@ -114,9 +154,21 @@ void lv_gif_restart(lv_obj_t * obj)
         return;
     }
 
+#if LV_GIF_DECODE_AHEAD
+    /*The frame decoded ahead has advanced the decoder already so show it*/
+    if(gifobj->canvas_next) {
+        job_wait(gifobj);
+        if(gifobj->next_state == LV_GIF_NEXT_READY) next_frame_show(gifobj);
+    }
+#endif
+
     gd_rewind(gifobj->gif);
     lv_timer_resume(gifobj->timer);
     lv_timer_reset(gifobj->timer);
+
+#if LV_GIF_DECODE_AHEAD
+    if(gifobj->canvas_next) job_queue(gifobj);
+#endif
 }
 
 void lv_gif_pause(lv_obj_t * obj)
@@ -164,7 +216,16 @@ void lv_gif_set_loop_count(lv_obj_t * obj, int32_t count)
         return;
     }
 
+#if LV_GIF_DECODE_AHEAD
+    /*The thread might be decoding the end of the GIF*/
+    if(gifobj->canvas_next) job_wait(gifobj);
+#endif
+
     gifobj->gif->loop_count = count;
+
+#if LV_GIF_DECODE_AHEAD
+    if(gifobj->canvas_next) job_queue(gifobj);
+#endif
 }
 
 /**********************
@@ -187,6 +248,10 @@ static void lv_gif_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     LV_UNUSED(class_p);
     lv_gif_t * gifobj = (lv_gif_t *) obj;
 
+#if LV_GIF_DECODE_AHEAD
+    decode_ahead_stop(gifobj);
+#endif
+
     lv_image_cache_drop(lv_image_get_src(obj));
 
     if(gifobj->gif)
@@ -198,12 +263,36 @@ static void next_frame_task_cb(lv_timer_t * t)
 {
     lv_obj_t * obj = t->user_data;
     lv_gif_t * gifobj = (lv_gif_t *) obj;
+
+#if LV_GIF_DECODE_AHEAD
+    if(gifobj->canvas_next) {
+        uint32_t elaps = lv_tick_elaps(gifobj->last_call);
+        if(elaps < gifobj->delay * 10) return;
+
+        gifobj->last_call = lv_tick_get();
+
+        /*Take the frame decoded by the thread or decode it now if the thread hasn't got to it yet*/
+        job_wait(gifobj);
+        if(gifobj->next_state != LV_GIF_NEXT_READY) next_frame_prepare(gifobj);
+        int has_next = next_frame_show(gifobj);
+        job_queue(gifobj);
+
+        if(has_next == 0) {
+            /*It was the last repeat*/
+            lv_obj_send_event(obj, LV_EVENT_READY, NULL);
+            lv_timer_pause(t);
+        }
+        return;
+    }
+#endif
+
     uint32_t elaps = lv_tick_elaps(gifobj->last_call);
     if(elaps < gifobj->gif->gce.delay * 10) return;
 
     gifobj->last_call = lv_tick_get();
 
-    int has_next = gd_get_frame(gifobj->gif);
+    lv_area_t frame_area;
+    int has_next = frame_decode(gifobj, (uint8_t *)gifobj->imgdsc.data, &frame_area);
     if(has_next == 0) {
         /*It was the last repeat*/
         lv_result_t res = lv_obj_send_event(obj, LV_EVENT_READY, NULL);
@@ -211,10 +300,290 @@ static void next_frame_task_cb(lv_timer_t * t)
         if(res != LV_RESULT_OK) return;
     }
 
-    gd_render_frame(gifobj->gif, (uint8_t *)gifobj->imgdsc.data);
+    lv_image_cache_drop(lv_image_get_src(obj));
+    invalidate_frame_area(obj, &frame_area);
+}
+
+/**
+ * Decode the next frame onto a canvas showing the current frame
+ * @param gifobj        pointer to a GIF object
+ * @param canvas        the canvas to update
+ * @param frame_area    store the area changed by the frame here
+ * @return              the return value of `gd_get_frame()`
+ */
+static int frame_decode(lv_gif_t * gifobj, uint8_t * canvas, lv_area_t * frame_area)
+{
+    gd_GIF * gif = gifobj->gif;
+
+    /*The area of the current frame is changed too when it's disposed*/
+    lv_area_t prev_area;
+    lv_area_set(&prev_area, gif->fx, gif->fy, gif->fx + gif->fw - 1, gif->fy + gif->fh - 1);
+
+    gif->canvas = canvas;
+    int has_next = gd_get_frame(gif);
+    gd_render_frame(gif, canvas);
+
+    lv_area_set(frame_area, gif->fx, gif->fy, gif->fx + gif->fw - 1, gif->fy + gif->fh - 1);
+    if(gif->fw == 0 || gif->fh == 0) *frame_area = prev_area;
+    else if(prev_area.x2 >= prev_area.x1 && prev_area.y2 >= prev_area.y1) lv_area_join(frame_area, frame_area, &prev_area);
+
+    return has_next;
+}
+
+/**
+ * Invalidate only the area changed by a frame if the image is drawn as it is
+ * @param obj           pointer to a GIF object
+ * @param frame_area    the changed area relative to the GIF
+ */
+static void invalidate_frame_area(lv_obj_t * obj, const lv_area_t * frame_area)
+{
+    lv_image_t * img = (lv_image_t *)obj;
+    if(img->rotation != 0 || img->scale_x != LV_SCALE_NONE || img->scale_y != LV_SCALE_NONE ||
+       img->align >= LV_IMAGE_ALIGN_AUTO_TRANSFORM) {
+        lv_obj_invalidate(obj);
+        return;
+    }
+
+    /*Where the image is drawn, see `draw_image()` of `lv_image`*/
+    lv_area_t image_area;
+    lv_area_set(&image_area, obj->coords.x1, obj->coords.y1, obj->coords.x1 + img->w - 1, obj->coords.y1 + img->h - 1);
+    lv_area_align(&obj->coords, &image_area, img->align, img->offset.x, img->offset.y);
+
+    lv_area_t area = *frame_area;
+    lv_area_move(&area, image_area.x1, image_area.y1);
+    lv_obj_invalidate_area(obj, &area);
+}
+
+#if LV_GIF_DECODE_AHEAD
+
+/**
+ * Allocate the second canvas and take the decode-ahead thread.
+ * Without them the frames are decoded in the timer.
+ */
+static void decode_ahead_start(lv_gif_t * gifobj)
+{
+    gd_GIF * gif = gifobj->gif;
+    uint32_t canvas_size = gif->width * gif->height * 4;
+
+    gifobj->canvas_alloc = lv_malloc(canvas_size);
+    if(gifobj->canvas_alloc == NULL) {
+        LV_LOG_WARN("Couldn't allocate the canvas for the next frame");
+        return;
+    }
+
+    if(!decode_ahead_ref()) {
+        lv_free(gifobj->canvas_alloc);
+        gifobj->canvas_alloc = NULL;
+        return;
+    }
+
+    /*Both canvases start with the background*/
+    lv_memcpy(gifobj->canvas_alloc, gif->canvas, canvas_size);
+    gifobj->canvas_next = gifobj->canvas_alloc;
+    lv_area_set(&gifobj->next_stale, 0, 0, -1, -1);
+    gifobj->delay = 0;
+    gifobj->next_state = LV_GIF_NEXT_IDLE;
+}
+
+static void decode_ahead_stop(lv_gif_t * gifobj)
+{
+    if(gifobj->canvas_next == NULL) return;
+
+    job_wait(gifobj);
+    decode_ahead_unref();
+
+    lv_free(gifobj->canvas_alloc);
+    gifobj->canvas_alloc = NULL;
+    gifobj->canvas_next = NULL;
+    gifobj->next_state = LV_GIF_NEXT_IDLE;
+}
+
+/**
+ * Start the thread for the first GIF
+ * @return true: the thread is running
+ */
+static bool decode_ahead_ref(void)
+{
+    lv_gif_decode_ahead_t * state = decode_ahead;
+    if(state == NULL) {
+        state = lv_malloc_zeroed(sizeof(lv_gif_decode_ahead_t));
+        LV_ASSERT_MALLOC(state);
+        if(state == NULL) return false;
+
+        lv_mutex_init(&state->lock);
+        lv_thread_sync_init(&state->sync);
+        lv_thread_sync_init(&state->done_sync);
+        lv_ll_init(&state->jobs, sizeof(lv_gif_t *));
+
+        if(lv_thread_init(&state->thread, LV_THREAD_PRIO_MID, decode_ahead_thread_cb, THREAD_STACK_SIZE,
+                          state) != LV_RESULT_OK) {
+            LV_LOG_WARN("Couldn't create the decode-ahead thread");
+            lv_thread_sync_delete(&state->done_sync);
+            lv_thread_sync_delete(&state->sync);
+            lv_mutex_delete(&state->lock);
+            lv_free(state);
+            return false;
+        }
+
+        decode_ahead = state;
+    }
+
+    state->ref_cnt++;
+    return true;
+}
+
+/**
+ * Stop the thread after the last GIF
+ */
+static void decode_ahead_unref(void)
+{
+    lv_gif_decode_ahead_t * state = decode_ahead;
+    state->ref_cnt--;
+    if(state->ref_cnt > 0) return;
+
+    lv_mutex_lock(&state->lock);
+    state->exit = true;
+    lv_mutex_unlock(&state->lock);
+    lv_thread_sync_signal(&state->sync);
+    lv_thread_delete(&state->thread);
+
+    lv_ll_clear(&state->jobs);
+    lv_thread_sync_delete(&state->done_sync);
+    lv_thread_sync_delete(&state->sync);
+    lv_mutex_delete(&state->lock);
+    lv_free(state);
+    decode_ahead = NULL;
+}
+
+static void decode_ahead_thread_cb(void * user_data)
+{
+    lv_gif_decode_ahead_t * state = user_data;
+
+    while(1) {
+        lv_mutex_lock(&state->lock);
+        if(state->exit) {
+            lv_mutex_unlock(&state->lock);
+            break;
+        }
+
+        lv_gif_t ** job = lv_ll_get_head(&state->jobs);
+        if(job == NULL) {
+            lv_mutex_unlock(&state->lock);
+            lv_thread_sync_wait(&state->sync);
+            continue;
+        }
+
+        lv_gif_t * gifobj = *job;
+        lv_ll_remove(&state->jobs, job);
+        lv_free(job);
+        gifobj->next_state = LV_GIF_NEXT_RUNNING;
+        lv_mutex_unlock(&state->lock);
+
+        next_frame_prepare(gifobj);
+
+        lv_mutex_lock(&state->lock);
+        gifobj->next_state = LV_GIF_NEXT_READY;
+        lv_mutex_unlock(&state->lock);
+        lv_thread_sync_signal(&state->done_sync);
+    }
+}
+
+/**
+ * Ask the thread to decode the next frame unless it's decoded already
+ */
+static void job_queue(lv_gif_t * gifobj)
+{
+    lv_gif_decode_ahead_t * state = decode_ahead;
+
+    lv_mutex_lock(&state->lock);
+    if(gifobj->next_state == LV_GIF_NEXT_IDLE) {
+        lv_gif_t ** job = lv_ll_ins_tail(&state->jobs);
+        LV_ASSERT_MALLOC(job);
+        if(job) {
+            *job = gifobj;
+            gifobj->next_state = LV_GIF_NEXT_QUEUED;
+        }
+    }
+    lv_mutex_unlock(&state->lock);
+    lv_thread_sync_signal(&state->sync);
+}
+
+/**
+ * Remove the job of the GIF if the thread hasn't started it yet or wait until it's finished.
+ * After this `next_state` is either `LV_GIF_NEXT_IDLE` or `LV_GIF_NEXT_READY`.
+ */
+static void job_wait(lv_gif_t * gifobj)
+{
+    lv_gif_decode_ahead_t * state = decode_ahead;
+
+    lv_mutex_lock(&state->lock);
+    if(gifobj->next_state == LV_GIF_NEXT_QUEUED) {
+        lv_gif_t ** job;
+        LV_LL_READ(&state->jobs, job) {
+            if(*job == gifobj) {
+                lv_ll_remove(&state->jobs, job);
+                lv_free(job);
+                break;
+            }
+        }
+        gifobj->next_state = LV_GIF_NEXT_IDLE;
+    }
+
+    while(gifobj->next_state == LV_GIF_NEXT_RUNNING) {
+        lv_mutex_unlock(&state->lock);
+        lv_thread_sync_wait(&state->done_sync);
+        lv_mutex_lock(&state->lock);
+    }
+    lv_mutex_unlock(&state->lock);
+}
+
+/**
+ * Decode the next frame onto `canvas_next` while the current frame is shown from the other canvas
+ */
+static void next_frame_prepare(lv_gif_t * gifobj)
+{
+    gd_GIF * gif = gifobj->gif;
+
+    /*Bring the canvas up to date with the shown frame first*/
+    const lv_area_t * stale = &gifobj->next_stale;
+    if(stale->x2 >= stale->x1 && stale->y2 >= stale->y1) {
+        uint32_t stride = gif->width * 4;
+        uint32_t offset = stale->y1 * stride + stale->x1 * 4;
+        uint32_t len = lv_area_get_width(stale) * 4;
+        int32_t y;
+        for(y = stale->y1; y <= stale->y2; y++) {
+            lv_memcpy(gifobj->canvas_next + offset, gifobj->imgdsc.data + offset, len);
+            offset += stride;
+        }
+    }
+
+    gifobj->next_res = frame_decode(gifobj, gifobj->canvas_next, &gifobj->next_area);
+    gifobj->next_delay = gif->gce.delay;
+}
+
+/**
+ * Show the decoded next frame by swapping the canvases
+ * @return the return value of `gd_get_frame()` for the frame
+ */
+static int next_frame_show(lv_gif_t * gifobj)
+{
+    lv_obj_t * obj = (lv_obj_t *)gifobj;
+
+    uint8_t * shown = (uint8_t *)gifobj->imgdsc.data;
+    gifobj->imgdsc.data = gifobj->canvas_next;
+    gifobj->canvas_next = shown;
+
+    /*The other canvas misses only the changes of this frame*/
+    gifobj->next_stale = gifobj->next_area;
+    gifobj->delay = gifobj->next_delay;
+    gifobj->next_state = LV_GIF_NEXT_IDLE;
 
     lv_image_cache_drop(lv_image_get_src(obj));
-    lv_obj_invalidate(obj);
+    invalidate_frame_area(obj, &gifobj->next_area);
+
+    return gifobj->next_res;
 }
 
+#endif /*LV_GIF_DECODE_AHEAD*/
+
 #endif /*LV_USE_GIF*/
@@ -27,6 +27,14 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+/** State of the frame decoded ahead*/
+typedef enum {
+    LV_GIF_NEXT_IDLE,
+    LV_GIF_NEXT_QUEUED,
+    LV_GIF_NEXT_RUNNING,
+    LV_GIF_NEXT_READY,
+} lv_gif_next_state_t;
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -37,6 +45,16 @@ struct lv_gif_t {
     lv_timer_t * timer;
     lv_image_dsc_t imgdsc;
     uint32_t last_call;
+#if LV_GIF_DECODE_AHEAD
+    uint8_t * canvas_next;              /**< The next frame is decoded here while `imgdsc.data` is shown*/
+    uint8_t * canvas_alloc;             /**< The canvas allocated besides the one in `gif`*/
+    lv_area_t next_stale;               /**< Area of `canvas_next` which is older than the shown frame*/
+    lv_area_t next_area;                /**< Area changed by the next frame*/
+    uint32_t delay;                     /**< Delay of the shown frame in 10 ms units*/
+    uint32_t next_delay;
+    int32_t next_res;                   /**< Return value of `gd_get_frame()` for the next frame*/
+    lv_gif_next_state_t next_state;     /**< Protected by the lock of the decode-ahead thread*/
+#endif
 };
 
 
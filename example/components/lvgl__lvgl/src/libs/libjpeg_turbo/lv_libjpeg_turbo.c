@@ -29,6 +29,14 @@
 #define JPEG_SIGNATURE 0xFFD8FF
 #define IS_JPEG_SIGNATURE(x) (((x) & 0x00FFFFFF) == JPEG_SIGNATURE)
 
+#if LV_LIBJPEG_TURBO_THREAD_CNT > 1
+    #define SLICE_WORKER_CNT        (LV_LIBJPEG_TURBO_THREAD_CNT - 1)
+    #define SLICE_THREAD_STACK_SIZE (32 * 1024)
+    #define MARKER_SOF0             0xC0    /*Baseline frame header*/
+    #define MARKER_SOF1             0xC1    /*Extended sequential frame header*/
+    #define MARKER_SOS              0xDA    /*Scan header*/
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -37,19 +45,70 @@ typedef struct error_mgr_s {
     jmp_buf jb;
 } error_mgr_t;
 
+#if LV_LIBJPEG_TURBO_THREAD_CNT > 1
+/** Where the restart intervals of a baseline JPEG are*/
+typedef struct {
+    const uint8_t * data;
+    uint32_t header_size;       /**< Everything up to the end of the SOS header*/
+    uint32_t sof_pos;           /**< Position of the SOF marker to patch the height*/
+    uint32_t interval_cnt;
+    uint32_t interval_rows;     /**< Pixel rows per restart interval*/
+    uint32_t * ofs;             /**< `interval_cnt + 1` items: start of the intervals and the end of the last one*/
+    uint32_t height;
+} jpeg_slices_t;
+
+/** Decode the intervals `first..last` into their rows of `decoded`*/
+typedef struct {
+    const jpeg_slices_t * slices;
+    lv_draw_buf_t * decoded;
+    uint32_t angle;
+    uint32_t first;
+    uint32_t last;
+    bool ok;
+} slice_job_t;
+
+typedef struct {
+    lv_thread_t thread;
+    lv_thread_sync_t sync;      /**< Signaled when `job` is set or on exit*/
+    struct slice_pool_t * pool;
+    slice_job_t * job;          /**< Protected by the `lock` of the pool*/
+    bool exit;                  /**< Protected by the `lock` of the pool*/
+} slice_worker_t;
+
+/** Threads decoding the slices of one image at a time*/
+typedef struct slice_pool_t {
+    slice_worker_t workers[SLICE_WORKER_CNT];
+    uint32_t worker_cnt;        /**< Number of the started workers*/
+    lv_mutex_t lock;
+    lv_thread_sync_t done_sync; /**< Signaled when `pending` becomes 0*/
+    uint32_t pending;           /**< Jobs running on the workers, protected by `lock`*/
+    bool busy;                  /**< An image is being decoded, protected by `lock`*/
+    bool started;
+} slice_pool_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static lv_result_t decoder_info(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc, lv_image_header_t * header);
 static lv_result_t decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
 static void decoder_close(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
-static lv_draw_buf_t * decode_jpeg_file(const char * filename);
+static lv_draw_buf_t * decode_jpeg_file(lv_image_decoder_t * decoder, const char * filename);
 static uint8_t * read_file(const char * filename, uint32_t * size);
 static bool get_jpeg_head_info(const char * filename, uint32_t * width, uint32_t * height, uint32_t * orientation);
 static bool get_jpeg_size(uint8_t * data, uint32_t data_size, uint32_t * width, uint32_t * height);
 static bool get_jpeg_direction(uint8_t * data, uint32_t data_size, uint32_t * orientation);
 static void rotate_buffer(lv_draw_buf_t * decoded, uint8_t * buffer, uint32_t line_index, uint32_t angle);
 static void error_exit(j_common_ptr cinfo);
+
+#if LV_LIBJPEG_TURBO_THREAD_CNT > 1
+    static lv_draw_buf_t * decode_parallel(lv_image_decoder_t * decoder, j_decompress_ptr cinfo,
+                                           const uint8_t * data, uint32_t data_size, uint32_t angle);
+    static bool slices_find(j_decompress_ptr cinfo, const uint8_t * data, uint32_t data_size, jpeg_slices_t * slices);
+    static bool slice_decode(slice_job_t * job);
+    static void slice_worker_cb(void * user_data);
+    static void slice_pool_delete(slice_pool_t * pool);
+#endif
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -81,6 +140,16 @@ void lv_libjpeg_turbo_init(void)
     lv_image_decoder_set_close_cb(dec, decoder_close);
 
     dec->name = DECODER_NAME;
+
+#if LV_LIBJPEG_TURBO_THREAD_CNT > 1
+    /*The threads are started on the first image to decode in parallel*/
+    slice_pool_t * pool = lv_malloc_zeroed(sizeof(slice_pool_t));
+    LV_ASSERT_MALLOC(pool);
+    if(pool == NULL) return;
+    lv_mutex_init(&pool->lock);
+    lv_thread_sync_init(&pool->done_sync);
+    dec->user_data = pool;
+#endif
 }
 
 void lv_libjpeg_turbo_deinit(void)
@@ -88,6 +157,9 @@ void lv_libjpeg_turbo_deinit(void)
     lv_image_decoder_t * dec = NULL;
     while((dec = lv_image_decoder_get_next(dec)) != NULL) {
         if(dec->info_cb == decoder_info) {
+#if LV_LIBJPEG_TURBO_THREAD_CNT > 1
+            if(dec->user_data) slice_pool_delete(dec->user_data);
+#endif
             lv_image_decoder_delete(dec);
             break;
         }
@@ -159,12 +231,10 @@ static lv_result_t decoder_info(lv_image_decoder_t * decoder, lv_image_decoder_d
  */
 static lv_result_t decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc)
 {
-    LV_UNUSED(decoder); /*Unused*/
-
     /*If it's a JPEG file...*/
     if(dsc->src_type == LV_IMAGE_SRC_FILE) {
         const char * fn = dsc->src;
-        lv_draw_buf_t * decoded = decode_jpeg_file(fn);
+        lv_draw_buf_t * decoded = decode_jpeg_file(decoder, fn);
         if(decoded == NULL) {
             LV_LOG_WARN("decode jpeg file failed");
             return LV_RESULT_INVALID;
@@ -262,7 +332,7 @@ failed:
     return data;
 }
 
-static lv_draw_buf_t * decode_jpeg_file(const char * filename)
+static lv_draw_buf_t * decode_jpeg_file(lv_image_decoder_t * decoder, const char * filename)
 {
     /* This struct contains the JPEG decompression parameters and pointers to
      * working space (which is allocated as needed by the JPEG library).
@@ -343,6 +413,18 @@ static lv_draw_buf_t * decode_jpeg_file(const char * filename)
 
     cinfo.out_color_space = JCS_EXT_BGR;
 
+#if LV_LIBJPEG_TURBO_THREAD_CNT > 1
+    /*Decode the slices between the restart markers on the worker threads if possible*/
+    lv_draw_buf_t * decoded_parallel = decode_parallel(decoder, &cinfo, data, data_size, image_angle);
+    if(decoded_parallel) {
+        jpeg_destroy_decompress(&cinfo);
+        lv_free(data);
+        return decoded_parallel;
+    }
+#else
+    LV_UNUSED(decoder);
+#endif
+
     /* In this example, we don't need to change any of the defaults set by
      * jpeg_read_header(), so we do nothing here.
      */
@@ -595,4 +677,334 @@ static void error_exit(j_common_ptr cinfo)
     longjmp(myerr->jb, 1);
 }
 
+#if LV_LIBJPEG_TURBO_THREAD_CNT > 1
+
+/**
+ * Decode a JPEG image in horizontal slices on the worker threads and on the calling thread.
+ * The slices are cut at the restart markers and every slice is decoded as a standalone JPEG with
+ * one more interval above and below it, so the upsampled chroma at the borders is the same as in a
+ * sequential decoding.
+ * @param decoder   pointer to the decoder
+ * @param cinfo     the decompressor after `jpeg_read_header()`
+ * @param data      the whole JPEG file
+ * @param data_size size of `data`
+ * @param angle     the rotation from the Exif data
+ * @return          the decoded image or NULL if the image can't be decoded in parallel
+ */
+static lv_draw_buf_t * decode_parallel(lv_image_decoder_t * decoder, j_decompress_ptr cinfo,
+                                       const uint8_t * data, uint32_t data_size, uint32_t angle)
+{
+    slice_pool_t * pool = decoder->user_data;
+    if(pool == NULL) return NULL;
+
+    jpeg_slices_t slices;
+    if(!slices_find(cinfo, data, data_size, &slices)) return NULL;
+
+    /*Only one image is decoded in parallel at a time, the others are decoded sequentially*/
+    lv_mutex_lock(&pool->lock);
+    bool busy = pool->busy;
+    pool->busy = true;
+    lv_mutex_unlock(&pool->lock);
+    if(busy) {
+        lv_free(slices.ofs);
+        return NULL;
+    }
+
+    uint32_t i;
+    if(!pool->started) {
+        pool->started = true;
+        for(i = 0; i < SLICE_WORKER_CNT; i++) {
+            slice_worker_t * worker = &pool->workers[i];
+            worker->pool = pool;
+            lv_thread_sync_init(&worker->sync);
+            if(lv_thread_init(&worker->thread, LV_THREAD_PRIO_MID, slice_worker_cb, SLICE_THREAD_STACK_SIZE,
+                              worker) != LV_RESULT_OK) {
+                lv_thread_sync_delete(&worker->sync);
+                break;
+            }
+            pool->worker_cnt++;
+        }
+    }
+
+    /*No threads could be started, the caller decodes the image sequentially*/
+    if(pool->worker_cnt == 0) {
+        lv_mutex_lock(&pool->lock);
+        pool->busy = false;
+        lv_mutex_unlock(&pool->lock);
+        lv_free(slices.ofs);
+        return NULL;
+    }
+
+    uint32_t buf_width = (angle % 180) ? cinfo->image_height : cinfo->image_width;
+    uint32_t buf_height = (angle % 180) ? cinfo->image_width : cinfo->image_height;
+    lv_draw_buf_t * decoded = lv_draw_buf_create_ex(image_cache_draw_buf_handlers, buf_width, buf_height,
+                                                    LV_COLOR_FORMAT_RGB888, LV_STRIDE_AUTO);
+    bool ok = decoded != NULL;
+    if(ok) {
+        slice_job_t jobs[LV_LIBJPEG_TURBO_THREAD_CNT];
+        uint32_t job_cnt = LV_MIN(pool->worker_cnt + 1, slices.interval_cnt);
+        for(i = 0; i < job_cnt; i++) {
+            jobs[i].slices = &slices;
+            jobs[i].decoded = decoded;
+            jobs[i].angle = angle;
+            jobs[i].first = slices.interval_cnt * i / job_cnt;
+            jobs[i].last = slices.interval_cnt * (i + 1) / job_cnt - 1;
+            jobs[i].ok = false;
+        }
+
+        lv_mutex_lock(&pool->lock);
+        pool->pending = job_cnt - 1;
+        for(i = 1; i < job_cnt; i++) pool->workers[i - 1].job = &jobs[i];
+        lv_mutex_unlock(&pool->lock);
+
+        for(i = 1; i < job_cnt; i++) lv_thread_sync_signal(&pool->workers[i - 1].sync);
+
+        /*The first slice is decoded here*/
+        jobs[0].ok = slice_decode(&jobs[0]);
+
+        while(1) {
+            lv_mutex_lock(&pool->lock);
+            uint32_t pending = pool->pending;
+            lv_mutex_unlock(&pool->lock);
+            if(pending == 0) break;
+            lv_thread_sync_wait(&pool->done_sync);
+        }
+
+        for(i = 0; i < job_cnt; i++) ok = ok && jobs[i].ok;
+    }
+
+    lv_mutex_lock(&pool->lock);
+    pool->busy = false;
+    lv_mutex_unlock(&pool->lock);
+
+    lv_free(slices.ofs);
+
+    if(!ok) {
+        LV_LOG_WARN("parallel decoding failed, decoding sequentially");
+        if(decoded) lv_draw_buf_destroy(decoded);
+        return NULL;
+    }
+
+    return decoded;
+}
+
+/**
+ * Find the restart intervals of a JPEG image if it can be decoded in slices:
+ * a baseline, single scan image whose restart intervals are whole MCU rows.
+ * @param cinfo     the decompressor after `jpeg_read_header()`
+ * @param data      the whole JPEG file
+ * @param data_size size of `data`
+ * @param slices    store the intervals here. `slices->ofs` needs to be freed if true is returned
+ * @return          true: the image can be decoded in slices
+ */
+static bool slices_find(j_decompress_ptr cinfo, const uint8_t * data, uint32_t data_size, jpeg_slices_t * slices)
+{
+    if(cinfo->restart_interval == 0 || cinfo->progressive_mode || cinfo->arith_code) return false;
+    if(cinfo->comps_in_scan != cinfo->num_components) return false;
+
+    uint32_t mcu_w = cinfo->comps_in_scan == 1 ? DCTSIZE : (uint32_t)cinfo->max_h_samp_factor * DCTSIZE;
+    uint32_t mcu_h = cinfo->comps_in_scan == 1 ? DCTSIZE : (uint32_t)cinfo->max_v_samp_factor * DCTSIZE;
+    uint32_t mcus_per_row = (cinfo->image_width + mcu_w - 1) / mcu_w;
+    if(cinfo->restart_interval % mcus_per_row != 0) return false;
+
+    slices->data = data;
+    slices->height = cinfo->image_height;
+    slices->interval_rows = cinfo->restart_interval / mcus_per_row * mcu_h;
+    slices->interval_cnt = (slices->height + slices->interval_rows - 1) / slices->interval_rows;
+    if(slices->interval_cnt < 2) return false;
+
+    /*Find the frame header and the end of the scan header*/
+    uint32_t pos = 2;
+    uint32_t sof_pos = 0;
+    while(1) {
+        if(pos + 4 > data_size || data[pos] != 0xFF) return false;
+        uint8_t marker = data[pos + 1];
+        if(marker == 0xFF) {
+            pos++;  /*Fill byte*/
+            continue;
+        }
+
+        if(marker == MARKER_SOF0 || marker == MARKER_SOF1) sof_pos = pos;
+        pos += 2 + ((data[pos + 2] << 8) | data[pos + 3]);
+        if(marker == MARKER_SOS) break;
+    }
+    if(sof_pos == 0 || pos >= data_size) return false;
+
+    slices->sof_pos = sof_pos;
+    slices->header_size = pos;
+    slices->ofs = lv_malloc((slices->interval_cnt + 1) * sizeof(uint32_t));
+    if(slices->ofs == NULL) return false;
+
+    /*Find the restart markers in the entropy coded data. There has to be one between every interval*/
+    uint32_t cnt = 0;
+    bool eoi = false;
+    slices->ofs[0] = pos;
+    while(pos + 1 < data_size) {
+        if(data[pos] != 0xFF) {
+            pos++;
+            continue;
+        }
+
+        uint8_t marker = data[pos + 1];
+        if(marker == 0x00) {
+            pos += 2;   /*Stuffed 0xFF byte*/
+        }
+        else if(marker == 0xFF) {
+            pos++;
+        }
+        else if(marker >= JPEG_RST0 && marker <= JPEG_RST0 + 7) {
+            cnt++;
+            if(cnt >= slices->interval_cnt) break;
+            pos += 2;
+            slices->ofs[cnt] = pos;
+        }
+        else {
+            if(marker == JPEG_EOI && cnt == slices->interval_cnt - 1) {
+                slices->ofs[slices->interval_cnt] = pos + 2;
+                eoi = true;
+            }
+            /*Any other marker (e.g. another scan) prevents the slicing*/
+            break;
+        }
+    }
+
+    if(!eoi) {
+        lv_free(slices->ofs);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Decode the intervals of a job and write their rows into the decoded image
+ * @param job   the job to decode
+ * @return      true: success
+ */
+static bool slice_decode(slice_job_t * job)
+{
+    const jpeg_slices_t * slices = job->slices;
+
+    /*Decode one more interval above and below as context for the upsampling*/
+    uint32_t dec_first = job->first > 0 ? job->first - 1 : 0;
+    uint32_t dec_last = LV_MIN(job->last + 1, slices->interval_cnt - 1);
+
+    /*Build a standalone JPEG: the headers with the height of the slice and the intervals with renumbered markers*/
+    uint32_t size = slices->header_size;
+    uint32_t i;
+    for(i = dec_first; i <= dec_last; i++) size += slices->ofs[i + 1] - slices->ofs[i];
+
+    uint8_t * slice_data = lv_malloc(size);
+    if(slice_data == NULL) return false;
+
+    uint32_t y_start = dec_first * slices->interval_rows;
+    uint32_t y_end = LV_MIN((dec_last + 1) * slices->interval_rows, slices->height);
+    lv_memcpy(slice_data, slices->data, slices->header_size);
+    slice_data[slices->sof_pos + 5] = (uint8_t)((y_end - y_start) >> 8);
+    slice_data[slices->sof_pos + 6] = (uint8_t)(y_end - y_start);
+
+    uint8_t * p = slice_data + slices->header_size;
+    for(i = dec_first; i <= dec_last; i++) {
+        uint32_t len = slices->ofs[i + 1] - 2 - slices->ofs[i];
+        lv_memcpy(p, slices->data + slices->ofs[i], len);
+        p += len;
+        *p++ = 0xFF;
+        *p++ = i < dec_last ? (uint8_t)(JPEG_RST0 + ((i - dec_first) & 7)) : JPEG_EOI;
+    }
+
+    uint32_t own_start = job->first * slices->interval_rows;
+    uint32_t own_end = LV_MIN((job->last + 1) * slices->interval_rows, slices->height);
+
+    struct jpeg_decompress_struct cinfo;
+    error_mgr_t jerr;
+    cinfo.err = jpeg_std_error(&jerr.pub);
+    jerr.pub.error_exit = error_exit;
+    if(setjmp(jerr.jb)) {
+        jpeg_destroy_decompress(&cinfo);
+        lv_free(slice_data);
+        return false;
+    }
+
+    jpeg_create_decompress(&cinfo);
+    jpeg_mem_src(&cinfo, slice_data, size);
+    jpeg_read_header(&cinfo, TRUE);
+    cinfo.out_color_space = JCS_EXT_BGR;
+    jpeg_start_decompress(&cinfo);
+
+    JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)
+                        ((j_common_ptr) &cinfo, JPOOL_IMAGE, cinfo.output_width * cinfo.output_components, 1);
+    lv_draw_buf_t * decoded = job->decoded;
+
+    /*The rows below the owned ones are needed only while upsampling the last owned rows*/
+    while(cinfo.output_scanline < cinfo.output_height) {
+        uint32_t y = y_start + cinfo.output_scanline;
+        if(y >= own_end) break;
+
+        if(y >= own_start && job->angle == 0) {
+            /*Directly into the decoded image*/
+            JSAMPROW row = decoded->data + y * decoded->header.stride;
+            jpeg_read_scanlines(&cinfo, &row, 1);
+        }
+        else {
+            jpeg_read_scanlines(&cinfo, buffer, 1);
+            if(y >= own_start) rotate_buffer(decoded, buffer[0], y, job->angle);
+        }
+    }
+
+    /*Not finished as the rows below are not read*/
+    jpeg_destroy_decompress(&cinfo);
+    lv_free(slice_data);
+
+    return true;
+}
+
+static void slice_worker_cb(void * user_data)
+{
+    slice_worker_t * worker = user_data;
+    slice_pool_t * pool = worker->pool;
+
+    while(1) {
+        lv_mutex_lock(&pool->lock);
+        slice_job_t * job = worker->job;
+        bool exit = worker->exit;
+        lv_mutex_unlock(&pool->lock);
+
+        if(exit) break;
+        if(job == NULL) {
+            lv_thread_sync_wait(&worker->sync);
+            continue;
+        }
+
+        job->ok = slice_decode(job);
+
+        lv_mutex_lock(&pool->lock);
+        worker->job = NULL;
+        pool->pending--;
+        bool done = pool->pending == 0;
+        lv_mutex_unlock(&pool->lock);
+
+        if(done) lv_thread_sync_signal(&pool->done_sync);
+    }
+}
+
+static void slice_pool_delete(slice_pool_t * pool)
+{
+    uint32_t i;
+    for(i = 0; i < pool->worker_cnt; i++) {
+        slice_worker_t * worker = &pool->workers[i];
+        lv_mutex_lock(&pool->lock);
+        worker->exit = true;
+        lv_mutex_unlock(&pool->lock);
+        lv_thread_sync_signal(&worker->sync);
+        lv_thread_delete(&worker->thread);
+        lv_thread_sync_delete(&worker->sync);
+    }
+
+    lv_thread_sync_delete(&pool->done_sync);
+    lv_mutex_delete(&pool->lock);
+    lv_free(pool);
+}
+
+#endif /*LV_LIBJPEG_TURBO_THREAD_CNT > 1*/
+
 #endif /*LV_USE_LIBJPEG_TURBO*/
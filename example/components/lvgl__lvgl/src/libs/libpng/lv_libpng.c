@@ -23,10 +23,40 @@
 
 #define image_cache_draw_buf_handlers &(LV_GLOBAL_DEFAULT()->image_cache_draw_buf_handlers)
 
+#define STRIP_HEIGHT        LV_LIBPNG_STRIP_HEIGHT
+
+/*Number of idle strip decoders kept to continue decoding where the previous draw has stopped*/
+#define STRIP_DECODER_CNT   4
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_LIBPNG_STRIP_HEIGHT
+/** A row by row decoding of an image*/
+typedef struct {
+    lv_image_src_t src_type;
+    const void * src;           /**< Copy of the path for files*/
+    lv_fs_file_t file;
+    const uint8_t * data;       /**< Data of the variable images*/
+    uint32_t data_size;
+    uint32_t data_pos;
+    png_structp png;
+    png_infop info;
+    int32_t w;
+    int32_t h;
+    int32_t next_row;           /**< The row `png_read_row()` returns next*/
+    int32_t strip_y;            /**< The first row in `strip` or -1*/
+    lv_draw_buf_t * strip;
+} strip_decoder_t;
+
+/** Idle strip decoders, the last used first*/
+typedef struct {
+    lv_ll_t decoders;           /**< `strip_decoder_t *`s*/
+    lv_mutex_t lock;
+} strip_pool_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -35,6 +65,17 @@ static lv_result_t decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
 static void decoder_close(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
 static lv_draw_buf_t * decode_png(lv_image_decoder_dsc_t * dsc);
 
+#if LV_LIBPNG_STRIP_HEIGHT
+    static lv_result_t decoder_get_area(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc,
+                                        const lv_area_t * full_area, lv_area_t * decoded_area);
+    static strip_decoder_t * strip_decoder_acquire(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
+    static void strip_decoder_release(lv_image_decoder_t * decoder, strip_decoder_t * sd);
+    static void strip_decoder_delete(strip_decoder_t * sd);
+    static bool strip_decoder_restart(strip_decoder_t * sd);
+    static bool strip_decoder_read(strip_decoder_t * sd, int32_t y);
+    static void strip_read_cb(png_structp png, png_bytep data, size_t length);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -58,6 +99,17 @@ void lv_libpng_init(void)
     lv_image_decoder_set_close_cb(dec, decoder_close);
 
     dec->name = DECODER_NAME;
+
+#if LV_LIBPNG_STRIP_HEIGHT
+    lv_image_decoder_set_get_area_cb(dec, decoder_get_area);
+
+    strip_pool_t * pool = lv_malloc_zeroed(sizeof(strip_pool_t));
+    LV_ASSERT_MALLOC(pool);
+    if(pool == NULL) return;
+    lv_ll_init(&pool->decoders, sizeof(strip_decoder_t *));
+    lv_mutex_init(&pool->lock);
+    dec->user_data = pool;
+#endif
 }
 
 void lv_libpng_deinit(void)
@@ -65,6 +117,18 @@ void lv_libpng_deinit(void)
     lv_image_decoder_t * dec = NULL;
     while((dec = lv_image_decoder_get_next(dec)) != NULL) {
         if(dec->info_cb == decoder_info) {
+#if LV_LIBPNG_STRIP_HEIGHT
+            strip_pool_t * pool = dec->user_data;
+            if(pool) {
+                strip_decoder_t ** sd_p;
+                LV_LL_READ(&pool->decoders, sd_p) {
+                    strip_decoder_delete(*sd_p);
+                }
+                lv_ll_clear(&pool->decoders);
+                lv_mutex_delete(&pool->lock);
+                lv_free(pool);
+            }
+#endif
             lv_image_decoder_delete(dec);
             break;
         }
@@ -138,6 +202,19 @@ static lv_result_t decoder_info(lv_image_decoder_t * decoder, lv_image_decoder_d
 static lv_result_t decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc)
 {
     LV_UNUSED(decoder); /*Unused*/
+
+#if LV_LIBPNG_STRIP_HEIGHT
+    /*Decode the tall images in strips in `decoder_get_area()` if the caller can draw them so*/
+    if(dsc->args.partial && !dsc->args.use_indexed && dsc->header.h > STRIP_HEIGHT) {
+        strip_decoder_t * sd = strip_decoder_acquire(decoder, dsc);
+        if(sd) {
+            dsc->user_data = sd;
+            dsc->decoded = NULL;
+            return LV_RESULT_OK;
+        }
+    }
+#endif
+
     lv_draw_buf_t * decoded;
     decoded = decode_png(dsc);
 
@@ -188,6 +265,15 @@ static void decoder_close(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t *
 {
     LV_UNUSED(decoder); /*Unused*/
 
+#if LV_LIBPNG_STRIP_HEIGHT
+    if(dsc->user_data) {
+        strip_decoder_release(decoder, dsc->user_data);
+        dsc->user_data = NULL;
+        dsc->decoded = NULL;
+        return;
+    }
+#endif
+
     if(dsc->args.no_cache ||
        !lv_image_cache_is_enabled()) lv_draw_buf_destroy_user(image_cache_draw_buf_handlers, (lv_draw_buf_t *)dsc->decoded);
 }
@@ -328,4 +414,261 @@ static lv_draw_buf_t * decode_png(lv_image_decoder_dsc_t * dsc)
     return decoded;
 }
 
+#if LV_LIBPNG_STRIP_HEIGHT
+
+/**
+ * Decode the strip of rows containing the next rows of the area to draw
+ * @param decoder       pointer to the decoder
+ * @param dsc           pointer to the decoder descriptor
+ * @param full_area     the area of the image to draw
+ * @param decoded_area  in: the previously decoded area, `LV_COORD_MIN` for the first call.
+ *                      out: the area of the decoded strip
+ * @return              LV_RESULT_OK: a strip is decoded; LV_RESULT_INVALID: the whole area is decoded or error
+ */
+static lv_result_t decoder_get_area(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc,
+                                    const lv_area_t * full_area, lv_area_t * decoded_area)
+{
+    LV_UNUSED(decoder);
+
+    strip_decoder_t * sd = dsc->user_data;
+    if(sd == NULL) return LV_RESULT_INVALID;
+
+    int32_t y;
+    if(decoded_area->y1 == LV_COORD_MIN) y = (full_area->y1 / STRIP_HEIGHT) * STRIP_HEIGHT;
+    else y = decoded_area->y1 + STRIP_HEIGHT;
+
+    if(y > full_area->y2 || y >= sd->h) return LV_RESULT_INVALID;
+
+    if(!strip_decoder_read(sd, y)) return LV_RESULT_INVALID;
+
+    decoded_area->x1 = 0;
+    decoded_area->x2 = sd->w - 1;
+    decoded_area->y1 = y;
+    decoded_area->y2 = y + sd->strip->header.h - 1;
+    dsc->decoded = sd->strip;
+
+    return LV_RESULT_OK;
+}
+
+/**
+ * Get an idle strip decoder of the image or create a new one
+ * @param decoder   pointer to the decoder
+ * @param dsc       pointer to the decoder descriptor
+ * @return          the strip decoder or NULL if the image can't be decoded in strips
+ */
+static strip_decoder_t * strip_decoder_acquire(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc)
+{
+    strip_pool_t * pool = decoder->user_data;
+    if(pool == NULL) return NULL;
+    if(dsc->src_type != LV_IMAGE_SRC_FILE && dsc->src_type != LV_IMAGE_SRC_VARIABLE) return NULL;
+
+    lv_mutex_lock(&pool->lock);
+    strip_decoder_t ** sd_p;
+    LV_LL_READ(&pool->decoders, sd_p) {
+        strip_decoder_t * sd = *sd_p;
+        if(sd->src_type != dsc->src_type) continue;
+        if(dsc->src_type == LV_IMAGE_SRC_FILE ? lv_strcmp(sd->src, dsc->src) == 0 : sd->src == dsc->src) {
+            lv_ll_remove(&pool->decoders, sd_p);
+            lv_free(sd_p);
+            lv_mutex_unlock(&pool->lock);
+            return sd;
+        }
+    }
+    lv_mutex_unlock(&pool->lock);
+
+    strip_decoder_t * sd = lv_malloc_zeroed(sizeof(strip_decoder_t));
+    LV_ASSERT_MALLOC(sd);
+    if(sd == NULL) return NULL;
+
+    sd->src_type = dsc->src_type;
+    sd->strip_y = -1;
+    if(dsc->src_type == LV_IMAGE_SRC_FILE) {
+        if(lv_strcmp(lv_fs_get_ext(dsc->src), "png") != 0 ||
+           lv_fs_open(&sd->file, dsc->src, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+            lv_free(sd);
+            return NULL;
+        }
+        sd->src = lv_strdup(dsc->src);
+        LV_ASSERT_MALLOC(sd->src);
+    }
+    else {
+        const lv_image_dsc_t * img_dsc = dsc->src;
+        sd->src = img_dsc;
+        sd->data = img_dsc->data;
+        sd->data_size = img_dsc->data_size;
+    }
+
+    if(sd->src == NULL || !strip_decoder_restart(sd)) {
+        strip_decoder_delete(sd);
+        return NULL;
+    }
+
+    sd->strip = lv_draw_buf_create_ex(image_cache_draw_buf_handlers, sd->w, STRIP_HEIGHT, LV_COLOR_FORMAT_ARGB8888,
+                                      LV_STRIDE_AUTO);
+    if(sd->strip == NULL) {
+        LV_LOG_WARN("can't allocate the strip buffer");
+        strip_decoder_delete(sd);
+        return NULL;
+    }
+
+    return sd;
+}
+
+/**
+ * Keep a strip decoder to continue from its current row. The least recently used ones are deleted.
+ */
+static void strip_decoder_release(lv_image_decoder_t * decoder, strip_decoder_t * sd)
+{
+    strip_pool_t * pool = decoder->user_data;
+
+    lv_mutex_lock(&pool->lock);
+    strip_decoder_t ** sd_p = lv_ll_ins_head(&pool->decoders);
+    if(sd_p) *sd_p = sd;
+    else strip_decoder_delete(sd);
+
+    if(lv_ll_get_len(&pool->decoders) > STRIP_DECODER_CNT) {
+        sd_p = lv_ll_get_tail(&pool->decoders);
+        strip_decoder_delete(*sd_p);
+        lv_ll_remove(&pool->decoders, sd_p);
+        lv_free(sd_p);
+    }
+    lv_mutex_unlock(&pool->lock);
+}
+
+static void strip_decoder_delete(strip_decoder_t * sd)
+{
+    if(sd->png) png_destroy_read_struct(&sd->png, &sd->info, NULL);
+    if(sd->strip) lv_draw_buf_destroy_user(image_cache_draw_buf_handlers, sd->strip);
+    if(sd->src_type == LV_IMAGE_SRC_FILE) {
+        lv_fs_close(&sd->file);
+        lv_free((void *)sd->src);
+    }
+    lv_free(sd);
+}
+
+/**
+ * Start decoding from the first row
+ * @param sd    pointer to a strip decoder
+ * @return      false: error or the image is interlaced
+ */
+static bool strip_decoder_restart(strip_decoder_t * sd)
+{
+    if(sd->png) png_destroy_read_struct(&sd->png, &sd->info, NULL);
+    sd->next_row = 0;
+    sd->strip_y = -1;
+
+    if(sd->src_type == LV_IMAGE_SRC_FILE) {
+        if(lv_fs_seek(&sd->file, 0, LV_FS_SEEK_SET) != LV_FS_RES_OK) return false;
+    }
+    else {
+        sd->data_pos = 0;
+    }
+
+    sd->png = png_create_read_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+    if(sd->png == NULL) return false;
+    sd->info = png_create_info_struct(sd->png);
+    if(sd->info == NULL) {
+        png_destroy_read_struct(&sd->png, NULL, NULL);
+        return false;
+    }
+
+    if(setjmp(png_jmpbuf(sd->png))) {
+        LV_LOG_WARN("png read failed");
+        png_destroy_read_struct(&sd->png, &sd->info, NULL);
+        return false;
+    }
+
+    png_set_read_fn(sd->png, sd, strip_read_cb);
+    png_read_info(sd->png, sd->info);
+
+    /*All the rows are needed to decode an interlaced image*/
+    if(png_get_interlace_type(sd->png, sd->info) != PNG_INTERLACE_NONE) {
+        png_destroy_read_struct(&sd->png, &sd->info, NULL);
+        return false;
+    }
+
+    /*Convert everything to 8 bit BGRA like `PNG_FORMAT_BGRA` of the simplified API*/
+    png_byte color_type = png_get_color_type(sd->png, sd->info);
+    png_byte bit_depth = png_get_bit_depth(sd->png, sd->info);
+    bool has_trns = png_get_valid(sd->png, sd->info, PNG_INFO_tRNS) != 0;
+    if(bit_depth == 16) png_set_strip_16(sd->png);
+    if(color_type == PNG_COLOR_TYPE_PALETTE) png_set_palette_to_rgb(sd->png);
+    if(color_type == PNG_COLOR_TYPE_GRAY && bit_depth < 8) png_set_expand_gray_1_2_4_to_8(sd->png);
+    if(has_trns) png_set_tRNS_to_alpha(sd->png);
+    if(color_type == PNG_COLOR_TYPE_GRAY || color_type == PNG_COLOR_TYPE_GRAY_ALPHA) png_set_gray_to_rgb(sd->png);
+    if(!(color_type & PNG_COLOR_MASK_ALPHA) && !has_trns) png_set_filler(sd->png, 0xff, PNG_FILLER_AFTER);
+    png_set_bgr(sd->png);
+    png_read_update_info(sd->png, sd->info);
+
+    sd->w = (int32_t)png_get_image_width(sd->png, sd->info);
+    sd->h = (int32_t)png_get_image_height(sd->png, sd->info);
+
+    return true;
+}
+
+/**
+ * Decode the strip starting at a row into `sd->strip`
+ * @param sd    pointer to a strip decoder
+ * @param y     the first row of the strip
+ * @return      false: error
+ */
+static bool strip_decoder_read(strip_decoder_t * sd, int32_t y)
+{
+    if(sd->strip_y == y) return true;
+
+    /*The rows can be read only forward*/
+    if(sd->next_row > y && !strip_decoder_restart(sd)) return false;
+
+    LV_PROFILER_BEGIN;
+
+    lv_draw_buf_t * strip = sd->strip;
+    int32_t row_cnt = LV_MIN(STRIP_HEIGHT, sd->h - y);
+    strip->header.h = (uint32_t)row_cnt;
+
+    if(setjmp(png_jmpbuf(sd->png))) {
+        LV_LOG_WARN("png decode failed");
+        /*The decoder is in an unknown state now*/
+        png_destroy_read_struct(&sd->png, &sd->info, NULL);
+        sd->next_row = INT32_MAX;
+        sd->strip_y = -1;
+        LV_PROFILER_END;
+        return false;
+    }
+
+    /*Skip the rows above the strip*/
+    while(sd->next_row < y) {
+        png_read_row(sd->png, strip->data, NULL);
+        sd->next_row++;
+    }
+
+    int32_t i;
+    for(i = 0; i < row_cnt; i++) {
+        png_read_row(sd->png, strip->data + i * strip->header.stride, NULL);
+        sd->next_row++;
+    }
+
+    sd->strip_y = y;
+
+    LV_PROFILER_END;
+    return true;
+}
+
+static void strip_read_cb(png_structp png, png_bytep data, size_t length)
+{
+    strip_decoder_t * sd = png_get_io_ptr(png);
+
+    if(sd->src_type == LV_IMAGE_SRC_FILE) {
+        uint32_t rn = 0;
+        lv_fs_res_t res = lv_fs_read(&sd->file, data, (uint32_t)length, &rn);
+        if(res != LV_FS_RES_OK || rn != length) png_error(png, "file read failed");
+    }
+    else {
+        if(length > sd->data_size - sd->data_pos) png_error(png, "unexpected end of data");
+        lv_memcpy(data, sd->data + sd->data_pos, length);
+        sd->data_pos += (uint32_t)length;
+    }
+}
+
+#endif /*LV_LIBPNG_STRIP_HEIGHT*/
+
 #endif /*LV_USE_LIBPNG*/
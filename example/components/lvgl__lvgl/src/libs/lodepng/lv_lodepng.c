@@ -35,6 +35,7 @@ static lv_result_t decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
 static void decoder_close(lv_image_decoder_t * dec, lv_image_decoder_dsc_t * dsc);
 static void convert_color_depth(uint8_t * img_p, uint32_t px_cnt);
 static lv_draw_buf_t * decode_png_data(const void * png_data, size_t png_data_size);
+static uint8_t * read_png_file(lv_fs_file_t * f, size_t * size);
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -142,18 +143,31 @@ static lv_result_t decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
 
     const uint8_t * png_data = NULL;
     size_t png_data_size = 0;
+    lv_fs_file_t file;
+    bool png_data_mapped = false;
     if(dsc->src_type == LV_IMAGE_SRC_FILE) {
         const char * fn = dsc->src;
         if(lv_strcmp(lv_fs_get_ext(fn), "png") == 0) {              /*Check the extension*/
-            unsigned error;
-            error = lodepng_load_file((void *)&png_data, &png_data_size, fn);  /*Load the file*/
-            if(error) {
-                if(png_data != NULL) {
-                    lv_free((void *)png_data);
-                }
-                LV_LOG_WARN("error %u: %s\n", error, lodepng_error_text(error));
+            if(lv_fs_open(&file, fn, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+                LV_LOG_WARN("can't open %s", fn);
                 return LV_RESULT_INVALID;
             }
+
+            /*Decode straight from the memory of the file if it's available*/
+            uint32_t file_size;
+            png_data = lv_fs_get_buffer(&file, &file_size);
+            if(png_data) {
+                png_data_size = file_size;
+                png_data_mapped = true;
+            }
+            else {
+                png_data = read_png_file(&file, &png_data_size);
+                lv_fs_close(&file);
+                if(png_data == NULL) {
+                    LV_LOG_WARN("can't read %s", fn);
+                    return LV_RESULT_INVALID;
+                }
+            }
         }
     }
     else if(dsc->src_type == LV_IMAGE_SRC_VARIABLE) {
@@ -167,7 +181,8 @@ static lv_result_t decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
 
     lv_draw_buf_t * decoded = decode_png_data(png_data, png_data_size);
 
-    if(dsc->src_type == LV_IMAGE_SRC_FILE) lv_free((void *)png_data);
+    if(png_data_mapped) lv_fs_close(&file);
+    else if(dsc->src_type == LV_IMAGE_SRC_FILE) lv_free((void *)png_data);
 
     if(!decoded) {
         LV_LOG_WARN("Error decoding PNG");
@@ -223,6 +238,32 @@ static void decoder_close(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t *
        !lv_image_cache_is_enabled()) lv_draw_buf_destroy((lv_draw_buf_t *)dsc->decoded);
 }
 
+/**
+ * Read a whole opened file into the memory
+ * @param f     pointer to an opened file
+ * @param size  store the size of the file here
+ * @return      the content of the file allocated with `lv_malloc()` or NULL on error
+ */
+static uint8_t * read_png_file(lv_fs_file_t * f, size_t * size)
+{
+    uint32_t file_size;
+    if(lv_fs_seek(f, 0, LV_FS_SEEK_END) != LV_FS_RES_OK) return NULL;
+    if(lv_fs_tell(f, &file_size) != LV_FS_RES_OK) return NULL;
+    if(lv_fs_seek(f, 0, LV_FS_SEEK_SET) != LV_FS_RES_OK) return NULL;
+
+    uint8_t * data = lv_malloc(file_size);
+    if(data == NULL) return NULL;
+
+    uint32_t br;
+    if(lv_fs_read(f, data, file_size, &br) != LV_FS_RES_OK || br != file_size) {
+        lv_free(data);
+        return NULL;
+    }
+
+    *size = file_size;
+    return data;
+}
+
 static lv_draw_buf_t * decode_png_data(const void * png_data, size_t png_data_size)
 {
     unsigned png_width;             /*Not used, just required by the decoder*/
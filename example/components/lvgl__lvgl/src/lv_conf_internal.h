@@ -27,6 +27,7 @@
 #define LV_DRAW_SW_ASM_NONE         0
 #define LV_DRAW_SW_ASM_NEON         1
 #define LV_DRAW_SW_ASM_HELIUM       2
+#define LV_DRAW_SW_ASM_X86          3
 #define LV_DRAW_SW_ASM_CUSTOM       255
 
 /* Handle special Kconfig options */
@@ -214,6 +215,17 @@
     #endif
 #endif  /*LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN*/
 
+/*Serve the allocations of at most 256 bytes from slabs of this size, with one free list per 16 byte size class.
+ *It makes allocating the small objects (widgets, styles, event descriptors, etc.) faster
+ *and keeps them from fragmenting the heap. (1024 bytes..1 MB, 0: disable)*/
+#ifndef LV_MEM_SLAB_SIZE
+    #ifdef CONFIG_LV_MEM_SLAB_SIZE
+        #define LV_MEM_SLAB_SIZE CONFIG_LV_MEM_SLAB_SIZE
+    #else
+        #define LV_MEM_SLAB_SIZE 0
+    #endif
+#endif
+
 /*====================
    HAL SETTINGS
  *====================*/
@@ -518,7 +530,7 @@
     #if LV_DRAW_SW_COMPLEX == 1
         /*Allow buffering some shadow calculation.
         *LV_DRAW_SW_SHADOW_CACHE_SIZE is the max. shadow size to buffer, where shadow size is `shadow_width + radius`
-        *Caching has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost*/
+        *Caching a shadow has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost*/
         #ifndef LV_DRAW_SW_SHADOW_CACHE_SIZE
             #ifdef CONFIG_LV_DRAW_SW_SHADOW_CACHE_SIZE
                 #define LV_DRAW_SW_SHADOW_CACHE_SIZE CONFIG_LV_DRAW_SW_SHADOW_CACHE_SIZE
@@ -527,6 +539,16 @@
             #endif
         #endif
 
+        /*Max. memory used by the cached shadows in bytes.
+        *Several shadows are cached and the least recently used ones are freed first when it's full*/
+        #ifndef LV_DRAW_SW_SHADOW_CACHE_MEM_SIZE
+            #ifdef CONFIG_LV_DRAW_SW_SHADOW_CACHE_MEM_SIZE
+                #define LV_DRAW_SW_SHADOW_CACHE_MEM_SIZE CONFIG_LV_DRAW_SW_SHADOW_CACHE_MEM_SIZE
+            #else
+                #define LV_DRAW_SW_SHADOW_CACHE_MEM_SIZE (16 * 1024)
+            #endif
+        #endif
+
         /* Set number of maximally cached circle data.
         * The circumference of 1/4 circle are saved for anti-aliasing
         * radius * 4 bytes are used per circle (the most often used radiuses are saved)
@@ -540,6 +562,12 @@
         #endif
     #endif
 
+    /* Use assembly or intrinsics for the blending. Possible values:
+     * - LV_DRAW_SW_ASM_NONE
+     * - LV_DRAW_SW_ASM_NEON
+     * - LV_DRAW_SW_ASM_HELIUM
+     * - LV_DRAW_SW_ASM_X86: SSE2, and AVX2 if the compiler targets it (e.g. `-mavx2`)
+     * - LV_DRAW_SW_ASM_CUSTOM: use the functions from LV_DRAW_SW_ASM_CUSTOM_INCLUDE */
     #ifndef LV_USE_DRAW_SW_ASM
         #ifdef CONFIG_LV_USE_DRAW_SW_ASM
             #define LV_USE_DRAW_SW_ASM CONFIG_LV_USE_DRAW_SW_ASM
@@ -1086,6 +1114,16 @@
     #endif
 #endif
 
+/*1: Use the scan-resistant S3-FIFO policy for the image cache instead of LRU.
+ *Images shown only once (e.g. a full screen background) can't push the frequently drawn images (e.g. icons) out of the cache.*/
+#ifndef LV_IMAGE_CACHE_S3FIFO
+    #ifdef CONFIG_LV_IMAGE_CACHE_S3FIFO
+        #define LV_IMAGE_CACHE_S3FIFO CONFIG_LV_IMAGE_CACHE_S3FIFO
+    #else
+        #define LV_IMAGE_CACHE_S3FIFO   0
+    #endif
+#endif
+
 /*Default number of image header cache entries. The cache is used to store the headers of images
  *The main logic is like `LV_CACHE_DEF_SIZE` but for image headers.*/
 #ifndef LV_IMAGE_HEADER_CACHE_DEF_CNT
@@ -1096,6 +1134,53 @@
     #endif
 #endif
 
+/*1: Keep the headers of the image files in an index file to get them without opening the images after a reboot.
+ *The headers are used only if the size and modification time of the image are the same,
+ *so only the images on file system drivers with `stat_cb` are indexed.*/
+#ifndef LV_USE_IMAGE_HEADER_INDEX
+    #ifdef CONFIG_LV_USE_IMAGE_HEADER_INDEX
+        #define LV_USE_IMAGE_HEADER_INDEX CONFIG_LV_USE_IMAGE_HEADER_INDEX
+    #else
+        #define LV_USE_IMAGE_HEADER_INDEX 0
+    #endif
+#endif
+#if LV_USE_IMAGE_HEADER_INDEX
+    /*The index file loaded in `lv_init()` and saved shortly after new headers were found.
+     *"" to load it later with `lv_image_header_index_load()`, e.g. after registering the file system driver.*/
+    #ifndef LV_IMAGE_HEADER_INDEX_PATH
+        #ifdef CONFIG_LV_IMAGE_HEADER_INDEX_PATH
+            #define LV_IMAGE_HEADER_INDEX_PATH CONFIG_LV_IMAGE_HEADER_INDEX_PATH
+        #else
+            #define LV_IMAGE_HEADER_INDEX_PATH ""
+        #endif
+    #endif
+#endif
+
+/*Split the image, image header and glyph caches into this many independently locked shards by the hash of the key.
+ *The draw units and decoders running in parallel threads wait less for each other.
+ *The size of the caches is split equally between the shards, so an image larger than
+ *`LV_CACHE_DEF_SIZE / LV_CACHE_SHARD_CNT` can't be cached (and the same applies to the glyphs).
+ *0 or 1: don't shard the caches*/
+#ifndef LV_CACHE_SHARD_CNT
+    #ifdef CONFIG_LV_CACHE_SHARD_CNT
+        #define LV_CACHE_SHARD_CNT CONFIG_LV_CACHE_SHARD_CNT
+    #else
+        #define LV_CACHE_SHARD_CNT      0
+    #endif
+#endif
+
+/*Default size of the render cache in bytes.
+ *Objects with `LV_OBJ_FLAG_RENDER_CACHE` are rendered once into an ARGB8888 buffer stored in this cache
+ *and only the buffer is drawn until the object or one of its children changes.
+ *If size is 0, the cache is not enabled and the flag has no effect.*/
+#ifndef LV_OBJ_RENDER_CACHE_DEF_SIZE
+    #ifdef CONFIG_LV_OBJ_RENDER_CACHE_DEF_SIZE
+        #define LV_OBJ_RENDER_CACHE_DEF_SIZE CONFIG_LV_OBJ_RENDER_CACHE_DEF_SIZE
+    #else
+        #define LV_OBJ_RENDER_CACHE_DEF_SIZE 0
+    #endif
+#endif
+
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
 #ifndef LV_GRADIENT_MAX_STOPS
@@ -1125,6 +1210,28 @@
     #endif
 #endif
 
+/* Number of style properties (power of 2) whose resolved value is stored per object for the current state.
+ * Speeds up getting the style properties while drawing. 0: disable.
+ * If enabled, lv_obj_report_style_change() needs to be called when a style already used by objects is modified. */
+#ifndef LV_OBJ_STYLE_RESOLVED_CACHE_SIZE
+    #ifdef CONFIG_LV_OBJ_STYLE_RESOLVED_CACHE_SIZE
+        #define LV_OBJ_STYLE_RESOLVED_CACHE_SIZE CONFIG_LV_OBJ_STYLE_RESOLVED_CACHE_SIZE
+    #else
+        #define LV_OBJ_STYLE_RESOLVED_CACHE_SIZE 0
+    #endif
+#endif
+
+/* Size of the grid cells (in px) used to find the pressed object of pointer input devices.
+ * The clickable objects are sorted into the cells and only the objects of the pressed cell are hit tested
+ * instead of walking the whole object tree. 0: disable. */
+#ifndef LV_INDEV_HIT_INDEX_CELL_SIZE
+    #ifdef CONFIG_LV_INDEV_HIT_INDEX_CELL_SIZE
+        #define LV_INDEV_HIT_INDEX_CELL_SIZE CONFIG_LV_INDEV_HIT_INDEX_CELL_SIZE
+    #else
+        #define LV_INDEV_HIT_INDEX_CELL_SIZE 0
+    #endif
+#endif
+
 /* Add `id` field to `lv_obj_t` */
 #ifndef LV_USE_OBJ_ID
     #ifdef CONFIG_LV_USE_OBJ_ID
@@ -1635,6 +1742,17 @@
         #define LV_USE_FONT_COMPRESSED 0
     #endif
 #endif
+#if LV_USE_FONT_COMPRESSED
+    /*Max. memory in bytes used to cache the decompressed glyph bitmaps of compressed fonts.
+     *The least recently used glyphs are freed first. 0: decompress the glyphs on every draw*/
+    #ifndef LV_FONT_COMPRESSED_CACHE_SIZE
+        #ifdef CONFIG_LV_FONT_COMPRESSED_CACHE_SIZE
+            #define LV_FONT_COMPRESSED_CACHE_SIZE CONFIG_LV_FONT_COMPRESSED_CACHE_SIZE
+        #else
+            #define LV_FONT_COMPRESSED_CACHE_SIZE 0
+        #endif
+    #endif
+#endif
 
 /*Enable drawing placeholders when glyph dsc is not found*/
 #ifndef LV_USE_FONT_PLACEHOLDER
@@ -2011,6 +2129,17 @@
             #define LV_LABEL_LONG_TXT_HINT 1  /*Store some extra info in labels to speed up drawing of very long texts*/
         #endif
     #endif
+    #ifndef LV_LABEL_LINE_CACHE
+        #ifdef LV_KCONFIG_PRESENT
+            #ifdef CONFIG_LV_LABEL_LINE_CACHE
+                #define LV_LABEL_LINE_CACHE CONFIG_LV_LABEL_LINE_CACHE
+            #else
+                #define LV_LABEL_LINE_CACHE 0
+            #endif
+        #else
+            #define LV_LABEL_LINE_CACHE 1     /*Store the line breaks and line widths of the labels to speed up redrawing*/
+        #endif
+    #endif
     #ifndef LV_LABEL_WAIT_CHAR_COUNT
         #ifdef CONFIG_LV_LABEL_WAIT_CHAR_COUNT
             #define LV_LABEL_WAIT_CHAR_COUNT CONFIG_LV_LABEL_WAIT_CHAR_COUNT
@@ -2372,6 +2501,17 @@
     #endif
 #endif
 
+/*1: Read ahead in a background thread on the drivers with `read_ahead` enabled.
+ *While a file is read sequentially the next part is already loaded and
+ *`lv_fs_prefetch()` can load a part of a file before it's opened. Disabled without `LV_USE_OS`.*/
+#ifndef LV_FS_READ_AHEAD
+    #ifdef CONFIG_LV_FS_READ_AHEAD
+        #define LV_FS_READ_AHEAD CONFIG_LV_FS_READ_AHEAD
+    #else
+        #define LV_FS_READ_AHEAD 0
+    #endif
+#endif
+
 /*API for fopen, fread, etc*/
 #ifndef LV_USE_FS_STDIO
     #ifdef CONFIG_LV_USE_FS_STDIO
@@ -2434,6 +2574,17 @@
             #define LV_FS_POSIX_CACHE_SIZE 0    /*>0 to cache this number of bytes in lv_fs_read()*/
         #endif
     #endif
+
+    /*1: Map the files opened for reading to the memory with `mmap()`.
+     *The reads are served from the page cache without system calls and
+     *`lv_fs_get_buffer()` lets the decoders use the content without copying it.*/
+    #ifndef LV_FS_POSIX_MMAP
+        #ifdef CONFIG_LV_FS_POSIX_MMAP
+            #define LV_FS_POSIX_MMAP CONFIG_LV_FS_POSIX_MMAP
+        #else
+            #define LV_FS_POSIX_MMAP 0
+        #endif
+    #endif
 #endif
 
 /*API for CreateFile, ReadFile, etc*/
@@ -2582,6 +2733,18 @@
         #define LV_USE_LIBPNG 0
     #endif
 #endif
+#if LV_USE_LIBPNG
+    /*>0: Decode the non-interlaced PNG images taller than this in strips of this many rows while they are drawn.
+     *Only a strip is kept in memory instead of the whole image, but the image is decoded again on every redraw.
+     *Rotated and scaled images are still decoded fully. 0: decode the whole image*/
+    #ifndef LV_LIBPNG_STRIP_HEIGHT
+        #ifdef CONFIG_LV_LIBPNG_STRIP_HEIGHT
+            #define LV_LIBPNG_STRIP_HEIGHT CONFIG_LV_LIBPNG_STRIP_HEIGHT
+        #else
+            #define LV_LIBPNG_STRIP_HEIGHT 0
+        #endif
+    #endif
+#endif
 
 /*BMP decoder library*/
 #ifndef LV_USE_BMP
@@ -2611,6 +2774,22 @@
         #define LV_USE_LIBJPEG_TURBO 0
     #endif
 #endif
+#if LV_USE_LIBJPEG_TURBO
+    /*>1: Decode the JPEG images having restart markers at row boundaries on this many threads (including the caller).
+     *Every thread decodes a horizontal slice directly into the decoded image. Without `LV_USE_OS` it's always 1.
+     *1: decode on the calling thread only*/
+    #ifndef LV_LIBJPEG_TURBO_THREAD_CNT
+        #ifdef LV_KCONFIG_PRESENT
+            #ifdef CONFIG_LV_LIBJPEG_TURBO_THREAD_CNT
+                #define LV_LIBJPEG_TURBO_THREAD_CNT CONFIG_LV_LIBJPEG_TURBO_THREAD_CNT
+            #else
+                #define LV_LIBJPEG_TURBO_THREAD_CNT 0
+            #endif
+        #else
+            #define LV_LIBJPEG_TURBO_THREAD_CNT 1
+        #endif
+    #endif
+#endif
 
 /*GIF decoder library*/
 #ifndef LV_USE_GIF
@@ -2629,6 +2808,16 @@
             #define LV_GIF_CACHE_DECODE_DATA 0
         #endif
     #endif
+    /*1: Decode the next frame of the GIFs on a background thread while the current one is shown.
+     *Without `LV_USE_OS` the frames are decoded when they are shown.
+     *Needs one more canvas (width x height x 4 bytes) per GIF*/
+    #ifndef LV_GIF_DECODE_AHEAD
+        #ifdef CONFIG_LV_GIF_DECODE_AHEAD
+            #define LV_GIF_DECODE_AHEAD CONFIG_LV_GIF_DECODE_AHEAD
+        #else
+            #define LV_GIF_DECODE_AHEAD 0
+        #endif
+    #endif
 #endif
 
 
@@ -3719,6 +3908,16 @@ LV_EXPORT_CONST_INT(LV_DRAW_BUF_ALIGN);
     #define LV_USE_THORVG  (LV_USE_THORVG_INTERNAL || LV_USE_THORVG_EXTERNAL)
 #endif
 
+/*Disable the features which need a thread*/
+#if LV_USE_OS == LV_OS_NONE
+    #undef LV_FS_READ_AHEAD
+    #define LV_FS_READ_AHEAD 0
+    #undef LV_LIBJPEG_TURBO_THREAD_CNT
+    #define LV_LIBJPEG_TURBO_THREAD_CNT 1
+    #undef LV_GIF_DECODE_AHEAD
+    #define LV_GIF_DECODE_AHEAD 0
+#endif
+
 #if LV_USE_OS
     #if (LV_USE_FREETYPE || LV_USE_THORVG) && LV_DRAW_THREAD_STACK_SIZE < (32 * 1024)
         #warning "Increase LV_DRAW_THREAD_STACK_SIZE to at least 32KB for FreeType or ThorVG."
@@ -14,7 +14,9 @@
 #include "draw/lv_draw_buf_private.h"
 #include "core/lv_refr_private.h"
 #include "core/lv_obj_style_private.h"
+#include "core/lv_obj_render_cache_private.h"
 #include "core/lv_group_private.h"
+#include "font/lv_font_fmt_txt_private.h"
 #include "lv_init.h"
 #include "core/lv_global.h"
 #include "core/lv_obj.h"
@@ -118,11 +120,6 @@ static inline void lv_global_init(lv_global_t * global)
     void LV_LOG_PRINT_CB(lv_log_level_t, const char * txt);
     global->custom_log_print_cb = LV_LOG_PRINT_CB;
 #endif
-
-#if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
-    global->sw_shadow_cache.cache_size = -1;
-    global->sw_shadow_cache.cache_r = -1;
-#endif
 }
 
 static inline void lv_cleanup_devices(lv_global_t * global)
@@ -164,6 +161,10 @@ void lv_init(void)
     /*Initialize members of static variable lv_global */
     LV_GLOBAL_INIT(LV_GLOBAL_DEFAULT());
 
+#if LV_MEM_SLAB_SIZE
+    lv_mem_slab_init();
+#endif
+
     lv_mem_init();
 
     lv_draw_buf_init_handlers();
@@ -230,6 +231,12 @@ void lv_init(void)
     lv_image_decoder_init(LV_CACHE_DEF_SIZE, LV_IMAGE_HEADER_CACHE_DEF_CNT);
     lv_bin_decoder_init();  /*LVGL built-in binary image decoder*/
 
+    lv_obj_render_cache_init(LV_OBJ_RENDER_CACHE_DEF_SIZE);
+
+#if LV_USE_FONT_COMPRESSED && LV_FONT_COMPRESSED_CACHE_SIZE
+    lv_font_fmt_txt_glyph_cache_init();
+#endif
+
 #if LV_USE_DRAW_VG_LITE
     lv_draw_vg_lite_init();
 #endif
@@ -334,6 +341,11 @@ void lv_init(void)
     lv_freetype_init(LV_FREETYPE_CACHE_FT_GLYPH_CNT);
 #endif
 
+#if LV_USE_IMAGE_HEADER_INDEX
+    /*After the file system drivers and the image decoders*/
+    if(LV_IMAGE_HEADER_INDEX_PATH[0] != '\0') lv_image_header_index_load(LV_IMAGE_HEADER_INDEX_PATH);
+#endif
+
     lv_initialized = true;
 
     LV_LOG_TRACE("finished");
@@ -383,6 +395,16 @@ void lv_deinit(void)
     lv_theme_mono_deinit();
 #endif
 
+    lv_obj_render_cache_deinit();
+
+#if LV_USE_FONT_COMPRESSED && LV_FONT_COMPRESSED_CACHE_SIZE
+    lv_font_fmt_txt_glyph_cache_deinit();
+#endif
+
+#if LV_USE_IMAGE_HEADER_INDEX
+    lv_image_header_index_deinit();
+#endif
+
     lv_image_decoder_deinit();
 
     lv_refr_deinit();
@@ -429,6 +451,10 @@ void lv_deinit(void)
 
     lv_mem_deinit();
 
+#if LV_MEM_SLAB_SIZE
+    lv_mem_slab_deinit();
+#endif
+
     lv_initialized = false;
 
     LV_LOG_INFO("lv_deinit done");
@@ -17,6 +17,7 @@ extern "C" {
 
 #include "display/lv_display_private.h"
 #include "indev/lv_indev_private.h"
+#include "indev/lv_indev_hit_index_private.h"
 #include "misc/lv_text_private.h"
 #include "misc/cache/lv_cache_entry_private.h"
 #include "misc/cache/lv_cache_private.h"
@@ -53,6 +54,7 @@ extern "C" {
 #include "core/lv_obj_private.h"
 #include "core/lv_obj_scroll_private.h"
 #include "core/lv_obj_draw_private.h"
+#include "core/lv_obj_render_cache_private.h"
 #include "core/lv_obj_class_private.h"
 #include "core/lv_group_private.h"
 #include "core/lv_obj_event_private.h"
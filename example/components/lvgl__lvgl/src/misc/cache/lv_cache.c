@@ -25,6 +25,9 @@
 static void cache_drop_internal_no_lock(lv_cache_t * cache, const void * key, void * user_data);
 static bool cache_evict_one_internal_no_lock(lv_cache_t * cache, void * user_data);
 static lv_cache_entry_t * cache_add_internal_no_lock(lv_cache_t * cache, const void * key, void * user_data);
+static uint32_t cache_get_entry_size(lv_cache_t * cache, lv_cache_entry_t * entry);
+static lv_cache_t * cache_get_shard(lv_cache_t * cache, const void * key);
+static size_t cache_get_shard_max_size(size_t max_size, uint32_t shard_cnt, uint32_t shard_id);
 /**********************
  *  GLOBAL VARIABLES
  **********************/
@@ -53,6 +56,7 @@ lv_cache_t * lv_cache_create(const lv_cache_class_t * cache_class,
     cache->max_size = max_size;
     cache->size = 0;
     cache->ops = ops;
+    lv_memzero(&cache->stats, sizeof(lv_cache_stats_t));
 
     if(cache->clz->init_cb(cache) == false) {
         LV_LOG_ERROR("Cache init failed");
@@ -65,10 +69,67 @@ lv_cache_t * lv_cache_create(const lv_cache_class_t * cache_class,
     return cache;
 }
 
+lv_cache_t * lv_cache_create_sharded(const lv_cache_class_t * cache_class,
+                                     size_t node_size, size_t max_size,
+                                     lv_cache_ops_t ops, uint32_t shard_cnt)
+{
+    if(shard_cnt <= 1 || ops.hash_cb == NULL) {
+        if(shard_cnt > 1) LV_LOG_WARN("The keys can't be sharded without hash_cb");
+        return lv_cache_create(cache_class, node_size, max_size, ops);
+    }
+
+    /*Only the configuration is used from the parent, the entries are stored in the shards*/
+    lv_cache_t * cache = lv_malloc_zeroed(sizeof(lv_cache_t));
+    LV_ASSERT_MALLOC(cache);
+    if(cache == NULL) return NULL;
+
+    cache->shards = lv_malloc_zeroed(shard_cnt * sizeof(lv_cache_t *));
+    LV_ASSERT_MALLOC(cache->shards);
+    if(cache->shards == NULL) {
+        lv_free(cache);
+        return NULL;
+    }
+
+    cache->clz = cache_class;
+    cache->node_size = node_size;
+    cache->max_size = max_size;
+    cache->ops = ops;
+    cache->shard_cnt = shard_cnt;
+
+    uint32_t i;
+    for(i = 0; i < shard_cnt; i++) {
+        cache->shards[i] = lv_cache_create(cache_class, node_size,
+                                           cache_get_shard_max_size(max_size, shard_cnt, i), ops);
+        if(cache->shards[i] == NULL) {
+            while(i > 0) {
+                i--;
+                lv_cache_destroy(cache->shards[i], NULL);
+            }
+            lv_free(cache->shards);
+            lv_free(cache);
+            return NULL;
+        }
+    }
+
+    /*Protects only the eviction turn, the shards have their own locks*/
+    lv_mutex_init(&cache->lock);
+
+    return cache;
+}
+
 void lv_cache_destroy(lv_cache_t * cache, void * user_data)
 {
     LV_ASSERT_NULL(cache);
 
+    if(cache->shard_cnt) {
+        uint32_t i;
+        for(i = 0; i < cache->shard_cnt; i++) lv_cache_destroy(cache->shards[i], user_data);
+        lv_free(cache->shards);
+        lv_mutex_delete(&cache->lock);
+        lv_free(cache);
+        return;
+    }
+
     lv_mutex_lock(&cache->lock);
     cache->clz->destroy_cb(cache, user_data);
     lv_mutex_unlock(&cache->lock);
@@ -81,11 +142,14 @@ lv_cache_entry_t * lv_cache_acquire(lv_cache_t * cache, const void * key, void *
     LV_ASSERT_NULL(cache);
     LV_ASSERT_NULL(key);
 
+    if(cache->shard_cnt) return lv_cache_acquire(cache_get_shard(cache, key), key, user_data);
+
     LV_PROFILER_BEGIN;
 
     lv_mutex_lock(&cache->lock);
 
     if(cache->size == 0) {
+        cache->stats.miss_cnt++;
         lv_mutex_unlock(&cache->lock);
 
         LV_PROFILER_END;
@@ -95,6 +159,11 @@ lv_cache_entry_t * lv_cache_acquire(lv_cache_t * cache, const void * key, void *
     lv_cache_entry_t * entry = cache->clz->get_cb(cache, key, user_data);
     if(entry != NULL) {
         lv_cache_entry_acquire_data(entry);
+        cache->stats.hit_cnt++;
+        cache->stats.hit_size += cache_get_entry_size(cache, entry);
+    }
+    else {
+        cache->stats.miss_cnt++;
     }
     lv_mutex_unlock(&cache->lock);
 
@@ -105,6 +174,12 @@ void lv_cache_release(lv_cache_t * cache, lv_cache_entry_t * entry, void * user_
 {
     LV_ASSERT_NULL(entry);
 
+    /*The entry knows its shard*/
+    if(cache->shard_cnt) {
+        lv_cache_release((lv_cache_t *)lv_cache_entry_get_cache(entry), entry, user_data);
+        return;
+    }
+
     LV_PROFILER_BEGIN;
 
     lv_mutex_lock(&cache->lock);
@@ -123,6 +198,8 @@ lv_cache_entry_t * lv_cache_add(lv_cache_t * cache, const void * key, void * use
     LV_ASSERT_NULL(cache);
     LV_ASSERT_NULL(key);
 
+    if(cache->shard_cnt) return lv_cache_add(cache_get_shard(cache, key), key, user_data);
+
     LV_PROFILER_BEGIN;
 
     lv_mutex_lock(&cache->lock);
@@ -136,6 +213,7 @@ lv_cache_entry_t * lv_cache_add(lv_cache_t * cache, const void * key, void * use
     lv_cache_entry_t * entry = cache_add_internal_no_lock(cache, key, user_data);
     if(entry != NULL) {
         lv_cache_entry_acquire_data(entry);
+        cache->stats.miss_size += cache_get_entry_size(cache, entry);
     }
     lv_mutex_unlock(&cache->lock);
 
@@ -147,6 +225,8 @@ lv_cache_entry_t * lv_cache_acquire_or_create(lv_cache_t * cache, const void * k
     LV_ASSERT_NULL(cache);
     LV_ASSERT_NULL(key);
 
+    if(cache->shard_cnt) return lv_cache_acquire_or_create(cache_get_shard(cache, key), key, user_data);
+
     LV_PROFILER_BEGIN;
 
     lv_mutex_lock(&cache->lock);
@@ -156,6 +236,8 @@ lv_cache_entry_t * lv_cache_acquire_or_create(lv_cache_t * cache, const void * k
         entry = cache->clz->get_cb(cache, key, user_data);
         if(entry != NULL) {
             lv_cache_entry_acquire_data(entry);
+            cache->stats.hit_cnt++;
+            cache->stats.hit_size += cache_get_entry_size(cache, entry);
             lv_mutex_unlock(&cache->lock);
 
             LV_PROFILER_END;
@@ -163,6 +245,8 @@ lv_cache_entry_t * lv_cache_acquire_or_create(lv_cache_t * cache, const void * k
         }
     }
 
+    cache->stats.miss_cnt++;
+
     if(cache->max_size == 0) {
         lv_mutex_unlock(&cache->lock);
 
@@ -185,6 +269,7 @@ lv_cache_entry_t * lv_cache_acquire_or_create(lv_cache_t * cache, const void * k
     }
     else {
         lv_cache_entry_acquire_data(entry);
+        cache->stats.miss_size += cache_get_entry_size(cache, entry);
     }
     lv_mutex_unlock(&cache->lock);
 
@@ -195,12 +280,23 @@ void lv_cache_reserve(lv_cache_t * cache, uint32_t reserved_size, void * user_da
 {
     LV_ASSERT_NULL(cache);
 
+    /*The key is not known so make room in each shard proportionally*/
+    if(cache->shard_cnt) {
+        uint32_t i;
+        for(i = 0; i < cache->shard_cnt; i++) {
+            lv_cache_reserve(cache->shards[i], reserved_size / cache->shard_cnt, user_data);
+        }
+        return;
+    }
+
     LV_PROFILER_BEGIN;
 
     for(lv_cache_reserve_cond_res_t reserve_cond_res = cache->clz->reserve_cond_cb(cache, NULL, reserved_size, user_data);
         reserve_cond_res == LV_CACHE_RESERVE_COND_NEED_VICTIM;
-        reserve_cond_res = cache->clz->reserve_cond_cb(cache, NULL, reserved_size, user_data))
-        cache_evict_one_internal_no_lock(cache, user_data);
+        reserve_cond_res = cache->clz->reserve_cond_cb(cache, NULL, reserved_size, user_data)) {
+        /*All the remaining entries are in use*/
+        if(!cache_evict_one_internal_no_lock(cache, user_data)) break;
+    }
 
     LV_PROFILER_END;
 }
@@ -209,6 +305,11 @@ void lv_cache_drop(lv_cache_t * cache, const void * key, void * user_data)
     LV_ASSERT_NULL(cache);
     LV_ASSERT_NULL(key);
 
+    if(cache->shard_cnt) {
+        lv_cache_drop(cache_get_shard(cache, key), key, user_data);
+        return;
+    }
+
     LV_PROFILER_BEGIN;
 
     lv_mutex_lock(&cache->lock);
@@ -221,6 +322,19 @@ bool lv_cache_evict_one(lv_cache_t * cache, void * user_data)
 {
     LV_ASSERT_NULL(cache);
 
+    /*Take the victims from the shards in turns*/
+    if(cache->shard_cnt) {
+        uint32_t i;
+        for(i = 0; i < cache->shard_cnt; i++) {
+            lv_mutex_lock(&cache->lock);
+            uint32_t shard_id = cache->evict_shard_id;
+            cache->evict_shard_id = (shard_id + 1) % cache->shard_cnt;
+            lv_mutex_unlock(&cache->lock);
+            if(lv_cache_evict_one(cache->shards[shard_id], user_data)) return true;
+        }
+        return false;
+    }
+
     LV_PROFILER_BEGIN;
 
     lv_mutex_lock(&cache->lock);
@@ -234,6 +348,12 @@ void lv_cache_drop_all(lv_cache_t * cache, void * user_data)
 {
     LV_ASSERT_NULL(cache);
 
+    if(cache->shard_cnt) {
+        uint32_t i;
+        for(i = 0; i < cache->shard_cnt; i++) lv_cache_drop_all(cache->shards[i], user_data);
+        return;
+    }
+
     LV_PROFILER_BEGIN;
 
     lv_mutex_lock(&cache->lock);
@@ -245,8 +365,12 @@ void lv_cache_drop_all(lv_cache_t * cache, void * user_data)
 
 void lv_cache_set_max_size(lv_cache_t * cache, size_t max_size, void * user_data)
 {
-    LV_UNUSED(user_data);
     cache->max_size = max_size;
+
+    uint32_t i;
+    for(i = 0; i < cache->shard_cnt; i++) {
+        lv_cache_set_max_size(cache->shards[i], cache_get_shard_max_size(max_size, cache->shard_cnt, i), user_data);
+    }
 }
 size_t lv_cache_get_max_size(lv_cache_t * cache, void * user_data)
 {
@@ -256,12 +380,17 @@ size_t lv_cache_get_max_size(lv_cache_t * cache, void * user_data)
 size_t lv_cache_get_size(lv_cache_t * cache, void * user_data)
 {
     LV_UNUSED(user_data);
-    return cache->size;
+    if(cache->shard_cnt == 0) return cache->size;
+
+    /*The shards are not locked so the sum is only a snapshot while other threads use the cache*/
+    size_t size = 0;
+    uint32_t i;
+    for(i = 0; i < cache->shard_cnt; i++) size += cache->shards[i]->size;
+    return size;
 }
 size_t lv_cache_get_free_size(lv_cache_t * cache, void * user_data)
 {
-    LV_UNUSED(user_data);
-    return cache->max_size - cache->size;
+    return cache->max_size - lv_cache_get_size(cache, user_data);
 }
 bool lv_cache_is_enabled(lv_cache_t * cache)
 {
@@ -269,29 +398,77 @@ bool lv_cache_is_enabled(lv_cache_t * cache)
 }
 void lv_cache_set_compare_cb(lv_cache_t * cache, lv_cache_compare_cb_t compare_cb, void * user_data)
 {
-    LV_UNUSED(user_data);
     cache->ops.compare_cb = compare_cb;
+
+    uint32_t i;
+    for(i = 0; i < cache->shard_cnt; i++) lv_cache_set_compare_cb(cache->shards[i], compare_cb, user_data);
 }
 void lv_cache_set_create_cb(lv_cache_t * cache, lv_cache_create_cb_t alloc_cb, void * user_data)
 {
-    LV_UNUSED(user_data);
     cache->ops.create_cb = alloc_cb;
+
+    uint32_t i;
+    for(i = 0; i < cache->shard_cnt; i++) lv_cache_set_create_cb(cache->shards[i], alloc_cb, user_data);
 }
 void lv_cache_set_free_cb(lv_cache_t * cache, lv_cache_free_cb_t free_cb, void * user_data)
 {
-    LV_UNUSED(user_data);
     cache->ops.free_cb = free_cb;
+
+    uint32_t i;
+    for(i = 0; i < cache->shard_cnt; i++) lv_cache_set_free_cb(cache->shards[i], free_cb, user_data);
 }
 void lv_cache_set_name(lv_cache_t * cache, const char * name)
 {
     if(cache == NULL) return;
     cache->name = name;
+
+    uint32_t i;
+    for(i = 0; i < cache->shard_cnt; i++) lv_cache_set_name(cache->shards[i], name);
 }
 const char * lv_cache_get_name(lv_cache_t * cache)
 {
     return cache->name;
 }
 
+void lv_cache_get_stats(lv_cache_t * cache, lv_cache_stats_t * stats)
+{
+    LV_ASSERT_NULL(cache);
+    LV_ASSERT_NULL(stats);
+
+    if(cache->shard_cnt) {
+        lv_memzero(stats, sizeof(lv_cache_stats_t));
+        uint32_t i;
+        for(i = 0; i < cache->shard_cnt; i++) {
+            lv_cache_stats_t shard_stats;
+            lv_cache_get_stats(cache->shards[i], &shard_stats);
+            stats->hit_cnt += shard_stats.hit_cnt;
+            stats->miss_cnt += shard_stats.miss_cnt;
+            stats->hit_size += shard_stats.hit_size;
+            stats->miss_size += shard_stats.miss_size;
+        }
+        return;
+    }
+
+    lv_mutex_lock(&cache->lock);
+    *stats = cache->stats;
+    lv_mutex_unlock(&cache->lock);
+}
+
+void lv_cache_reset_stats(lv_cache_t * cache)
+{
+    LV_ASSERT_NULL(cache);
+
+    if(cache->shard_cnt) {
+        uint32_t i;
+        for(i = 0; i < cache->shard_cnt; i++) lv_cache_reset_stats(cache->shards[i]);
+        return;
+    }
+
+    lv_mutex_lock(&cache->lock);
+    lv_memzero(&cache->stats, sizeof(lv_cache_stats_t));
+    lv_mutex_unlock(&cache->lock);
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -346,3 +523,25 @@ static lv_cache_entry_t * cache_add_internal_no_lock(lv_cache_t * cache, const v
 
     return entry;
 }
+
+static uint32_t cache_get_entry_size(lv_cache_t * cache, lv_cache_entry_t * entry)
+{
+    if(cache->clz->get_data_size_cb == NULL) return 1;
+    return cache->clz->get_data_size_cb(lv_cache_entry_get_data(entry));
+}
+
+static lv_cache_t * cache_get_shard(lv_cache_t * cache, const void * key)
+{
+    /*Mix the bits as e.g. hashed addresses differ only in the upper bits*/
+    uint32_t hash = cache->ops.hash_cb(key);
+    hash ^= hash >> 16;
+    hash *= 0x45d9f3bu;
+    hash ^= hash >> 16;
+    return cache->shards[hash % cache->shard_cnt];
+}
+
+/*Split the budget so that the shards add up to `max_size` exactly*/
+static size_t cache_get_shard_max_size(size_t max_size, uint32_t shard_cnt, uint32_t shard_id)
+{
+    return max_size / shard_cnt + (shard_id < max_size % shard_cnt ? 1 : 0);
+}
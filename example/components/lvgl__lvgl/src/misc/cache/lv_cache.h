@@ -18,9 +18,11 @@ extern "C" {
 #include "../lv_types.h"
 
 #include "lv_cache_lru_rb.h"
+#include "lv_cache_s3fifo.h"
 
 #include "lv_image_cache.h"
 #include "lv_image_header_cache.h"
+#include "lv_image_header_index.h"
 /*********************
  *      DEFINES
  *********************/
@@ -38,6 +40,8 @@ extern "C" {
  * @param cache_class   The class of the cache. Currently only support one two builtin classes:
  *                        - lv_cache_class_lru_rb_count for LRU-based cache with count-based eviction policy.
  *                        - lv_cache_class_lru_rb_size for LRU-based cache with size-based eviction policy.
+ *                        - lv_cache_class_s3fifo_count and lv_cache_class_s3fifo_size for the scan-resistant
+ *                          S3-FIFO policy with count or size-based eviction.
  * @param node_size     The node size is the size of the data stored in the cache..
  * @param max_size      The max size is the maximum amount of memory or count that the cache can hold.
  *                        - lv_cache_class_lru_rb_count: max_size is the maximum count of nodes in the cache.
@@ -49,6 +53,22 @@ lv_cache_t * lv_cache_create(const lv_cache_class_t * cache_class,
                              size_t node_size, size_t max_size,
                              lv_cache_ops_t ops);
 
+/**
+ * Create a cache object whose entries are split into independently locked shards by the hash of their keys.
+ * Threads using entries of different shards don't wait for each other.
+ * The returned cache can be used with the same functions as the caches created by `lv_cache_create()`.
+ * @param cache_class   The class of the shards. See `lv_cache_create()`.
+ * @param node_size     The node size is the size of the data stored in the cache..
+ * @param max_size      The maximum size of the whole cache. Each shard gets an equal part of it,
+ *                      so the size limit is applied per shard.
+ * @param ops           A set of operations that can be performed on the cache. `hash_cb` is required.
+ * @param shard_cnt     The number of shards. If it's 0 or 1, or `hash_cb` is not set, a normal cache is created.
+ * @return              Returns a pointer to the created cache object on success, `NULL` on error.
+ */
+lv_cache_t * lv_cache_create_sharded(const lv_cache_class_t * cache_class,
+                                     size_t node_size, size_t max_size,
+                                     lv_cache_ops_t ops, uint32_t shard_cnt);
+
 /**
  * Destroy a cache object.
  * @param cache         The cache object pointer to destroy.
@@ -215,6 +235,20 @@ void lv_cache_set_name(lv_cache_t * cache, const char * name);
  */
 const char * lv_cache_get_name(lv_cache_t * cache);
 
+/**
+ * Get the hit and miss statistics of the cache. The hit ratio is `hit_cnt / (hit_cnt + miss_cnt)`
+ * and the byte-hit ratio is `hit_size / (hit_size + miss_size)`.
+ * @param cache     The cache object pointer to get the statistics of.
+ * @param stats     Store the statistics here.
+ */
+void lv_cache_get_stats(lv_cache_t * cache, lv_cache_stats_t * stats);
+
+/**
+ * Clear the hit and miss statistics of the cache.
+ * @param cache     The cache object pointer to reset the statistics of.
+ */
+void lv_cache_reset_stats(lv_cache_t * cache);
+
 /*************************
  *    GLOBAL VARIABLES
  *************************/
@@ -105,7 +105,8 @@ const lv_cache_class_t lv_cache_class_lru_rb_count = {
     .drop_cb = drop_cb,
     .drop_all_cb = drop_all_cb,
     .get_victim_cb = get_victim_cb,
-    .reserve_cond_cb = reserve_cond_cb
+    .reserve_cond_cb = reserve_cond_cb,
+    .get_data_size_cb = cnt_get_data_size_cb
 };
 
 const lv_cache_class_t lv_cache_class_lru_rb_size = {
@@ -119,7 +120,8 @@ const lv_cache_class_t lv_cache_class_lru_rb_size = {
     .drop_cb = drop_cb,
     .drop_all_cb = drop_all_cb,
     .get_victim_cb = get_victim_cb,
-    .reserve_cond_cb = reserve_cond_cb
+    .reserve_cond_cb = reserve_cond_cb,
+    .get_data_size_cb = size_get_data_size_cb
 };
 /**********************
  *  STATIC VARIABLES
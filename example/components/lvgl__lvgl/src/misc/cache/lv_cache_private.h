@@ -48,6 +48,7 @@ typedef int8_t lv_cache_compare_res_t;
 typedef bool (*lv_cache_create_cb_t)(void * node, void * user_data);
 typedef void (*lv_cache_free_cb_t)(void * node, void * user_data);
 typedef lv_cache_compare_res_t (*lv_cache_compare_cb_t)(const void * a, const void * b);
+typedef uint32_t (*lv_cache_hash_cb_t)(const void * key);
 
 /**
  * The cache instance allocation function, used by the cache class to allocate memory for cache instances.
@@ -100,6 +101,12 @@ typedef void (*lv_cache_drop_all_cb_t)(lv_cache_t * cache, void * user_data);
  */
 typedef lv_cache_entry_t * (*lv_cache_get_victim_cb)(lv_cache_t * cache, void * user_data);
 
+/**
+ * The cache data size function, used to tell how much an entry counts against the maximum size of the cache.
+ * @return the size of the data, e.g. 1 for count-based and `lv_cache_slot_size_t::size` for size-based caches.
+ */
+typedef uint32_t (*lv_cache_get_data_size_cb)(const void * data);
+
 /**
  * The cache reserve condition function, used by the cache class to check if a new entry can be added to the cache without exceeding its maximum size.
  * See lv_cache_reserve_cond_res_t for the possible results.
@@ -114,15 +121,29 @@ struct lv_cache_ops_t {
     lv_cache_compare_cb_t compare_cb;    /**< Compare function for keys */
     lv_cache_create_cb_t create_cb;      /**< Create function for nodes */
     lv_cache_free_cb_t free_cb;          /**< Free function for nodes */
+    lv_cache_hash_cb_t hash_cb;          /**< Hash function for keys (optional). Equal keys should have equal hashes.
+                                          *   Lets the S3-FIFO policy remember the recently evicted entries.
+                                          *   Required to shard the cache. */
 };
 
+/**
+ * The hit and miss statistics of a cache
+ */
+typedef struct {
+    uint32_t hit_cnt;                 /**< Number of lookups finding the entry */
+    uint32_t miss_cnt;                /**< Number of lookups not finding the entry */
+    uint64_t hit_size;                /**< Sum of the data size of the entries found */
+    uint64_t miss_size;               /**< Sum of the data size of the entries added */
+} lv_cache_stats_t;
+
 /**
  * The cache entry struct
  */
 struct lv_cache_t {
     const lv_cache_class_t * clz;     /**< Cache class. There are two built-in classes:
                                        * - lv_cache_class_lru_rb_count for LRU-based cache with count-based eviction policy.
-                                       * - lv_cache_class_lru_rb_size for LRU-based cache with size-based eviction policy. */
+                                       * - lv_cache_class_lru_rb_size for LRU-based cache with size-based eviction policy.
+                                       * - lv_cache_class_s3fifo_count and lv_cache_class_s3fifo_size for the scan-resistant S3-FIFO policy. */
 
     uint32_t node_size;               /**< Size of a node */
 
@@ -134,6 +155,12 @@ struct lv_cache_t {
     lv_mutex_t lock;                  /**< Cache lock used to protect the cache in multithreading environments */
 
     const char * name;                /**< Name of the cache */
+
+    lv_cache_stats_t stats;           /**< Hit and miss statistics */
+
+    lv_cache_t ** shards;             /**< The independently locked caches storing the entries of a sharded cache */
+    uint32_t shard_cnt;               /**< Number of shards. 0: the cache is not sharded */
+    uint32_t evict_shard_id;          /**< The shard to evict from next by `lv_cache_evict_one()`, protected by `lock` */
 };
 
 /**
@@ -142,6 +169,8 @@ struct lv_cache_t {
  * Examples:
  * - lv_cache_class_lru_rb_count for LRU-based cache with count-based eviction policy.
  * - lv_cache_class_lru_rb_size for LRU-based cache with size-based eviction policy.
+ * - lv_cache_class_s3fifo_count for S3-FIFO cache with count-based eviction policy.
+ * - lv_cache_class_s3fifo_size for S3-FIFO cache with size-based eviction policy.
  */
 struct lv_cache_class_t {
     lv_cache_alloc_cb_t alloc_cb;                 /**< The allocation function for cache entries */
@@ -155,6 +184,8 @@ struct lv_cache_class_t {
     lv_cache_drop_all_cb_t drop_all_cb;           /**< The drop all function for cache entries */
     lv_cache_get_victim_cb get_victim_cb;         /**< The get victim function for cache entries */
     lv_cache_reserve_cond_cb reserve_cond_cb;     /**< The reserve condition function for cache entries */
+    lv_cache_get_data_size_cb get_data_size_cb;   /**< The size of an entry's data, only used for the statistics.
+                                                   *   Every entry counts as 1 if NULL. */
 };
 
 /*-----------------
@@ -0,0 +1,502 @@
+/**
+* @file lv_cache_s3fifo.c
+*
+*/
+
+/*
+ * S3-FIFO: entries are looked up in a red-black tree and kept in two FIFO queues.
+ *
+ * - New entries go to the small queue which holds about 10% of the cache.
+ * - A hit only increments the entry's 2 bit access counter, the entry is not moved.
+ * - Evicting from the small queue: an entry which was hit while in the small queue
+ *   is moved to the main queue, the others are evicted.
+ * - Evicting from the main queue: an entry with non-zero counter is reinserted
+ *   with decremented counter, the others are evicted.
+ * - If the cache has `hash_cb` the hashes of the entries evicted from the small queue
+ *   are kept in a ghost queue. When they are added again they go directly to the main queue.
+ *
+ * Entries used only once (e.g. a large image shown only for a moment) leave the cache
+ * through the small queue and can't push out the frequently used entries from the main queue.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_cache_s3fifo.h"
+#include "../../stdlib/lv_sprintf.h"
+#include "../../stdlib/lv_string.h"
+#include "../lv_ll.h"
+#include "../lv_math.h"
+#include "../lv_rb_private.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define FREQ_MAX            3
+#define SMALL_QUEUE_RATIO   10  /*The small queue has 1/SMALL_QUEUE_RATIO of the max size*/
+#define GHOST_CNT           64  /*Number of hashes remembered in the ghost queue*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef uint32_t (get_data_size_cb_t)(const void * data);
+
+/*Stored after the cache entry in the nodes of the red-black tree*/
+typedef struct {
+    void * ll_node;
+    uint8_t freq;
+    uint8_t in_main;
+} s3fifo_ext_t;
+
+typedef struct {
+    lv_cache_t cache;
+
+    lv_rb_t rb;
+    lv_ll_t small_ll;
+    lv_ll_t main_ll;
+
+    uint32_t small_size;
+    uint32_t entry_cnt;
+    uint32_t ext_ofs;
+
+    uint32_t * ghost;           /**< Ring buffer of the hashes of the entries evicted from the small queue*/
+    uint32_t ghost_cnt;
+    uint32_t ghost_next;
+
+    get_data_size_cb_t * get_data_size_cb;
+} lv_cache_s3fifo_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static void * alloc_cb(void);
+static bool init_cnt_cb(lv_cache_t * cache);
+static bool init_size_cb(lv_cache_t * cache);
+static void destroy_cb(lv_cache_t * cache, void * user_data);
+
+static lv_cache_entry_t * get_cb(lv_cache_t * cache, const void * key, void * user_data);
+static lv_cache_entry_t * add_cb(lv_cache_t * cache, const void * key, void * user_data);
+static void remove_cb(lv_cache_t * cache, lv_cache_entry_t * entry, void * user_data);
+static void drop_cb(lv_cache_t * cache, const void * key, void * user_data);
+static void drop_all_cb(lv_cache_t * cache, void * user_data);
+static lv_cache_entry_t * get_victim_cb(lv_cache_t * cache, void * user_data);
+static lv_cache_reserve_cond_res_t reserve_cond_cb(lv_cache_t * cache, const void * key, size_t reserved_size,
+                                                   void * user_data);
+
+static bool init_common(lv_cache_s3fifo_t * s3, get_data_size_cb_t * get_data_size_cb);
+static void remove_node(lv_cache_s3fifo_t * s3, lv_rb_node_t * node);
+static inline s3fifo_ext_t * get_ext(lv_cache_s3fifo_t * s3, lv_rb_node_t * node);
+static void ghost_add(lv_cache_s3fifo_t * s3, const void * key);
+static bool ghost_has(lv_cache_s3fifo_t * s3, const void * key);
+
+static uint32_t cnt_get_data_size_cb(const void * data);
+static uint32_t size_get_data_size_cb(const void * data);
+
+/**********************
+ *  GLOBAL VARIABLES
+ **********************/
+const lv_cache_class_t lv_cache_class_s3fifo_count = {
+    .alloc_cb = alloc_cb,
+    .init_cb = init_cnt_cb,
+    .destroy_cb = destroy_cb,
+
+    .get_cb = get_cb,
+    .add_cb = add_cb,
+    .remove_cb = remove_cb,
+    .drop_cb = drop_cb,
+    .drop_all_cb = drop_all_cb,
+    .get_victim_cb = get_victim_cb,
+    .reserve_cond_cb = reserve_cond_cb,
+    .get_data_size_cb = cnt_get_data_size_cb
+};
+
+const lv_cache_class_t lv_cache_class_s3fifo_size = {
+    .alloc_cb = alloc_cb,
+    .init_cb = init_size_cb,
+    .destroy_cb = destroy_cb,
+
+    .get_cb = get_cb,
+    .add_cb = add_cb,
+    .remove_cb = remove_cb,
+    .drop_cb = drop_cb,
+    .drop_all_cb = drop_all_cb,
+    .get_victim_cb = get_victim_cb,
+    .reserve_cond_cb = reserve_cond_cb,
+    .get_data_size_cb = size_get_data_size_cb
+};
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void * alloc_cb(void)
+{
+    void * res = lv_malloc_zeroed(sizeof(lv_cache_s3fifo_t));
+    LV_ASSERT_MALLOC(res);
+    if(res == NULL) {
+        LV_LOG_ERROR("malloc failed");
+        return NULL;
+    }
+
+    return res;
+}
+
+static bool init_cnt_cb(lv_cache_t * cache)
+{
+    return init_common((lv_cache_s3fifo_t *)cache, cnt_get_data_size_cb);
+}
+
+static bool init_size_cb(lv_cache_t * cache)
+{
+    return init_common((lv_cache_s3fifo_t *)cache, size_get_data_size_cb);
+}
+
+static bool init_common(lv_cache_s3fifo_t * s3, get_data_size_cb_t * get_data_size_cb)
+{
+    LV_ASSERT_NULL(s3->cache.ops.compare_cb);
+    LV_ASSERT_NULL(s3->cache.ops.free_cb);
+    LV_ASSERT(s3->cache.node_size > 0);
+
+    if(s3->cache.node_size <= 0 || s3->cache.ops.compare_cb == NULL || s3->cache.ops.free_cb == NULL) {
+        return false;
+    }
+
+    /*Add the queue related data after the entry*/
+    s3->ext_ofs = LV_ALIGN_UP(lv_cache_entry_get_size(s3->cache.node_size), sizeof(void *));
+    if(!lv_rb_init(&s3->rb, s3->cache.ops.compare_cb, s3->ext_ofs + sizeof(s3fifo_ext_t))) {
+        return false;
+    }
+    lv_ll_init(&s3->small_ll, sizeof(void *));
+    lv_ll_init(&s3->main_ll, sizeof(void *));
+
+    s3->get_data_size_cb = get_data_size_cb;
+
+    return true;
+}
+
+static void destroy_cb(lv_cache_t * cache, void * user_data)
+{
+    LV_ASSERT_NULL(cache);
+
+    if(cache == NULL) {
+        return;
+    }
+
+    cache->clz->drop_all_cb(cache, user_data);
+
+    lv_cache_s3fifo_t * s3 = (lv_cache_s3fifo_t *)cache;
+    lv_free(s3->ghost);
+    s3->ghost = NULL;
+}
+
+static lv_cache_entry_t * get_cb(lv_cache_t * cache, const void * key, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_cache_s3fifo_t * s3 = (lv_cache_s3fifo_t *)cache;
+
+    LV_ASSERT_NULL(s3);
+    LV_ASSERT_NULL(key);
+
+    if(s3 == NULL || key == NULL) {
+        return NULL;
+    }
+
+    lv_rb_node_t * node = lv_rb_find(&s3->rb, key);
+    if(node == NULL) {
+        return NULL;
+    }
+
+    /*Only count the hit, the entry stays in place*/
+    s3fifo_ext_t * ext = get_ext(s3, node);
+    if(ext->freq < FREQ_MAX) ext->freq++;
+
+    return lv_cache_entry_get_entry(node->data, cache->node_size);
+}
+
+static lv_cache_entry_t * add_cb(lv_cache_t * cache, const void * key, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_cache_s3fifo_t * s3 = (lv_cache_s3fifo_t *)cache;
+
+    LV_ASSERT_NULL(s3);
+    LV_ASSERT_NULL(key);
+
+    if(s3 == NULL || key == NULL) {
+        return NULL;
+    }
+
+    lv_rb_node_t * node = lv_rb_insert(&s3->rb, (void *)key);
+    if(node == NULL) {
+        return NULL;
+    }
+
+    /*Evicted recently without a second hit in the small queue but needed again*/
+    bool to_main = ghost_has(s3, key);
+
+    void * ll_node = lv_ll_ins_head(to_main ? &s3->main_ll : &s3->small_ll);
+    if(ll_node == NULL) {
+        lv_rb_drop_node(&s3->rb, node);
+        return NULL;
+    }
+
+    lv_memcpy(node->data, key, cache->node_size);
+    lv_memcpy(ll_node, &node, sizeof(void *));
+
+    s3fifo_ext_t * ext = get_ext(s3, node);
+    ext->ll_node = ll_node;
+    ext->freq = 0;
+    ext->in_main = to_main;
+
+    lv_cache_entry_t * entry = lv_cache_entry_get_entry(node->data, cache->node_size);
+    lv_cache_entry_init(entry, cache, cache->node_size);
+
+    uint32_t data_size = s3->get_data_size_cb(key);
+    cache->size += data_size;
+    if(!to_main) s3->small_size += data_size;
+    s3->entry_cnt++;
+
+    return entry;
+}
+
+static void remove_cb(lv_cache_t * cache, lv_cache_entry_t * entry, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_cache_s3fifo_t * s3 = (lv_cache_s3fifo_t *)cache;
+
+    LV_ASSERT_NULL(s3);
+    LV_ASSERT_NULL(entry);
+
+    if(s3 == NULL || entry == NULL) {
+        return;
+    }
+
+    lv_rb_node_t * node = lv_rb_find(&s3->rb, lv_cache_entry_get_data(entry));
+    if(node == NULL) {
+        return;
+    }
+
+    remove_node(s3, node);
+}
+
+static void drop_cb(lv_cache_t * cache, const void * key, void * user_data)
+{
+    lv_cache_s3fifo_t * s3 = (lv_cache_s3fifo_t *)cache;
+
+    LV_ASSERT_NULL(s3);
+    LV_ASSERT_NULL(key);
+
+    if(s3 == NULL || key == NULL) {
+        return;
+    }
+
+    lv_rb_node_t * node = lv_rb_find(&s3->rb, key);
+    if(node == NULL) {
+        return;
+    }
+
+    void * data = node->data;
+    cache->ops.free_cb(data, user_data);
+
+    remove_node(s3, node);
+    lv_cache_entry_delete(lv_cache_entry_get_entry(data, cache->node_size));
+}
+
+static void drop_all_cb(lv_cache_t * cache, void * user_data)
+{
+    lv_cache_s3fifo_t * s3 = (lv_cache_s3fifo_t *)cache;
+
+    LV_ASSERT_NULL(s3);
+
+    if(s3 == NULL) {
+        return;
+    }
+
+    uint32_t used_cnt = 0;
+    lv_ll_t * lls[2] = {&s3->small_ll, &s3->main_ll};
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        lv_rb_node_t ** node;
+        LV_LL_READ(lls[i], node) {
+            /*free user handled data and do other clean up*/
+            void * data = (*node)->data;
+            lv_cache_entry_t * entry = lv_cache_entry_get_entry(data, cache->node_size);
+            if(lv_cache_entry_get_ref(entry) == 0) {
+                cache->ops.free_cb(data, user_data);
+            }
+            else {
+                LV_LOG_WARN("entry (%p) is still referenced (%" LV_PRId32 ")", (void *)entry, lv_cache_entry_get_ref(entry));
+                used_cnt++;
+            }
+        }
+    }
+    if(used_cnt > 0) {
+        LV_LOG_WARN("%" LV_PRId32 " entries are still referenced", used_cnt);
+    }
+
+    lv_rb_destroy(&s3->rb);
+    lv_ll_clear(&s3->small_ll);
+    lv_ll_clear(&s3->main_ll);
+
+    cache->size = 0;
+    s3->small_size = 0;
+    s3->entry_cnt = 0;
+}
+
+static lv_cache_entry_t * get_victim_cb(lv_cache_t * cache, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_cache_s3fifo_t * s3 = (lv_cache_s3fifo_t *)cache;
+
+    LV_ASSERT_NULL(s3);
+
+    uint32_t small_max = cache->max_size / SMALL_QUEUE_RATIO;
+
+    /*Each entry is moved at most FREQ_MAX + 1 times before it's evicted or found to be in use*/
+    uint32_t step_cnt = (FREQ_MAX + 2) * s3->entry_cnt;
+    while(step_cnt > 0) {
+        step_cnt--;
+
+        bool from_small = s3->small_size > small_max || lv_ll_is_empty(&s3->main_ll);
+        lv_ll_t * ll = from_small ? &s3->small_ll : &s3->main_ll;
+        void * ll_node = lv_ll_get_tail(ll);
+        if(ll_node == NULL) return NULL;
+
+        lv_rb_node_t * node = *(lv_rb_node_t **)ll_node;
+        s3fifo_ext_t * ext = get_ext(s3, node);
+
+        if(ext->freq > 0) {
+            if(from_small) {
+                /*Used again since it was added: keep it in the main queue*/
+                lv_ll_chg_list(&s3->small_ll, &s3->main_ll, ll_node, true);
+                ext->in_main = 1;
+                ext->freq = 0;
+                s3->small_size -= s3->get_data_size_cb(node->data);
+            }
+            else {
+                lv_ll_chg_list(&s3->main_ll, &s3->main_ll, ll_node, true);
+                ext->freq--;
+            }
+            continue;
+        }
+
+        lv_cache_entry_t * entry = lv_cache_entry_get_entry(node->data, cache->node_size);
+        if(lv_cache_entry_get_ref(entry) == 0) {
+            if(from_small) ghost_add(s3, node->data);
+            return entry;
+        }
+
+        /*In use, check it again later*/
+        lv_ll_chg_list(ll, ll, ll_node, true);
+    }
+
+    return NULL;
+}
+
+static lv_cache_reserve_cond_res_t reserve_cond_cb(lv_cache_t * cache, const void * key, size_t reserved_size,
+                                                   void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_cache_s3fifo_t * s3 = (lv_cache_s3fifo_t *)cache;
+
+    LV_ASSERT_NULL(s3);
+
+    if(s3 == NULL) {
+        return LV_CACHE_RESERVE_COND_ERROR;
+    }
+
+    uint32_t data_size = key ? s3->get_data_size_cb(key) : 0;
+    if(data_size > cache->max_size) {
+        LV_LOG_ERROR("data size (%" LV_PRIu32 ") is larger than max size (%" LV_PRIu32 ")", data_size, cache->max_size);
+        return LV_CACHE_RESERVE_COND_TOO_LARGE;
+    }
+
+    return cache->size + reserved_size + data_size > cache->max_size
+           ? LV_CACHE_RESERVE_COND_NEED_VICTIM
+           : LV_CACHE_RESERVE_COND_OK;
+}
+
+/**
+ * Remove a node from the tree and its queue without freeing the entry
+ */
+static void remove_node(lv_cache_s3fifo_t * s3, lv_rb_node_t * node)
+{
+    s3fifo_ext_t * ext = get_ext(s3, node);
+    uint32_t data_size = s3->get_data_size_cb(node->data);
+    void * ll_node = ext->ll_node;
+
+    if(ext->in_main) {
+        lv_ll_remove(&s3->main_ll, ll_node);
+    }
+    else {
+        lv_ll_remove(&s3->small_ll, ll_node);
+        s3->small_size -= data_size;
+    }
+    lv_free(ll_node);
+
+    lv_rb_remove_node(&s3->rb, node);
+
+    s3->cache.size -= data_size;
+    s3->entry_cnt--;
+}
+
+static inline s3fifo_ext_t * get_ext(lv_cache_s3fifo_t * s3, lv_rb_node_t * node)
+{
+    return (s3fifo_ext_t *)((uint8_t *)node->data + s3->ext_ofs);
+}
+
+static void ghost_add(lv_cache_s3fifo_t * s3, const void * key)
+{
+    if(s3->cache.ops.hash_cb == NULL) return;
+
+    if(s3->ghost == NULL) {
+        s3->ghost = lv_malloc(GHOST_CNT * sizeof(uint32_t));
+        LV_ASSERT_MALLOC(s3->ghost);
+        if(s3->ghost == NULL) return;
+    }
+
+    s3->ghost[s3->ghost_next] = s3->cache.ops.hash_cb(key);
+    s3->ghost_next = (s3->ghost_next + 1) % GHOST_CNT;
+    if(s3->ghost_cnt < GHOST_CNT) s3->ghost_cnt++;
+}
+
+static bool ghost_has(lv_cache_s3fifo_t * s3, const void * key)
+{
+    if(s3->ghost_cnt == 0) return false;
+
+    uint32_t hash = s3->cache.ops.hash_cb(key);
+    uint32_t i;
+    for(i = 0; i < s3->ghost_cnt; i++) {
+        if(s3->ghost[i] == hash) return true;
+    }
+
+    return false;
+}
+
+static uint32_t cnt_get_data_size_cb(const void * data)
+{
+    LV_UNUSED(data);
+    return 1;
+}
+
+static uint32_t size_get_data_size_cb(const void * data)
+{
+    lv_cache_slot_size_t * slot = (lv_cache_slot_size_t *)data;
+    return slot->size;
+}
@@ -9,6 +9,7 @@
 
 #include "../../draw/lv_image_decoder_private.h"
 #include "../lv_assert.h"
+#include "../lv_utils.h"
 #include "../../core/lv_global.h"
 
 #include "lv_image_cache.h"
@@ -34,6 +35,7 @@
 static lv_cache_compare_res_t image_cache_compare_cb(const lv_image_cache_data_t * lhs,
                                                      const lv_image_cache_data_t * rhs);
 static void image_cache_free_cb(lv_image_cache_data_t * entry, void * user_data);
+static uint32_t image_cache_hash_cb(const lv_image_cache_data_t * key);
 
 /**********************
  *  GLOBAL VARIABLES
@@ -57,12 +59,19 @@ lv_result_t lv_image_cache_init(uint32_t size)
         return LV_RESULT_OK;
     }
 
-    img_cache_p = lv_cache_create(&lv_cache_class_lru_rb_size,
+#if LV_IMAGE_CACHE_S3FIFO
+    const lv_cache_class_t * cache_class = &lv_cache_class_s3fifo_size;
+#else
+    const lv_cache_class_t * cache_class = &lv_cache_class_lru_rb_size;
+#endif
+
+    img_cache_p = lv_cache_create_sharded(cache_class,
     sizeof(lv_image_cache_data_t), size, (lv_cache_ops_t) {
         .compare_cb = (lv_cache_compare_cb_t) image_cache_compare_cb,
         .create_cb = NULL,
         .free_cb = (lv_cache_free_cb_t) image_cache_free_cb,
-    });
+        .hash_cb = (lv_cache_hash_cb_t) image_cache_hash_cb,
+    }, LV_CACHE_SHARD_CNT);
 
     lv_cache_set_name(img_cache_p, CACHE_NAME);
     return img_cache_p != NULL ? LV_RESULT_OK : LV_RESULT_INVALID;
@@ -99,6 +108,15 @@ bool lv_image_cache_is_enabled(void)
     return lv_cache_is_enabled(img_cache_p);
 }
 
+uint32_t lv_image_cache_hash_src(lv_image_src_t src_type, const void * src)
+{
+    uint32_t hash = LV_UTILS_FNV1A_INIT ^ (uint32_t)src_type;
+    if(src_type == LV_IMAGE_SRC_FILE) hash = lv_utils_fnv1a(hash, src, lv_strlen(src));
+    else if(src_type == LV_IMAGE_SRC_VARIABLE) hash = lv_utils_fnv1a(hash, &src, sizeof(src));
+
+    return hash;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -143,3 +161,8 @@ static void image_cache_free_cb(lv_image_cache_data_t * entry, void * user_data)
     /*Free the duplicated file name*/
     if(entry->src_type == LV_IMAGE_SRC_FILE) lv_free((void *)entry->src);
 }
+
+static uint32_t image_cache_hash_cb(const lv_image_cache_data_t * key)
+{
+    return lv_image_cache_hash_src(key->src_type, key->src);
+}
@@ -12,6 +12,7 @@
 #include "../../core/lv_global.h"
 
 #include "lv_image_header_cache.h"
+#include "lv_image_header_index.h"
 
 /*********************
  *      DEFINES
@@ -32,6 +33,7 @@
 static lv_cache_compare_res_t image_header_cache_compare_cb(const lv_image_header_cache_data_t * lhs,
                                                             const lv_image_header_cache_data_t * rhs);
 static void image_header_cache_free_cb(lv_image_header_cache_data_t * entry, void * user_data);
+static uint32_t image_header_cache_hash_cb(const lv_image_header_cache_data_t * key);
 
 /**********************
  *  GLOBAL VARIABLES
@@ -55,12 +57,13 @@ lv_result_t lv_image_header_cache_init(uint32_t count)
         return LV_RESULT_OK;
     }
 
-    img_header_cache_p = lv_cache_create(&lv_cache_class_lru_rb_count,
+    img_header_cache_p = lv_cache_create_sharded(&lv_cache_class_lru_rb_count,
     sizeof(lv_image_header_cache_data_t), count, (lv_cache_ops_t) {
         .compare_cb = (lv_cache_compare_cb_t) image_header_cache_compare_cb,
         .create_cb = NULL,
-        .free_cb = (lv_cache_free_cb_t) image_header_cache_free_cb
-    });
+        .free_cb = (lv_cache_free_cb_t) image_header_cache_free_cb,
+        .hash_cb = (lv_cache_hash_cb_t) image_header_cache_hash_cb,
+    }, LV_CACHE_SHARD_CNT);
 
     lv_cache_set_name(img_header_cache_p, CACHE_NAME);
     return img_header_cache_p != NULL ? LV_RESULT_OK : LV_RESULT_INVALID;
@@ -76,6 +79,10 @@ void lv_image_header_cache_resize(uint32_t count, bool evict_now)
 
 void lv_image_header_cache_drop(const void * src)
 {
+#if LV_USE_IMAGE_HEADER_INDEX
+    if(src == NULL || lv_image_src_get_type(src) == LV_IMAGE_SRC_FILE) lv_image_header_index_drop(src);
+#endif
+
     if(src == NULL) {
         lv_cache_drop_all(img_header_cache_p, NULL);
         return;
@@ -131,3 +138,8 @@ static void image_header_cache_free_cb(lv_image_header_cache_data_t * entry, voi
 
     if(entry->src_type == LV_IMAGE_SRC_FILE) lv_free((void *)entry->src);
 }
+
+static uint32_t image_header_cache_hash_cb(const lv_image_header_cache_data_t * key)
+{
+    return lv_image_cache_hash_src(key->src_type, key->src);
+}
@@ -0,0 +1,467 @@
+/**
+* @file lv_image_header_index.c
+*
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_image_header_index.h"
+
+#if LV_USE_IMAGE_HEADER_INDEX
+
+#include "../../draw/lv_image_decoder_private.h"
+#include "../../core/lv_global.h"
+#include "../../stdlib/lv_string.h"
+#include "../lv_fs.h"
+#include "../lv_array.h"
+#include "../lv_utils.h"
+#include "../lv_timer.h"
+#include "../lv_log.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define img_header_index_p (LV_GLOBAL_DEFAULT()->img_header_index)
+
+#define INDEX_MAGIC         0x48494C56  /*"VLIH"*/
+#define INDEX_VERSION       2
+#define INDEX_SAVE_DELAY    1000        /*Save the new headers after this many ms*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct lv_image_header_index_t lv_image_header_index_t;
+
+struct lv_image_header_index_t {
+    char * path;                /**< Path of the index file*/
+    lv_array_t entries;         /**< Array of `index_entry_t`*/
+    lv_mutex_t lock;            /**< The decoders can get the headers from the draw threads*/
+    lv_timer_t * save_timer;
+    bool changed;
+};
+
+typedef struct {
+    char * src;                 /**< Path of the image file*/
+    char * decoder_name;
+    uint32_t hash;              /**< Hash of `src` to skip the different paths quickly*/
+    lv_fs_stat_t stat;          /**< Size and modification time of the file when its header was read*/
+    lv_image_header_t header;
+} index_entry_t;
+
+/*The layout of the file. Only the same build can read it as it contains `lv_image_header_t` as it is.*/
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t header_size;       /**< sizeof(lv_image_header_t)*/
+    uint32_t entry_cnt;
+    uint32_t data_size;         /**< Size of the entries after this header*/
+    uint32_t checksum;          /**< FNV-1a of this header with `checksum = 0` and the entries*/
+} index_file_header_t;
+
+typedef struct {
+    uint32_t size;
+    uint32_t mtime;
+    lv_image_header_t header;
+    uint16_t src_len;
+    uint8_t decoder_name_len;
+    uint8_t reserved;
+    /*Followed by the path and the decoder name without '\0'*/
+} index_file_entry_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static void read_index_file(lv_image_header_index_t * index);
+static bool parse_index(lv_image_header_index_t * index, const uint8_t * data, uint32_t size);
+static index_entry_t * find_entry(lv_image_header_index_t * index, const char * src, uint32_t hash);
+static void free_entry(index_entry_t * entry);
+static void clear_entries(lv_image_header_index_t * index);
+static void save_timer_cb(lv_timer_t * timer);
+static uint32_t index_checksum(const index_file_header_t * file_header, const uint8_t * data);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_result_t lv_image_header_index_load(const char * path)
+{
+    LV_ASSERT_NULL(path);
+
+    lv_image_header_index_deinit();
+
+    lv_image_header_index_t * index = lv_malloc_zeroed(sizeof(lv_image_header_index_t));
+    LV_ASSERT_MALLOC(index);
+    if(index == NULL) return LV_RESULT_INVALID;
+
+    index->path = lv_strdup(path);
+    index->save_timer = lv_timer_create(save_timer_cb, INDEX_SAVE_DELAY, index);
+    if(index->path == NULL || index->save_timer == NULL) {
+        if(index->save_timer) lv_timer_delete(index->save_timer);
+        lv_free(index->path);
+        lv_free(index);
+        return LV_RESULT_INVALID;
+    }
+
+    lv_array_init(&index->entries, 0, sizeof(index_entry_t));
+    lv_mutex_init(&index->lock);
+    read_index_file(index);
+
+    img_header_index_p = index;
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_image_header_index_save(void)
+{
+    lv_image_header_index_t * index = img_header_index_p;
+    if(index == NULL) return LV_RESULT_OK;
+
+    lv_mutex_lock(&index->lock);
+    if(!index->changed) {
+        lv_mutex_unlock(&index->lock);
+        return LV_RESULT_OK;
+    }
+
+    uint32_t entry_cnt = lv_array_size(&index->entries);
+    uint32_t data_size = 0;
+    uint32_t i;
+    for(i = 0; i < entry_cnt; i++) {
+        index_entry_t * entry = lv_array_at(&index->entries, i);
+        data_size += sizeof(index_file_entry_t) + lv_strlen(entry->src) + lv_strlen(entry->decoder_name);
+    }
+
+    uint8_t * buf = lv_malloc(sizeof(index_file_header_t) + data_size);
+    if(buf == NULL) {
+        lv_mutex_unlock(&index->lock);
+        LV_LOG_WARN("Out of memory");
+        return LV_RESULT_INVALID;
+    }
+
+    uint8_t * p = buf + sizeof(index_file_header_t);
+    for(i = 0; i < entry_cnt; i++) {
+        index_entry_t * entry = lv_array_at(&index->entries, i);
+        index_file_entry_t file_entry;
+        lv_memzero(&file_entry, sizeof(file_entry));
+        file_entry.size = entry->stat.size;
+        file_entry.mtime = entry->stat.mtime;
+        file_entry.header = entry->header;
+        file_entry.src_len = (uint16_t)lv_strlen(entry->src);
+        file_entry.decoder_name_len = (uint8_t)lv_strlen(entry->decoder_name);
+        lv_memcpy(p, &file_entry, sizeof(file_entry));
+        p += sizeof(file_entry);
+        lv_memcpy(p, entry->src, file_entry.src_len);
+        p += file_entry.src_len;
+        lv_memcpy(p, entry->decoder_name, file_entry.decoder_name_len);
+        p += file_entry.decoder_name_len;
+    }
+
+    /*Don't try again and again if the file can't be written*/
+    index->changed = false;
+    lv_mutex_unlock(&index->lock);
+
+    index_file_header_t file_header;
+    lv_memzero(&file_header, sizeof(file_header));
+    file_header.magic = INDEX_MAGIC;
+    file_header.version = INDEX_VERSION;
+    file_header.header_size = sizeof(lv_image_header_t);
+    file_header.entry_cnt = entry_cnt;
+    file_header.data_size = data_size;
+    file_header.checksum = index_checksum(&file_header, buf + sizeof(index_file_header_t));
+    lv_memcpy(buf, &file_header, sizeof(file_header));
+
+    lv_result_t res = LV_RESULT_INVALID;
+    lv_fs_file_t f;
+    uint32_t bw = 0;
+    lv_fs_res_t fs_res = lv_fs_open(&f, index->path, LV_FS_MODE_WR);
+    if(fs_res == LV_FS_RES_OK) {
+        fs_res = lv_fs_write(&f, buf, sizeof(index_file_header_t) + data_size, &bw);
+        lv_fs_close(&f);
+        if(fs_res == LV_FS_RES_OK && bw == sizeof(index_file_header_t) + data_size) res = LV_RESULT_OK;
+    }
+
+    if(res == LV_RESULT_OK) LV_LOG_INFO("Saved %" LV_PRIu32 " image headers to %s", entry_cnt, index->path);
+    else LV_LOG_WARN("Couldn't save the image header index to %s: %d", index->path, fs_res);
+
+    lv_free(buf);
+    return res;
+}
+
+void lv_image_header_index_deinit(void)
+{
+    lv_image_header_index_t * index = img_header_index_p;
+    if(index == NULL) return;
+
+    lv_image_header_index_save();
+
+    img_header_index_p = NULL;
+    lv_timer_delete(index->save_timer);
+
+    clear_entries(index);
+    lv_array_deinit(&index->entries);
+    lv_mutex_delete(&index->lock);
+    lv_free(index->path);
+    lv_free(index);
+}
+
+bool lv_image_header_index_get(const char * src, lv_image_header_t * header, lv_image_decoder_t ** decoder)
+{
+    lv_image_header_index_t * index = img_header_index_p;
+    if(index == NULL) return false;
+
+    uint32_t hash = lv_utils_fnv1a(LV_UTILS_FNV1A_INIT, src, lv_strlen(src));
+    lv_fs_stat_t indexed_stat;
+    lv_image_header_t indexed_header;
+    lv_image_decoder_t * found_decoder = NULL;
+
+    lv_mutex_lock(&index->lock);
+    index_entry_t * entry = find_entry(index, src, hash);
+    if(entry) {
+        /*The decoders have no IDs, but they are named*/
+        lv_image_decoder_t * d = lv_image_decoder_get_next(NULL);
+        while(d) {
+            if(d->name && lv_strcmp(d->name, entry->decoder_name) == 0) break;
+            d = lv_image_decoder_get_next(d);
+        }
+
+        found_decoder = d;
+        indexed_stat = entry->stat;
+        indexed_header = entry->header;
+    }
+    lv_mutex_unlock(&index->lock);
+
+    if(found_decoder == NULL) return false;
+
+    /*Only the metadata of the file is read, the file is not opened*/
+    lv_fs_stat_t stat;
+    if(lv_fs_stat(src, &stat) != LV_FS_RES_OK) return false;
+    if(stat.size != indexed_stat.size || stat.mtime != indexed_stat.mtime) return false;
+
+    *header = indexed_header;
+    *decoder = found_decoder;
+    return true;
+}
+
+void lv_image_header_index_set(const char * src, const lv_image_header_t * header, const lv_image_decoder_t * decoder)
+{
+    lv_image_header_index_t * index = img_header_index_p;
+    if(index == NULL || decoder->name == NULL) return;
+
+    /*Without the size and modification time it couldn't be known whether the image has changed*/
+    lv_fs_stat_t stat;
+    if(lv_fs_stat(src, &stat) != LV_FS_RES_OK) return;
+
+    uint32_t hash = lv_utils_fnv1a(LV_UTILS_FNV1A_INIT, src, lv_strlen(src));
+
+    lv_mutex_lock(&index->lock);
+    index_entry_t * entry = find_entry(index, src, hash);
+    if(entry) {
+        if(entry->stat.size == stat.size && entry->stat.mtime == stat.mtime &&
+           lv_memcmp(&entry->header, header, sizeof(lv_image_header_t)) == 0 &&
+           lv_strcmp(entry->decoder_name, decoder->name) == 0) {
+            lv_mutex_unlock(&index->lock);
+            return;
+        }
+
+        if(lv_strcmp(entry->decoder_name, decoder->name) != 0) {
+            char * decoder_name = lv_strdup(decoder->name);
+            if(decoder_name == NULL) {
+                lv_mutex_unlock(&index->lock);
+                return;
+            }
+            lv_free(entry->decoder_name);
+            entry->decoder_name = decoder_name;
+        }
+    }
+    else {
+        index_entry_t new_entry;
+        new_entry.src = lv_strdup(src);
+        new_entry.decoder_name = lv_strdup(decoder->name);
+        new_entry.hash = hash;
+        if(new_entry.src == NULL || new_entry.decoder_name == NULL ||
+           lv_array_push_back(&index->entries, &new_entry) != LV_RESULT_OK) {
+            free_entry(&new_entry);
+            lv_mutex_unlock(&index->lock);
+            return;
+        }
+        entry = lv_array_back(&index->entries);
+    }
+
+    entry->stat = stat;
+    entry->header = *header;
+    index->changed = true;
+    lv_mutex_unlock(&index->lock);
+}
+
+void lv_image_header_index_drop(const char * src)
+{
+    lv_image_header_index_t * index = img_header_index_p;
+    if(index == NULL) return;
+
+    lv_mutex_lock(&index->lock);
+    if(src == NULL) {
+        if(!lv_array_is_empty(&index->entries)) index->changed = true;
+        clear_entries(index);
+    }
+    else {
+        index_entry_t * entry = find_entry(index, src, lv_utils_fnv1a(LV_UTILS_FNV1A_INIT, src, lv_strlen(src)));
+        if(entry) {
+            free_entry(entry);
+            uint32_t i = (uint32_t)(entry - (index_entry_t *)lv_array_front(&index->entries));
+            lv_array_remove(&index->entries, i);
+            index->changed = true;
+        }
+    }
+    lv_mutex_unlock(&index->lock);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void read_index_file(lv_image_header_index_t * index)
+{
+    lv_fs_file_t f;
+    if(lv_fs_open(&f, index->path, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+        LV_LOG_INFO("No image header index in %s yet", index->path);
+        return;
+    }
+
+    index_file_header_t file_header;
+    uint32_t br = 0;
+    uint32_t file_size = 0;
+    lv_fs_res_t fs_res = lv_fs_read(&f, &file_header, sizeof(file_header), &br);
+    if(fs_res == LV_FS_RES_OK) fs_res = lv_fs_seek(&f, 0, LV_FS_SEEK_END);
+    if(fs_res == LV_FS_RES_OK) fs_res = lv_fs_tell(&f, &file_size);
+    if(fs_res == LV_FS_RES_OK) fs_res = lv_fs_seek(&f, sizeof(file_header), LV_FS_SEEK_SET);
+
+    /*The header is checked before allocating anything based on it. A flipped bit in a size or
+     *count would be caught only by the checksum which needs the data read first.*/
+    if(fs_res != LV_FS_RES_OK || br != sizeof(file_header) || file_header.magic != INDEX_MAGIC ||
+       file_header.version != INDEX_VERSION || file_header.header_size != sizeof(lv_image_header_t) ||
+       file_size < sizeof(file_header) || file_header.data_size > file_size - sizeof(file_header) ||
+       file_header.entry_cnt > file_header.data_size / sizeof(index_file_entry_t)) {
+        LV_LOG_WARN("Invalid image header index: %s", index->path);
+        lv_fs_close(&f);
+        return;
+    }
+
+    uint8_t * data = lv_malloc(file_header.data_size);
+    if(data == NULL) {
+        LV_LOG_WARN("Out of memory");
+        lv_fs_close(&f);
+        return;
+    }
+
+    fs_res = lv_fs_read(&f, data, file_header.data_size, &br);
+    lv_fs_close(&f);
+
+    bool valid = fs_res == LV_FS_RES_OK && br == file_header.data_size &&
+                 index_checksum(&file_header, data) == file_header.checksum;
+    if(valid) {
+        lv_array_resize(&index->entries, file_header.entry_cnt);
+        valid = parse_index(index, data, file_header.data_size) &&
+                lv_array_size(&index->entries) == file_header.entry_cnt;
+    }
+
+    if(!valid) {
+        LV_LOG_WARN("Invalid image header index: %s", index->path);
+        clear_entries(index);
+    }
+    else {
+        LV_LOG_INFO("Loaded %" LV_PRIu32 " image headers from %s", lv_array_size(&index->entries), index->path);
+    }
+
+    lv_free(data);
+}
+
+static bool parse_index(lv_image_header_index_t * index, const uint8_t * data, uint32_t size)
+{
+    uint32_t pos = 0;
+    while(pos < size) {
+        index_file_entry_t file_entry;
+        if(size - pos < sizeof(file_entry)) return false;
+        lv_memcpy(&file_entry, data + pos, sizeof(file_entry));
+        pos += sizeof(file_entry);
+        if(size - pos < (uint32_t)file_entry.src_len + file_entry.decoder_name_len) return false;
+
+        index_entry_t entry;
+        entry.src = lv_malloc(file_entry.src_len + 1);
+        entry.decoder_name = lv_malloc(file_entry.decoder_name_len + 1);
+        if(entry.src == NULL || entry.decoder_name == NULL) {
+            free_entry(&entry);
+            return false;
+        }
+
+        lv_memcpy(entry.src, data + pos, file_entry.src_len);
+        entry.src[file_entry.src_len] = '\0';
+        pos += file_entry.src_len;
+        lv_memcpy(entry.decoder_name, data + pos, file_entry.decoder_name_len);
+        entry.decoder_name[file_entry.decoder_name_len] = '\0';
+        pos += file_entry.decoder_name_len;
+
+        entry.hash = lv_utils_fnv1a(LV_UTILS_FNV1A_INIT, entry.src, file_entry.src_len);
+        entry.stat.size = file_entry.size;
+        entry.stat.mtime = file_entry.mtime;
+        entry.header = file_entry.header;
+        if(lv_array_push_back(&index->entries, &entry) != LV_RESULT_OK) {
+            free_entry(&entry);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static index_entry_t * find_entry(lv_image_header_index_t * index, const char * src, uint32_t hash)
+{
+    uint32_t i;
+    for(i = 0; i < lv_array_size(&index->entries); i++) {
+        index_entry_t * entry = lv_array_at(&index->entries, i);
+        if(entry->hash == hash && lv_strcmp(entry->src, src) == 0) return entry;
+    }
+
+    return NULL;
+}
+
+static void free_entry(index_entry_t * entry)
+{
+    lv_free(entry->src);
+    lv_free(entry->decoder_name);
+}
+
+static void clear_entries(lv_image_header_index_t * index)
+{
+    uint32_t i;
+    for(i = 0; i < lv_array_size(&index->entries); i++) {
+        free_entry(lv_array_at(&index->entries, i));
+    }
+    lv_array_clear(&index->entries);
+}
+
+static void save_timer_cb(lv_timer_t * timer)
+{
+    LV_UNUSED(timer);
+    lv_image_header_index_save();
+}
+
+static uint32_t index_checksum(const index_file_header_t * file_header, const uint8_t * data)
+{
+    index_file_header_t h = *file_header;
+    h.checksum = 0;
+    uint32_t hash = lv_utils_fnv1a(LV_UTILS_FNV1A_INIT, &h, sizeof(h));
+    return lv_utils_fnv1a(hash, data, file_header->data_size);
+}
+
+#endif /*LV_USE_IMAGE_HEADER_INDEX*/
@@ -0,0 +1,97 @@
+/**
+* @file lv_image_header_index.h
+*
+ */
+
+#ifndef LV_IMAGE_HEADER_INDEX_H
+#define LV_IMAGE_HEADER_INDEX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../../lv_conf_internal.h"
+#include "../lv_types.h"
+#include "../../draw/lv_image_dsc.h"
+
+#if LV_USE_IMAGE_HEADER_INDEX
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Load the headers of the image files saved in an earlier run, so they can be used
+ * without opening the images if their size and modification time are the same.
+ * The new headers are saved to the same file shortly after they were found.
+ * Called by `lv_init()` with `LV_IMAGE_HEADER_INDEX_PATH`.
+ * The previously loaded index is saved and replaced.
+ * @param path  path of the index file. It's created if it doesn't exist.
+ * @return      LV_RESULT_OK: the index is used, even if the file was missing or invalid;
+ *              LV_RESULT_INVALID: out of memory
+ */
+lv_result_t lv_image_header_index_load(const char * path);
+
+/**
+ * Save the index now if it has changed, e.g. before turning off the device.
+ * @return  LV_RESULT_OK: saved or there was nothing to save; LV_RESULT_INVALID: the file couldn't be written
+ */
+lv_result_t lv_image_header_index_save(void);
+
+/**
+ * Save the index if it has changed and free it. Called in `lv_deinit()`.
+ */
+void lv_image_header_index_deinit(void);
+
+/**
+ * Get the header and the decoder of an image file from the index if the file hasn't changed.
+ * Called internally when the info of an image is needed.
+ * @param src       path of the image file
+ * @param header    store the header here
+ * @param decoder   store the decoder which can open the image here
+ * @return          true: found; false: not indexed or changed since indexed
+ */
+bool lv_image_header_index_get(const char * src, lv_image_header_t * header, lv_image_decoder_t ** decoder);
+
+/**
+ * Add or update the header of an image file in the index.
+ * Called internally when a decoder has read the header.
+ * @param src       path of the image file
+ * @param header    header of the image
+ * @param decoder   the decoder which read the header
+ */
+void lv_image_header_index_set(const char * src, const lv_image_header_t * header, const lv_image_decoder_t * decoder);
+
+/**
+ * Remove an image file from the index. Called when the image cache is invalidated.
+ * @param src   path of the image file or NULL to remove all
+ */
+void lv_image_header_index_drop(const char * src);
+
+/*************************
+ *    GLOBAL VARIABLES
+ *************************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_IMAGE_HEADER_INDEX*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_IMAGE_HEADER_INDEX_H*/
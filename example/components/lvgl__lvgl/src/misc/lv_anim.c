@@ -24,10 +24,26 @@
 #define state LV_GLOBAL_DEFAULT()->anim_state
 #define anim_ll_p &(state.anim_ll)
 
+#define EASE_IN_PARA        LV_BEZIER_VAL_FLOAT(0.42), LV_BEZIER_VAL_FLOAT(0), LV_BEZIER_VAL_FLOAT(1), LV_BEZIER_VAL_FLOAT(1)
+#define EASE_OUT_PARA       LV_BEZIER_VAL_FLOAT(0), LV_BEZIER_VAL_FLOAT(0), LV_BEZIER_VAL_FLOAT(0.58), LV_BEZIER_VAL_FLOAT(1)
+#define EASE_IN_OUT_PARA    LV_BEZIER_VAL_FLOAT(0.42), LV_BEZIER_VAL_FLOAT(0), LV_BEZIER_VAL_FLOAT(0.58), LV_BEZIER_VAL_FLOAT(1)
+#define OVERSHOOT_PARA      341, 0, 683, 1300
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+/** The animations whose values are calculated together. The bezier paths are in the order of `path_bezier_paras`.*/
+typedef enum {
+    ANIM_PATH_GROUP_LINEAR,
+    ANIM_PATH_GROUP_EASE_IN,
+    ANIM_PATH_GROUP_EASE_OUT,
+    ANIM_PATH_GROUP_EASE_IN_OUT,
+    ANIM_PATH_GROUP_OVERSHOOT,
+    ANIM_PATH_GROUP_OTHER,          /**< Calculated by calling `path_cb`*/
+    ANIM_PATH_GROUP_CNT,
+} anim_path_group_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -40,10 +56,22 @@ static uint32_t convert_speed_to_time(uint32_t speed, int32_t start, int32_t end
 static void resolve_time(lv_anim_t * a);
 static bool remove_concurrent_anims(lv_anim_t * a_current);
 static void remove_anim(void * a);
+static bool batch_collect(lv_anim_batch_t * batch);
+static void batch_start(lv_anim_batch_t * batch, uint32_t i, uint32_t now);
+static void batch_eval(lv_anim_batch_t * batch);
+static void batch_apply(lv_anim_batch_t * batch, uint32_t i);
+static uint32_t path_group_get(lv_anim_path_cb_t path_cb);
+static void batch_forget(lv_anim_t * a);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+static const int32_t path_bezier_paras[][4] = {
+    {EASE_IN_PARA},
+    {EASE_OUT_PARA},
+    {EASE_IN_OUT_PARA},
+    {OVERSHOOT_PARA},
+};
 
 /**********************
  *      MACROS
@@ -63,13 +91,15 @@ void lv_anim_core_init(void)
     lv_ll_init(anim_ll_p, sizeof(lv_anim_t));
     state.timer = lv_timer_create(anim_timer, LV_DEF_REFR_PERIOD, NULL);
     anim_mark_list_change(); /*Turn off the animation timer*/
-    state.anim_list_changed = false;
-    state.anim_run_round = false;
 }
 
 void lv_anim_core_deinit(void)
 {
     lv_anim_delete_all();
+
+    lv_free(state.batch_buf);
+    state.batch_buf = NULL;
+    state.batch_buf_cnt = 0;
 }
 
 void lv_anim_init(lv_anim_t * a)
@@ -95,7 +125,7 @@ lv_anim_t * lv_anim_start(const lv_anim_t * a)
     /*Initialize the animation descriptor*/
     lv_memcpy(new_anim, a, sizeof(lv_anim_t));
     if(a->var == a) new_anim->var = new_anim;
-    new_anim->run_round = state.anim_run_round;
+    new_anim->batch_pos = 0;
     new_anim->last_timer_run = lv_tick_get();
 
     /*Set the start value*/
@@ -120,8 +150,7 @@ lv_anim_t * lv_anim_start(const lv_anim_t * a)
         }
     }
 
-    /*Creating an animation changed the linked list.
-     *It's important if it happens in a ready callback. (see `anim_timer`)*/
+    /*Resume the animation timer if needed*/
     anim_mark_list_change();
 
     LV_TRACE_ANIM("finished");
@@ -151,8 +180,7 @@ bool lv_anim_delete(void * var, lv_anim_exec_xcb_t exec_cb)
         bool del = false;
         if((a->var == var || var == NULL) && (a->exec_cb == exec_cb || exec_cb == NULL)) {
             remove_anim(a);
-            anim_mark_list_change(); /*Read by `anim_timer`. It need to know if a delete occurred in
-                                       the linked list*/
+            anim_mark_list_change();
             del_any = true;
             del = true;
         }
@@ -259,25 +287,22 @@ int32_t lv_anim_path_linear(const lv_anim_t * a)
 
 int32_t lv_anim_path_ease_in(const lv_anim_t * a)
 {
-    return lv_anim_path_cubic_bezier(a, LV_BEZIER_VAL_FLOAT(0.42), LV_BEZIER_VAL_FLOAT(0),
-                                     LV_BEZIER_VAL_FLOAT(1), LV_BEZIER_VAL_FLOAT(1));
+    return lv_anim_path_cubic_bezier(a, EASE_IN_PARA);
 }
 
 int32_t lv_anim_path_ease_out(const lv_anim_t * a)
 {
-    return lv_anim_path_cubic_bezier(a, LV_BEZIER_VAL_FLOAT(0), LV_BEZIER_VAL_FLOAT(0),
-                                     LV_BEZIER_VAL_FLOAT(0.58), LV_BEZIER_VAL_FLOAT(1));
+    return lv_anim_path_cubic_bezier(a, EASE_OUT_PARA);
 }
 
 int32_t lv_anim_path_ease_in_out(const lv_anim_t * a)
 {
-    return lv_anim_path_cubic_bezier(a, LV_BEZIER_VAL_FLOAT(0.42), LV_BEZIER_VAL_FLOAT(0),
-                                     LV_BEZIER_VAL_FLOAT(0.58), LV_BEZIER_VAL_FLOAT(1));
+    return lv_anim_path_cubic_bezier(a, EASE_IN_OUT_PARA);
 }
 
 int32_t lv_anim_path_overshoot(const lv_anim_t * a)
 {
-    return lv_anim_path_cubic_bezier(a, 341, 0, 683, 1300);
+    return lv_anim_path_cubic_bezier(a, OVERSHOOT_PARA);
 }
 
 int32_t lv_anim_path_bounce(const lv_anim_t * a)
@@ -494,72 +519,257 @@ static void anim_timer(lv_timer_t * param)
 {
     LV_UNUSED(param);
 
-    /*Flip the run round*/
-    state.anim_run_round = state.anim_run_round ? false : true;
+    /*Collect the animations first and process only them. This way the callbacks can start
+     *and delete animations without reading the linked list again from the head*/
+    lv_anim_batch_t batch;
+    if(!batch_collect(&batch)) return;
 
-    lv_anim_t * a = lv_ll_get_head(anim_ll_p);
+    /*Not NULL if `lv_anim_refr_now()` is called from an animation's callback*/
+    batch.parent = state.batch;
+    state.batch = &batch;
 
-    while(a != NULL) {
-        uint32_t elaps = lv_tick_elaps(a->last_timer_run);
-        a->act_time += elaps;
+    uint32_t now = lv_tick_get();
+    uint32_t i;
+    for(i = 0; i < batch.cnt; i++) {
+        if(batch.anims[i]) batch_start(&batch, i, now);
+    }
 
-        a->last_timer_run = lv_tick_get();
+    batch_eval(&batch);
 
-        /*It can be set by `lv_anim_delete()` typically in `end_cb`. If set then an animation delete
-         * happened in `anim_completed_handler` which could make this linked list reading corrupt
-         * because the list is changed meanwhile
-         */
-        state.anim_list_changed = false;
+    for(i = 0; i < batch.cnt; i++) {
+        if(batch.anims[i]) batch_apply(&batch, i);
+    }
 
-        if(a->run_round != state.anim_run_round) {
-            a->run_round = state.anim_run_round; /*The list readying might be reset so need to know which anim has run already*/
+    state.batch = batch.parent;
+    if(batch.parent == NULL) return;
 
-            /*The animation will run now for the first time. Call `start_cb`*/
-            if(!a->start_cb_called && a->act_time >= 0) {
+    /*The animations of the outer batch were added to this one too. Point to the outer batch again.*/
+    lv_free(batch.anims);
+    for(i = 0; i < state.batch->cnt; i++) {
+        lv_anim_t * a = state.batch->anims[i];
+        if(a) a->batch_pos = i + 1;
+    }
+}
 
-                if(a->early_apply == 0 && a->get_value_cb) {
-                    int32_t v_ofs = a->get_value_cb(a);
-                    a->start_value += v_ofs;
-                    a->end_value += v_ofs;
-                }
+/**
+ * Collect the running animations into a batch
+ * @param batch     initialize this batch
+ * @return          true: success; false: out of memory
+ */
+static bool batch_collect(lv_anim_batch_t * batch)
+{
+    uint32_t cnt = 0;
+    lv_anim_t * a;
+    LV_LL_READ(anim_ll_p, a) cnt++;
+    if(cnt == 0) return false;
+
+    /*The arrays of the outermost batch are reused, the nested batches are rare*/
+    const uint32_t item_size = sizeof(lv_anim_t *) + sizeof(int32_t) + sizeof(uint32_t);
+    void * buf;
+    if(state.batch == NULL) {
+        if(cnt > state.batch_buf_cnt) {
+            void * new_buf = lv_realloc(state.batch_buf, cnt * item_size);
+            LV_ASSERT_MALLOC(new_buf);
+            if(new_buf == NULL) return false;
+            state.batch_buf = new_buf;
+            state.batch_buf_cnt = cnt;
+        }
+        buf = state.batch_buf;
+    }
+    else {
+        buf = lv_malloc(cnt * item_size);
+        LV_ASSERT_MALLOC(buf);
+        if(buf == NULL) return false;
+    }
 
-                resolve_time(a);
+    batch->anims = buf;
+    batch->values = (int32_t *)(batch->anims + cnt);
+    batch->order = (uint32_t *)(batch->values + cnt);
+    batch->cnt = 0;
+    LV_LL_READ(anim_ll_p, a) {
+        batch->anims[batch->cnt] = a;
+        batch->cnt++;
+        a->batch_pos = batch->cnt;
+    }
 
-                if(a->start_cb) a->start_cb(a);
-                a->start_cb_called = 1;
+    return true;
+}
 
-                /*Do not let two animations for the same 'var' with the same 'exec_cb'*/
-                remove_concurrent_anims(a);
-            }
+/**
+ * Step the time of an animation and start it if its delay has elapsed
+ * @param batch     the batch being processed
+ * @param i         index of the animation in the batch
+ * @param now       the current tick
+ */
+static void batch_start(lv_anim_batch_t * batch, uint32_t i, uint32_t now)
+{
+    lv_anim_t * a = batch->anims[i];
+    a->act_time += (int32_t)(now - a->last_timer_run);
+    a->last_timer_run = now;
+
+    /*The animation will run now for the first time. Call `start_cb`*/
+    if(!a->start_cb_called && a->act_time >= 0) {
 
-            if(a->act_time >= 0) {
-                if(a->act_time > a->duration) a->act_time = a->duration;
+        if(a->early_apply == 0 && a->get_value_cb) {
+            int32_t v_ofs = a->get_value_cb(a);
+            a->start_value += v_ofs;
+            a->end_value += v_ofs;
+        }
 
-                int32_t new_value;
-                new_value = a->path_cb(a);
+        resolve_time(a);
 
-                if(new_value != a->current_value) {
-                    a->current_value = new_value;
-                    /*Apply the calculated value*/
-                    if(a->exec_cb) a->exec_cb(a->var, new_value);
-                    if(!state.anim_list_changed && a->custom_exec_cb) a->custom_exec_cb(a, new_value);
-                }
+        if(a->start_cb) a->start_cb(a);
+        /*NULL if the callback has deleted the animation*/
+        if(batch->anims[i] == NULL) return;
+        a->start_cb_called = 1;
 
-                /*If the time is elapsed the animation is ready*/
-                if(!state.anim_list_changed && a->act_time >= a->duration) {
-                    anim_completed_handler(a);
-                }
-            }
+        /*Do not let two animations for the same 'var' with the same 'exec_cb'*/
+        remove_concurrent_anims(a);
+        if(batch->anims[i] == NULL) return;
+    }
+
+    /*Still waiting for its delay, nothing else to do in this round*/
+    if(a->act_time < 0) {
+        batch->anims[i] = NULL;
+        a->batch_pos = 0;
+        return;
+    }
+
+    if(a->act_time > a->duration) a->act_time = a->duration;
+}
+
+/**
+ * Calculate the new value of the started animations of a batch.
+ * The animations are grouped by path function so the common easings are calculated in tight loops
+ * without calling the path functions.
+ * @param batch     the batch being processed
+ */
+static void batch_eval(lv_anim_batch_t * batch)
+{
+    /*Count the animations of the groups. `values` is free until the values are calculated.*/
+    uint32_t group_start[ANIM_PATH_GROUP_CNT + 1];
+    lv_memzero(group_start, sizeof(group_start));
+    uint32_t i;
+    for(i = 0; i < batch->cnt; i++) {
+        if(batch->anims[i] == NULL) continue;
+        uint32_t group = path_group_get(batch->anims[i]->path_cb);
+        batch->values[i] = (int32_t)group;
+        group_start[group + 1]++;
+    }
+
+    uint32_t group;
+    for(group = 1; group <= ANIM_PATH_GROUP_CNT; group++) group_start[group] += group_start[group - 1];
+
+    uint32_t group_pos[ANIM_PATH_GROUP_CNT];
+    lv_memcpy(group_pos, group_start, sizeof(group_pos));
+    for(i = 0; i < batch->cnt; i++) {
+        if(batch->anims[i] == NULL) continue;
+        group = (uint32_t)batch->values[i];
+        batch->order[group_pos[group]] = i;
+        group_pos[group]++;
+    }
+
+    /*Calculate the same way as the path functions*/
+    uint32_t j;
+    for(j = group_start[ANIM_PATH_GROUP_LINEAR]; j < group_start[ANIM_PATH_GROUP_LINEAR + 1]; j++) {
+        i = batch->order[j];
+        const lv_anim_t * a = batch->anims[i];
+        int32_t step = lv_map(a->act_time, 0, a->duration, 0, LV_ANIM_RESOLUTION);
+        int32_t new_value = step * (a->end_value - a->start_value);
+        new_value = new_value >> LV_ANIM_RES_SHIFT;
+        batch->values[i] = new_value + a->start_value;
+    }
+
+    for(group = ANIM_PATH_GROUP_EASE_IN; group <= ANIM_PATH_GROUP_OVERSHOOT; group++) {
+        const int32_t * para = path_bezier_paras[group - ANIM_PATH_GROUP_EASE_IN];
+        for(j = group_start[group]; j < group_start[group + 1]; j++) {
+            i = batch->order[j];
+            const lv_anim_t * a = batch->anims[i];
+            int32_t t = lv_map(a->act_time, 0, a->duration, 0, LV_BEZIER_VAL_MAX);
+            int32_t step = lv_cubic_bezier(t, para[0], para[1], para[2], para[3]);
+            int32_t new_value = step * (a->end_value - a->start_value);
+            new_value = new_value >> LV_BEZIER_VAL_SHIFT;
+            batch->values[i] = new_value + a->start_value;
+        }
+    }
+
+    for(j = group_start[ANIM_PATH_GROUP_OTHER]; j < group_start[ANIM_PATH_GROUP_OTHER + 1]; j++) {
+        i = batch->order[j];
+        lv_anim_t * a = batch->anims[i];
+        batch->values[i] = a->path_cb(a);
+    }
+}
+
+/**
+ * Apply the new value of an animation and complete it if its time has elapsed
+ * @param batch     the batch being processed
+ * @param i         index of the animation in the batch
+ */
+static void batch_apply(lv_anim_batch_t * batch, uint32_t i)
+{
+    lv_anim_t * a = batch->anims[i];
+    int32_t new_value = batch->values[i];
+
+    if(new_value != a->current_value) {
+        a->current_value = new_value;
+        /*Apply the calculated value. The slot is NULL if a callback has deleted the animation.*/
+        if(a->exec_cb) {
+            a->exec_cb(a->var, new_value);
+            if(batch->anims[i] == NULL) return;
         }
+        if(a->custom_exec_cb) {
+            a->custom_exec_cb(a, new_value);
+            if(batch->anims[i] == NULL) return;
+        }
+    }
 
-        /*If the linked list changed due to anim. delete then it's not safe to continue
-         *the reading of the list from here -> start from the head*/
-        if(state.anim_list_changed)
-            a = lv_ll_get_head(anim_ll_p);
-        else
-            a = lv_ll_get_next(anim_ll_p, a);
+    /*If the time is elapsed the animation is ready*/
+    if(a->act_time >= a->duration) {
+        anim_completed_handler(a);
+        if(batch->anims[i] == NULL) return;
     }
 
+    batch->anims[i] = NULL;
+    a->batch_pos = 0;
+}
+
+/**
+ * Get the group of a path function in which the animations are calculated together
+ * @param path_cb   a path function
+ * @return          an `anim_path_group_t` value
+ */
+static uint32_t path_group_get(lv_anim_path_cb_t path_cb)
+{
+    if(path_cb == lv_anim_path_linear) return ANIM_PATH_GROUP_LINEAR;
+    if(path_cb == lv_anim_path_ease_in) return ANIM_PATH_GROUP_EASE_IN;
+    if(path_cb == lv_anim_path_ease_out) return ANIM_PATH_GROUP_EASE_OUT;
+    if(path_cb == lv_anim_path_ease_in_out) return ANIM_PATH_GROUP_EASE_IN_OUT;
+    if(path_cb == lv_anim_path_overshoot) return ANIM_PATH_GROUP_OVERSHOOT;
+    return ANIM_PATH_GROUP_OTHER;
+}
+
+/**
+ * Remove an animation from the batches of the running animation timer
+ * because it's deleted
+ * @param a     pointer to an animation
+ */
+static void batch_forget(lv_anim_t * a)
+{
+    if(state.batch == NULL) return;
+
+    if(a->batch_pos) {
+        state.batch->anims[a->batch_pos - 1] = NULL;
+        a->batch_pos = 0;
+    }
+
+    /*The outer batches exist only if `lv_anim_refr_now()` was called from a callback*/
+    lv_anim_batch_t * batch;
+    for(batch = state.batch->parent; batch; batch = batch->parent) {
+        uint32_t i;
+        for(i = 0; i < batch->cnt; i++) {
+            if(batch->anims[i] == a) batch->anims[i] = NULL;
+        }
+    }
 }
 
 /**
@@ -582,7 +792,7 @@ static void anim_completed_handler(lv_anim_t * a)
         /*Delete the animation from the list.
          * This way the `completed_cb` will see the animations like it's animation is already deleted*/
         lv_ll_remove(anim_ll_p, a);
-        /*Flag that the list has changed*/
+        batch_forget(a);
         anim_mark_list_change();
 
         /*Call the callback function at the end*/
@@ -614,7 +824,6 @@ static void anim_completed_handler(lv_anim_t * a)
 
 static void anim_mark_list_change(void)
 {
-    state.anim_list_changed = true;
     if(lv_ll_get_head(anim_ll_p) == NULL)
         lv_timer_pause(state.timer);
     else
@@ -681,9 +890,9 @@ static bool remove_concurrent_anims(lv_anim_t * a_current)
            ((a->exec_cb && a->exec_cb == a_current->exec_cb)
             /*|| (a->custom_exec_cb && a->custom_exec_cb == a_current->custom_exec_cb)*/)) {
             lv_ll_remove(anim_ll_p, a);
+            batch_forget(a);
             if(a->deleted_cb != NULL) a->deleted_cb(a);
             lv_free(a);
-            /*Read by `anim_timer`. It need to know if a delete occurred in the linked list*/
             anim_mark_list_change();
 
             del_any = true;
@@ -702,6 +911,7 @@ static void remove_anim(void * a)
 {
     lv_anim_t * anim = a;
     lv_ll_remove(anim_ll_p, a);
+    batch_forget(anim);
     if(anim->deleted_cb != NULL) anim->deleted_cb(anim);
     lv_free(a);
 }
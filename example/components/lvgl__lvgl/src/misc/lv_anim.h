@@ -147,8 +147,8 @@ struct lv_anim_t {
 
     /* Animation system use these - user shouldn't set */
     uint32_t last_timer_run;
+    uint32_t batch_pos;           /**< 1-based index in the innermost batch of the animation timer, 0: not in it*/
     uint8_t playback_now : 1;     /**< Play back is in progress*/
-    uint8_t run_round : 1;        /**< Indicates the animation has run in this round*/
     uint8_t start_cb_called : 1;  /**< Indicates that the `start_cb` was already called*/
     uint8_t early_apply  : 1;     /**< 1: Apply start value immediately even is there is `delay`*/
 };
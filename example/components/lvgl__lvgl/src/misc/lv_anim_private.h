@@ -24,11 +24,23 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+typedef struct lv_anim_batch_t lv_anim_batch_t;
+
+/** The animations processed by a run of the animation timer, stored as parallel arrays*/
+struct lv_anim_batch_t {
+    lv_anim_t ** anims;         /**< The animations in the order of the list. NULL: deleted or already processed*/
+    int32_t * values;           /**< The new value of each animation*/
+    uint32_t * order;           /**< Indices of `anims` grouped by path function*/
+    uint32_t cnt;
+    lv_anim_batch_t * parent;   /**< The batch interrupted by `lv_anim_refr_now()` called from a callback*/
+};
+
 typedef struct {
-    bool anim_list_changed;
-    bool anim_run_round;
     lv_timer_t * timer;
     lv_ll_t anim_ll;
+    lv_anim_batch_t * batch;    /**< The innermost batch being processed or NULL*/
+    void * batch_buf;           /**< The arrays of the outermost batch, kept between the timer runs*/
+    uint32_t batch_buf_cnt;     /**< Number of animations fitting into `batch_buf`*/
 } lv_anim_state_t;
 
 /**********************
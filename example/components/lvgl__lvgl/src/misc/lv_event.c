@@ -209,6 +209,24 @@ uint32_t lv_event_register_id(void)
     return event_last_id;
 }
 
+uint64_t lv_event_get_filter_mask(lv_event_list_t * list)
+{
+    LV_ASSERT_NULL(list);
+
+    uint64_t mask = 0;
+    uint32_t size = lv_array_size(list);
+    lv_event_dsc_t ** dsc = lv_array_front(list);
+    uint32_t i;
+    for(i = 0; i < size; i++) {
+        if(dsc[i]->cb == NULL) continue;
+        lv_event_code_t filter = dsc[i]->filter & ~LV_EVENT_PREPROCESS;
+        if(filter == LV_EVENT_ALL) return UINT64_MAX;
+        mask |= lv_event_get_filter_bit(filter);
+    }
+
+    return mask;
+}
+
 void lv_event_mark_deleted(void * target)
 {
     lv_event_t * e = event_head;
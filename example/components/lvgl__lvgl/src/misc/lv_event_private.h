@@ -62,6 +62,26 @@ void lv_event_pop(lv_event_t * e);
  */
 void lv_event_mark_deleted(void * target);
 
+/**
+ * Get the bit of an event code in the filter bitmaps. The codes above 62 share the last bit.
+ * @param code      an event code, the `LV_EVENT_PREPROCESS` flag is ignored
+ * @return          the bit of the code
+ */
+static inline uint64_t lv_event_get_filter_bit(uint32_t code)
+{
+    code &= ~(uint32_t)LV_EVENT_PREPROCESS;
+    return (uint64_t)1 << (code < 63 ? code : 63);
+}
+
+/**
+ * Get the bitmap of the event codes the callbacks of an event list listen to.
+ * If the bit of an event code (`lv_event_get_filter_bit(code)`) is not set,
+ * sending the event to this list won't call any callbacks.
+ * @param list      pointer to an event list
+ * @return          the bitmap of the event codes
+ */
+uint64_t lv_event_get_filter_mask(lv_event_list_t * list);
+
 /**********************
  *      MACROS
  **********************/
@@ -55,10 +55,16 @@ static lv_fs_res_t lv_fs_seek_cached(lv_fs_file_t * file_p, uint32_t pos, lv_fs_
 void lv_fs_init(void)
 {
     lv_ll_init(fsdrv_ll_p, sizeof(lv_fs_drv_t *));
+#if LV_FS_READ_AHEAD
+    lv_fs_read_ahead_init();
+#endif
 }
 
 void lv_fs_deinit(void)
 {
+#if LV_FS_READ_AHEAD
+    lv_fs_read_ahead_deinit();
+#endif
     lv_ll_clear(fsdrv_ll_p);
 }
 
@@ -104,6 +110,9 @@ lv_fs_res_t lv_fs_open(lv_fs_file_t * file_p, const char * path, lv_fs_mode_t mo
     LV_PROFILER_BEGIN;
 
     file_p->drv = drv;
+#if LV_FS_READ_AHEAD
+    file_p->read_ahead = NULL;
+#endif
 
     /* For memory-mapped files we set the file handle to our file descriptor so that we can access the cache from the file operations */
     if(drv->cache_size == LV_FS_CACHE_FROM_BUFFER) {
@@ -118,6 +127,19 @@ lv_fs_res_t lv_fs_open(lv_fs_file_t * file_p, const char * path, lv_fs_mode_t mo
         file_p->file_d = file_d;
     }
 
+#if LV_FS_READ_AHEAD
+    /*The read-ahead windows replace the cache*/
+    if(drv->read_ahead && mode == LV_FS_MODE_RD && drv->cache_size &&
+       drv->cache_size != LV_FS_CACHE_FROM_BUFFER && drv->seek_cb && drv->tell_cb) {
+        file_p->read_ahead = lv_fs_read_ahead_create(drv, file_p->file_d, path);
+        if(file_p->read_ahead) {
+            file_p->cache = NULL;
+            LV_PROFILER_END;
+            return LV_FS_RES_OK;
+        }
+    }
+#endif
+
     if(drv->cache_size) {
         file_p->cache = lv_malloc_zeroed(sizeof(lv_fs_file_cache_t));
         LV_ASSERT_MALLOC(file_p->cache);
@@ -163,6 +185,13 @@ lv_fs_res_t lv_fs_close(lv_fs_file_t * file_p)
 
     LV_PROFILER_BEGIN;
 
+#if LV_FS_READ_AHEAD
+    if(file_p->read_ahead) {
+        lv_fs_read_ahead_delete(file_p->read_ahead);
+        file_p->read_ahead = NULL;
+    }
+#endif
+
     lv_fs_res_t res = file_p->drv->close_cb(file_p->drv, file_p->file_d);
 
     if(file_p->drv->cache_size && file_p->cache) {
@@ -290,7 +319,11 @@ lv_fs_res_t lv_fs_tell(lv_fs_file_t * file_p, uint32_t * pos)
 
     lv_fs_res_t res;
     if(file_p->drv->cache_size) {
+#if LV_FS_READ_AHEAD
+        *pos = file_p->read_ahead ? file_p->read_ahead->pos : file_p->cache->file_position;
+#else
         *pos = file_p->cache->file_position;
+#endif
         res = LV_FS_RES_OK;
     }
     else {
@@ -302,6 +335,66 @@ lv_fs_res_t lv_fs_tell(lv_fs_file_t * file_p, uint32_t * pos)
     return res;
 }
 
+const void * lv_fs_get_buffer(lv_fs_file_t * file_p, uint32_t * size)
+{
+    *size = 0;
+    if(file_p->drv == NULL) return NULL;
+
+    /*The end of the cache is the size of the buffer for memory-mapped files*/
+    if(file_p->drv->cache_size == LV_FS_CACHE_FROM_BUFFER) {
+        *size = file_p->cache->end;
+        return file_p->cache->buffer;
+    }
+
+    if(file_p->drv->get_buffer_cb == NULL) return NULL;
+
+    return file_p->drv->get_buffer_cb(file_p->drv, file_p->file_d, size);
+}
+
+lv_fs_res_t lv_fs_prefetch(const char * path, uint32_t offset, uint32_t len)
+{
+#if LV_FS_READ_AHEAD
+    if(path == NULL) return LV_FS_RES_INV_PARAM;
+
+    resolved_path_t resolved_path = lv_fs_resolve_path(path);
+
+    lv_fs_drv_t * drv = lv_fs_get_drv(resolved_path.drive_letter);
+    if(drv == NULL) return LV_FS_RES_NOT_EX;
+
+    if(!drv->read_ahead || drv->cache_size == 0 || drv->cache_size == LV_FS_CACHE_FROM_BUFFER ||
+       drv->open_cb == NULL || drv->read_cb == NULL || drv->seek_cb == NULL || drv->close_cb == NULL) {
+        return LV_FS_RES_NOT_IMP;
+    }
+
+    if(len == 0) len = drv->cache_size;
+
+    return lv_fs_read_ahead_prefetch(drv, path, resolved_path.real_path, offset, len);
+#else
+    LV_UNUSED(path);
+    LV_UNUSED(offset);
+    LV_UNUSED(len);
+    return LV_FS_RES_NOT_IMP;
+#endif
+}
+
+lv_fs_res_t lv_fs_stat(const char * path, lv_fs_stat_t * stat)
+{
+    if(path == NULL || stat == NULL) return LV_FS_RES_INV_PARAM;
+
+    resolved_path_t resolved_path = lv_fs_resolve_path(path);
+
+    lv_fs_drv_t * drv = lv_fs_get_drv(resolved_path.drive_letter);
+    if(drv == NULL) return LV_FS_RES_NOT_EX;
+
+    if(drv->ready_cb) {
+        if(drv->ready_cb(drv) == false) return LV_FS_RES_HW_ERR;
+    }
+
+    if(drv->stat_cb == NULL) return LV_FS_RES_NOT_IMP;
+
+    return drv->stat_cb(drv, resolved_path.real_path, stat);
+}
+
 lv_fs_res_t lv_fs_dir_open(lv_fs_dir_t * rddir_p, const char * path)
 {
     if(path == NULL) return LV_FS_RES_INV_PARAM;
@@ -537,6 +630,10 @@ static resolved_path_t lv_fs_resolve_path(const char * path)
 
 static lv_fs_res_t lv_fs_read_cached(lv_fs_file_t * file_p, void * buf, uint32_t btr, uint32_t * br)
 {
+#if LV_FS_READ_AHEAD
+    if(file_p->read_ahead) return lv_fs_read_ahead_read(file_p->read_ahead, buf, btr, br);
+#endif
+
     lv_fs_res_t res = LV_FS_RES_OK;
     uint32_t file_position = file_p->cache->file_position;
     uint32_t start = file_p->cache->start;
@@ -622,6 +719,11 @@ static lv_fs_res_t lv_fs_read_cached(lv_fs_file_t * file_p, void * buf, uint32_t
 
 static lv_fs_res_t lv_fs_write_cached(lv_fs_file_t * file_p, const void * buf, uint32_t btw, uint32_t * bw)
 {
+#if LV_FS_READ_AHEAD
+    /*Only the files opened for reading are read ahead*/
+    if(file_p->read_ahead) return LV_FS_RES_DENIED;
+#endif
+
     lv_fs_res_t res = LV_FS_RES_OK;
 
     /*Need to do FS seek before writing data to FS*/
@@ -666,6 +768,10 @@ static lv_fs_res_t lv_fs_write_cached(lv_fs_file_t * file_p, const void * buf, u
 
 static lv_fs_res_t lv_fs_seek_cached(lv_fs_file_t * file_p, uint32_t pos, lv_fs_whence_t whence)
 {
+#if LV_FS_READ_AHEAD
+    if(file_p->read_ahead) return lv_fs_read_ahead_seek(file_p->read_ahead, pos, whence);
+#endif
+
     lv_fs_res_t res = LV_FS_RES_OK;
     switch(whence) {
         case LV_FS_SEEK_SET: {
@@ -64,11 +64,21 @@ typedef enum {
     LV_FS_SEEK_END = 0x02,      /**< Set the position from the end of the file*/
 } lv_fs_whence_t;
 
+/**
+ * Information about a file
+ */
+typedef struct {
+    uint32_t size;      /**< Size of the file in bytes*/
+    uint32_t mtime;     /**< Time of the last modification in a driver specific unit. Only compared for equality.*/
+} lv_fs_stat_t;
+
 struct lv_fs_drv_t;
 typedef struct lv_fs_drv_t lv_fs_drv_t;
 struct lv_fs_drv_t {
     char letter;
     uint32_t cache_size;
+    bool read_ahead;    /**< With `LV_FS_READ_AHEAD` and `cache_size` read the next part of the files in a background
+                         *   thread. The callbacks will be called from that thread too but never for the same file at once.*/
     bool (*ready_cb)(lv_fs_drv_t * drv);
 
     void * (*open_cb)(lv_fs_drv_t * drv, const char * path, lv_fs_mode_t mode);
@@ -77,6 +87,8 @@ struct lv_fs_drv_t {
     lv_fs_res_t (*write_cb)(lv_fs_drv_t * drv, void * file_p, const void * buf, uint32_t btw, uint32_t * bw);
     lv_fs_res_t (*seek_cb)(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence);
     lv_fs_res_t (*tell_cb)(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
+    const void * (*get_buffer_cb)(lv_fs_drv_t * drv, void * file_p, uint32_t * size); /**< Optional, see `lv_fs_get_buffer()`*/
+    lv_fs_res_t (*stat_cb)(lv_fs_drv_t * drv, const char * path, lv_fs_stat_t * stat); /**< Optional, see `lv_fs_stat()`*/
 
     void * (*dir_open_cb)(lv_fs_drv_t * drv, const char * path);
     lv_fs_res_t (*dir_read_cb)(lv_fs_drv_t * drv, void * rddir_p, char * fn, uint32_t fn_len);
@@ -89,6 +101,9 @@ typedef struct {
     void * file_d;
     lv_fs_drv_t * drv;
     lv_fs_file_cache_t * cache;
+#if LV_FS_READ_AHEAD
+    lv_fs_read_ahead_t * read_ahead;
+#endif
 } lv_fs_file_t;
 
 
@@ -194,6 +209,38 @@ lv_fs_res_t lv_fs_seek(lv_fs_file_t * file_p, uint32_t pos, lv_fs_whence_t whenc
  */
 lv_fs_res_t lv_fs_tell(lv_fs_file_t * file_p, uint32_t * pos);
 
+/**
+ * Get the whole content of a file in memory without reading it, if the driver can provide it.
+ * It works with the files opened from a buffer (see `lv_fs_make_path_from_buffer()`)
+ * and with the drivers mapping the files to the memory (e.g. `LV_FS_POSIX_MMAP`).
+ * The data is borrowed from the file: it's read-only and valid until the file is closed.
+ * @param file_p    pointer to a lv_fs_file_t variable
+ * @param size      pointer to store the size of the file in bytes
+ * @return          pointer to the content of the file or NULL if it's not available in memory
+ */
+const void * lv_fs_get_buffer(lv_fs_file_t * file_p, uint32_t * size);
+
+/**
+ * Start reading a part of a file in the background before it's opened, e.g. the next image of an animation.
+ * When the file is opened the reads of this part will be served from memory.
+ * Needs `LV_FS_READ_AHEAD` and a driver with `read_ahead` enabled.
+ * Only a few parts are kept, the oldest ones are dropped.
+ * @param path      path to the file beginning with the driver letter (e.g. S:/folder/file.txt)
+ * @param offset    position of the part in the file
+ * @param len       length of the part in bytes. 0: the `cache_size` of the driver
+ * @return          LV_FS_RES_OK: the read is scheduled, or any error from `lv_fs_res_t` enum
+ */
+lv_fs_res_t lv_fs_prefetch(const char * path, uint32_t offset, uint32_t len);
+
+/**
+ * Get the size and modification time of a file without opening it, if the driver supports it.
+ * @param path      path to the file beginning with the driver letter (e.g. S:/folder/file.txt)
+ * @param stat      pointer to store the information
+ * @return          LV_FS_RES_OK or any error from `lv_fs_res_t` enum.
+ *                  LV_FS_RES_NOT_IMP if the driver has no `stat_cb`.
+ */
+lv_fs_res_t lv_fs_stat(const char * path, lv_fs_stat_t * stat);
+
 /**
  * Initialize a 'fs_dir_t' variable for directory reading
  * @param rddir_p   pointer to a 'lv_fs_dir_t' variable
@@ -15,6 +15,8 @@ extern "C" {
  *********************/
 
 #include "lv_fs.h"
+#include "lv_ll.h"
+#include "../osal/lv_os.h"
 
 /*********************
  *      DEFINES
@@ -31,6 +33,52 @@ struct lv_fs_file_cache_t {
     void * buffer;
 };
 
+#if LV_FS_READ_AHEAD
+
+/** A part of a file in memory*/
+typedef struct {
+    uint8_t * buf;
+    uint32_t buf_size;      /**< Allocated size of `buf`*/
+    uint32_t start;         /**< Position of the first byte of `buf` in the file*/
+    uint32_t len;           /**< Number of valid bytes in `buf`*/
+} lv_fs_read_ahead_window_t;
+
+struct lv_fs_read_ahead_t {
+    lv_fs_drv_t * drv;
+    void * file_d;
+    lv_mutex_t io_lock;                     /**< Held while the driver reads the file*/
+    lv_fs_read_ahead_window_t windows[2];   /**< Reads are served from `windows[act]`, the other one is prefetched*/
+    uint32_t act;
+    uint32_t pos;                           /**< Position of the next read*/
+    uint32_t window_size;                   /**< Size of the next window. Grows while reading sequentially.*/
+    uint32_t job_size;                      /**< Number of bytes to prefetch*/
+    bool job_pending;                       /**< The other window is queued to be prefetched*/
+    bool job_done;                          /**< Set by the thread when the prefetch is ready. Protected by `io_lock`*/
+};
+
+/** A part of a file read before the file is opened*/
+typedef struct {
+    char * path;
+    lv_fs_drv_t * drv;
+    const char * real_path;     /**< Path without the driver letter, points into `path`*/
+    lv_fs_read_ahead_window_t window;
+    uint32_t req_len;
+    bool running;               /**< The thread is reading it*/
+    bool ready;
+} lv_fs_prefetch_t;
+
+typedef struct {
+    lv_thread_t thread;
+    lv_thread_sync_t sync;
+    lv_mutex_t lock;            /**< Protects the lists and the prefetched parts*/
+    lv_ll_t jobs;               /**< `lv_fs_read_ahead_job_t`s in the order of arrival*/
+    lv_ll_t prefetches;         /**< `lv_fs_prefetch_t *`s, the oldest first*/
+    bool thread_running;
+    bool exit;
+} lv_fs_read_ahead_state_t;
+
+#endif /*LV_FS_READ_AHEAD*/
+
 /** Extended path object to specify buffer for memory-mapped files */
 struct lv_fs_path_ex_t {
     char path[4];   /**<  This is needed to make it compatible with a normal path */
@@ -52,6 +100,52 @@ void lv_fs_init(void);
  */
 void lv_fs_deinit(void);
 
+#if LV_FS_READ_AHEAD
+
+/**
+ * Initialize the read-ahead state. The thread is started only when it's needed first.
+ */
+void lv_fs_read_ahead_init(void);
+
+/**
+ * Stop the read-ahead thread and free the prefetched parts
+ */
+void lv_fs_read_ahead_deinit(void);
+
+/**
+ * Create the read-ahead state of a file opened for reading.
+ * A matching part loaded by `lv_fs_prefetch()` is taken over.
+ * @param drv       the driver of the file
+ * @param file_d    the file descriptor returned by the driver
+ * @param path      the path the file was opened with
+ * @return          the read-ahead state or NULL on out of memory
+ */
+lv_fs_read_ahead_t * lv_fs_read_ahead_create(lv_fs_drv_t * drv, void * file_d, const char * path);
+
+/**
+ * Wait for the pending read of the file and free the read-ahead state. The file is not closed.
+ * @param ra        pointer to a read-ahead state
+ */
+void lv_fs_read_ahead_delete(lv_fs_read_ahead_t * ra);
+
+lv_fs_res_t lv_fs_read_ahead_read(lv_fs_read_ahead_t * ra, void * buf, uint32_t btr, uint32_t * br);
+
+lv_fs_res_t lv_fs_read_ahead_seek(lv_fs_read_ahead_t * ra, uint32_t pos, lv_fs_whence_t whence);
+
+/**
+ * Queue the reading of a part of a file before it's opened
+ * @param drv       the driver of the file
+ * @param path      the full path of the file
+ * @param real_path the path without the driver letter, pointing into `path`
+ * @param offset    position of the part in the file
+ * @param len       length of the part in bytes
+ * @return          LV_FS_RES_OK or any error from `lv_fs_res_t` enum
+ */
+lv_fs_res_t lv_fs_read_ahead_prefetch(lv_fs_drv_t * drv, const char * path, const char * real_path, uint32_t offset,
+                                      uint32_t len);
+
+#endif /*LV_FS_READ_AHEAD*/
+
 /**********************
  *      MACROS
  **********************/
@@ -0,0 +1,482 @@
+/**
+ * @file lv_fs_read_ahead.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_fs_private.h"
+#if LV_FS_READ_AHEAD
+
+#include "lv_assert.h"
+#include "lv_profiler.h"
+#include "../stdlib/lv_mem.h"
+#include "../stdlib/lv_string.h"
+#include "../core/lv_global.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define state_p (&LV_GLOBAL_DEFAULT()->fs_read_ahead)
+
+/*The windows grow up to this many times the cache size of the driver while reading sequentially*/
+#define WINDOW_SIZE_MAX_FACTOR  8
+
+/*Number of parts loaded by `lv_fs_prefetch()` kept at once*/
+#define PREFETCH_CNT_MAX        4
+
+#define THREAD_STACK_SIZE       (16 * 1024)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    lv_fs_read_ahead_t * ra;        /**< Prefetch the other window of an open file, or*/
+    lv_fs_prefetch_t * prefetch;    /**< read a part of a file which is not opened yet*/
+} lv_fs_read_ahead_job_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void thread_cb(void * user_data);
+static void job_add(lv_fs_read_ahead_t * ra, lv_fs_prefetch_t * prefetch);
+static void job_remove(lv_fs_read_ahead_t * ra, lv_fs_prefetch_t * prefetch);
+static void job_queue(lv_fs_read_ahead_t * ra);
+static void job_wait(lv_fs_read_ahead_t * ra);
+static bool window_reserve(lv_fs_read_ahead_window_t * window, uint32_t size);
+static lv_fs_res_t window_fill(lv_fs_read_ahead_t * ra, lv_fs_read_ahead_window_t * window, uint32_t pos);
+static bool window_has(const lv_fs_read_ahead_window_t * window, uint32_t pos);
+static void prefetch_read(lv_fs_prefetch_t * prefetch);
+static void prefetch_free(lv_fs_prefetch_t * prefetch);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_fs_read_ahead_init(void)
+{
+    lv_fs_read_ahead_state_t * state = state_p;
+    lv_memzero(state, sizeof(lv_fs_read_ahead_state_t));
+    lv_mutex_init(&state->lock);
+    lv_thread_sync_init(&state->sync);
+    lv_ll_init(&state->jobs, sizeof(lv_fs_read_ahead_job_t));
+    lv_ll_init(&state->prefetches, sizeof(lv_fs_prefetch_t *));
+}
+
+void lv_fs_read_ahead_deinit(void)
+{
+    lv_fs_read_ahead_state_t * state = state_p;
+
+    if(state->thread_running) {
+        lv_mutex_lock(&state->lock);
+        state->exit = true;
+        lv_mutex_unlock(&state->lock);
+        lv_thread_sync_signal(&state->sync);
+        lv_thread_delete(&state->thread);
+        state->thread_running = false;
+    }
+
+    lv_fs_prefetch_t ** prefetch_p;
+    LV_LL_READ(&state->prefetches, prefetch_p) {
+        prefetch_free(*prefetch_p);
+    }
+    lv_ll_clear(&state->prefetches);
+    lv_ll_clear(&state->jobs);
+
+    lv_thread_sync_delete(&state->sync);
+    lv_mutex_delete(&state->lock);
+}
+
+lv_fs_read_ahead_t * lv_fs_read_ahead_create(lv_fs_drv_t * drv, void * file_d, const char * path)
+{
+    lv_fs_read_ahead_t * ra = lv_malloc_zeroed(sizeof(lv_fs_read_ahead_t));
+    LV_ASSERT_MALLOC(ra);
+    if(ra == NULL) return NULL;
+
+    ra->drv = drv;
+    ra->file_d = file_d;
+    ra->window_size = drv->cache_size;
+    lv_mutex_init(&ra->io_lock);
+
+    /*Take over the part loaded by `lv_fs_prefetch()`. It's put to the other window
+     *as the first read might be before it*/
+    lv_fs_read_ahead_state_t * state = state_p;
+    lv_mutex_lock(&state->lock);
+    lv_fs_prefetch_t ** prefetch_p;
+    LV_LL_READ(&state->prefetches, prefetch_p) {
+        lv_fs_prefetch_t * prefetch = *prefetch_p;
+        if(prefetch->ready && prefetch->window.len > 0 && lv_strcmp(prefetch->path, path) == 0) {
+            ra->windows[1] = prefetch->window;
+            prefetch->window.buf = NULL;
+            lv_ll_remove(&state->prefetches, prefetch_p);
+            lv_free(prefetch_p);
+            prefetch_free(prefetch);
+            break;
+        }
+    }
+    lv_mutex_unlock(&state->lock);
+
+    return ra;
+}
+
+void lv_fs_read_ahead_delete(lv_fs_read_ahead_t * ra)
+{
+    job_wait(ra);
+    lv_mutex_delete(&ra->io_lock);
+    lv_free(ra->windows[0].buf);
+    lv_free(ra->windows[1].buf);
+    lv_free(ra);
+}
+
+lv_fs_res_t lv_fs_read_ahead_read(lv_fs_read_ahead_t * ra, void * buf, uint32_t btr, uint32_t * br)
+{
+    lv_fs_res_t res = LV_FS_RES_OK;
+    uint8_t * buf_u8 = buf;
+    *br = 0;
+
+    while(btr > 0) {
+        lv_fs_read_ahead_window_t * act = &ra->windows[ra->act];
+        if(window_has(act, ra->pos)) {
+            uint32_t n = LV_MIN(btr, act->start + act->len - ra->pos);
+            lv_memcpy(buf_u8, act->buf + (ra->pos - act->start), n);
+            buf_u8 += n;
+            btr -= n;
+            *br += n;
+            ra->pos += n;
+            continue;
+        }
+
+        /*Reading on right after the window means sequential access*/
+        bool sequential = act->len > 0 && ra->pos == act->start + act->len;
+
+        job_wait(ra);
+        lv_fs_read_ahead_window_t * other = &ra->windows[ra->act ^ 1];
+        if(window_has(other, ra->pos)) {
+            ra->act ^= 1;
+            act = other;
+        }
+        else {
+            res = window_fill(ra, act, ra->pos);
+            if(res != LV_FS_RES_OK) break;
+            if(act->len == 0) break;    /*End of the file*/
+        }
+
+        /*Read larger and larger parts in the background while the file is read sequentially.
+         *Random access reads only what's needed to not waste bandwidth.*/
+        if(sequential) {
+            ra->window_size = LV_MIN(ra->window_size * 2, ra->drv->cache_size * WINDOW_SIZE_MAX_FACTOR);
+            job_queue(ra);
+        }
+        else {
+            ra->window_size = ra->drv->cache_size;
+        }
+    }
+
+    return res;
+}
+
+lv_fs_res_t lv_fs_read_ahead_seek(lv_fs_read_ahead_t * ra, uint32_t pos, lv_fs_whence_t whence)
+{
+    switch(whence) {
+        case LV_FS_SEEK_SET:
+            ra->pos = pos;
+            return LV_FS_RES_OK;
+        case LV_FS_SEEK_CUR:
+            ra->pos += pos;
+            return LV_FS_RES_OK;
+        case LV_FS_SEEK_END: {
+                /*The driver knows the size of the file*/
+                job_wait(ra);
+                lv_mutex_lock(&ra->io_lock);
+                lv_fs_res_t res = ra->drv->seek_cb(ra->drv, ra->file_d, pos, LV_FS_SEEK_END);
+                if(res == LV_FS_RES_OK) res = ra->drv->tell_cb(ra->drv, ra->file_d, &ra->pos);
+                lv_mutex_unlock(&ra->io_lock);
+                return res;
+            }
+        default:
+            return LV_FS_RES_INV_PARAM;
+    }
+}
+
+lv_fs_res_t lv_fs_read_ahead_prefetch(lv_fs_drv_t * drv, const char * path, const char * real_path, uint32_t offset,
+                                      uint32_t len)
+{
+    lv_fs_read_ahead_state_t * state = state_p;
+    lv_mutex_lock(&state->lock);
+
+    /*Already requested*/
+    lv_fs_prefetch_t ** prefetch_p;
+    LV_LL_READ(&state->prefetches, prefetch_p) {
+        lv_fs_prefetch_t * prefetch = *prefetch_p;
+        if(prefetch->window.start == offset && prefetch->req_len >= len && lv_strcmp(prefetch->path, path) == 0) {
+            lv_mutex_unlock(&state->lock);
+            return LV_FS_RES_OK;
+        }
+    }
+
+    /*Drop the oldest part which is not being read now*/
+    if(lv_ll_get_len(&state->prefetches) >= PREFETCH_CNT_MAX) {
+        LV_LL_READ(&state->prefetches, prefetch_p) {
+            if(!(*prefetch_p)->running) break;
+        }
+
+        if(prefetch_p == NULL) {
+            lv_mutex_unlock(&state->lock);
+            return LV_FS_RES_BUSY;
+        }
+
+        lv_fs_prefetch_t * old = *prefetch_p;
+        if(!old->ready) job_remove(NULL, old);
+        lv_ll_remove(&state->prefetches, prefetch_p);
+        lv_free(prefetch_p);
+        prefetch_free(old);
+    }
+
+    lv_fs_prefetch_t * prefetch = lv_malloc_zeroed(sizeof(lv_fs_prefetch_t));
+    LV_ASSERT_MALLOC(prefetch);
+    if(prefetch == NULL) {
+        lv_mutex_unlock(&state->lock);
+        return LV_FS_RES_OUT_OF_MEM;
+    }
+
+    prefetch->path = lv_strdup(path);
+    LV_ASSERT_MALLOC(prefetch->path);
+    if(prefetch->path == NULL || !window_reserve(&prefetch->window, len)) {
+        prefetch_free(prefetch);
+        lv_mutex_unlock(&state->lock);
+        return LV_FS_RES_OUT_OF_MEM;
+    }
+
+    prefetch->drv = drv;
+    prefetch->real_path = prefetch->path + (real_path - path);
+    prefetch->window.start = offset;
+    prefetch->req_len = len;
+
+    prefetch_p = lv_ll_ins_tail(&state->prefetches);
+    LV_ASSERT_MALLOC(prefetch_p);
+    if(prefetch_p == NULL) {
+        prefetch_free(prefetch);
+        lv_mutex_unlock(&state->lock);
+        return LV_FS_RES_OUT_OF_MEM;
+    }
+    *prefetch_p = prefetch;
+
+    job_add(NULL, prefetch);
+    lv_mutex_unlock(&state->lock);
+    lv_thread_sync_signal(&state->sync);
+
+    return LV_FS_RES_OK;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void thread_cb(void * user_data)
+{
+    LV_UNUSED(user_data);
+    lv_fs_read_ahead_state_t * state = state_p;
+
+    while(1) {
+        lv_mutex_lock(&state->lock);
+        if(state->exit) {
+            lv_mutex_unlock(&state->lock);
+            break;
+        }
+
+        lv_fs_read_ahead_job_t * job = lv_ll_get_head(&state->jobs);
+        if(job == NULL) {
+            lv_mutex_unlock(&state->lock);
+            lv_thread_sync_wait(&state->sync);
+            continue;
+        }
+
+        lv_fs_read_ahead_t * ra = job->ra;
+        lv_fs_prefetch_t * prefetch = job->prefetch;
+        lv_ll_remove(&state->jobs, job);
+        lv_free(job);
+
+        /*Take the file before releasing the lock so `job_wait()` can't miss it*/
+        if(ra) lv_mutex_lock(&ra->io_lock);
+        else prefetch->running = true;
+        lv_mutex_unlock(&state->lock);
+
+        if(ra) {
+            lv_fs_read_ahead_window_t * window = &ra->windows[ra->act ^ 1];
+            uint32_t pos = window->start;
+            lv_fs_res_t res = ra->drv->seek_cb(ra->drv, ra->file_d, pos, LV_FS_SEEK_SET);
+            if(res == LV_FS_RES_OK) res = ra->drv->read_cb(ra->drv, ra->file_d, window->buf, ra->job_size, &window->len);
+            if(res != LV_FS_RES_OK) window->len = 0;
+            ra->job_done = true;
+            lv_mutex_unlock(&ra->io_lock);
+        }
+        else {
+            prefetch_read(prefetch);
+            lv_mutex_lock(&state->lock);
+            prefetch->running = false;
+            prefetch->ready = true;
+            lv_mutex_unlock(&state->lock);
+        }
+    }
+}
+
+/**
+ * Add a job to the queue and start the thread if it's not running yet. `state->lock` needs to be held.
+ */
+static void job_add(lv_fs_read_ahead_t * ra, lv_fs_prefetch_t * prefetch)
+{
+    lv_fs_read_ahead_state_t * state = state_p;
+
+    lv_fs_read_ahead_job_t * job = lv_ll_ins_tail(&state->jobs);
+    LV_ASSERT_MALLOC(job);
+    if(job == NULL) return;
+    job->ra = ra;
+    job->prefetch = prefetch;
+
+    if(!state->thread_running) {
+        lv_result_t res = lv_thread_init(&state->thread, LV_THREAD_PRIO_MID, thread_cb, THREAD_STACK_SIZE, NULL);
+        if(res == LV_RESULT_OK) state->thread_running = true;
+        else LV_LOG_ERROR("Couldn't create the read-ahead thread");
+    }
+}
+
+/**
+ * Remove a job from the queue if the thread hasn't taken it yet. `state->lock` needs to be held.
+ */
+static void job_remove(lv_fs_read_ahead_t * ra, lv_fs_prefetch_t * prefetch)
+{
+    lv_fs_read_ahead_state_t * state = state_p;
+    lv_fs_read_ahead_job_t * job;
+    LV_LL_READ(&state->jobs, job) {
+        if(job->ra == ra && job->prefetch == prefetch) {
+            lv_ll_remove(&state->jobs, job);
+            lv_free(job);
+            return;
+        }
+    }
+}
+
+/**
+ * Prefetch the part after the active window into the other window
+ */
+static void job_queue(lv_fs_read_ahead_t * ra)
+{
+    lv_fs_read_ahead_window_t * act = &ra->windows[ra->act];
+    lv_fs_read_ahead_window_t * other = &ra->windows[ra->act ^ 1];
+
+    /*The active window was filled with at least half of the current size unless the file ended*/
+    if(act->len < ra->window_size / 2) return;
+
+    if(!window_reserve(other, ra->window_size)) return;
+    other->start = act->start + act->len;
+    other->len = 0;
+    ra->job_size = ra->window_size;
+    ra->job_done = false;
+    ra->job_pending = true;
+
+    lv_fs_read_ahead_state_t * state = state_p;
+    lv_mutex_lock(&state->lock);
+    job_add(ra, NULL);
+    lv_mutex_unlock(&state->lock);
+    lv_thread_sync_signal(&state->sync);
+}
+
+/**
+ * Cancel the prefetch of the file if it hasn't started yet or wait until it's finished
+ */
+static void job_wait(lv_fs_read_ahead_t * ra)
+{
+    if(!ra->job_pending) return;
+
+    lv_fs_read_ahead_state_t * state = state_p;
+    lv_mutex_lock(&state->lock);
+    job_remove(ra, NULL);
+    lv_mutex_unlock(&state->lock);
+
+    /*If the thread has taken the job it holds the file until the read is finished*/
+    lv_mutex_lock(&ra->io_lock);
+    if(!ra->job_done) ra->windows[ra->act ^ 1].len = 0;
+    lv_mutex_unlock(&ra->io_lock);
+
+    ra->job_pending = false;
+}
+
+static bool window_reserve(lv_fs_read_ahead_window_t * window, uint32_t size)
+{
+    if(window->buf_size >= size) return true;
+
+    /*The old content is not needed*/
+    lv_free(window->buf);
+    window->len = 0;
+    window->buf_size = 0;
+    window->buf = lv_malloc(size);
+    LV_ASSERT_MALLOC(window->buf);
+    if(window->buf == NULL) return false;
+
+    window->buf_size = size;
+    return true;
+}
+
+static lv_fs_res_t window_fill(lv_fs_read_ahead_t * ra, lv_fs_read_ahead_window_t * window, uint32_t pos)
+{
+    LV_PROFILER_BEGIN;
+
+    if(!window_reserve(window, ra->window_size)) {
+        LV_PROFILER_END;
+        return LV_FS_RES_OUT_OF_MEM;
+    }
+
+    window->start = pos;
+    window->len = 0;
+
+    lv_mutex_lock(&ra->io_lock);
+    lv_fs_res_t res = ra->drv->seek_cb(ra->drv, ra->file_d, pos, LV_FS_SEEK_SET);
+    if(res == LV_FS_RES_OK) res = ra->drv->read_cb(ra->drv, ra->file_d, window->buf, ra->window_size, &window->len);
+    lv_mutex_unlock(&ra->io_lock);
+
+    if(res != LV_FS_RES_OK) window->len = 0;
+
+    LV_PROFILER_END;
+    return res;
+}
+
+static bool window_has(const lv_fs_read_ahead_window_t * window, uint32_t pos)
+{
+    return window->len > 0 && pos >= window->start && pos - window->start < window->len;
+}
+
+static void prefetch_read(lv_fs_prefetch_t * prefetch)
+{
+    lv_fs_drv_t * drv = prefetch->drv;
+    lv_fs_read_ahead_window_t * window = &prefetch->window;
+    window->len = 0;
+
+    if(drv->ready_cb && !drv->ready_cb(drv)) return;
+
+    void * file_d = drv->open_cb(drv, prefetch->real_path, LV_FS_MODE_RD);
+    if(file_d == NULL || file_d == (void *)(-1)) return;
+
+    lv_fs_res_t res = drv->seek_cb(drv, file_d, window->start, LV_FS_SEEK_SET);
+    if(res == LV_FS_RES_OK) res = drv->read_cb(drv, file_d, window->buf, prefetch->req_len, &window->len);
+    if(res != LV_FS_RES_OK) window->len = 0;
+
+    drv->close_cb(drv, file_d);
+}
+
+static void prefetch_free(lv_fs_prefetch_t * prefetch)
+{
+    lv_free(prefetch->path);
+    lv_free(prefetch->window.buf);
+    lv_free(prefetch);
+}
+
+#endif /*LV_FS_READ_AHEAD*/
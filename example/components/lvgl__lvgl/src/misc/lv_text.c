@@ -28,6 +28,8 @@
  *  STATIC PROTOTYPES
  **********************/
 
+static void normalize_layout_params(int32_t * max_width, lv_text_flag_t * flag);
+
 #if LV_TXT_ENC == LV_TXT_ENC_UTF8
     static uint8_t lv_text_utf8_size(const char * str);
     static uint32_t lv_text_unicode_to_utf8(uint32_t letter_uni);
@@ -136,6 +138,96 @@ void lv_text_get_size(lv_point_t * size_res, const char * text, const lv_font_t
         size_res->y -= line_space;
 }
 
+void lv_text_layout_init(lv_text_layout_t * layout)
+{
+    lv_memzero(layout, sizeof(lv_text_layout_t));
+}
+
+void lv_text_layout_deinit(lv_text_layout_t * layout)
+{
+    lv_array_deinit(&layout->lines);
+    layout->valid = 0;
+}
+
+void lv_text_layout_invalidate(lv_text_layout_t * layout)
+{
+    layout->valid = 0;
+}
+
+bool lv_text_layout_is_valid(const lv_text_layout_t * layout, const char * text, const lv_font_t * font,
+                             int32_t letter_space, int32_t max_width, lv_text_flag_t flag)
+{
+    if(!layout->valid) return false;
+
+    normalize_layout_params(&max_width, &flag);
+    return layout->text == text && layout->font == font && layout->letter_space == letter_space &&
+           layout->max_width == max_width && layout->flag == flag;
+}
+
+bool lv_text_layout_update(lv_text_layout_t * layout, const char * text, const lv_font_t * font,
+                           int32_t letter_space, int32_t max_width, lv_text_flag_t flag)
+{
+    if(lv_text_layout_is_valid(layout, text, font, letter_space, max_width, flag)) return true;
+
+    layout->valid = 0;
+    if(text == NULL || font == NULL) return false;
+
+    normalize_layout_params(&max_width, &flag);
+    layout->text = text;
+    layout->font = font;
+    layout->letter_space = letter_space;
+    layout->max_width = max_width;
+    layout->flag = flag;
+    layout->max_line_width = 0;
+
+    if(layout->lines.data == NULL) {
+        lv_array_init(&layout->lines, 4, sizeof(lv_text_line_t));
+        if(layout->lines.data == NULL) return false;
+    }
+    lv_array_clear(&layout->lines);
+
+    lv_text_line_t line;
+    line.start = 0;
+    while(text[line.start] != '\0') {
+        uint32_t line_end = line.start + lv_text_get_next_line(&text[line.start], font, letter_space, max_width, NULL, flag);
+        line.width = lv_text_get_width(&text[line.start], line_end - line.start, font, letter_space);
+        layout->max_line_width = LV_MAX(layout->max_line_width, line.width);
+        lv_array_push_back(&layout->lines, &line);
+        line.start = line_end;
+    }
+
+    /*Close the last line with the end of the text*/
+    line.width = 0;
+    lv_array_push_back(&layout->lines, &line);
+
+    layout->valid = 1;
+    return true;
+}
+
+void lv_text_layout_get_size(const lv_text_layout_t * layout, int32_t line_space, lv_point_t * size_res)
+{
+    const char * text = layout->text;
+    uint32_t line_cnt = lv_text_layout_get_line_count(layout);
+    uint32_t text_len = lv_text_layout_get_line(layout, line_cnt)->start;
+    int32_t letter_height = lv_font_get_line_height(layout->font);
+
+    /*Make the text one line taller if the last character is '\n' or '\r'*/
+    if(text_len != 0 && (text[text_len - 1] == '\n' || text[text_len - 1] == '\r')) line_cnt++;
+
+    size_res->x = layout->max_line_width;
+
+    int64_t h = (int64_t)line_cnt * (letter_height + line_space);
+    if(h > (int64_t)LV_MAX_OF(int32_t)) {
+        LV_LOG_WARN("integer overflow while calculating text height");
+        size_res->y = 0;
+        return;
+    }
+
+    /*Correction with the last line space or set the height manually if the text is empty*/
+    if(h == 0) size_res->y = letter_height;
+    else size_res->y = (int32_t)h - line_space;
+}
+
 /**
  * Get the next word of text. A word is delimited by break characters.
  *
@@ -454,6 +546,23 @@ void lv_text_encoded_letter_next_2(const char * txt, uint32_t * letter, uint32_t
     *letter_next = *letter != '\0' ? lv_text_encoded_next(&txt[*ofs], NULL) : 0;
 }
 
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Use the same layout parameters for all the texts which are broken only at new line characters
+ * @param max_width     pointer to the max. width of the lines
+ * @param flag          pointer to the flags of the text
+ */
+static void normalize_layout_params(int32_t * max_width, lv_text_flag_t * flag)
+{
+    if(*flag & (LV_TEXT_FLAG_EXPAND | LV_TEXT_FLAG_FIT)) {
+        *max_width = LV_COORD_MAX;
+        *flag = LV_TEXT_FLAG_EXPAND;
+    }
+}
+
 #if LV_TXT_ENC == LV_TXT_ENC_UTF8
 /*******************************
  *   UTF-8 ENCODER/DECODER
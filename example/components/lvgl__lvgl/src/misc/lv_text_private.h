@@ -15,6 +15,7 @@ extern "C" {
  *********************/
 
 #include "lv_text.h"
+#include "lv_array.h"
 
 /*********************
  *      DEFINES
@@ -24,6 +25,24 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+typedef struct {
+    uint32_t start;         /**< Byte index of the first character of the line*/
+    int32_t width;          /**< Width of the line in pixels*/
+} lv_text_line_t;
+
+/** The line breaks and the line widths of a text.
+ * They are valid only for the same text, font, letter space, max. width and flags.*/
+struct lv_text_layout_t {
+    const char * text;
+    const lv_font_t * font;
+    int32_t letter_space;
+    int32_t max_width;
+    lv_text_flag_t flag;
+    int32_t max_line_width;     /**< Width of the longest line*/
+    lv_array_t lines;           /**< `lv_text_line_t` elements and a closing one with the length of the text*/
+    uint8_t valid : 1;
+};
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -44,6 +63,79 @@ extern "C" {
 uint32_t lv_text_get_next_line(const char * txt, const lv_font_t * font, int32_t letter_space,
                                int32_t max_width, int32_t * used_width, lv_text_flag_t flag);
 
+/**
+ * Initialize a text layout. It will be calculated on the first `lv_text_layout_update()`
+ * @param layout        pointer to a text layout
+ */
+void lv_text_layout_init(lv_text_layout_t * layout);
+
+/**
+ * Free the memory used by a text layout
+ * @param layout        pointer to a text layout
+ */
+void lv_text_layout_deinit(lv_text_layout_t * layout);
+
+/**
+ * Mark a text layout as invalid. Needs to be called if the text is changed in place.
+ * @param layout        pointer to a text layout
+ */
+void lv_text_layout_invalidate(lv_text_layout_t * layout);
+
+/**
+ * Check if a text layout was calculated with the given parameters
+ * @param layout        pointer to a text layout
+ * @param text          a '\0' terminated string
+ * @param font          pointer to a font
+ * @param letter_space  letter space
+ * @param max_width     max width of the lines
+ * @param flag          settings for the text from ::lv_text_flag_t
+ * @return              true: the lines of the layout can be used
+ */
+bool lv_text_layout_is_valid(const lv_text_layout_t * layout, const char * text, const lv_font_t * font,
+                             int32_t letter_space, int32_t max_width, lv_text_flag_t flag);
+
+/**
+ * Break a text into lines and measure them if the layout was calculated with other parameters
+ * @param layout        pointer to a text layout
+ * @param text          a '\0' terminated string
+ * @param font          pointer to a font
+ * @param letter_space  letter space
+ * @param max_width     max width of the lines
+ * @param flag          settings for the text from ::lv_text_flag_t
+ * @return              true: the layout is valid; false: out of memory
+ */
+bool lv_text_layout_update(lv_text_layout_t * layout, const char * text, const lv_font_t * font,
+                           int32_t letter_space, int32_t max_width, lv_text_flag_t flag);
+
+/**
+ * Get the size of a text from its layout. Gives the same result as `lv_text_get_size()`.
+ * @param layout        pointer to a valid text layout
+ * @param line_space    line space
+ * @param size_res      store the result here
+ */
+void lv_text_layout_get_size(const lv_text_layout_t * layout, int32_t line_space, lv_point_t * size_res);
+
+/**
+ * Get the number of lines in a text layout
+ * @param layout        pointer to a valid text layout
+ * @return              number of lines
+ */
+static inline uint32_t lv_text_layout_get_line_count(const lv_text_layout_t * layout)
+{
+    return lv_array_size(&layout->lines) - 1;
+}
+
+/**
+ * Get a line of a text layout
+ * @param layout        pointer to a valid text layout
+ * @param idx           index of the line. `lv_text_layout_get_line_count()` gives the end of the text
+ * @return              pointer to the line
+ */
+static inline const lv_text_line_t * lv_text_layout_get_line(const lv_text_layout_t * layout, uint32_t idx)
+{
+    return (const lv_text_line_t *)lv_array_at(&layout->lines, idx);
+}
+
 /**
  * Insert a string into another
  * @param txt_buf the original text (must be big enough for the result text and NULL terminated)
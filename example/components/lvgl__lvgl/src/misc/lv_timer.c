@@ -34,6 +34,14 @@
 static bool lv_timer_exec(lv_timer_t * timer);
 static uint32_t lv_timer_time_remaining(lv_timer_t * timer);
 static void lv_timer_handler_resume(void);
+static uint64_t tick_ext_get(void);
+static bool timer_schedule(lv_timer_t * timer);
+static void timer_unschedule(lv_timer_t * timer);
+static bool heap_insert(lv_timer_t * timer);
+static void heap_remove(lv_timer_t * timer);
+static void heap_sift_up(uint32_t i);
+static void heap_sift_down(uint32_t i);
+static bool due_push(lv_timer_t * timer);
 
 /**********************
  *  STATIC VARIABLES
@@ -90,42 +98,39 @@ LV_ATTRIBUTE_TIMER_HANDLER uint32_t lv_timer_handler(void)
         }
     }
 
-    /*Run all timer from the list*/
-    lv_timer_t * next;
-    lv_timer_t * timer_active;
-    lv_ll_t * timer_head = timer_ll_p;
-    do {
-        state_p->timer_deleted             = false;
-        state_p->timer_created             = false;
-
-        timer_active = lv_ll_get_head(timer_head);
-        while(timer_active) {
-            /*The timer might be deleted if it runs only once ('repeat_count = 1')
-             *So get next element until the current is surely valid*/
-            next = lv_ll_get_next(timer_head, timer_active);
-
-            if(lv_timer_exec(timer_active)) {
-                /*If a timer was created or deleted then this or the next item might be corrupted*/
-                if(state_p->timer_created || state_p->timer_deleted) {
-                    LV_TRACE_TIMER("Start from the first timer again because a timer was created or deleted");
-                    break;
-                }
-            }
+    /*Collect the due timers first so that each timer runs at most once in a call,
+     *even if it's rescheduled to be due again or created by a callback*/
+    uint64_t now = tick_ext_get();
+    state_p->due_cnt = 0;
+    while(state_p->heap_cnt > 0 && state_p->heap[0]->deadline <= now) {
+        lv_timer_t * timer = state_p->heap[0];
+        if(!due_push(timer)) break;
+        heap_remove(timer);
+    }
 
-            timer_active = next; /*Load the next timer*/
-        }
-    } while(timer_active);
+    uint32_t i;
+    for(i = 0; i < state_p->due_cnt; i++) {
+        /*NULL if deleted by an other timer's callback*/
+        lv_timer_t * timer_active = state_p->due[i];
+        if(timer_active == NULL) continue;
+        state_p->due[i] = NULL;
+        timer_active->in_due = 0;
+
+        state_p->timer_deleted = false;
+        state_p->timer_exec = timer_active;
+        lv_timer_exec(timer_active);
+        state_p->timer_exec = NULL;
+
+        /*The callback might have deleted the timer*/
+        if(!state_p->timer_deleted) timer_schedule(timer_active);
+    }
+    state_p->due_cnt = 0;
 
     uint32_t time_until_next = LV_NO_TIMER_READY;
-    next = lv_ll_get_head(timer_head);
-    while(next) {
-        if(!next->paused) {
-            uint32_t delay = lv_timer_time_remaining(next);
-            if(delay < time_until_next)
-                time_until_next = delay;
-        }
-
-        next = lv_ll_get_next(timer_head, next); /*Find the next timer*/
+    if(state_p->heap_cnt > 0) {
+        uint64_t deadline = state_p->heap[0]->deadline;
+        now = tick_ext_get();
+        time_until_next = deadline <= now ? 0 : (uint32_t)(deadline - now);
     }
 
     state_p->busy_time += lv_tick_elaps(handler_start);
@@ -178,8 +183,15 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
     new_timer->last_run = lv_tick_get();
     new_timer->user_data = user_data;
     new_timer->auto_delete = true;
-
-    state.timer_created = true;
+    new_timer->seq = state.seq_next++;
+    new_timer->heap_pos = 0;
+    new_timer->in_due = 0;
+
+    if(!timer_schedule(new_timer)) {
+        lv_ll_remove(timer_ll_p, new_timer);
+        lv_free(new_timer);
+        return NULL;
+    }
 
     lv_timer_handler_resume();
 
@@ -194,8 +206,10 @@ void lv_timer_set_cb(lv_timer_t * timer, lv_timer_cb_t timer_cb)
 
 void lv_timer_delete(lv_timer_t * timer)
 {
+    timer_unschedule(timer);
+    if(timer == state.timer_exec) state.timer_deleted = true;
+
     lv_ll_remove(timer_ll_p, timer);
-    state.timer_deleted = true;
 
     lv_free(timer);
 }
@@ -204,12 +218,14 @@ void lv_timer_pause(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->paused = true;
+    timer_schedule(timer);
 }
 
 void lv_timer_resume(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->paused = false;
+    timer_schedule(timer);
     lv_timer_handler_resume();
 }
 
@@ -217,18 +233,21 @@ void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 {
     LV_ASSERT_NULL(timer);
     timer->period = period;
+    timer_schedule(timer);
 }
 
 void lv_timer_ready(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->last_run = lv_tick_get() - timer->period - 1;
+    timer_schedule(timer);
 }
 
 void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
 {
     LV_ASSERT_NULL(timer);
     timer->repeat_count = repeat_count;
+    timer_schedule(timer);
 }
 
 void lv_timer_set_auto_delete(lv_timer_t * timer, bool auto_delete)
@@ -247,6 +266,7 @@ void lv_timer_reset(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->last_run = lv_tick_get();
+    timer_schedule(timer);
     lv_timer_handler_resume();
 }
 
@@ -261,6 +281,16 @@ void lv_timer_core_deinit(void)
     lv_timer_enable(false);
 
     lv_ll_clear(timer_ll_p);
+
+    lv_free(state.heap);
+    state.heap = NULL;
+    state.heap_cnt = 0;
+    state.heap_size = 0;
+
+    lv_free(state.due);
+    state.due = NULL;
+    state.due_cnt = 0;
+    state.due_size = 0;
 }
 
 uint32_t lv_timer_get_idle(void)
@@ -378,6 +408,161 @@ static void lv_timer_handler_resume(void)
     }
 }
 
+/**
+ * Get the current tick extended to 64 bit so that the deadlines of the timers
+ * can be compared directly even if `lv_tick_get()` overflows.
+ * @return the extended tick
+ */
+static uint64_t tick_ext_get(void)
+{
+    uint32_t act = lv_tick_get();
+    state.tick_ext += (uint32_t)(act - state.tick_ext_last);
+    state.tick_ext_last = act;
+    return state.tick_ext;
+}
+
+/**
+ * Update the position of a timer in the heap according to its current
+ * `last_run`, `period`, `repeat_count` and `paused` fields.
+ * @param timer pointer to a timer
+ * @return      false: the heap couldn't grow so the timer won't run
+ */
+static bool timer_schedule(lv_timer_t * timer)
+{
+    /*It will be scheduled when its turn comes in the current `lv_timer_handler()` call*/
+    if(timer->in_due) return true;
+
+    if(timer->paused) {
+        heap_remove(timer);
+        return true;
+    }
+
+    /*A finished timer needs to run once more to delete or pause itself*/
+    uint32_t remaining = timer->repeat_count == 0 ? 0 : lv_timer_time_remaining(timer);
+    timer->deadline = tick_ext_get() + remaining;
+
+    if(timer->heap_pos == 0) {
+        if(!heap_insert(timer)) {
+            LV_LOG_WARN("couldn't schedule the timer, it won't run");
+            return false;
+        }
+    }
+    else {
+        heap_sift_up(timer->heap_pos - 1);
+        heap_sift_down(timer->heap_pos - 1);
+    }
+
+    return true;
+}
+
+/**
+ * Remove a timer from the heap and from the due timers
+ * @param timer pointer to a timer
+ */
+static void timer_unschedule(lv_timer_t * timer)
+{
+    heap_remove(timer);
+
+    if(timer->in_due) {
+        uint32_t i;
+        for(i = 0; i < state.due_cnt; i++) {
+            if(state.due[i] == timer) {
+                state.due[i] = NULL;
+                break;
+            }
+        }
+        timer->in_due = 0;
+    }
+}
+
+static inline bool heap_is_earlier(const lv_timer_t * a, const lv_timer_t * b)
+{
+    if(a->deadline != b->deadline) return a->deadline < b->deadline;
+    /*Keep the order of the former timer list: the newer timer first*/
+    return (int32_t)(a->seq - b->seq) > 0;
+}
+
+static inline void heap_set(uint32_t i, lv_timer_t * timer)
+{
+    state.heap[i] = timer;
+    timer->heap_pos = i + 1;
+}
+
+static bool heap_insert(lv_timer_t * timer)
+{
+    if(state.heap_cnt == state.heap_size) {
+        uint32_t new_size = state.heap_size ? state.heap_size * 2 : 8;
+        lv_timer_t ** new_heap = lv_realloc(state.heap, new_size * sizeof(lv_timer_t *));
+        LV_ASSERT_MALLOC(new_heap);
+        if(new_heap == NULL) return false;
+        state.heap = new_heap;
+        state.heap_size = new_size;
+    }
+
+    heap_set(state.heap_cnt, timer);
+    state.heap_cnt++;
+    heap_sift_up(state.heap_cnt - 1);
+    return true;
+}
+
+static void heap_remove(lv_timer_t * timer)
+{
+    if(timer->heap_pos == 0) return;
+
+    uint32_t i = timer->heap_pos - 1;
+    timer->heap_pos = 0;
+    state.heap_cnt--;
+    if(i == state.heap_cnt) return;
+
+    /*Move the last timer to the hole and restore the heap order*/
+    heap_set(i, state.heap[state.heap_cnt]);
+    heap_sift_up(i);
+    heap_sift_down(i);
+}
+
+static void heap_sift_up(uint32_t i)
+{
+    lv_timer_t * timer = state.heap[i];
+    while(i > 0) {
+        uint32_t parent = (i - 1) / 2;
+        if(!heap_is_earlier(timer, state.heap[parent])) break;
+        heap_set(i, state.heap[parent]);
+        i = parent;
+    }
+    heap_set(i, timer);
+}
+
+static void heap_sift_down(uint32_t i)
+{
+    lv_timer_t * timer = state.heap[i];
+    while(1) {
+        uint32_t child = 2 * i + 1;
+        if(child >= state.heap_cnt) break;
+        if(child + 1 < state.heap_cnt && heap_is_earlier(state.heap[child + 1], state.heap[child])) child++;
+        if(!heap_is_earlier(state.heap[child], timer)) break;
+        heap_set(i, state.heap[child]);
+        i = child;
+    }
+    heap_set(i, timer);
+}
+
+static bool due_push(lv_timer_t * timer)
+{
+    if(state.due_cnt == state.due_size) {
+        uint32_t new_size = state.due_size ? state.due_size * 2 : 8;
+        lv_timer_t ** new_due = lv_realloc(state.due, new_size * sizeof(lv_timer_t *));
+        LV_ASSERT_MALLOC(new_due);
+        if(new_due == NULL) return false;
+        state.due = new_due;
+        state.due_size = new_size;
+    }
+
+    state.due[state.due_cnt] = timer;
+    state.due_cnt++;
+    timer->in_due = 1;
+    return true;
+}
+
 void lv_timer_handler_set_resume_cb(lv_timer_handler_resume_cb_t cb, void * data)
 {
     state.resume_cb = cb;
@@ -33,17 +33,31 @@ struct lv_timer_t {
     lv_timer_cb_t timer_cb;    /**< Timer function */
     void * user_data;          /**< Custom user data */
     int32_t repeat_count;      /**< 1: One time;  -1 : infinity;  n>0: residual times */
+    uint64_t deadline;         /**< When the timer needs to run next time on the extended tick*/
+    uint32_t seq;              /**< Creation order. Newer timers run first if they are due at the same time*/
+    uint32_t heap_pos;         /**< 1-based index in the heap of the scheduled timers, 0: not scheduled*/
     uint32_t paused : 1;
     uint32_t auto_delete : 1;
+    uint32_t in_due : 1;       /**< Collected to run in the current `lv_timer_handler()` call*/
 };
 
 typedef struct {
     lv_ll_t timer_ll;          /**< Linked list to store the lv_timers */
 
+    lv_timer_t ** heap;        /**< Binary min-heap of the not paused timers ordered by `deadline`*/
+    uint32_t heap_cnt;
+    uint32_t heap_size;
+    lv_timer_t ** due;         /**< The timers to run in the current `lv_timer_handler()` call*/
+    uint32_t due_cnt;
+    uint32_t due_size;
+    uint32_t seq_next;
+    uint64_t tick_ext;         /**< `lv_tick_get()` extended to 64 bit to not overflow*/
+    uint32_t tick_ext_last;
+
     bool lv_timer_run;
     uint8_t idle_last;
-    bool timer_deleted;
-    bool timer_created;
+    bool timer_deleted;        /**< The timer whose callback is running was deleted*/
+    lv_timer_t * timer_exec;   /**< The timer whose callback is running*/
     uint32_t timer_time_until_next;
 
     bool already_running;
@@ -137,6 +137,8 @@ typedef struct lv_event_dsc_t lv_event_dsc_t;
 
 typedef struct lv_fs_file_cache_t lv_fs_file_cache_t;
 
+typedef struct lv_fs_read_ahead_t lv_fs_read_ahead_t;
+
 typedef struct lv_fs_path_ex_t lv_fs_path_ex_t;
 
 typedef struct lv_image_decoder_args_t lv_image_decoder_args_t;
@@ -151,6 +153,8 @@ typedef struct lv_grad_t lv_grad_t;
 
 typedef struct lv_draw_label_hint_t lv_draw_label_hint_t;
 
+typedef struct lv_text_layout_t lv_text_layout_t;
+
 typedef struct lv_draw_glyph_dsc_t lv_draw_glyph_dsc_t;
 
 typedef struct lv_draw_image_sup_t lv_draw_image_sup_t;
@@ -159,6 +163,10 @@ typedef struct lv_draw_mask_rect_dsc_t lv_draw_mask_rect_dsc_t;
 
 typedef struct lv_obj_style_t lv_obj_style_t;
 
+typedef struct lv_obj_style_resolved_t lv_obj_style_resolved_t;
+
+typedef struct lv_indev_hit_index_t lv_indev_hit_index_t;
+
 typedef struct lv_obj_style_transition_dsc_t lv_obj_style_transition_dsc_t;
 
 typedef struct lv_hit_test_info_t lv_hit_test_info_t;
@@ -58,6 +58,17 @@ void * lv_utils_bsearch(const void * key, const void * base, size_t n, size_t si
     return NULL;
 }
 
+uint32_t lv_utils_fnv1a(uint32_t hash, const void * data, uint32_t len)
+{
+    const uint8_t * p = data;
+    uint32_t i;
+    for(i = 0; i < len; i++) {
+        hash = (hash ^ p[i]) * 16777619u;
+    }
+
+    return hash;
+}
+
 lv_result_t lv_draw_buf_save_to_file(const lv_draw_buf_t * draw_buf, const char * path)
 {
     lv_fs_file_t file;
@@ -21,6 +21,9 @@ extern "C" {
  *      DEFINES
  *********************/
 
+/** The initial value of an FNV-1a hash for `lv_utils_fnv1a()`*/
+#define LV_UTILS_FNV1A_INIT 2166136261u
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -49,6 +52,15 @@ extern "C" {
 void * lv_utils_bsearch(const void * key, const void * base, size_t n, size_t size,
                         int (*cmp)(const void * pRef, const void * pElement));
 
+/**
+ * Continue an FNV-1a hash with some bytes
+ * @param hash  `LV_UTILS_FNV1A_INIT` to start a new hash or the hash of the previous bytes
+ * @param data  pointer to the bytes to hash
+ * @param len   number of bytes
+ * @return      the new hash
+ */
+uint32_t lv_utils_fnv1a(uint32_t hash, const void * data, uint32_t len);
+
 /**
  * Save a draw buf to a file
  * @param draw_buf  pointer to a draw buffer
@@ -9,6 +9,7 @@
 #include "lv_string.h"
 #include "../misc/lv_assert.h"
 #include "../misc/lv_log.h"
+#include "../misc/lv_math.h"
 #include "../core/lv_global.h"
 
 #if LV_USE_OS == LV_OS_PTHREAD
@@ -25,6 +26,21 @@
 
 #define zero_mem LV_GLOBAL_DEFAULT()->memory_zero
 
+#if LV_MEM_SLAB_SIZE
+    #define slab_state LV_GLOBAL_DEFAULT()->mem_slab_state
+
+    #define SLAB_CLASS_UNIT     16
+    #define SLAB_BLOCK_MAX      (SLAB_CLASS_UNIT * LV_MEM_SLAB_CLASS_CNT)
+    #define SLAB_HEADER_SIZE    LV_ALIGN_UP(sizeof(lv_mem_slab_t), SLAB_CLASS_UNIT)
+
+    #if LV_MEM_SLAB_SIZE < 1024
+        #error "LV_MEM_SLAB_SIZE should be at least 1024"
+    #elif LV_MEM_SLAB_SIZE / SLAB_CLASS_UNIT > 0xFFFF
+        /*The block count of a slab is stored on 16 bits*/
+        #error "LV_MEM_SLAB_SIZE should be at most 1 MB"
+    #endif
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -32,6 +48,21 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static void * mem_alloc(size_t size);
+
+#if LV_MEM_SLAB_SIZE
+    static void * slab_alloc(size_t size);
+    static bool slab_free(void * p);
+    static size_t slab_get_block_size(const void * p);
+    static int32_t slab_find(const void * p);
+    static bool slab_is_in_range(const void * p);
+    static void slab_update_range(void);
+    static lv_mem_slab_t * slab_create(uint32_t class_id);
+    static void slab_release(int32_t idx);
+    static lv_result_t slab_test(void);
+    static void slab_lock(void);
+    static void slab_unlock(void);
+#endif
 
 /**********************
  *  GLOBAL PROTOTYPES
@@ -59,6 +90,35 @@ lv_result_t lv_mem_test_core(void);
  *   GLOBAL FUNCTIONS
  **********************/
 
+#if LV_MEM_SLAB_SIZE
+
+void lv_mem_slab_init(void)
+{
+    lv_memzero(&slab_state, sizeof(lv_mem_slab_state_t));
+#if LV_USE_OS
+    lv_mutex_init(&slab_state.mutex);
+#endif
+}
+
+void lv_mem_slab_deinit(void)
+{
+    /*The builtin heap is destroyed already together with the slabs in it*/
+#if LV_USE_STDLIB_MALLOC != LV_STDLIB_BUILTIN
+    uint32_t i;
+    for(i = 0; i < slab_state.slab_cnt; i++) {
+        lv_free_core(slab_state.slabs[i]);
+    }
+    lv_free_core(slab_state.slabs);
+#endif
+
+#if LV_USE_OS
+    lv_mutex_delete(&slab_state.mutex);
+#endif
+    lv_memzero(&slab_state, sizeof(lv_mem_slab_state_t));
+}
+
+#endif /*LV_MEM_SLAB_SIZE*/
+
 void * lv_malloc(size_t size)
 {
     LV_TRACE_MEM("allocating %lu bytes", (unsigned long)size);
@@ -67,7 +127,7 @@ void * lv_malloc(size_t size)
         return &zero_mem;
     }
 
-    void * alloc = lv_malloc_core(size);
+    void * alloc = mem_alloc(size);
 
     if(alloc == NULL) {
         LV_LOG_INFO("couldn't allocate memory (%lu bytes)", (unsigned long)size);
@@ -97,7 +157,7 @@ void * lv_malloc_zeroed(size_t size)
         return &zero_mem;
     }
 
-    void * alloc = lv_malloc_core(size);
+    void * alloc = mem_alloc(size);
     if(alloc == NULL) {
         LV_LOG_INFO("couldn't allocate memory (%lu bytes)", (unsigned long)size);
 #if LV_LOG_LEVEL <= LV_LOG_LEVEL_INFO
@@ -122,6 +182,10 @@ void lv_free(void * data)
     if(data == &zero_mem) return;
     if(data == NULL) return;
 
+#if LV_MEM_SLAB_SIZE
+    if(slab_free(data)) return;
+#endif
+
     lv_free_core(data);
 }
 
@@ -136,6 +200,25 @@ void * lv_realloc(void * data_p, size_t new_size)
 
     if(data_p == &zero_mem) return lv_malloc(new_size);
 
+#if LV_MEM_SLAB_SIZE
+    size_t block_size = slab_get_block_size(data_p);
+    if(block_size) {
+        /*Keep the block if the new size belongs to the same size class*/
+        if(new_size <= block_size && new_size > block_size - SLAB_CLASS_UNIT) return data_p;
+
+        void * new_p = mem_alloc(new_size);
+        if(new_p == NULL) {
+            LV_LOG_ERROR("couldn't reallocate memory");
+            return NULL;
+        }
+
+        lv_memcpy(new_p, data_p, LV_MIN(new_size, block_size));
+        slab_free(data_p);
+        LV_TRACE_MEM("reallocated at %p", new_p);
+        return new_p;
+    }
+#endif
+
     void * new_p = lv_realloc_core(data_p, new_size);
 
     if(new_p == NULL) {
@@ -154,6 +237,10 @@ lv_result_t lv_mem_test(void)
         return LV_RESULT_INVALID;
     }
 
+#if LV_MEM_SLAB_SIZE
+    if(slab_test() != LV_RESULT_OK) return LV_RESULT_INVALID;
+#endif
+
     return lv_mem_test_core();
 }
 
@@ -161,8 +248,284 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
 {
     lv_memzero(mon_p, sizeof(lv_mem_monitor_t));
     lv_mem_monitor_core(mon_p);
+
+#if LV_MEM_SLAB_SIZE
+    slab_lock();
+    mon_p->slab_total_size = (size_t)slab_state.slab_cnt * LV_MEM_SLAB_SIZE;
+    mon_p->slab_used_size = slab_state.used_size;
+    slab_unlock();
+#endif
 }
 
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+static void * mem_alloc(size_t size)
+{
+#if LV_MEM_SLAB_SIZE
+    if(size <= SLAB_BLOCK_MAX) {
+        void * p = slab_alloc(size);
+        if(p) return p;
+    }
+#endif
+
+    return lv_malloc_core(size);
+}
+
+#if LV_MEM_SLAB_SIZE
+
+static void * slab_alloc(size_t size)
+{
+    uint32_t class_id = (uint32_t)((size - 1) / SLAB_CLASS_UNIT);
+
+    slab_lock();
+    lv_mem_slab_t * slab = slab_state.partial[class_id];
+    if(slab == NULL) {
+        slab = slab_create(class_id);
+        if(slab == NULL) {
+            slab_unlock();
+            return NULL;
+        }
+    }
+
+    void * p = slab->free_list;
+    slab->free_list = *(void **)p;
+    slab->used_cnt++;
+    slab_state.used_size += (class_id + 1) * SLAB_CLASS_UNIT;
+
+    /*Full: remove it from the list of slabs with free blocks*/
+    if(slab->free_list == NULL) {
+        slab_state.partial[class_id] = slab->next;
+        if(slab->next) slab->next->prev = NULL;
+        slab->next = NULL;
+    }
+
+    slab_unlock();
+    return p;
+}
+
+/**
+ * Put back a block to its slab
+ * @param p     pointer to a block
+ * @return      false: `p` is not in a slab
+ */
+static bool slab_free(void * p)
+{
+    if(!slab_is_in_range(p)) return false;
+
+    slab_lock();
+    int32_t idx = slab_find(p);
+    if(idx < 0) {
+        slab_unlock();
+        return false;
+    }
+
+    lv_mem_slab_t * slab = slab_state.slabs[idx];
+    bool was_full = slab->free_list == NULL;
+    *(void **)p = slab->free_list;
+    slab->free_list = p;
+    slab->used_cnt--;
+    slab_state.used_size -= (slab->class_id + 1) * SLAB_CLASS_UNIT;
+
+    if(was_full) {
+        slab->prev = NULL;
+        slab->next = slab_state.partial[slab->class_id];
+        if(slab->next) slab->next->prev = slab;
+        slab_state.partial[slab->class_id] = slab;
+    }
+
+    /*Give an empty slab back to the heap but keep the last one of the class to avoid thrashing*/
+    if(slab->used_cnt == 0 && (slab->prev || slab->next)) {
+        slab_release(idx);
+    }
+
+    slab_unlock();
+    return true;
+}
+
+/**
+ * Get the size of the block containing `p`
+ * @param p     pointer to a block
+ * @return      the size of the block or 0 if `p` is not in a slab
+ */
+static size_t slab_get_block_size(const void * p)
+{
+    if(!slab_is_in_range(p)) return 0;
+
+    slab_lock();
+    int32_t idx = slab_find(p);
+    size_t size = idx < 0 ? 0 : (slab_state.slabs[idx]->class_id + 1) * SLAB_CLASS_UNIT;
+    slab_unlock();
+    return size;
+}
+
+/**
+ * Find the slab containing an address with binary search
+ * @param p     an address
+ * @return      index of the slab in `slab_state.slabs` or -1 if not found
+ */
+static int32_t slab_find(const void * p)
+{
+    int32_t min = 0;
+    int32_t max = (int32_t)slab_state.slab_cnt - 1;
+    const uint8_t * p8 = p;
+
+    while(min <= max) {
+        int32_t mid = (min + max) / 2;
+        const uint8_t * slab8 = (const uint8_t *)slab_state.slabs[mid];
+        if(p8 < slab8) max = mid - 1;
+        else if(p8 >= slab8 + LV_MEM_SLAB_SIZE) min = mid + 1;
+        else return mid;
+    }
+
+    return -1;
+}
+
+/**
+ * Check if an address can be in a slab without locking.
+ * The slab of a block allocated by the caller can't be created or freed meanwhile,
+ * so a concurrent update of the range doesn't change the result for it.
+ * @param p     an address
+ * @return      false: `p` is surely not in a slab
+ */
+static bool slab_is_in_range(const void * p)
+{
+    const uint8_t * p8 = p;
+    return p8 >= slab_state.range_start && p8 < slab_state.range_end;
+}
+
+static void slab_update_range(void)
+{
+    if(slab_state.slab_cnt == 0) {
+        slab_state.range_start = NULL;
+        slab_state.range_end = NULL;
+        return;
+    }
+
+    slab_state.range_start = (const uint8_t *)slab_state.slabs[0];
+    slab_state.range_end = (const uint8_t *)slab_state.slabs[slab_state.slab_cnt - 1] + LV_MEM_SLAB_SIZE;
+}
+
+static lv_mem_slab_t * slab_create(uint32_t class_id)
+{
+    if(slab_state.slab_cnt == slab_state.slab_arr_size) {
+        uint32_t new_size = slab_state.slab_arr_size ? slab_state.slab_arr_size * 2 : 8;
+        lv_mem_slab_t ** new_arr;
+        if(slab_state.slabs == NULL) new_arr = lv_malloc_core(new_size * sizeof(lv_mem_slab_t *));
+        else new_arr = lv_realloc_core(slab_state.slabs, new_size * sizeof(lv_mem_slab_t *));
+        if(new_arr == NULL) return NULL;
+        slab_state.slabs = new_arr;
+        slab_state.slab_arr_size = new_size;
+    }
+
+    lv_mem_slab_t * slab = lv_malloc_core(LV_MEM_SLAB_SIZE);
+    if(slab == NULL) return NULL;
+
+    uint32_t block_size = (class_id + 1) * SLAB_CLASS_UNIT;
+    slab->prev = NULL;
+    slab->next = NULL;
+    slab->used_cnt = 0;
+    slab->block_cnt = (uint16_t)((LV_MEM_SLAB_SIZE - SLAB_HEADER_SIZE) / block_size);
+    slab->class_id = (uint8_t)class_id;
+
+    /*Chain the blocks in address order*/
+    uint8_t * block = (uint8_t *)slab + SLAB_HEADER_SIZE;
+    slab->free_list = block;
+    uint32_t i;
+    for(i = 0; i < slab->block_cnt - 1U; i++) {
+        *(void **)block = block + block_size;
+        block += block_size;
+    }
+    *(void **)block = NULL;
+
+    /*Keep the slabs sorted by address*/
+    uint32_t idx = slab_state.slab_cnt;
+    while(idx > 0 && slab_state.slabs[idx - 1] > slab) idx--;
+    lv_memmove(&slab_state.slabs[idx + 1], &slab_state.slabs[idx],
+               (slab_state.slab_cnt - idx) * sizeof(lv_mem_slab_t *));
+    slab_state.slabs[idx] = slab;
+    slab_state.slab_cnt++;
+    slab_update_range();
+
+    slab_state.partial[class_id] = slab;
+    return slab;
+}
+
+static void slab_release(int32_t idx)
+{
+    lv_mem_slab_t * slab = slab_state.slabs[idx];
+    if(slab->prev) slab->prev->next = slab->next;
+    else slab_state.partial[slab->class_id] = slab->next;
+    if(slab->next) slab->next->prev = slab->prev;
+
+    slab_state.slab_cnt--;
+    lv_memmove(&slab_state.slabs[idx], &slab_state.slabs[idx + 1],
+               (slab_state.slab_cnt - idx) * sizeof(lv_mem_slab_t *));
+    slab_update_range();
+    lv_free_core(slab);
+}
+
+/**
+ * Check the free lists of the slabs and their used counters
+ * @return      LV_RESULT_OK: the slabs are consistent
+ */
+static lv_result_t slab_test(void)
+{
+    lv_result_t res = LV_RESULT_OK;
+    size_t used_size = 0;
+
+    slab_lock();
+    uint32_t i;
+    for(i = 0; i < slab_state.slab_cnt && res == LV_RESULT_OK; i++) {
+        lv_mem_slab_t * slab = slab_state.slabs[i];
+        uint32_t block_size = (slab->class_id + 1) * SLAB_CLASS_UNIT;
+        const uint8_t * first = (const uint8_t *)slab + SLAB_HEADER_SIZE;
+        const uint8_t * end = first + (size_t)slab->block_cnt * block_size;
+
+        /*Every free block is on a block boundary of its slab and the list has no loops*/
+        uint32_t free_cnt = 0;
+        const uint8_t * block = slab->free_list;
+        while(block) {
+            if(block < first || block >= end || (size_t)(block - first) % block_size != 0 ||
+               free_cnt >= slab->block_cnt) {
+                LV_LOG_WARN("corrupted free list in the slab %p", (void *)slab);
+                res = LV_RESULT_INVALID;
+                break;
+            }
+            free_cnt++;
+            block = *(void * const *)block;
+        }
+
+        if(res == LV_RESULT_OK && free_cnt + slab->used_cnt != slab->block_cnt) {
+            LV_LOG_WARN("wrong used block count in the slab %p", (void *)slab);
+            res = LV_RESULT_INVALID;
+        }
+
+        used_size += (size_t)slab->used_cnt * block_size;
+    }
+
+    if(res == LV_RESULT_OK && used_size != slab_state.used_size) {
+        LV_LOG_WARN("wrong used size of the slabs");
+        res = LV_RESULT_INVALID;
+    }
+    slab_unlock();
+
+    return res;
+}
+
+static void slab_lock(void)
+{
+#if LV_USE_OS
+    lv_mutex_lock(&slab_state.mutex);
+#endif
+}
+
+static void slab_unlock(void)
+{
+#if LV_USE_OS
+    lv_mutex_unlock(&slab_state.mutex);
+#endif
+}
+
+#endif /*LV_MEM_SLAB_SIZE*/
@@ -41,6 +41,8 @@ typedef struct {
     size_t max_used;    /**< Max size of Heap memory used */
     uint8_t used_pct;   /**< Percentage used */
     uint8_t frag_pct;   /**< Amount of fragmentation */
+    size_t slab_total_size; /**< Memory taken from the heap by the slabs of the small allocations */
+    size_t slab_used_size;  /**< Memory used by allocations in the slabs */
 } lv_mem_monitor_t;
 
 /**********************
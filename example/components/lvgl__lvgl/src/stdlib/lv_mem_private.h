@@ -15,19 +15,69 @@ extern "C" {
  *********************/
 
 #include "lv_mem.h"
+#include "../osal/lv_os.h"
 
 /*********************
  *      DEFINES
  *********************/
 
+/*Size classes of 16, 32, ... 256 bytes*/
+#define LV_MEM_SLAB_CLASS_CNT   16
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_MEM_SLAB_SIZE
+
+typedef struct lv_mem_slab_t lv_mem_slab_t;
+
+/** The header at the beginning of a slab. The rest of the slab is split into blocks of the same size.*/
+struct lv_mem_slab_t {
+    lv_mem_slab_t * prev;   /**< The neighbours in the list of slabs with free blocks of the same size class*/
+    lv_mem_slab_t * next;
+    void * free_list;       /**< The free blocks of the slab, each storing the address of the next one*/
+    uint16_t used_cnt;
+    uint16_t block_cnt;
+    uint8_t class_id;
+};
+
+typedef struct {
+#if LV_USE_OS
+    lv_mutex_t mutex;
+#endif
+    lv_mem_slab_t * partial[LV_MEM_SLAB_CLASS_CNT];  /**< Slabs with free blocks per size class*/
+    lv_mem_slab_t ** slabs;                         /**< All slabs sorted by address to find the slab of a block*/
+    uint32_t slab_cnt;
+    uint32_t slab_arr_size;
+    size_t used_size;                               /**< Sum of the size of the used blocks*/
+
+    /** All slabs are in `[range_start, range_end)`. Read without the mutex to not lock
+     * for the pointers which are surely not in a slab.*/
+    const uint8_t * range_start;
+    const uint8_t * range_end;
+} lv_mem_slab_state_t;
+
+#endif /*LV_MEM_SLAB_SIZE*/
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
+#if LV_MEM_SLAB_SIZE
+
+/**
+ * Prepare the slabs of the small allocations. Should be called before `lv_mem_init()`.
+ */
+void lv_mem_slab_init(void);
+
+/**
+ * Release the slabs. Should be called after `lv_mem_deinit()`.
+ */
+void lv_mem_slab_deinit(void);
+
+#endif /*LV_MEM_SLAB_SIZE*/
+
 /**********************
  *      MACROS
  **********************/
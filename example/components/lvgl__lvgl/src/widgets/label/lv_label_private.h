@@ -16,6 +16,7 @@ extern "C" {
 
 #include "../../draw/lv_draw_label_private.h"
 #include "../../core/lv_obj_private.h"
+#include "../../misc/lv_text_private.h"
 #include "lv_label.h"
 
 #if LV_USE_LABEL != 0
@@ -41,6 +42,10 @@ struct lv_label_t {
     lv_draw_label_hint_t hint;
 #endif
 
+#if LV_LABEL_LINE_CACHE
+    lv_text_layout_t layout;            /**< Line breaks and line widths shared by the size calculation and drawing */
+#endif
+
 #if LV_LABEL_TEXT_SELECTION
     uint32_t sel_start;
     uint32_t sel_end;
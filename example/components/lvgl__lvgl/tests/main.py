@@ -35,12 +35,24 @@ test_options = {
     'OPTIONS_TEST_SYSHEAP': 'Test config, system heap, 32 bit color depth',
     'OPTIONS_TEST_DEFHEAP': 'Test config, LVGL heap, 32 bit color depth',
     'OPTIONS_TEST_VG_LITE': 'VG-Lite simulator with full config, 32 bit color depth',
+    'OPTIONS_TEST_SLAB': 'Test config, LVGL heap with slabs, 32 bit color depth',
 }
 
+if platform.machine() in ('x86_64', 'AMD64') and platform.system() != 'Windows':
+    test_options['OPTIONS_TEST_X86_ASM'] = 'Test config, system heap, x86 SIMD blend functions'
+
+# Run only on request as the results depend on the machine
+perf_options = {}
+
+if platform.system() != 'Windows':
+    perf_options['OPTIONS_TEST_PERF'] = 'Performance measurements, test config, system heap, release build'
+
 
 def get_option_description(option_name):
     if option_name in build_only_options:
         return build_only_options[option_name]
+    if option_name in perf_options:
+        return perf_options[option_name]
     return test_options[option_name]
 
 
@@ -150,12 +162,20 @@ def run_tests(options_name, test_suite):
     print('=' * len(label), flush=True)
 
     os.chdir(get_build_dir(options_name))
-    args = [
-        'ctest',
-        '--timeout', '300',
-        '--parallel', str(os.cpu_count()),
-        '--output-on-failure',
-    ]
+    if options_name in perf_options:
+        # One at a time and with the printed results
+        args = [
+            'ctest',
+            '--timeout', '300',
+            '--verbose',
+        ]
+    else:
+        args = [
+            'ctest',
+            '--timeout', '300',
+            '--parallel', str(os.cpu_count()),
+            '--output-on-failure',
+        ]
     if test_suite is not None:
         args.extend(["--tests-regex", test_suite])
     subprocess.check_call(args)
@@ -222,7 +242,7 @@ if __name__ == "__main__":
     parser = argparse.ArgumentParser(
         description='Build and/or run LVGL tests.', epilog=epilog)
     parser.add_argument('--build-options', nargs=1,
-                        choices=list(chain(build_only_options, test_options)),
+                        choices=list(chain(build_only_options, test_options, perf_options)),
                         help='''the build option name to build or run. When
                         omitted all build configurations are used.
                         ''')
@@ -230,8 +250,9 @@ if __name__ == "__main__":
                         help='clean existing build artifacts before operation.')
     parser.add_argument('--report', action='store_true',
                         help='generate code coverage report for tests.')
-    parser.add_argument('actions', nargs='*', choices=['build', 'test'],
-                        help='build: compile build tests, test: compile/run executable tests.')
+    parser.add_argument('actions', nargs='*', choices=['build', 'test', 'perf'],
+                        help='build: compile build tests, test: compile/run executable tests, '
+                             'perf: compile/run the performance measurements.')
     parser.add_argument('--test-suite', default=None,
                         help='select test suite to run')
     parser.add_argument('--update-image', action='store_true', default=False,
@@ -244,6 +265,8 @@ if __name__ == "__main__":
 
     if args.build_options:
         options_to_build = args.build_options
+    elif 'perf' in args.actions:
+        options_to_build = perf_options
     else:
         if 'build' in args.actions:
             if 'test' in args.actions:
@@ -254,8 +277,8 @@ if __name__ == "__main__":
             options_to_build = test_options
 
     for options_name in options_to_build:
-        is_test = options_name in test_options
-        build_type = 'Debug'
+        is_test = options_name in test_options or options_name in perf_options
+        build_type = 'Release' if options_name in perf_options else 'Debug'
         build_tests(options_name, build_type, args.clean)
         if is_test:
             try:
@@ -3,6 +3,8 @@
 
 #define LV_MEM_SIZE                     (32 * 1024 * 1024)
 #define LV_DRAW_SW_SHADOW_CACHE_SIZE    8
+#define LV_OBJ_STYLE_RESOLVED_CACHE_SIZE 16
+#define LV_INDEV_HIT_INDEX_CELL_SIZE 32
 #define LV_DRAW_THREAD_STACK_SIZE    (64 * 1024) /*Increase stack size to 64KB in order to run ThorVG*/
 #define LV_USE_LOG              1
 #define LV_LOG_LEVEL            LV_LOG_LEVEL_TRACE
@@ -45,6 +47,7 @@
 #define LV_FONT_DEFAULT         &lv_font_montserrat_14
 #define LV_FONT_FMT_TXT_LARGE   1
 #define LV_USE_FONT_COMPRESSED  1
+#define LV_FONT_COMPRESSED_CACHE_SIZE (16 * 1024)
 #define LV_USE_BIDI 1
 #define LV_USE_ARABIC_PERSIAN_CHARS 1
 #define LV_USE_PERF_MONITOR         1
@@ -63,23 +66,34 @@
 #ifndef _WIN32
     #define LV_USE_FS_POSIX     1
     #define LV_FS_POSIX_LETTER  'B'
+    #define LV_FS_POSIX_MMAP    1
 #else
     #define LV_USE_FS_WIN32 1
     #define LV_FS_WIN32_LETTER 'C'
 #endif
 #define LV_USE_FS_MEMFS     1
 #define LV_FS_MEMFS_LETTER  'M'
+#ifdef LVGL_CI_USING_SYS_HEAP  /*Needs LV_USE_OS*/
+    #define LV_FS_READ_AHEAD    1
+#endif
 
 #define LV_USE_MONKEY       1
 #define LV_USE_RLE          1
 #define LV_USE_LODEPNG      1
 #define LV_USE_LIBPNG       1
+#define LV_LIBPNG_STRIP_HEIGHT  16
 #define LV_USE_BMP          1
 #define LV_USE_TJPGD        1
 #ifndef _WIN32
     #define LV_USE_LIBJPEG_TURBO   1
+    #ifdef LVGL_CI_USING_SYS_HEAP  /*Needs LV_USE_OS*/
+        #define LV_LIBJPEG_TURBO_THREAD_CNT 4
+    #endif
 #endif
 #define LV_USE_GIF          1
+#ifdef LVGL_CI_USING_SYS_HEAP  /*Needs LV_USE_OS*/
+    #define LV_GIF_DECODE_AHEAD 1
+#endif
 #define LV_USE_QRCODE       1
 #define LV_USE_BARCODE      1
 #define LV_USE_FRAGMENT     1
@@ -117,6 +131,7 @@
 #define LV_USE_OBJ_ID_BUILTIN   1
 
 #define LV_CACHE_DEF_SIZE       (10 * 1024 * 1024)
+#define LV_USE_IMAGE_HEADER_INDEX   1
 
 #ifndef LV_USE_LINUX_DRM
     #define LV_USE_LINUX_DRM    1
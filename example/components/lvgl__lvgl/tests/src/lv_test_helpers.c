@@ -2,6 +2,14 @@
 
 #include "lv_test_helpers.h"
 
+#if LV_USE_LZ4_INTERNAL
+#include "../../src/libs/lz4/lz4.h"
+#endif
+
+#ifdef LV_BUILD_TEST_PERF
+#include <time.h>
+#endif
+
 void lv_test_wait(uint32_t ms)
 {
     lv_tick_inc(ms);
@@ -9,4 +17,63 @@ void lv_test_wait(uint32_t ms)
     lv_refr_now(NULL);
 }
 
+#if LV_USE_LZ4_INTERNAL
+void lv_test_image_compress_lz4_rows(const lv_image_dsc_t * src, lv_image_dsc_t * dst, uint32_t block_rows)
+{
+    const lv_image_header_t * header = &src->header;
+    bool a8 = header->cf == LV_COLOR_FORMAT_RGB565A8;
+    uint32_t block_cnt = (header->h + block_rows - 1) / block_rows;
+    uint32_t block_size = block_rows * header->stride * (a8 ? 3 : 2) / 2;
+    uint32_t table_size = (block_cnt + 1) * sizeof(uint32_t);
+    uint32_t max_size = 12 + sizeof(uint32_t) + table_size + block_cnt * LZ4_compressBound(block_size);
+
+    uint8_t * data = lv_malloc(max_size);
+    uint8_t * block = lv_malloc(block_size);
+    uint32_t * table = (uint32_t *)(data + 16);
+    uint8_t * blocks = data + 16 + table_size;
+
+    uint32_t ofs = 0;
+    uint32_t i;
+    for(i = 0; i < block_cnt; i++) {
+        uint32_t y = i * block_rows;
+        uint32_t rows = LV_MIN(block_rows, header->h - y);
+        uint32_t len = rows * header->stride;
+        lv_memcpy(block, src->data + y * header->stride, len);
+        if(a8) {
+            uint32_t stride_a8 = header->stride / 2;
+            lv_memcpy(block + len, src->data + header->h * header->stride + y * stride_a8, rows * stride_a8);
+            len += rows * stride_a8;
+        }
+
+        table[i] = ofs;
+        ofs += LZ4_compress_default((const char *)block, (char *)blocks + ofs, len, LZ4_compressBound(block_size));
+    }
+    table[block_cnt] = ofs;
+
+    uint32_t * info = (uint32_t *)data;
+    info[0] = LV_IMAGE_COMPRESS_LZ4_ROWS;
+    info[1] = sizeof(uint32_t) + table_size + ofs;
+    info[2] = src->data_size;
+    info[3] = block_rows;
+
+    lv_free(block);
+
+    lv_memzero(dst, sizeof(*dst));
+    dst->header = *header;
+    dst->header.magic = LV_IMAGE_HEADER_MAGIC;
+    dst->header.flags |= LV_IMAGE_FLAGS_COMPRESSED;
+    dst->data = data;
+    dst->data_size = 12 + info[1];
+}
+#endif
+
+#ifdef LV_BUILD_TEST_PERF
+uint64_t lv_test_perf_get_time_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+}
+#endif
+
 #endif
@@ -10,13 +10,23 @@
 /* Pick a non-zero value */
 #define lv_test_get_free_mem() (65536)
 #else
+#if LV_MEM_SLAB_SIZE
+/* The empty slabs kept for reuse change the free size by a few bytes */
+#define LV_HEAP_CHECK(x) do {} while(0)
+#else
 #define LV_HEAP_CHECK(x) x
+#endif
 
 static inline size_t lv_test_get_free_mem(void)
 {
     lv_mem_monitor_t m1;
     lv_mem_monitor(&m1);
+#if LV_MEM_SLAB_SIZE
+    /*The unused blocks of the slabs are free too*/
+    return m1.free_size + m1.slab_total_size - m1.slab_used_size;
+#else
     return m1.free_size;
+#endif
 }
 #endif /* LVGL_CI_USING_SYS_HEAP */
 
@@ -24,4 +34,15 @@ static inline size_t lv_test_get_free_mem(void)
 
 void lv_test_wait(uint32_t ms);
 
+#if LV_USE_LZ4_INTERNAL
+/* Compress an image by LZ4 blocks of rows like LVGLImage.py with `--compress LZ4_ROWS`.
+ * `dst->data` is allocated with `lv_malloc()`. */
+void lv_test_image_compress_lz4_rows(const lv_image_dsc_t * src, lv_image_dsc_t * dst, uint32_t block_rows);
+#endif
+
+#ifdef LV_BUILD_TEST_PERF
+/* Monotonic time in nanoseconds for the performance measurements */
+uint64_t lv_test_perf_get_time_ns(void);
+#endif
+
 #endif /*LV_TEST_HELPERS_H*/
@@ -0,0 +1,193 @@
+#if LV_BUILD_TEST
+
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+typedef struct {
+    lv_cache_slot_size_t slot;
+    int32_t id;
+} test_data;
+
+static lv_cache_compare_res_t compare_cb(const test_data * lhs, const test_data * rhs)
+{
+    if(lhs->id != rhs->id) {
+        return lhs->id > rhs->id ? 1 : -1;
+    }
+    return 0;
+}
+
+static void free_cb(test_data * node, void * user_data)
+{
+    LV_UNUSED(node);
+    LV_UNUSED(user_data);
+}
+
+static uint32_t hash_cb(const test_data * key)
+{
+    return (uint32_t)key->id * 2654435761u;
+}
+
+static lv_cache_t * cache_create(const lv_cache_class_t * clz, uint32_t max_size)
+{
+    lv_cache_ops_t ops = {
+        .compare_cb = (lv_cache_compare_cb_t)compare_cb,
+        .create_cb = NULL,
+        .free_cb = (lv_cache_free_cb_t)free_cb,
+        .hash_cb = (lv_cache_hash_cb_t)hash_cb,
+    };
+    return lv_cache_create(clz, sizeof(test_data), max_size, ops);
+}
+
+/*Look up an entry and add it on miss like the image decoders do*/
+static void cache_access(lv_cache_t * cache, int32_t id, uint32_t size)
+{
+    test_data key = {
+        .slot.size = size,
+        .id = id,
+    };
+
+    lv_cache_entry_t * entry = lv_cache_acquire(cache, &key, NULL);
+    if(entry == NULL) entry = lv_cache_add(cache, &key, NULL);
+    if(entry) lv_cache_release(cache, entry, NULL);
+}
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+void test_cache_s3fifo_add_drop(void)
+{
+    lv_cache_t * cache = cache_create(&lv_cache_class_s3fifo_size, 100);
+
+    uint32_t i;
+    for(i = 0; i < 5; i++) cache_access(cache, (int32_t)i, 10);
+    TEST_ASSERT_EQUAL(50, lv_cache_get_size(cache, NULL));
+
+    test_data key = {.id = 3};
+    lv_cache_drop(cache, &key, NULL);
+    TEST_ASSERT_EQUAL(40, lv_cache_get_size(cache, NULL));
+    TEST_ASSERT_NULL(lv_cache_acquire(cache, &key, NULL));
+
+    /*The size is kept under the limit*/
+    for(i = 10; i < 30; i++) cache_access(cache, (int32_t)i, 30);
+    TEST_ASSERT_LESS_OR_EQUAL(100, lv_cache_get_size(cache, NULL));
+
+    lv_cache_drop_all(cache, NULL);
+    TEST_ASSERT_EQUAL(0, lv_cache_get_size(cache, NULL));
+
+    lv_cache_destroy(cache, NULL);
+}
+
+void test_cache_s3fifo_in_use_is_kept(void)
+{
+    lv_cache_t * cache = cache_create(&lv_cache_class_s3fifo_count, 4);
+
+    test_data key = {.id = 100};
+    lv_cache_entry_t * used = lv_cache_add(cache, &key, NULL);
+    TEST_ASSERT_NOT_NULL(used);
+
+    uint32_t i;
+    for(i = 0; i < 20; i++) cache_access(cache, (int32_t)i, 1);
+    TEST_ASSERT_EQUAL(4, lv_cache_get_size(cache, NULL));
+
+    lv_cache_entry_t * entry = lv_cache_acquire(cache, &key, NULL);
+    TEST_ASSERT_EQUAL_PTR(used, entry);
+    lv_cache_release(cache, entry, NULL);
+    lv_cache_release(cache, used, NULL);
+
+    lv_cache_destroy(cache, NULL);
+}
+
+void test_cache_s3fifo_stats(void)
+{
+    lv_cache_t * cache = cache_create(&lv_cache_class_s3fifo_size, 100);
+
+    cache_access(cache, 1, 10);
+    cache_access(cache, 1, 10);
+    cache_access(cache, 1, 10);
+    cache_access(cache, 2, 30);
+
+    lv_cache_stats_t stats;
+    lv_cache_get_stats(cache, &stats);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT64(20, stats.hit_size);
+    TEST_ASSERT_EQUAL_UINT64(40, stats.miss_size);
+
+    lv_cache_reset_stats(cache);
+    lv_cache_get_stats(cache, &stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.hit_cnt + stats.miss_cnt);
+
+    lv_cache_destroy(cache, NULL);
+}
+
+/*An image access trace of a dashboard screen refreshing at every frame:
+ *small icons drawn on every frame and a few large images shown only once*/
+#define TRACE_FRAME_CNT     100
+#define TRACE_CACHE_SIZE    (64 * 1024)
+
+typedef struct {
+    int32_t id;
+    uint32_t size;
+} trace_item_t;
+
+static const trace_item_t trace_frame[] = {
+    {1, 2 * 1024},      /*icon_bpm*/
+    {2, 2 * 1024},      /*icon_temp*/
+    {3, 2 * 1024},      /*icon_heart_beat*/
+    {4, 4 * 1024},      /*img_spo2_icons*/
+    {-1, 20 * 1024},    /*One-off images, different on every frame*/
+    {-1, 20 * 1024},
+    {-1, 20 * 1024},
+    {-1, 20 * 1024},
+};
+
+static void trace_replay(lv_cache_t * cache, lv_cache_stats_t * stats)
+{
+    int32_t one_off_id = 1000;
+    uint32_t frame;
+    for(frame = 0; frame < TRACE_FRAME_CNT; frame++) {
+        uint32_t i;
+        for(i = 0; i < sizeof(trace_frame) / sizeof(trace_frame[0]); i++) {
+            int32_t id = trace_frame[i].id >= 0 ? trace_frame[i].id : one_off_id++;
+            cache_access(cache, id, trace_frame[i].size);
+        }
+    }
+
+    lv_cache_get_stats(cache, stats);
+}
+
+void test_cache_s3fifo_trace_replay(void)
+{
+    lv_cache_t * lru = cache_create(&lv_cache_class_lru_rb_size, TRACE_CACHE_SIZE);
+    lv_cache_t * s3fifo = cache_create(&lv_cache_class_s3fifo_size, TRACE_CACHE_SIZE);
+
+    lv_cache_stats_t lru_stats;
+    lv_cache_stats_t s3fifo_stats;
+    trace_replay(lru, &lru_stats);
+    trace_replay(s3fifo, &s3fifo_stats);
+
+    uint32_t s3fifo_hit_pct = s3fifo_stats.hit_cnt * 100 / (s3fifo_stats.hit_cnt + s3fifo_stats.miss_cnt);
+    uint32_t s3fifo_byte_hit_pct = (uint32_t)(s3fifo_stats.hit_size * 100 /
+                                              (s3fifo_stats.hit_size + s3fifo_stats.miss_size));
+
+    /*The one-off images push out the icons from the LRU cache on every frame*/
+    TEST_ASSERT_EQUAL_UINT32(0, lru_stats.hit_cnt);
+
+    /*The icons stay in the S3-FIFO cache after the first frames. Half of the accesses are icons*/
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(45, s3fifo_hit_pct);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, s3fifo_byte_hit_pct);
+
+    lv_cache_destroy(lru, NULL);
+    lv_cache_destroy(s3fifo, NULL);
+}
+
+#endif
@@ -0,0 +1,239 @@
+#if LV_BUILD_TEST
+
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+typedef struct {
+    lv_cache_slot_size_t slot;
+    int32_t id;
+} test_data;
+
+static lv_cache_compare_res_t compare_cb(const test_data * lhs, const test_data * rhs)
+{
+    if(lhs->id != rhs->id) {
+        return lhs->id > rhs->id ? 1 : -1;
+    }
+    return 0;
+}
+
+static bool create_cb(test_data * node, void * user_data)
+{
+    LV_UNUSED(node);
+    LV_UNUSED(user_data);
+    return true;
+}
+
+static void free_cb(test_data * node, void * user_data)
+{
+    LV_UNUSED(node);
+    LV_UNUSED(user_data);
+}
+
+static uint32_t hash_cb(const test_data * key)
+{
+    return (uint32_t)key->id;
+}
+
+static lv_cache_t * cache_create(uint32_t max_size, uint32_t shard_cnt)
+{
+    lv_cache_ops_t ops = {
+        .compare_cb = (lv_cache_compare_cb_t)compare_cb,
+        .create_cb = (lv_cache_create_cb_t)create_cb,
+        .free_cb = (lv_cache_free_cb_t)free_cb,
+        .hash_cb = (lv_cache_hash_cb_t)hash_cb,
+    };
+    return lv_cache_create_sharded(&lv_cache_class_lru_rb_count, sizeof(test_data), max_size, ops, shard_cnt);
+}
+
+static void cache_access(lv_cache_t * cache, int32_t id)
+{
+    test_data key = {.id = id};
+    lv_cache_entry_t * entry = lv_cache_acquire_or_create(cache, &key, NULL);
+    TEST_ASSERT_NOT_NULL(entry);
+    lv_cache_release(cache, entry, NULL);
+}
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+void test_cache_sharded_add_drop(void)
+{
+    lv_cache_t * cache = cache_create(100, 4);
+    TEST_ASSERT_EQUAL_UINT32(4, cache->shard_cnt);
+
+    uint32_t i;
+    for(i = 0; i < 8; i++) cache_access(cache, (int32_t)i);
+    TEST_ASSERT_EQUAL(8, lv_cache_get_size(cache, NULL));
+    TEST_ASSERT_EQUAL(92, lv_cache_get_free_size(cache, NULL));
+
+    /*The entries are stored in the shards*/
+    test_data key = {.id = 5};
+    lv_cache_entry_t * entry = lv_cache_acquire(cache, &key, NULL);
+    TEST_ASSERT_NOT_NULL(entry);
+    const lv_cache_t * shard = lv_cache_entry_get_cache(entry);
+    TEST_ASSERT_NOT_EQUAL(cache, shard);
+    lv_cache_release(cache, entry, NULL);
+
+    lv_cache_drop(cache, &key, NULL);
+    TEST_ASSERT_NULL(lv_cache_acquire(cache, &key, NULL));
+    TEST_ASSERT_EQUAL(7, lv_cache_get_size(cache, NULL));
+
+    /*The budget is split between the shards*/
+    lv_cache_set_max_size(cache, 10, NULL);
+    TEST_ASSERT_EQUAL(10, lv_cache_get_max_size(cache, NULL));
+    size_t shard_max_sum = 0;
+    for(i = 0; i < cache->shard_cnt; i++) shard_max_sum += lv_cache_get_max_size(cache->shards[i], NULL);
+    TEST_ASSERT_EQUAL(10, shard_max_sum);
+
+    /*Never more than the budget*/
+    for(i = 100; i < 200; i++) cache_access(cache, (int32_t)i);
+    TEST_ASSERT_LESS_OR_EQUAL(10, lv_cache_get_size(cache, NULL));
+
+    size_t size = lv_cache_get_size(cache, NULL);
+    TEST_ASSERT_TRUE(lv_cache_evict_one(cache, NULL));
+    TEST_ASSERT_EQUAL(size - 1, lv_cache_get_size(cache, NULL));
+
+    lv_cache_drop_all(cache, NULL);
+    TEST_ASSERT_EQUAL(0, lv_cache_get_size(cache, NULL));
+    TEST_ASSERT_FALSE(lv_cache_evict_one(cache, NULL));
+
+    lv_cache_destroy(cache, NULL);
+}
+
+void test_cache_sharded_stats(void)
+{
+    lv_cache_t * cache = cache_create(100, 4);
+
+    uint32_t i;
+    for(i = 0; i < 16; i++) cache_access(cache, (int32_t)i);
+    for(i = 0; i < 16; i++) cache_access(cache, (int32_t)i);
+
+    lv_cache_stats_t stats;
+    lv_cache_get_stats(cache, &stats);
+    TEST_ASSERT_EQUAL_UINT32(16, stats.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(16, stats.miss_cnt);
+
+    lv_cache_reset_stats(cache);
+    lv_cache_get_stats(cache, &stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.hit_cnt + stats.miss_cnt);
+
+    lv_cache_destroy(cache, NULL);
+}
+
+void test_cache_sharded_fallback(void)
+{
+    /*A single shard or a missing hash function means a normal cache*/
+    lv_cache_t * cache = cache_create(10, 1);
+    TEST_ASSERT_EQUAL_UINT32(0, cache->shard_cnt);
+    cache_access(cache, 1);
+    TEST_ASSERT_EQUAL(1, lv_cache_get_size(cache, NULL));
+    lv_cache_destroy(cache, NULL);
+
+    lv_cache_ops_t ops = {
+        .compare_cb = (lv_cache_compare_cb_t)compare_cb,
+        .create_cb = (lv_cache_create_cb_t)create_cb,
+        .free_cb = (lv_cache_free_cb_t)free_cb,
+    };
+    cache = lv_cache_create_sharded(&lv_cache_class_lru_rb_count, sizeof(test_data), 10, ops, 4);
+    TEST_ASSERT_EQUAL_UINT32(0, cache->shard_cnt);
+    lv_cache_destroy(cache, NULL);
+}
+
+void test_cache_sharded_distribution(void)
+{
+    lv_cache_t * cache = cache_create(100, 4);
+
+    /*The keys are spread across all shards*/
+    uint32_t i;
+    for(i = 0; i < 64; i++) cache_access(cache, (int32_t)i);
+
+    size_t size_sum = 0;
+    for(i = 0; i < cache->shard_cnt; i++) {
+        size_t shard_size = lv_cache_get_size(cache->shards[i], NULL);
+        TEST_ASSERT_GREATER_THAN(0, shard_size);
+        size_sum += shard_size;
+    }
+    TEST_ASSERT_EQUAL(64, size_sum);
+
+    /*A key is always found in the same shard*/
+    for(i = 0; i < 64; i++) {
+        test_data key = {.id = (int32_t)i};
+        lv_cache_entry_t * entry = lv_cache_acquire(cache, &key, NULL);
+        TEST_ASSERT_NOT_NULL(entry);
+        lv_cache_t * shard = (lv_cache_t *)lv_cache_entry_get_cache(entry);
+        lv_cache_release(cache, entry, NULL);
+
+        lv_cache_entry_t * shard_entry = lv_cache_acquire(shard, &key, NULL);
+        TEST_ASSERT_EQUAL_PTR(entry, shard_entry);
+        lv_cache_release(shard, shard_entry, NULL);
+    }
+
+    lv_cache_destroy(cache, NULL);
+}
+
+#if LV_USE_OS == LV_OS_PTHREAD
+
+/*Draw threads looking up the same few hundred images like the draw units do*/
+#define THREAD_KEY_CNT      256
+#define THREAD_ACCESS_CNT   20000
+#define THREAD_CNT          4
+
+typedef struct {
+    lv_thread_t thread;
+    lv_cache_t * cache;
+    uint32_t seed;
+} access_thread_t;
+
+static void access_thread_cb(void * user_data)
+{
+    access_thread_t * t = user_data;
+    uint32_t seed = t->seed;
+    uint32_t i;
+    for(i = 0; i < THREAD_ACCESS_CNT; i++) {
+        seed = seed * 1103515245u + 12345u;
+        test_data key = {.id = (int32_t)((seed >> 16) % THREAD_KEY_CNT)};
+        lv_cache_entry_t * entry = lv_cache_acquire_or_create(t->cache, &key, NULL);
+        if(entry) lv_cache_release(t->cache, entry, NULL);
+    }
+}
+
+void test_cache_sharded_threads(void)
+{
+    lv_cache_t * cache = cache_create(THREAD_KEY_CNT / 2, 8);
+    access_thread_t threads[THREAD_CNT];
+
+    uint32_t i;
+    for(i = 0; i < THREAD_CNT; i++) {
+        threads[i].cache = cache;
+        threads[i].seed = i + 1;
+        lv_thread_init(&threads[i].thread, LV_THREAD_PRIO_MID, access_thread_cb, 64 * 1024, &threads[i]);
+    }
+    for(i = 0; i < THREAD_CNT; i++) lv_thread_delete(&threads[i].thread);
+
+    /*Every access is counted exactly once and the budget is kept while evicting concurrently*/
+    lv_cache_stats_t stats;
+    lv_cache_get_stats(cache, &stats);
+    TEST_ASSERT_EQUAL_UINT32(THREAD_CNT * THREAD_ACCESS_CNT, stats.hit_cnt + stats.miss_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL(THREAD_KEY_CNT / 2, lv_cache_get_size(cache, NULL));
+
+    lv_cache_destroy(cache, NULL);
+}
+
+#else
+
+void test_cache_sharded_threads(void)
+{
+}
+
+#endif /*LV_USE_OS == LV_OS_PTHREAD*/
+
+#endif
@@ -0,0 +1,357 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+#include "../../src/draw/sw/blend/lv_draw_sw_blend_to_argb8888.h"
+#include "../../src/draw/sw/blend/lv_draw_sw_blend_to_rgb565.h"
+#include "../../src/draw/sw/blend/lv_draw_sw_blend_to_rgb888.h"
+#include "../../src/draw/sw/blend/x86/lv_blend_x86.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86 && LV_BLEND_X86_SSE2
+
+/*Blend random pixels with the SIMD functions and compare them with the formulas of the C implementation*/
+
+#define MAX_W   37
+#define H       3
+
+static uint32_t rnd_state;
+static uint8_t dest[H * MAX_W * 4];
+static uint8_t dest_ref[H * MAX_W * 4];
+static uint8_t src[H * MAX_W * 4];
+static lv_opa_t mask[H * MAX_W];
+
+static const lv_opa_t opa_values[] = {LV_OPA_COVER, 254, 253, 200, 128, 3, 2, 1};
+
+void setUp(void)
+{
+    rnd_state = 1234;
+    lv_blend_x86_set_avx2(true);
+}
+
+void tearDown(void)
+{
+    lv_blend_x86_set_avx2(true);
+}
+
+static uint8_t rnd(void)
+{
+    rnd_state = rnd_state * 1103515245 + 12345;
+    return (uint8_t)(rnd_state >> 16);
+}
+
+/*Often use the special 0, 1, 2, 253, 254 and 255 values*/
+static uint8_t rnd_opa(void)
+{
+    uint8_t r = rnd();
+    if(r < 40) return 255;
+    if(r < 70) return 0;
+    if(r < 100) return opa_values[rnd() % sizeof(opa_values)];
+    return rnd();
+}
+
+static void fill_random(uint8_t * buf, uint32_t size, bool has_alpha)
+{
+    uint32_t i;
+    for(i = 0; i < size; i++) {
+        buf[i] = (has_alpha && i % 4 == 3) ? rnd_opa() : rnd();
+    }
+}
+
+static void init_buffers(void)
+{
+    fill_random(dest, sizeof(dest), true);
+    fill_random(src, sizeof(src), true);
+    uint32_t i;
+    for(i = 0; i < sizeof(mask); i++) mask[i] = rnd_opa();
+    lv_memcpy(dest_ref, dest, sizeof(dest));
+}
+
+static lv_color32_t color_32_32_mix(lv_color32_t fg, lv_color32_t bg)
+{
+    if(fg.alpha >= LV_OPA_MAX || bg.alpha <= LV_OPA_MIN) return fg;
+    if(fg.alpha <= LV_OPA_MIN) return bg;
+    if(bg.alpha == 255) return lv_color_mix32(fg, bg);
+
+    lv_opa_t res_alpha = 255 - LV_OPA_MIX2(255 - fg.alpha, 255 - bg.alpha);
+    fg.alpha = (uint32_t)((uint32_t)fg.alpha * 255) / res_alpha;
+    lv_color32_t res = lv_color_mix32(fg, bg);
+    res.alpha = res_alpha;
+    return res;
+}
+
+static uint16_t color_24_16_mix(const uint8_t * c1, uint16_t c2, uint8_t mix)
+{
+    if(mix == 0) return c2;
+    if(mix == 255) return ((c1[2] & 0xF8) << 8)  + ((c1[1] & 0xFC) << 3) + ((c1[0] & 0xF8) >> 3);
+
+    lv_opa_t mix_inv = 255 - mix;
+    return ((((c1[2] >> 3) * mix + ((c2 >> 11) & 0x1F) * mix_inv) << 3) & 0xF800) +
+           ((((c1[1] >> 2) * mix + ((c2 >> 5) & 0x3F) * mix_inv) >> 3) & 0x07E0) +
+           (((c1[0] >> 3) * mix + (c2 & 0x1F) * mix_inv) >> 8);
+}
+
+static void color_24_24_mix(const uint8_t * c1, uint8_t * dest_px, uint8_t mix)
+{
+    if(mix == 0) return;
+
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        if(mix >= LV_OPA_MAX) dest_px[i] = c1[i];
+        else dest_px[i] = (uint32_t)((uint32_t)c1[i] * mix + dest_px[i] * (255 - mix)) >> 8;
+    }
+}
+
+static lv_opa_t px_opa(lv_opa_t src_a, bool use_src_a, const lv_opa_t * mask_px, lv_opa_t opa)
+{
+    if(use_src_a) {
+        if(mask_px && opa < LV_OPA_MAX) return LV_OPA_MIX3(src_a, *mask_px, opa);
+        if(mask_px) return LV_OPA_MIX2(src_a, *mask_px);
+        if(opa < LV_OPA_MAX) return LV_OPA_MIX2(src_a, opa);
+        return src_a;
+    }
+
+    if(mask_px && opa < LV_OPA_MAX) return LV_OPA_MIX2(*mask_px, opa);
+    if(mask_px) return *mask_px;
+    return opa;
+}
+
+static void init_fill_dsc(lv_draw_sw_blend_fill_dsc_t * dsc, int32_t w, uint32_t px_size, bool use_mask, lv_opa_t opa)
+{
+    lv_memzero(dsc, sizeof(*dsc));
+    dsc->dest_buf = dest;
+    dsc->dest_w = w;
+    dsc->dest_h = H;
+    dsc->dest_stride = MAX_W * px_size;
+    dsc->mask_buf = use_mask ? mask : NULL;
+    dsc->mask_stride = MAX_W;
+    dsc->color = lv_color_make(rnd(), rnd(), rnd());
+    dsc->opa = opa;
+}
+
+static void init_image_dsc(lv_draw_sw_blend_image_dsc_t * dsc, int32_t w, uint32_t dest_px_size,
+                           lv_color_format_t src_cf, bool use_mask, lv_opa_t opa)
+{
+    lv_memzero(dsc, sizeof(*dsc));
+    dsc->dest_buf = dest;
+    dsc->dest_w = w;
+    dsc->dest_h = H;
+    dsc->dest_stride = MAX_W * dest_px_size;
+    dsc->mask_buf = use_mask ? mask : NULL;
+    dsc->mask_stride = MAX_W;
+    dsc->src_buf = src;
+    dsc->src_stride = MAX_W * lv_color_format_get_size(src_cf);
+    dsc->src_color_format = src_cf;
+    dsc->opa = opa;
+    dsc->blend_mode = LV_BLEND_MODE_NORMAL;
+}
+
+static void assert_dest(const char * msg)
+{
+    TEST_ASSERT_EQUAL_MEMORY_MESSAGE(dest_ref, dest, sizeof(dest), msg);
+}
+
+static void test_color_to_argb8888(int32_t w, bool use_mask, lv_opa_t opa)
+{
+    lv_draw_sw_blend_fill_dsc_t dsc;
+    init_buffers();
+    init_fill_dsc(&dsc, w, 4, use_mask, opa);
+    lv_draw_sw_blend_color_to_argb8888(&dsc);
+
+    int32_t x, y;
+    for(y = 0; y < H; y++) {
+        for(x = 0; x < w; x++) {
+            lv_color32_t * d = (lv_color32_t *)&dest_ref[(y * MAX_W + x) * 4];
+            lv_color32_t fg = lv_color_to_32(dsc.color, 0xff);
+            if(use_mask || opa < LV_OPA_MAX) fg.alpha = px_opa(0, false, use_mask ? &mask[y * MAX_W + x] : NULL, opa);
+            *d = color_32_32_mix(fg, *d);
+        }
+    }
+    assert_dest("color to ARGB8888");
+}
+
+static void test_image_to_argb8888(int32_t w, lv_color_format_t src_cf, bool use_mask, lv_opa_t opa)
+{
+    lv_draw_sw_blend_image_dsc_t dsc;
+    init_buffers();
+    init_image_dsc(&dsc, w, 4, src_cf, use_mask, opa);
+    lv_draw_sw_blend_image_to_argb8888(&dsc);
+
+    uint32_t src_px_size = lv_color_format_get_size(src_cf);
+    int32_t x, y;
+    for(y = 0; y < H; y++) {
+        for(x = 0; x < w; x++) {
+            lv_color32_t * d = (lv_color32_t *)&dest_ref[(y * MAX_W + x) * 4];
+            const uint8_t * s = &src[y * dsc.src_stride + x * src_px_size];
+            const lv_opa_t * m = use_mask ? &mask[y * MAX_W + x] : NULL;
+            lv_color32_t fg;
+            if(src_cf == LV_COLOR_FORMAT_RGB565) {
+                uint16_t c = s[0] | (s[1] << 8);
+                fg.red = ((c >> 11) * 2106) >> 8;
+                fg.green = (((c >> 5) & 0x3F) * 1037) >> 8;
+                fg.blue = ((c & 0x1F) * 2106) >> 8;
+                fg.alpha = px_opa(0, false, m, opa);
+            }
+            else {
+                fg.blue = s[0];
+                fg.green = s[1];
+                fg.red = s[2];
+                if(src_cf == LV_COLOR_FORMAT_ARGB8888) fg.alpha = px_opa(s[3], true, m, opa);
+                else if(m || opa < LV_OPA_MAX) fg.alpha = px_opa(0, false, m, opa);
+                else fg.alpha = src_cf == LV_COLOR_FORMAT_RGB888 ? 0xff : s[3];
+            }
+
+            if(src_cf == LV_COLOR_FORMAT_XRGB8888 && m == NULL && opa >= LV_OPA_MAX) *d = fg;
+            else *d = color_32_32_mix(fg, *d);
+        }
+    }
+    assert_dest("image to ARGB8888");
+}
+
+static void test_color_to_rgb565(int32_t w, bool use_mask, lv_opa_t opa)
+{
+    lv_draw_sw_blend_fill_dsc_t dsc;
+    init_buffers();
+    init_fill_dsc(&dsc, w, 2, use_mask, opa);
+    lv_draw_sw_blend_color_to_rgb565(&dsc);
+
+    uint16_t c = lv_color_to_u16(dsc.color);
+    int32_t x, y;
+    for(y = 0; y < H; y++) {
+        for(x = 0; x < w; x++) {
+            uint16_t * d = (uint16_t *)&dest_ref[(y * MAX_W + x) * 2];
+            lv_opa_t mix = px_opa(0, false, use_mask ? &mask[y * MAX_W + x] : NULL, opa);
+            *d = mix >= LV_OPA_MAX && !use_mask ? c : lv_color_16_16_mix(c, *d, mix);
+        }
+    }
+    assert_dest("color to RGB565");
+}
+
+static void test_image_to_rgb565(int32_t w, lv_color_format_t src_cf, bool use_mask, lv_opa_t opa)
+{
+    lv_draw_sw_blend_image_dsc_t dsc;
+    init_buffers();
+    init_image_dsc(&dsc, w, 2, src_cf, use_mask, opa);
+    lv_draw_sw_blend_image_to_rgb565(&dsc);
+
+    uint32_t src_px_size = lv_color_format_get_size(src_cf);
+    int32_t x, y;
+    for(y = 0; y < H; y++) {
+        for(x = 0; x < w; x++) {
+            uint16_t * d = (uint16_t *)&dest_ref[(y * MAX_W + x) * 2];
+            const uint8_t * s = &src[y * dsc.src_stride + x * src_px_size];
+            const lv_opa_t * m = use_mask ? &mask[y * MAX_W + x] : NULL;
+            if(src_cf == LV_COLOR_FORMAT_RGB565) {
+                uint16_t c = s[0] | (s[1] << 8);
+                if(m == NULL && opa >= LV_OPA_MAX) *d = c;
+                else *d = lv_color_16_16_mix(c, *d, px_opa(0, false, m, opa));
+            }
+            else {
+                *d = color_24_16_mix(s, *d, px_opa(s[3], true, m, opa));
+            }
+        }
+    }
+    assert_dest("image to RGB565");
+}
+
+static void test_to_rgb888(int32_t w, uint32_t dest_px_size, bool image, bool use_mask, lv_opa_t opa)
+{
+    init_buffers();
+    lv_draw_sw_blend_fill_dsc_t fill_dsc;
+    lv_draw_sw_blend_image_dsc_t image_dsc;
+    uint8_t color[4] = {0};
+    if(image) {
+        init_image_dsc(&image_dsc, w, dest_px_size, LV_COLOR_FORMAT_ARGB8888, use_mask, opa);
+        lv_draw_sw_blend_image_to_rgb888(&image_dsc, dest_px_size);
+    }
+    else {
+        init_fill_dsc(&fill_dsc, w, dest_px_size, use_mask, opa);
+        lv_draw_sw_blend_color_to_rgb888(&fill_dsc, dest_px_size);
+        color[0] = fill_dsc.color.blue;
+        color[1] = fill_dsc.color.green;
+        color[2] = fill_dsc.color.red;
+        color[3] = 0xff;
+    }
+
+    int32_t x, y;
+    for(y = 0; y < H; y++) {
+        for(x = 0; x < w; x++) {
+            uint8_t * d = &dest_ref[y * MAX_W * dest_px_size + x * dest_px_size];
+            const lv_opa_t * m = use_mask ? &mask[y * MAX_W + x] : NULL;
+            if(image) {
+                const uint8_t * s = &src[(y * MAX_W + x) * 4];
+                color_24_24_mix(s, d, px_opa(s[3], true, m, opa));
+            }
+            else if(m == NULL && opa >= LV_OPA_MAX) {
+                lv_memcpy(d, color, dest_px_size);
+            }
+            else {
+                color_24_24_mix(color, d, px_opa(0, false, m, opa));
+            }
+        }
+    }
+    assert_dest(image ? "image to RGB888" : "color to RGB888");
+}
+
+static void test_all_cases(void)
+{
+    static const lv_color_format_t argb8888_srcs[] = {
+        LV_COLOR_FORMAT_RGB565, LV_COLOR_FORMAT_RGB888, LV_COLOR_FORMAT_XRGB8888, LV_COLOR_FORMAT_ARGB8888
+    };
+    int32_t w;
+    uint32_t i;
+    uint32_t cf;
+    for(w = 1; w <= MAX_W; w++) {
+        for(i = 0; i < sizeof(opa_values); i++) {
+            lv_opa_t opa = opa_values[i];
+            uint32_t use_mask;
+            for(use_mask = 0; use_mask < 2; use_mask++) {
+                test_color_to_argb8888(w, use_mask, opa);
+                for(cf = 0; cf < sizeof(argb8888_srcs) / sizeof(argb8888_srcs[0]); cf++) {
+                    test_image_to_argb8888(w, argb8888_srcs[cf], use_mask, opa);
+                }
+                test_color_to_rgb565(w, use_mask, opa);
+                test_image_to_rgb565(w, LV_COLOR_FORMAT_RGB565, use_mask, opa);
+                test_image_to_rgb565(w, LV_COLOR_FORMAT_ARGB8888, use_mask, opa);
+                test_to_rgb888(w, 3, false, use_mask, opa);
+                test_to_rgb888(w, 4, false, use_mask, opa);
+                test_to_rgb888(w, 4, true, use_mask, opa);
+            }
+        }
+    }
+}
+
+void test_blend_x86_sse2(void)
+{
+    lv_blend_x86_set_avx2(false);
+    TEST_ASSERT_FALSE(lv_blend_x86_has_avx2());
+    test_all_cases();
+}
+
+void test_blend_x86_avx2(void)
+{
+    if(!lv_blend_x86_has_avx2()) TEST_IGNORE_MESSAGE("AVX2 is not supported by the CPU");
+    test_all_cases();
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_blend_x86_sse2(void)
+{
+}
+
+void test_blend_x86_avx2(void)
+{
+}
+
+#endif
+
+#endif
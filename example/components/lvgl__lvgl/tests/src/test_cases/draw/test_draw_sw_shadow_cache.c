@@ -0,0 +1,133 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#define REF_W   200
+#define REF_H   100
+
+#define SHADOW_CACHE    LV_GLOBAL_DEFAULT()->sw_shadow_cache.cache
+
+static uint8_t ref_img[REF_H * REF_W * 4];
+
+void setUp(void)
+{
+    /*Start from an empty cache*/
+    lv_draw_sw_shadow_cache_resize(0);
+    lv_draw_sw_shadow_cache_resize(LV_DRAW_SW_SHADOW_CACHE_MEM_SIZE);
+    lv_cache_reset_stats(SHADOW_CACHE);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+static lv_obj_t * shadow_obj_create(int32_t x, int32_t y, int32_t w, int32_t h, int32_t shadow_w, int32_t radius)
+{
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_pos(obj, x, y);
+    lv_obj_set_size(obj, w, h);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(obj, lv_color_white(), 0);
+    lv_obj_set_style_radius(obj, radius, 0);
+    lv_obj_set_style_shadow_width(obj, shadow_w, 0);
+    lv_obj_set_style_shadow_opa(obj, LV_OPA_COVER, 0);
+    return obj;
+}
+
+static void refresh(void)
+{
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+}
+
+static void save_ref(void)
+{
+    lv_draw_buf_t * buf = lv_display_get_buf_active(NULL);
+    int32_t y;
+    for(y = 0; y < REF_H; y++) {
+        lv_memcpy(&ref_img[y * REF_W * 4], lv_draw_buf_goto_xy(buf, 0, y), REF_W * 4);
+    }
+}
+
+static void assert_ref(void)
+{
+    lv_draw_buf_t * buf = lv_display_get_buf_active(NULL);
+    int32_t y;
+    for(y = 0; y < REF_H; y++) {
+        TEST_ASSERT_EQUAL_MEMORY(&ref_img[y * REF_W * 4], lv_draw_buf_goto_xy(buf, 0, y), REF_W * 4);
+    }
+}
+
+void test_shadow_cache_multiple_entries(void)
+{
+    /*Two different shadows shouldn't evict each other*/
+    shadow_obj_create(10, 10, 60, 40, 4, 3);
+    shadow_obj_create(100, 10, 60, 40, 5, 1);
+
+    lv_cache_stats_t stats;
+    refresh();
+    lv_cache_get_stats(SHADOW_CACHE, &stats);
+    TEST_ASSERT_EQUAL(0, stats.hit_cnt);
+    TEST_ASSERT_EQUAL(2, stats.miss_cnt);
+    save_ref();
+
+    refresh();
+    lv_cache_get_stats(SHADOW_CACHE, &stats);
+    TEST_ASSERT_EQUAL(2, stats.hit_cnt);
+    TEST_ASSERT_EQUAL(2, stats.miss_cnt);
+    assert_ref();
+
+    lv_cache_reset_stats(SHADOW_CACHE);
+    lv_cache_get_stats(SHADOW_CACHE, &stats);
+    TEST_ASSERT_EQUAL(0, stats.hit_cnt);
+    TEST_ASSERT_EQUAL(0, stats.miss_cnt);
+}
+
+void test_shadow_cache_small_rect(void)
+{
+    /*The size of small rectangles is visible on the corners so they can't share the cached corner*/
+    shadow_obj_create(10, 10, 4, 4, 6, 2);
+    shadow_obj_create(40, 10, 6, 5, 6, 2);
+    shadow_obj_create(70, 10, 60, 40, 6, 2);
+    shadow_obj_create(140, 10, 50, 70, 6, 2);
+
+    lv_draw_sw_shadow_cache_resize(0);
+    refresh();
+    save_ref();
+
+    lv_draw_sw_shadow_cache_resize(LV_DRAW_SW_SHADOW_CACHE_MEM_SIZE);
+    lv_cache_reset_stats(SHADOW_CACHE);
+    refresh();
+    assert_ref();
+    refresh();
+    assert_ref();
+
+    /*The 2 large rectangles use the same corner*/
+    lv_cache_stats_t stats;
+    lv_cache_get_stats(SHADOW_CACHE, &stats);
+    TEST_ASSERT_EQUAL(5, stats.hit_cnt);
+    TEST_ASSERT_EQUAL(3, stats.miss_cnt);
+}
+
+void test_shadow_cache_budget(void)
+{
+    /*Only one corner fits*/
+    lv_draw_sw_shadow_cache_resize(8 * 8);
+    shadow_obj_create(10, 10, 60, 40, 4, 3);
+    shadow_obj_create(100, 10, 60, 40, 5, 1);
+
+    refresh();
+    refresh();
+
+    lv_cache_stats_t stats;
+    lv_cache_get_stats(SHADOW_CACHE, &stats);
+    TEST_ASSERT_EQUAL(0, stats.hit_cnt);
+    TEST_ASSERT_EQUAL(4, stats.miss_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL(8 * 8, lv_cache_get_size(SHADOW_CACHE, NULL));
+}
+
+#endif
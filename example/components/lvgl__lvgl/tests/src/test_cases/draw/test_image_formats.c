@@ -255,15 +255,15 @@ static void img_create(const char * name, const void * img_src, bool rotate, boo
     lv_label_set_text(label, name);
 }
 
-static void bin_image_create(bool rotate, bool recolor, int align, int compress)
+static void bin_image_create(char letter, bool rotate, bool recolor, int align, int compress)
 {
     char name[32];
     char path[256];
     int stride = stride_align[align];
     for(unsigned i = 0; i < sizeof(color_formats) / sizeof(color_formats[0]); i++) {
         lv_snprintf(name, sizeof(name), "bin%s", color_formats[i]);
-        lv_snprintf(path, sizeof(path), "A:test_images/stride_align%d/%s/test_%s.bin", stride, compressions[compress],
-                    color_formats[i]);
+        lv_snprintf(path, sizeof(path), "%c:test_images/stride_align%d/%s/test_%s.bin", letter, stride,
+                    compressions[compress], color_formats[i]);
         img_create(name, path, rotate, recolor);
     }
 }
@@ -291,7 +291,7 @@ void test_image_formats(void)
             /*Loop compressions array and do test.*/
             for(unsigned i = 0; i < sizeof(compressions) / sizeof(compressions[0]); i++) {
                 char reference[256];
-                bin_image_create(rotate, recolor, align, i);
+                bin_image_create('A', rotate, recolor, align, i);
                 lv_snprintf(reference, sizeof(reference), "draw/bin_image_stride%d_%s_%s.png", stride, compressions[i], modes[mode]);
                 TEST_ASSERT_EQUAL_SCREENSHOT(reference);
                 lv_obj_clean(lv_screen_active());
@@ -306,4 +306,24 @@ void test_image_formats(void)
     }
 }
 
+void test_image_formats_mapped(void)
+{
+    /*'B' maps the files to the memory, the uncompressed images are drawn from there*/
+    for(unsigned align = 0; align <= 1; align++) {
+        int stride = stride_align[align];
+        for(unsigned mode = 0; mode <= 3; mode++) {
+            bool rotate = mode & 0x02;
+            bool recolor = mode & 0x01;
+#if LV_BIN_DECODER_RAM_LOAD == 0
+            if(rotate) continue;  /* Transform relies on LV_BIN_DECODER_RAM_LOAD to be enabled */
+#endif
+            char reference[256];
+            bin_image_create('B', rotate, recolor, align, 0);
+            lv_snprintf(reference, sizeof(reference), "draw/bin_image_stride%d_UNCOMPRESSED_%s.png", stride, modes[mode]);
+            TEST_ASSERT_EQUAL_SCREENSHOT(reference);
+            lv_obj_clean(lv_screen_active());
+        }
+    }
+}
+
 #endif
@@ -3,6 +3,9 @@
 #include "../../lvgl_private.h"
 
 #include "unity/unity.h"
+#include "lv_test_helpers.h"
+
+#include <stdio.h>
 
 void setUp(void)
 {
@@ -89,4 +92,186 @@ void test_bin_decoder_argb8888_tile(void)
     bin_decoder_tile(&test_image_cogwheel_argb8888, "libs/bin_decoder_4.png");
 }
 
+void test_bin_decoder_mapped(void)
+{
+    /*Save the image as a .bin file on 'B' which maps the files to the memory*/
+    LV_IMAGE_DECLARE(test_image_cogwheel_argb8888);
+    const char * path = "B:bin_decoder_mapped.bin";
+    lv_image_header_t header = test_image_cogwheel_argb8888.header;
+    header.magic = LV_IMAGE_HEADER_MAGIC;
+
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, path, LV_FS_MODE_WR));
+    lv_fs_write(&f, &header, sizeof(header), NULL);
+    lv_fs_write(&f, test_image_cogwheel_argb8888.data, test_image_cogwheel_argb8888.data_size, NULL);
+    lv_fs_close(&f);
+
+    /*The pixels are used from the file without copying them*/
+    lv_image_decoder_dsc_t dsc;
+    lv_image_decoder_args_t args = {.no_cache = true};
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, path, &args));
+    TEST_ASSERT_FALSE(lv_draw_buf_has_flag((lv_draw_buf_t *)dsc.decoded, LV_IMAGE_FLAGS_ALLOCATED));
+    TEST_ASSERT_EQUAL_MEMORY(test_image_cogwheel_argb8888.data, dsc.decoded->data, test_image_cogwheel_argb8888.data_size);
+    lv_image_decoder_close(&dsc);
+
+    bin_decoder(path, "libs/bin_decoder_3.png");
+
+    remove(path + 2);
+}
+
+
+#if LV_USE_LZ4_INTERNAL
+
+#define ROW_BLOCK_H     16
+
+static void save_image(const lv_image_dsc_t * img, const char * path)
+{
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, path, LV_FS_MODE_WR));
+    lv_fs_write(&f, &img->header, sizeof(img->header), NULL);
+    lv_fs_write(&f, img->data, img->data_size, NULL);
+    lv_fs_close(&f);
+}
+
+/*Check that only the blocks intersecting the clip area are decompressed and they are correct*/
+static void check_row_blocks(const lv_image_dsc_t * ref, const void * src)
+{
+    lv_image_decoder_dsc_t dsc;
+    lv_image_decoder_args_t args = {.no_cache = true, .partial = true};
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, src, &args));
+    TEST_ASSERT_NULL(dsc.decoded);
+
+    const lv_image_header_t * header = &ref->header;
+    lv_area_t full_area = {0, 40, header->w - 1, 60};
+    lv_area_t decoded_area = {LV_COORD_MIN, LV_COORD_MIN, LV_COORD_MIN, LV_COORD_MIN};
+    int32_t y = 32;
+    while(lv_image_decoder_get_area(&dsc, &full_area, &decoded_area) == LV_RESULT_OK) {
+        int32_t rows = LV_MIN(ROW_BLOCK_H, (int32_t)header->h - y);
+        TEST_ASSERT_EQUAL_INT32(y, decoded_area.y1);
+        TEST_ASSERT_EQUAL_INT32(y + rows - 1, decoded_area.y2);
+        TEST_ASSERT_EQUAL_INT32(rows, dsc.decoded->header.h);
+
+        const uint8_t * data = dsc.decoded->data;
+        TEST_ASSERT_EQUAL_MEMORY(ref->data + y * header->stride, data, rows * header->stride);
+        if(header->cf == LV_COLOR_FORMAT_RGB565A8) {
+            uint32_t stride_a8 = header->stride / 2;
+            TEST_ASSERT_EQUAL_MEMORY(ref->data + header->h * header->stride + y * stride_a8,
+                                     data + rows * header->stride, rows * stride_a8);
+        }
+        y += ROW_BLOCK_H;
+    }
+    TEST_ASSERT_EQUAL_INT32(64, y);
+    lv_image_decoder_close(&dsc);
+
+#if LV_BIN_DECODER_RAM_LOAD
+    /*Decompressed entirely if the parts can't be drawn*/
+    args.partial = false;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, src, &args));
+    TEST_ASSERT_NOT_NULL(dsc.decoded);
+    TEST_ASSERT_EQUAL_MEMORY(ref->data, dsc.decoded->data, ref->data_size);
+    lv_image_decoder_close(&dsc);
+#endif
+}
+
+void test_bin_decoder_lz4_rows(void)
+{
+    LV_IMAGE_DECLARE(test_image_cogwheel_argb8888);
+    LV_IMAGE_DECLARE(test_image_cogwheel_rgb565a8);
+    const char * path = "B:bin_decoder_lz4_rows.bin";
+    const char * path_rgb565a8 = "B:bin_decoder_lz4_rows_rgb565a8.bin";
+
+    lv_image_dsc_t img;
+    lv_test_image_compress_lz4_rows(&test_image_cogwheel_rgb565a8, &img, ROW_BLOCK_H);
+    check_row_blocks(&test_image_cogwheel_rgb565a8, &img);
+    save_image(&img, path_rgb565a8);
+    check_row_blocks(&test_image_cogwheel_rgb565a8, path_rgb565a8);
+    lv_free((void *)img.data);
+
+    lv_test_image_compress_lz4_rows(&test_image_cogwheel_argb8888, &img, ROW_BLOCK_H);
+    check_row_blocks(&test_image_cogwheel_argb8888, &img);
+    save_image(&img, path);
+    check_row_blocks(&test_image_cogwheel_argb8888, path);
+#if LV_BIN_DECODER_RAM_LOAD
+    /*Decompressed entirely as the stride is not aligned to LV_DRAW_BUF_STRIDE_ALIGN*/
+    bin_decoder(&img, "libs/bin_decoder_3.png");
+    bin_decoder(path, "libs/bin_decoder_3.png");
+#endif
+    lv_free((void *)img.data);
+
+    /*Without the drive letter*/
+    remove(path + 2);
+    remove(path_rgb565a8 + 2);
+}
+
+/*Decode a 16 px high band. The blocks outside of it are corrupted so decompressing any of them fails*/
+static void check_row_blocks_band(const lv_image_dsc_t * ref, const void * src)
+{
+    lv_image_decoder_args_t args = {.no_cache = true, .partial = true};
+    lv_image_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, src, &args));
+
+    const lv_image_header_t * header = &ref->header;
+    lv_area_t full_area = {0, 40, header->w - 1, 55};
+    lv_area_t decoded_area = {LV_COORD_MIN, LV_COORD_MIN, LV_COORD_MIN, LV_COORD_MIN};
+    uint32_t block_cnt = 0;
+    while(lv_image_decoder_get_area(&dsc, &full_area, &decoded_area) == LV_RESULT_OK) {
+        int32_t rows = lv_area_get_height(&decoded_area);
+        TEST_ASSERT_EQUAL_MEMORY(ref->data + decoded_area.y1 * header->stride, dsc.decoded->data, rows * header->stride);
+        block_cnt++;
+    }
+    TEST_ASSERT_EQUAL_INT32(48, decoded_area.y1);
+    TEST_ASSERT_EQUAL_UINT32(2, block_cnt);
+    lv_image_decoder_close(&dsc);
+}
+
+void test_bin_decoder_lz4_rows_band(void)
+{
+    LV_IMAGE_DECLARE(test_image_cogwheel_argb8888);
+    const lv_image_dsc_t * ref = &test_image_cogwheel_argb8888;
+    const char * path = "B:bin_decoder_lz4_rows_band.bin";
+    lv_image_dsc_t img;
+    lv_test_image_compress_lz4_rows(ref, &img, ROW_BLOCK_H);
+    TEST_ASSERT_LESS_THAN_UINT32(ref->data_size, img.data_size);
+
+    lv_image_decoder_args_t args = {.no_cache = true};
+    lv_image_decoder_dsc_t dsc;
+#if LV_BIN_DECODER_RAM_LOAD
+    /*Round trip of the whole image*/
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, &img, &args));
+    TEST_ASSERT_EQUAL_MEMORY(ref->data, dsc.decoded->data, ref->data_size);
+    lv_image_decoder_close(&dsc);
+#endif
+
+    /*Corrupt all blocks except the 2nd and 3rd which hold the rows 32..63*/
+    uint32_t block_cnt = (ref->header.h + ROW_BLOCK_H - 1) / ROW_BLOCK_H;
+    const uint32_t * table = (const uint32_t *)(img.data + 16);
+    uint8_t * blocks = (uint8_t *)img.data + 16 + (block_cnt + 1) * sizeof(uint32_t);
+    uint32_t i;
+    for(i = 0; i < block_cnt; i++) {
+        if(i == 2 || i == 3) continue;
+        lv_memset(blocks + table[i], 0xFF, table[i + 1] - table[i]);
+    }
+
+    /*Decoding the whole image fails now*/
+    TEST_ASSERT_NOT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, &img, &args));
+
+    check_row_blocks_band(ref, &img);
+    save_image(&img, path);
+    check_row_blocks_band(ref, path);
+    lv_free((void *)img.data);
+    remove(path + 2);
+}
+
+#else
+
+void test_bin_decoder_lz4_rows(void)
+{
+}
+
+void test_bin_decoder_lz4_rows_band(void)
+{
+}
+
+#endif /*LV_USE_LZ4_INTERNAL*/
+
 #endif
@@ -0,0 +1,179 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+
+#include <unistd.h>
+
+#define TEST_GIF_PATH   "A:src/test_assets/test_img_bulb.gif"
+
+static lv_obj_t * gif_obj;
+static gd_GIF * ref;
+
+void setUp(void)
+{
+    gif_obj = lv_gif_create(lv_screen_active());
+    lv_obj_set_pos(gif_obj, 30, 20);
+
+    /*The same GIF decoded directly for reference*/
+    ref = gd_open_gif_file(TEST_GIF_PATH);
+    TEST_ASSERT_NOT_NULL(ref);
+}
+
+void tearDown(void)
+{
+    gd_close_gif(ref);
+    lv_obj_clean(lv_screen_active());
+}
+
+static void ref_next_frame(void)
+{
+    gd_get_frame(ref);
+    gd_render_frame(ref, ref->canvas);
+}
+
+/*Run only the timer of the GIF to see what it invalidates*/
+static void run_gif_timer(void)
+{
+    lv_gif_t * gifobj = (lv_gif_t *)gif_obj;
+    gifobj->timer->timer_cb(gifobj->timer);
+}
+
+static void assert_frame_equal(void)
+{
+    lv_gif_t * gifobj = (lv_gif_t *)gif_obj;
+    TEST_ASSERT_EQUAL_MEMORY(ref->canvas, gifobj->imgdsc.data, ref->width * ref->height * 4);
+}
+
+void test_gif_frames(void)
+{
+    lv_gif_set_src(gif_obj, TEST_GIF_PATH);
+    TEST_ASSERT_TRUE(lv_gif_is_loaded(gif_obj));
+    lv_refr_now(NULL);
+
+    ref_next_frame();
+    assert_frame_equal();
+
+    /*Play it more than once to cover the wrap around*/
+    lv_display_t * disp = lv_display_get_default();
+    uint32_t i;
+    for(i = 0; i < 150; i++) {
+        lv_area_t prev_area;
+        lv_area_set(&prev_area, ref->fx, ref->fy, ref->fx + ref->fw - 1, ref->fy + ref->fh - 1);
+        uint32_t delay = ref->gce.delay * 10;
+
+#if LV_GIF_DECODE_AHEAD
+        /*The next frame is decoded in the background meanwhile*/
+        lv_gif_t * gifobj = (lv_gif_t *)gif_obj;
+        uint32_t t;
+        for(t = 0; t < 1000 && gifobj->next_state != LV_GIF_NEXT_READY; t++) usleep(1000);
+        TEST_ASSERT_EQUAL(LV_GIF_NEXT_READY, gifobj->next_state);
+#endif
+
+        lv_tick_inc(delay);
+        run_gif_timer();
+        ref_next_frame();
+        assert_frame_equal();
+
+        /*Only the area of the previous and the new frame is redrawn*/
+        lv_area_t frame_area;
+        lv_area_set(&frame_area, ref->fx, ref->fy, ref->fx + ref->fw - 1, ref->fy + ref->fh - 1);
+        lv_area_join(&frame_area, &frame_area, &prev_area);
+        lv_area_move(&frame_area, gif_obj->coords.x1, gif_obj->coords.y1);
+
+        /*Rounded up by a pixel when invalidated*/
+        lv_area_t frame_area_max = frame_area;
+        lv_area_increase(&frame_area_max, 1, 1);
+        TEST_ASSERT_EQUAL_UINT32(1, disp->inv_p);
+        TEST_ASSERT_TRUE(lv_area_is_in(&frame_area, &disp->inv_areas[0], 0));
+        TEST_ASSERT_TRUE(lv_area_is_in(&disp->inv_areas[0], &frame_area_max, 0));
+
+        lv_refr_now(NULL);
+    }
+}
+
+void test_gif_invalidate_transformed(void)
+{
+    lv_gif_set_src(gif_obj, TEST_GIF_PATH);
+    lv_image_set_scale(gif_obj, 512);
+    lv_refr_now(NULL);
+
+    /*A scaled image is invalidated entirely*/
+    lv_tick_inc(ref->gce.delay * 10 + 1000);
+    run_gif_timer();
+
+    lv_display_t * disp = lv_display_get_default();
+    lv_area_t obj_area;
+    lv_obj_get_coords(gif_obj, &obj_area);
+    TEST_ASSERT_EQUAL_UINT32(1, disp->inv_p);
+    TEST_ASSERT_TRUE(lv_area_is_in(&obj_area, &disp->inv_areas[0], 0));
+}
+
+void test_gif_change_src(void)
+{
+    /*Changing the source and deleting the object while a frame is decoded ahead*/
+    uint32_t i;
+    for(i = 0; i < 10; i++) {
+        lv_gif_set_src(gif_obj, TEST_GIF_PATH);
+        lv_tick_inc(400);
+        lv_timer_handler();
+        lv_gif_restart(gif_obj);
+        lv_gif_set_loop_count(gif_obj, 2);
+    }
+
+    lv_obj_t * gif_obj2 = lv_gif_create(lv_screen_active());
+    lv_gif_set_src(gif_obj2, TEST_GIF_PATH);
+    lv_tick_inc(400);
+    lv_timer_handler();
+    lv_obj_delete(gif_obj);
+    lv_obj_delete(gif_obj2);
+    gif_obj = lv_gif_create(lv_screen_active());
+}
+
+/*A 2x1 GIF with a 2 color palette. The LZW codes (3 bits) are
+ *clear, 0, 1, end so the last code exactly fills the frame.*/
+static const uint8_t gif_2x1[] = {
+    'G', 'I', 'F', '8', '9', 'a', 0x02, 0x00, 0x01, 0x00, 0x80, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0xff, 0xff, 0xff,
+    ',', 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x01, 0x00, 0x00,
+    0x02, 0x02, 0x44, 0x0a, 0x00,
+    ';'
+};
+
+/*The same but the codes are clear, 0, 6, end. Code 6 is 2 pixels long
+ *so it doesn't fit the frame anymore.*/
+static const uint8_t gif_2x1_overflow[] = {
+    'G', 'I', 'F', '8', '9', 'a', 0x02, 0x00, 0x01, 0x00, 0x80, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0xff, 0xff, 0xff,
+    ',', 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x01, 0x00, 0x00,
+    0x02, 0x02, 0x84, 0x0b, 0x00,
+    ';'
+};
+
+void test_gif_lzw_code_fills_frame(void)
+{
+    gd_GIF * gif = gd_open_gif_data(gif_2x1);
+    TEST_ASSERT_NOT_NULL(gif);
+    TEST_ASSERT_EQUAL_INT(1, gd_get_frame(gif));
+    TEST_ASSERT_EQUAL_UINT8(0, gif->frame[0]);
+    TEST_ASSERT_EQUAL_UINT8(1, gif->frame[1]);
+    gd_close_gif(gif);
+}
+
+void test_gif_lzw_code_overflows_frame(void)
+{
+    size_t initial_available_memory = lv_test_get_free_mem();
+
+    gd_GIF * gif = gd_open_gif_data(gif_2x1_overflow);
+    TEST_ASSERT_NOT_NULL(gif);
+    TEST_ASSERT_EQUAL_INT(-1, gd_get_frame(gif));
+    gd_close_gif(gif);
+
+    /*The LZW table is freed on the error too*/
+    LV_UNUSED(initial_available_memory);
+    LV_HEAP_CHECK(TEST_ASSERT_MEM_LEAK_LESS_THAN(initial_available_memory, 32));
+}
+
+#endif
@@ -80,4 +80,141 @@ void test_jpg_2(void)
     lv_tjpgd_init();
 }
 
+#if LV_LIBJPEG_TURBO_THREAD_CNT > 1
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <jpeglib.h>
+
+#define RESTART_TEST_PATH   "libjpeg_turbo_restart_test.jpg"
+
+/*Encode a noisy gradient and save it to a file*/
+static void restart_test_encode(uint32_t w, uint32_t h, bool gray, int restart_in_rows, unsigned int restart_interval,
+                                uint8_t ** jpg, unsigned long * jpg_size)
+{
+    struct jpeg_compress_struct cinfo;
+    struct jpeg_error_mgr jerr;
+    cinfo.err = jpeg_std_error(&jerr);
+    jpeg_create_compress(&cinfo);
+
+    *jpg = NULL;
+    *jpg_size = 0;
+    jpeg_mem_dest(&cinfo, jpg, jpg_size);
+
+    cinfo.image_width = w;
+    cinfo.image_height = h;
+    cinfo.input_components = gray ? 1 : 3;
+    cinfo.in_color_space = gray ? JCS_GRAYSCALE : JCS_RGB;
+    jpeg_set_defaults(&cinfo);
+    jpeg_set_quality(&cinfo, 85, TRUE);
+    cinfo.restart_in_rows = restart_in_rows;
+    cinfo.restart_interval = restart_interval;
+    jpeg_start_compress(&cinfo, TRUE);
+
+    uint8_t * row = lv_malloc(w * 3);
+    uint32_t seed = 1;
+    while(cinfo.next_scanline < cinfo.image_height) {
+        uint32_t y = cinfo.next_scanline;
+        uint32_t x;
+        for(x = 0; x < w * cinfo.input_components; x++) {
+            seed = seed * 1103515245u + 12345u;
+            row[x] = (uint8_t)((x * 255 / (w * 3)) + (y * 128 / h) + ((seed >> 16) & 0x1F));
+        }
+        jpeg_write_scanlines(&cinfo, &row, 1);
+    }
+    lv_free(row);
+
+    jpeg_finish_compress(&cinfo);
+    jpeg_destroy_compress(&cinfo);
+
+    FILE * f = fopen(RESTART_TEST_PATH, "wb");
+    TEST_ASSERT_NOT_NULL(f);
+    fwrite(*jpg, 1, *jpg_size, f);
+    fclose(f);
+}
+
+/*Decode with the calling thread only*/
+static uint8_t * restart_test_decode_sequential(const uint8_t * jpg, unsigned long jpg_size)
+{
+    struct jpeg_decompress_struct cinfo;
+    struct jpeg_error_mgr jerr;
+    cinfo.err = jpeg_std_error(&jerr);
+    jpeg_create_decompress(&cinfo);
+    jpeg_mem_src(&cinfo, jpg, jpg_size);
+    jpeg_read_header(&cinfo, TRUE);
+    cinfo.out_color_space = JCS_EXT_BGR;
+    jpeg_start_decompress(&cinfo);
+
+    uint32_t row_size = cinfo.output_width * 3;
+    uint8_t * pixels = lv_malloc(row_size * cinfo.output_height);
+    while(cinfo.output_scanline < cinfo.output_height) {
+        JSAMPROW row = pixels + cinfo.output_scanline * row_size;
+        jpeg_read_scanlines(&cinfo, &row, 1);
+    }
+
+    jpeg_finish_decompress(&cinfo);
+    jpeg_destroy_decompress(&cinfo);
+    return pixels;
+}
+
+static void restart_test_check(uint32_t w, uint32_t h, bool gray, int restart_in_rows, unsigned int restart_interval)
+{
+    uint8_t * jpg;
+    unsigned long jpg_size;
+    restart_test_encode(w, h, gray, restart_in_rows, restart_interval, &jpg, &jpg_size);
+    uint8_t * expected = restart_test_decode_sequential(jpg, jpg_size);
+
+    lv_image_decoder_args_t args;
+    lv_memzero(&args, sizeof(args));
+    args.no_cache = true;
+
+    lv_image_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, "A:" RESTART_TEST_PATH, &args));
+
+    TEST_ASSERT_EQUAL_UINT32(w, dsc.decoded->header.w);
+    TEST_ASSERT_EQUAL_UINT32(h, dsc.decoded->header.h);
+
+    uint32_t y;
+    for(y = 0; y < h; y++) {
+        TEST_ASSERT_EQUAL_MEMORY(expected + y * w * 3, dsc.decoded->data + y * dsc.decoded->header.stride, w * 3);
+    }
+
+    lv_image_decoder_close(&dsc);
+    lv_free(expected);
+    free(jpg);
+    remove(RESTART_TEST_PATH);
+}
+
+void test_jpg_restart_parallel(void)
+{
+    /* Temporarily remove tjpgd decoder */
+    lv_tjpgd_deinit();
+
+    /*Sliced at every MCU row, also with partial MCUs on the right and at the bottom*/
+    restart_test_check(301, 203, false, 1, 0);
+    restart_test_check(301, 203, true, 1, 0);
+    restart_test_check(64, 40, false, 1, 0);
+
+    /*Intervals of 3 MCU rows, more intervals than threads*/
+    restart_test_check(160, 400, false, 0, 30);
+
+    /*Falls back to sequential decoding: intervals which are not whole rows and no restart markers*/
+    restart_test_check(301, 203, false, 0, 7);
+    restart_test_check(301, 203, false, 0, 0);
+
+    /*A large image with many slices per thread*/
+    restart_test_check(1920, 1080, false, 1, 0);
+
+    /* Re-add tjpgd decoder */
+    lv_tjpgd_init();
+}
+
+#else
+
+void test_jpg_restart_parallel(void)
+{
+}
+
+#endif
+
 #endif
@@ -76,4 +76,54 @@ void test_libpng_1(void)
     lv_lodepng_init();
 }
 
+void test_libpng_strips(void)
+{
+#if LV_LIBPNG_STRIP_HEIGHT
+    lv_lodepng_deinit();
+
+    lv_image_decoder_args_t args;
+    lv_memzero(&args, sizeof(args));
+    args.no_cache = true;
+    args.partial = true;
+
+    lv_image_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, "A:src/test_assets/test_img_lvgl_logo.png", &args));
+    TEST_ASSERT_NULL(dsc.decoded);
+
+    /*Only the strips of the area are decoded*/
+    lv_area_t full_area = {0, 20, dsc.header.w - 1, dsc.header.h - 1};
+    lv_area_t decoded_area = {LV_COORD_MIN, LV_COORD_MIN, LV_COORD_MIN, LV_COORD_MIN};
+    int32_t y = (20 / LV_LIBPNG_STRIP_HEIGHT) * LV_LIBPNG_STRIP_HEIGHT;
+    while(lv_image_decoder_get_area(&dsc, &full_area, &decoded_area) == LV_RESULT_OK) {
+        TEST_ASSERT_EQUAL_INT32(y, decoded_area.y1);
+        TEST_ASSERT_EQUAL_INT32(dsc.header.w, lv_area_get_width(&decoded_area));
+        TEST_ASSERT_LESS_OR_EQUAL(LV_LIBPNG_STRIP_HEIGHT, lv_area_get_height(&decoded_area));
+        TEST_ASSERT_EQUAL_INT32(lv_area_get_height(&decoded_area), dsc.decoded->header.h);
+        y = decoded_area.y2 + 1;
+    }
+    TEST_ASSERT_EQUAL_INT32(dsc.header.h, y);
+
+    /*The strip buffer is much smaller than the image*/
+    TEST_ASSERT_LESS_THAN_UINT32(dsc.header.w * dsc.header.h * 4, dsc.decoded->data_size);
+    lv_image_decoder_close(&dsc);
+
+    /*Decoding from the start again*/
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, "A:src/test_assets/test_img_lvgl_logo.png", &args));
+    full_area.y1 = 0;
+    decoded_area.y1 = LV_COORD_MIN;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_get_area(&dsc, &full_area, &decoded_area));
+    TEST_ASSERT_EQUAL_INT32(0, decoded_area.y1);
+    lv_image_decoder_close(&dsc);
+
+    /*Decoded fully if the caller needs the whole image*/
+    args.partial = false;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, "A:src/test_assets/test_img_lvgl_logo.png", &args));
+    TEST_ASSERT_NOT_NULL(dsc.decoded);
+    TEST_ASSERT_EQUAL_INT32(dsc.header.h, dsc.decoded->header.h);
+    lv_image_decoder_close(&dsc);
+
+    lv_lodepng_init();
+#endif
+}
+
 #endif
@@ -91,4 +91,210 @@ void test_anim_delete_custom(void)
     TEST_ASSERT_EQUAL(39, var);
 }
 
+#define MANY_ANIM_CNT 1000
+
+static int32_t many_var[MANY_ANIM_CNT];
+static uint32_t completed_cnt;
+
+static void many_completed_cb(lv_anim_t * a)
+{
+    LV_UNUSED(a);
+    completed_cnt++;
+}
+
+static void delete_next_exec_cb(void * var, int32_t v)
+{
+    int32_t * var_i32 = var;
+    *var_i32 = v;
+
+    /*Delete the animation of the next variable while the animations are processed*/
+    lv_anim_delete(var_i32 + 1, NULL);
+}
+
+static void start_new_exec_cb(void * var, int32_t v)
+{
+    int32_t * var_i32 = var;
+    *var_i32 = v;
+
+    /*The new animation should run only in the next round*/
+    if(lv_anim_get(var_i32 + 1, NULL) == NULL) {
+        lv_anim_t a;
+        lv_anim_init(&a);
+        lv_anim_set_var(&a, var_i32 + 1);
+        lv_anim_set_values(&a, 1000, 2000);
+        lv_anim_set_exec_cb(&a, exec_cb);
+        lv_anim_set_duration(&a, 100);
+        lv_anim_start(&a);
+    }
+}
+
+void test_anim_many(void)
+{
+    static lv_anim_path_cb_t paths[] = {lv_anim_path_linear, lv_anim_path_ease_in, lv_anim_path_ease_out,
+                                        lv_anim_path_ease_in_out, lv_anim_path_overshoot, lv_anim_path_bounce
+                                       };
+
+    completed_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < MANY_ANIM_CNT; i++) {
+        many_var[i] = -1;
+        lv_anim_t a;
+        lv_anim_init(&a);
+        lv_anim_set_var(&a, &many_var[i]);
+        lv_anim_set_values(&a, 0, i);
+        lv_anim_set_exec_cb(&a, exec_cb);
+        lv_anim_set_path_cb(&a, paths[i % 6]);
+        lv_anim_set_duration(&a, 100 + (i % 7) * 10);
+        lv_anim_set_delay(&a, i % 3 * 10);
+        lv_anim_set_completed_cb(&a, many_completed_cb);
+        lv_anim_start(&a);
+    }
+
+    TEST_ASSERT_EQUAL(MANY_ANIM_CNT, lv_anim_count_running());
+
+    lv_test_wait(300);
+
+    TEST_ASSERT_EQUAL(0, lv_anim_count_running());
+    TEST_ASSERT_EQUAL(MANY_ANIM_CNT, completed_cnt);
+    for(i = 0; i < MANY_ANIM_CNT; i++) {
+        TEST_ASSERT_EQUAL(i, many_var[i]);
+    }
+}
+
+void test_anim_change_list_while_running(void)
+{
+    lv_memzero(many_var, sizeof(many_var));
+
+    /*Animations are processed from the newest. The deleted one keeps its early applied start value*/
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, &many_var[1]);
+    lv_anim_set_values(&a, 100, 200);
+    lv_anim_set_exec_cb(&a, exec_cb);
+    lv_anim_set_duration(&a, 100);
+    lv_anim_start(&a);
+
+    lv_anim_set_var(&a, &many_var[0]);
+    lv_anim_set_exec_cb(&a, delete_next_exec_cb);
+    lv_anim_start(&a);
+
+    lv_test_wait(10);
+    TEST_ASSERT_EQUAL(109, many_var[0]);
+    TEST_ASSERT_EQUAL(100, many_var[1]);
+    TEST_ASSERT_EQUAL(1, lv_anim_count_running());
+    lv_anim_delete(&many_var[0], NULL);
+
+    /*The animation started by an other animation doesn't run in the same round*/
+    lv_anim_set_var(&a, &many_var[2]);
+    lv_anim_set_exec_cb(&a, start_new_exec_cb);
+    lv_anim_set_early_apply(&a, false);
+    lv_anim_start(&a);
+
+    lv_test_wait(10);
+    TEST_ASSERT_EQUAL(109, many_var[2]);
+    TEST_ASSERT_EQUAL(1000, many_var[3]);
+    TEST_ASSERT_EQUAL(2, lv_anim_count_running());
+
+    lv_test_wait(10);
+    TEST_ASSERT_GREATER_THAN(1000, many_var[3]);
+
+    lv_anim_delete(NULL, NULL);
+}
+
+static uint32_t path_check_cnt;
+
+static void path_check_exec_cb(lv_anim_t * a, int32_t v)
+{
+    /*The values of the common paths are calculated without calling the path function*/
+    TEST_ASSERT_EQUAL_INT32(a->path_cb(a), v);
+    path_check_cnt++;
+}
+
+void test_anim_batch_paths(void)
+{
+    static lv_anim_path_cb_t paths[] = {lv_anim_path_linear, lv_anim_path_ease_in, lv_anim_path_ease_out,
+                                        lv_anim_path_ease_in_out, lv_anim_path_overshoot, lv_anim_path_bounce,
+                                        lv_anim_path_step, lv_anim_path_custom_bezier3
+                                       };
+
+    path_check_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < 64; i++) {
+        lv_anim_t a;
+        lv_anim_init(&a);
+        lv_anim_set_var(&a, &many_var[i]);
+        lv_anim_set_values(&a, -(int32_t)i * 37, (int32_t)i * 1001);
+        lv_anim_set_custom_exec_cb(&a, path_check_exec_cb);
+        lv_anim_set_path_cb(&a, paths[i % 8]);
+        lv_anim_set_bezier3_param(&a, LV_BEZIER_VAL_FLOAT(0.1), LV_BEZIER_VAL_FLOAT(0.7),
+                                  LV_BEZIER_VAL_FLOAT(0.4), LV_BEZIER_VAL_FLOAT(1.2));
+        lv_anim_set_duration(&a, 50 + i * 3);
+        lv_anim_set_early_apply(&a, false);
+        lv_anim_start(&a);
+    }
+
+    for(i = 0; i < 30; i++) lv_test_wait(11);
+
+    TEST_ASSERT_EQUAL(0, lv_anim_count_running());
+    TEST_ASSERT_GREATER_THAN(64 * 3, path_check_cnt);
+}
+
+static int32_t nested_var[2];
+
+static void nested_inner_exec_cb(void * var, int32_t v)
+{
+    int32_t * var_i32 = var;
+    *var_i32 = v;
+
+    /*Delete the animation whose callback is still running*/
+    lv_anim_delete(&nested_var[0], NULL);
+}
+
+static void nested_outer_exec_cb(void * var, int32_t v)
+{
+    int32_t * var_i32 = var;
+    *var_i32 = v;
+
+    if(lv_anim_get(&nested_var[1], NULL) == NULL) {
+        lv_anim_t a;
+        lv_anim_init(&a);
+        lv_anim_set_var(&a, &nested_var[1]);
+        lv_anim_set_values(&a, 500, 600);
+        lv_anim_set_exec_cb(&a, nested_inner_exec_cb);
+        lv_anim_set_duration(&a, 100);
+        lv_anim_set_early_apply(&a, false);
+        lv_anim_start(&a);
+
+        /*Apply the new animation right now*/
+        lv_anim_refr_now();
+        TEST_ASSERT_EQUAL(500, nested_var[1]);
+    }
+}
+
+void test_anim_refr_now_in_callback(void)
+{
+    nested_var[0] = 0;
+    nested_var[1] = 0;
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, &nested_var[0]);
+    lv_anim_set_values(&a, 100, 200);
+    lv_anim_set_exec_cb(&a, nested_outer_exec_cb);
+    lv_anim_set_duration(&a, 100);
+    lv_anim_set_early_apply(&a, false);
+    lv_anim_start(&a);
+
+    lv_test_wait(10);
+    TEST_ASSERT_EQUAL(109, nested_var[0]);
+    TEST_ASSERT_EQUAL(500, nested_var[1]);
+    TEST_ASSERT_EQUAL(1, lv_anim_count_running());
+
+    lv_test_wait(10);
+    TEST_ASSERT_EQUAL(109, nested_var[0]);
+    TEST_ASSERT_EQUAL(509, nested_var[1]);
+
+    lv_anim_delete(NULL, NULL);
+}
+
 #endif
@@ -0,0 +1,204 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#define SYNC_HOR_RES 120
+#define SYNC_VER_RES 100
+
+static lv_display_t * disp_ori;
+static lv_display_t * disp;
+static lv_draw_buf_t * buf1;
+static lv_draw_buf_t * buf2;
+static uint32_t sync_cb_cnt;
+static uint32_t sync_area_cnt;
+static uint32_t sync_wait_cnt;
+
+static void flush_cb(lv_display_t * d, const lv_area_t * area, uint8_t * px_map)
+{
+    LV_UNUSED(area);
+    LV_UNUSED(px_map);
+    lv_display_flush_ready(d);
+}
+
+static void sync_cb(lv_display_t * d, lv_draw_buf_t * dest, const lv_draw_buf_t * src,
+                    const lv_area_t * areas, uint32_t area_cnt)
+{
+    uint32_t i;
+    for(i = 1; i < area_cnt; i++) {
+        /*The areas should be sorted from top to bottom*/
+        TEST_ASSERT_TRUE(areas[i - 1].y1 <= areas[i].y1);
+    }
+
+    sync_cb_cnt++;
+    sync_area_cnt += area_cnt;
+    lv_draw_buf_copy_areas(dest, src, areas, area_cnt);
+    lv_display_sync_ready(d);
+}
+
+/*Copy the areas but signal it only from the wait callback, like a DMA*/
+static void sync_cb_deferred(lv_display_t * d, lv_draw_buf_t * dest, const lv_draw_buf_t * src,
+                             const lv_area_t * areas, uint32_t area_cnt)
+{
+    LV_UNUSED(d);
+    sync_cb_cnt++;
+    lv_draw_buf_copy_areas(dest, src, areas, area_cnt);
+}
+
+static void sync_wait_cb(lv_display_t * d)
+{
+    TEST_ASSERT_EQUAL(1, d->syncing);
+    sync_wait_cnt++;
+}
+
+void setUp(void)
+{
+    disp_ori = lv_display_get_default();
+    disp = lv_display_create(SYNC_HOR_RES, SYNC_VER_RES);
+    buf1 = lv_draw_buf_create(SYNC_HOR_RES, SYNC_VER_RES, LV_COLOR_FORMAT_ARGB8888, 0);
+    buf2 = lv_draw_buf_create(SYNC_HOR_RES, SYNC_VER_RES, LV_COLOR_FORMAT_ARGB8888, 0);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_ARGB8888);
+    lv_display_set_draw_buffers(disp, buf1, buf2);
+    lv_display_set_render_mode(disp, LV_DISPLAY_RENDER_MODE_DIRECT);
+    lv_display_set_flush_cb(disp, flush_cb);
+    lv_display_set_default(disp);
+    lv_obj_set_style_bg_opa(lv_screen_active(), LV_OPA_COVER, 0);
+
+    sync_cb_cnt = 0;
+    sync_area_cnt = 0;
+    sync_wait_cnt = 0;
+}
+
+void tearDown(void)
+{
+    lv_display_delete(disp);
+    lv_draw_buf_destroy(buf1);
+    lv_draw_buf_destroy(buf2);
+    lv_display_set_default(disp_ori);
+}
+
+static void assert_buffers_synced(void)
+{
+    /*Refresh without invalid areas to copy the areas of the last frame to the other buffer*/
+    lv_refr_now(disp);
+    TEST_ASSERT_EQUAL(0, disp->sync_p);
+    int32_t y;
+    for(y = 0; y < SYNC_VER_RES; y++) {
+        TEST_ASSERT_EQUAL_MEMORY(lv_draw_buf_goto_xy(buf1, 0, y), lv_draw_buf_goto_xy(buf2, 0, y), SYNC_HOR_RES * 4);
+    }
+}
+
+static uint32_t next_rand(uint32_t * seed)
+{
+    *seed = *seed * 1103515245 + 12345;
+    return (*seed >> 16) & 0x7fff;
+}
+
+static void render_random_frames(void)
+{
+    lv_obj_t * objs[24];
+    uint32_t seed = 1;
+    uint32_t i;
+    for(i = 0; i < 24; i++) {
+        objs[i] = lv_obj_create(lv_screen_active());
+        lv_obj_remove_style_all(objs[i]);
+        lv_obj_set_style_bg_opa(objs[i], LV_OPA_COVER, 0);
+        lv_obj_set_size(objs[i], 3 + next_rand(&seed) % 20, 3 + next_rand(&seed) % 20);
+    }
+
+    uint32_t frame;
+    for(frame = 0; frame < 30; frame++) {
+        for(i = 0; i < 24; i++) {
+            lv_obj_set_pos(objs[i], next_rand(&seed) % SYNC_HOR_RES, next_rand(&seed) % SYNC_VER_RES);
+            lv_obj_set_style_bg_color(objs[i], lv_color_hex(next_rand(&seed) * next_rand(&seed)), 0);
+        }
+        lv_refr_now(disp);
+        TEST_ASSERT_TRUE(disp->sync_p <= LV_SYNC_AREA_BUF_SIZE);
+    }
+}
+
+void test_display_sync_areas(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(obj, 30, 20);
+    lv_refr_now(disp);
+
+    lv_obj_set_pos(obj, 50, 40);
+    lv_refr_now(disp);
+    assert_buffers_synced();
+}
+
+void test_display_sync_areas_many(void)
+{
+    render_random_frames();
+    assert_buffers_synced();
+}
+
+void test_display_sync_cb(void)
+{
+    lv_display_set_sync_cb(disp, sync_cb);
+    render_random_frames();
+    assert_buffers_synced();
+
+    TEST_ASSERT_NOT_EQUAL(0, sync_cb_cnt);
+    TEST_ASSERT_NOT_EQUAL(0, sync_area_cnt);
+    TEST_ASSERT_EQUAL(0, disp->syncing);
+}
+
+void test_display_sync_wait_cb(void)
+{
+    lv_display_set_sync_cb(disp, sync_cb_deferred);
+    lv_display_set_sync_wait_cb(disp, sync_wait_cb);
+
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(obj, 30, 20);
+    lv_refr_now(disp);
+
+    /*The areas of the previous frame are synced and waited for before the last flush*/
+    int32_t i;
+    for(i = 0; i < 3; i++) {
+        lv_obj_set_pos(obj, 10 + i * 20, 10 + i * 15);
+        lv_refr_now(disp);
+        TEST_ASSERT_EQUAL_UINT32(sync_cb_cnt, sync_wait_cnt);
+        TEST_ASSERT_EQUAL(0, disp->syncing);
+    }
+    TEST_ASSERT_NOT_EQUAL(0, sync_wait_cnt);
+
+    assert_buffers_synced();
+}
+
+void test_draw_buf_copy_areas(void)
+{
+    lv_draw_buf_t * src = lv_draw_buf_create(40, 30, LV_COLOR_FORMAT_RGB565, 0);
+    lv_draw_buf_t * dest = lv_draw_buf_create(40, 30, LV_COLOR_FORMAT_RGB565, 0);
+    uint32_t i;
+    for(i = 0; i < src->data_size; i++) src->data[i] = (uint8_t)i;
+    lv_draw_buf_clear(dest, NULL);
+
+    lv_area_t areas[2] = {
+        {0, 2, 39, 5},  /*Full width*/
+        {3, 10, 7, 12},
+    };
+    lv_draw_buf_copy_areas(dest, src, areas, 2);
+
+    int32_t x, y;
+    for(y = 0; y < 30; y++) {
+        for(x = 0; x < 40; x++) {
+            lv_point_t p = {x, y};
+            uint16_t * px_dest = lv_draw_buf_goto_xy(dest, x, y);
+            uint16_t * px_src = lv_draw_buf_goto_xy(src, x, y);
+            if(lv_area_is_point_on(&areas[0], &p, 0) || lv_area_is_point_on(&areas[1], &p, 0)) {
+                TEST_ASSERT_EQUAL_UINT16(*px_src, *px_dest);
+            }
+            else {
+                TEST_ASSERT_EQUAL_UINT16(0, *px_dest);
+            }
+        }
+    }
+
+    lv_draw_buf_destroy(src);
+    lv_draw_buf_destroy(dest);
+}
+
+#endif
@@ -122,4 +122,74 @@ void test_event_stop_processing(void)
     TEST_ASSERT_EQUAL(post_cnt_2, 0);
 }
 
+static uint32_t filter_cnt;
+
+static void event_filter_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+    filter_cnt++;
+}
+
+void test_event_filter(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    uint32_t custom_code = lv_event_register_id();
+    while(custom_code < 70) custom_code = lv_event_register_id();
+
+    lv_event_dsc_t * dsc = lv_obj_add_event_cb(obj, event_filter_cb, LV_EVENT_VALUE_CHANGED, NULL);
+    lv_obj_add_event_cb(obj, event_filter_cb, (lv_event_code_t)custom_code, NULL);
+
+    filter_cnt = 0;
+    lv_obj_send_event(obj, LV_EVENT_VALUE_CHANGED, NULL);
+    lv_obj_send_event(obj, LV_EVENT_READY, NULL);
+    lv_obj_send_event(obj, (lv_event_code_t)custom_code, NULL);
+    /*Shares the bit of `custom_code` but the callback is not called*/
+    lv_obj_send_event(obj, (lv_event_code_t)(custom_code + 1), NULL);
+    TEST_ASSERT_EQUAL_UINT32(2, filter_cnt);
+
+    lv_obj_remove_event_dsc(obj, dsc);
+    lv_obj_send_event(obj, LV_EVENT_VALUE_CHANGED, NULL);
+    TEST_ASSERT_EQUAL_UINT32(2, filter_cnt);
+
+    lv_obj_add_event_cb(obj, event_filter_cb, LV_EVENT_READY | LV_EVENT_PREPROCESS, NULL);
+    lv_obj_send_event(obj, LV_EVENT_READY, NULL);
+    TEST_ASSERT_EQUAL_UINT32(3, filter_cnt);
+
+    lv_obj_add_event_cb(obj, event_filter_cb, LV_EVENT_ALL, NULL);
+    lv_obj_send_event(obj, LV_EVENT_CANCEL, NULL);
+    TEST_ASSERT_EQUAL_UINT32(4, filter_cnt);
+
+    lv_obj_delete(obj);
+}
+
+void test_event_stats(void)
+{
+    lv_obj_t * parent = lv_obj_create(lv_screen_active());
+    lv_obj_t * obj = lv_obj_create(parent);
+    lv_obj_add_flag(obj, LV_OBJ_FLAG_EVENT_BUBBLE);
+    lv_obj_add_event_cb(parent, event_filter_cb, LV_EVENT_CLICKED, NULL);
+    lv_obj_add_event_cb(obj, event_filter_cb, LV_EVENT_VALUE_CHANGED, NULL);
+
+    uint32_t sent_cnt;
+    uint32_t handled_cnt;
+    lv_obj_reset_event_stats();
+    lv_obj_get_event_stats(&sent_cnt, &handled_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, sent_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, handled_cnt);
+
+    /*Bubbled to the parent*/
+    lv_obj_send_event(obj, LV_EVENT_CLICKED, NULL);
+    lv_obj_get_event_stats(&sent_cnt, &handled_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, sent_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, handled_cnt);
+
+    /*Not bubbled and no callback*/
+    lv_obj_send_event(obj, LV_EVENT_REFRESH, NULL);
+    lv_obj_get_event_stats(&sent_cnt, &handled_cnt);
+    TEST_ASSERT_EQUAL_UINT32(3, sent_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, handled_cnt);
+
+    lv_obj_delete(parent);
+}
+
 #endif
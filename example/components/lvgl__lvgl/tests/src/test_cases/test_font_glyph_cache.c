@@ -0,0 +1,105 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+LV_FONT_DECLARE(test_font_montserrat_ascii_4bpp_compressed)
+
+static const lv_font_t * font = &test_font_montserrat_ascii_4bpp_compressed;
+
+#define GLYPH_CACHE     LV_GLOBAL_DEFAULT()->font_fmt_glyph_cache.cache
+
+void setUp(void)
+{
+    /*Start from an empty cache*/
+    lv_font_fmt_txt_glyph_cache_resize(0);
+    lv_font_fmt_txt_glyph_cache_resize(LV_FONT_COMPRESSED_CACHE_SIZE);
+    lv_cache_reset_stats(GLYPH_CACHE);
+}
+
+void tearDown(void)
+{
+    lv_font_fmt_txt_glyph_cache_resize(LV_FONT_COMPRESSED_CACHE_SIZE);
+    lv_obj_clean(lv_screen_active());
+}
+
+static lv_draw_buf_t * get_glyph(uint32_t letter, lv_font_glyph_dsc_t * g)
+{
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, g, letter, 0));
+
+    lv_draw_buf_t * draw_buf = lv_draw_buf_create(g->box_w, g->box_h, LV_COLOR_FORMAT_A8, LV_STRIDE_AUTO);
+    lv_memzero(draw_buf->data, draw_buf->data_size);
+    TEST_ASSERT_EQUAL_PTR(draw_buf, lv_font_get_glyph_bitmap(g, draw_buf));
+    return draw_buf;
+}
+
+static void assert_stats(uint32_t hit_exp, uint32_t miss_exp)
+{
+    lv_cache_stats_t stats;
+    lv_cache_get_stats(GLYPH_CACHE, &stats);
+    TEST_ASSERT_EQUAL_UINT32(hit_exp, stats.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(miss_exp, stats.miss_cnt);
+}
+
+void test_font_glyph_cache_same_bitmap(void)
+{
+    static const char letters[] = "AgW@q";
+    uint32_t i;
+    for(i = 0; letters[i]; i++) {
+        lv_font_glyph_dsc_t g;
+
+        /*Decompressed without the cache*/
+        lv_font_fmt_txt_glyph_cache_resize(0);
+        lv_draw_buf_t * ref = get_glyph(letters[i], &g);
+
+        /*Decompressed into the cache and copied from it*/
+        lv_font_fmt_txt_glyph_cache_resize(LV_FONT_COMPRESSED_CACHE_SIZE);
+        lv_draw_buf_t * first = get_glyph(letters[i], &g);
+        lv_draw_buf_t * second = get_glyph(letters[i], &g);
+
+        TEST_ASSERT_EQUAL_MEMORY(ref->data, first->data, ref->data_size);
+        TEST_ASSERT_EQUAL_MEMORY(ref->data, second->data, ref->data_size);
+
+        lv_draw_buf_destroy(ref);
+        lv_draw_buf_destroy(first);
+        lv_draw_buf_destroy(second);
+    }
+
+    /*The disabled cache is not counted*/
+    assert_stats(5, 5);
+}
+
+void test_font_glyph_cache_label_redraw(void)
+{
+    lv_obj_t * label = lv_label_create(lv_screen_active());
+    lv_obj_set_style_text_font(label, font, 0);
+    lv_label_set_text(label, "aaaa bbbb");
+    lv_refr_now(NULL);
+
+    /*Only the first letter of each kind is decompressed*/
+    assert_stats(6, 2);
+
+    lv_obj_invalidate(label);
+    lv_refr_now(NULL);
+    assert_stats(14, 2);
+}
+
+void test_font_glyph_cache_budget(void)
+{
+    lv_font_glyph_dsc_t g;
+    lv_draw_buf_t * draw_buf = get_glyph('W', &g);
+    lv_draw_buf_destroy(draw_buf);
+    assert_stats(0, 1);
+
+    /*The glyph doesn't fit into the cache so it's decompressed again*/
+    lv_font_fmt_txt_glyph_cache_resize(8);
+    lv_cache_reset_stats(GLYPH_CACHE);
+    draw_buf = get_glyph('W', &g);
+    lv_draw_buf_destroy(draw_buf);
+    draw_buf = get_glyph('W', &g);
+    lv_draw_buf_destroy(draw_buf);
+    assert_stats(0, 0);
+}
+
+#endif
@@ -25,9 +25,11 @@
  **********************/
 
 static int compare_fonts(lv_font_t * f1, lv_font_t * f2);
+static void compare_glyph_bitmaps(lv_font_t * f1, lv_font_t * f2);
 void test_font_loader_with_cache(void);
 void test_font_loader_no_cache(void);
 void test_font_loader_from_buffer(void);
+void test_font_loader_lazy(void);
 
 /**********************
  *  STATIC VARIABLES
@@ -66,12 +68,8 @@ void tearDown(void)
 
 }
 
-static void common(void)
+static void check_labels(void)
 {
-    compare_fonts(&test_font_1, font_1_bin);
-    compare_fonts(&test_font_2, font_2_bin);
-    compare_fonts(&test_font_3, font_3_bin);
-
     /* create labels for testing */
     lv_obj_t * scr = lv_screen_active();
     lv_obj_t * label1 = lv_label_create(scr);
@@ -97,6 +95,15 @@ static void common(void)
     lv_binfont_destroy(font_3_bin);
 }
 
+static void common(void)
+{
+    compare_fonts(&test_font_1, font_1_bin);
+    compare_fonts(&test_font_2, font_2_bin);
+    compare_fonts(&test_font_3, font_3_bin);
+
+    check_labels();
+}
+
 void test_font_loader_with_cache(void)
 {
     /*Test with cache ('A' has cache)*/
@@ -145,6 +152,49 @@ void test_font_loader_from_buffer(void)
     common();
 }
 
+void test_font_loader_lazy(void)
+{
+    const char * paths[] = {
+        "A:src/test_assets/test_font_1.fnt",
+        "A:src/test_assets/test_font_2.fnt",
+        "A:src/test_assets/test_font_3.fnt",
+    };
+
+    /*Same glyphs as with the normal loader with a large, a tiny and no cache*/
+    uint32_t cache_sizes[] = {16 * 1024, 512, 0};
+    for(uint32_t i = 0; i < 3; i++) {
+        lv_font_t * font = lv_binfont_create(paths[i]);
+        TEST_ASSERT_NOT_NULL(font);
+        for(uint32_t c = 0; c < 3; c++) {
+            lv_font_t * font_lazy = lv_binfont_create_lazy(paths[i], cache_sizes[c]);
+            TEST_ASSERT_NOT_NULL(font_lazy);
+
+            /*Only the metrics are loaded*/
+            lv_font_fmt_txt_dsc_t * dsc = (lv_font_fmt_txt_dsc_t *)font_lazy->dsc;
+            TEST_ASSERT_NULL(dsc->glyph_bitmap);
+
+            compare_glyph_bitmaps(font, font_lazy);
+            compare_glyph_bitmaps(font, font_lazy);
+            lv_binfont_destroy(font_lazy);
+        }
+        lv_binfont_destroy(font);
+    }
+
+    /*Prefetch loads each glyph once*/
+    lv_font_t * font = lv_binfont_create_lazy(paths[0], 16 * 1024);
+    TEST_ASSERT_EQUAL_UINT32(4, lv_binfont_prefetch(font, "Hello"));
+    TEST_ASSERT_EQUAL_UINT32(3, lv_binfont_prefetch(font, "Hello world"));
+    TEST_ASSERT_EQUAL_UINT32(0, lv_binfont_prefetch(font, "Hello world"));
+    lv_binfont_destroy(font);
+
+    TEST_ASSERT_NULL(lv_binfont_create_lazy("A:src/test_assets/no_such_font.fnt", 1024));
+
+    font_1_bin = lv_binfont_create_lazy(paths[0], 16 * 1024);
+    font_2_bin = lv_binfont_create_lazy(paths[1], 16 * 1024);
+    font_3_bin = lv_binfont_create_lazy(paths[2], 16 * 1024);
+    check_labels();
+}
+
 void test_font_loader_reload(void)
 {
     /*Reload a font which is being used by a label*/
@@ -318,6 +368,34 @@ static int compare_fonts(lv_font_t * f1, lv_font_t * f2)
     return 0;
 }
 
+static void compare_glyph_bitmaps(lv_font_t * f1, lv_font_t * f2)
+{
+    lv_draw_buf_t * buf1 = lv_draw_buf_create(64, 64, LV_COLOR_FORMAT_A8, LV_STRIDE_AUTO);
+    lv_draw_buf_t * buf2 = lv_draw_buf_create(64, 64, LV_COLOR_FORMAT_A8, LV_STRIDE_AUTO);
+
+    for(uint32_t letter = 0x20; letter < 0x7f; letter++) {
+        lv_font_glyph_dsc_t g1;
+        lv_font_glyph_dsc_t g2;
+        bool found = lv_font_get_glyph_dsc(f1, &g1, letter, 0);
+        TEST_ASSERT_EQUAL(found, lv_font_get_glyph_dsc(f2, &g2, letter, 0));
+        if(!found || g1.box_w * g1.box_h == 0) continue;
+
+        TEST_ASSERT_EQUAL_INT(g1.box_w, g2.box_w);
+        TEST_ASSERT_EQUAL_INT(g1.box_h, g2.box_h);
+
+        lv_memzero(buf1->data, buf1->data_size);
+        lv_memzero(buf2->data, buf2->data_size);
+        TEST_ASSERT_NOT_NULL(lv_font_get_glyph_bitmap(&g1, buf1));
+        TEST_ASSERT_NOT_NULL(lv_font_get_glyph_bitmap(&g2, buf2));
+
+        uint32_t stride = lv_draw_buf_width_to_stride(g1.box_w, LV_COLOR_FORMAT_A8);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(buf1->data, buf2->data, stride * g1.box_h, "glyph_bitmap");
+    }
+
+    lv_draw_buf_destroy(buf1);
+    lv_draw_buf_destroy(buf2);
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -65,6 +65,57 @@ void test_read(void)
     lv_fs_close(&fb);
 }
 
+void test_get_buffer(void)
+{
+    lv_fs_res_t res;
+    uint32_t size;
+    const void * buf;
+
+    /*'B' maps the files opened for reading*/
+    lv_fs_file_t f;
+    res = lv_fs_open(&f, "B:src/test_files/readtest.txt", LV_FS_MODE_RD);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    buf = lv_fs_get_buffer(&f, &size);
+    TEST_ASSERT_NOT_NULL(buf);
+    TEST_ASSERT_EQUAL_UINT32(strlen(read_exp) + 1, size);  /*With the closing new line*/
+    TEST_ASSERT_EQUAL_MEMORY(read_exp, buf, strlen(read_exp));
+
+    /*Reading works the same way*/
+    char read_buf[16];
+    uint32_t br;
+    lv_fs_seek(&f, 6, LV_FS_SEEK_SET);
+    res = lv_fs_read(&f, read_buf, sizeof(read_buf), &br);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    TEST_ASSERT_EQUAL_UINT32(sizeof(read_buf), br);
+    TEST_ASSERT_EQUAL_MEMORY(read_exp + 6, read_buf, sizeof(read_buf));
+
+    uint32_t pos;
+    lv_fs_seek(&f, 0, LV_FS_SEEK_END);
+    lv_fs_tell(&f, &pos);
+    TEST_ASSERT_EQUAL_UINT32(size, pos);
+    res = lv_fs_read(&f, read_buf, sizeof(read_buf), &br);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    TEST_ASSERT_EQUAL_UINT32(0, br);
+    lv_fs_close(&f);
+
+    /*Files opened from a buffer give the buffer*/
+    lv_fs_path_ex_t path;
+    lv_fs_make_path_from_buffer(&path, 'M', read_exp, strlen(read_exp));
+    res = lv_fs_open(&f, (const char *)&path, LV_FS_MODE_RD);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    buf = lv_fs_get_buffer(&f, &size);
+    TEST_ASSERT_EQUAL_PTR(read_exp, buf);
+    TEST_ASSERT_EQUAL_UINT32(strlen(read_exp), size);
+    lv_fs_close(&f);
+
+    /*'A' can only read*/
+    res = lv_fs_open(&f, "A:src/test_files/readtest.txt", LV_FS_MODE_RD);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    TEST_ASSERT_NULL(lv_fs_get_buffer(&f, &size));
+    TEST_ASSERT_EQUAL_UINT32(0, size);
+    lv_fs_close(&f);
+}
+
 void test_read_random(void)
 {
     read_random_drv('A', 8);
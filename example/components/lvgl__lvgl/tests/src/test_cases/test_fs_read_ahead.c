@@ -0,0 +1,251 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#if LV_FS_READ_AHEAD
+
+#include <stdio.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#define TEST_FILE_PATH      "read_ahead_test.bin"
+#define TEST_FILE_SIZE      (64 * 1024)
+#define TEST_CACHE_SIZE     1024
+
+static lv_fs_drv_t counting_drv;
+static volatile uint32_t read_cnt;
+static volatile uint32_t caller_read_cnt;   /*Reads not done by the read-ahead thread*/
+static pthread_t caller_thread;
+
+static void * counting_open_cb(lv_fs_drv_t * drv, const char * path, lv_fs_mode_t mode)
+{
+    LV_UNUSED(drv);
+    LV_UNUSED(mode);
+    return fopen(path, "rb");
+}
+
+static lv_fs_res_t counting_close_cb(lv_fs_drv_t * drv, void * file_p)
+{
+    LV_UNUSED(drv);
+    fclose(file_p);
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t counting_read_cb(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+    LV_UNUSED(drv);
+    *br = (uint32_t)fread(buf, 1, btr, file_p);
+    read_cnt++;
+    if(pthread_equal(pthread_self(), caller_thread)) caller_read_cnt++;
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t counting_seek_cb(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence)
+{
+    LV_UNUSED(drv);
+    int w = whence == LV_FS_SEEK_SET ? SEEK_SET : whence == LV_FS_SEEK_CUR ? SEEK_CUR : SEEK_END;
+    return fseek(file_p, (long)pos, w) == 0 ? LV_FS_RES_OK : LV_FS_RES_FS_ERR;
+}
+
+static lv_fs_res_t counting_tell_cb(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p)
+{
+    LV_UNUSED(drv);
+    *pos_p = (uint32_t)ftell(file_p);
+    return LV_FS_RES_OK;
+}
+
+static uint8_t test_byte(uint32_t pos)
+{
+    return (uint8_t)(pos * 7 + (pos >> 8));
+}
+
+/*Let the read-ahead thread finish the queued read like a decoder processing the data for a while would*/
+static void wait_for_prefetch(lv_fs_file_t * f)
+{
+    lv_fs_read_ahead_t * ra = f->read_ahead;
+    if(ra == NULL) return;
+
+    while(1) {
+        lv_mutex_lock(&ra->io_lock);
+        bool done = !ra->job_pending || ra->job_done;
+        lv_mutex_unlock(&ra->io_lock);
+        if(done) return;
+        usleep(100);
+    }
+}
+
+static void assert_content(const uint8_t * buf, uint32_t pos, uint32_t len)
+{
+    uint32_t i;
+    for(i = 0; i < len; i++) {
+        if(buf[i] != test_byte(pos + i)) {
+            TEST_FAIL_MESSAGE("Wrong content");
+        }
+    }
+}
+
+void setUp(void)
+{
+    FILE * f = fopen(TEST_FILE_PATH, "wb");
+    TEST_ASSERT_NOT_NULL(f);
+    uint32_t i;
+    for(i = 0; i < TEST_FILE_SIZE; i++) fputc(test_byte(i), f);
+    fclose(f);
+
+    if(lv_fs_get_drv('T') == NULL) {
+        lv_fs_drv_init(&counting_drv);
+        counting_drv.letter = 'T';
+        counting_drv.cache_size = TEST_CACHE_SIZE;
+        counting_drv.open_cb = counting_open_cb;
+        counting_drv.close_cb = counting_close_cb;
+        counting_drv.read_cb = counting_read_cb;
+        counting_drv.seek_cb = counting_seek_cb;
+        counting_drv.tell_cb = counting_tell_cb;
+        lv_fs_drv_register(&counting_drv);
+    }
+
+    counting_drv.read_ahead = true;
+    read_cnt = 0;
+    caller_read_cnt = 0;
+    caller_thread = pthread_self();
+}
+
+void tearDown(void)
+{
+    remove(TEST_FILE_PATH);
+}
+
+/*Read the whole file in small chunks like a decoder*/
+static void read_sequential(void)
+{
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, "T:" TEST_FILE_PATH, LV_FS_MODE_RD));
+
+    uint8_t buf[256];
+    uint32_t pos = 0;
+    while(1) {
+        uint32_t br;
+        TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&f, buf, sizeof(buf), &br));
+        if(br == 0) break;
+        assert_content(buf, pos, br);
+        pos += br;
+        wait_for_prefetch(&f);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(TEST_FILE_SIZE, pos);
+    lv_fs_close(&f);
+}
+
+void test_fs_read_ahead_sequential(void)
+{
+    counting_drv.read_ahead = false;
+    read_sequential();
+    uint32_t plain_read_cnt = read_cnt;
+    TEST_ASSERT_EQUAL_UINT32(plain_read_cnt, caller_read_cnt);
+
+    counting_drv.read_ahead = true;
+    read_cnt = 0;
+    caller_read_cnt = 0;
+    read_sequential();
+
+    /*The windows grow so there are fewer reads*/
+    TEST_ASSERT_LESS_THAN_UINT32(plain_read_cnt, read_cnt);
+
+    /*Only the first two windows (before the access is known to be sequential) and the end of the file
+     *are read on request. All the other parts were already in memory when they were needed.*/
+    TEST_ASSERT_EQUAL_UINT32(3, caller_read_cnt);
+}
+
+void test_fs_read_ahead_random(void)
+{
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, "T:" TEST_FILE_PATH, LV_FS_MODE_RD));
+    TEST_ASSERT_NOT_NULL(f.read_ahead);
+
+    uint8_t buf[3000];
+    uint32_t seed = 1;
+    uint32_t i;
+    for(i = 0; i < 200; i++) {
+        seed = seed * 1103515245u + 12345u;
+        uint32_t len = (seed >> 8) % sizeof(buf);
+
+        /*Seek away sometimes, continue sequentially otherwise*/
+        uint32_t pos;
+        if(i % 4 == 0) {
+            pos = (seed >> 4) % TEST_FILE_SIZE;
+            TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&f, pos, LV_FS_SEEK_SET));
+        }
+        TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_tell(&f, &pos));
+
+        uint32_t br;
+        TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&f, buf, len, &br));
+        TEST_ASSERT_EQUAL_UINT32(LV_MIN(len, TEST_FILE_SIZE - pos), br);
+        assert_content(buf, pos, br);
+    }
+
+    uint32_t pos;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&f, 0, LV_FS_SEEK_END));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_tell(&f, &pos));
+    TEST_ASSERT_EQUAL_UINT32(TEST_FILE_SIZE, pos);
+
+    /*Only the files opened for reading are read ahead*/
+    uint32_t bw;
+    TEST_ASSERT_EQUAL(LV_FS_RES_NOT_IMP, lv_fs_write(&f, buf, 1, &bw));
+
+    lv_fs_close(&f);
+}
+
+void test_fs_read_ahead_prefetch(void)
+{
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_prefetch("T:" TEST_FILE_PATH, 0, 4096));
+
+    /*Wait until the thread has read it*/
+    uint32_t i;
+    for(i = 0; i < 100 && read_cnt == 0; i++) usleep(10000);
+    usleep(20000);
+    TEST_ASSERT_EQUAL_UINT32(1, read_cnt);
+
+    /*Served from memory*/
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, "T:" TEST_FILE_PATH, LV_FS_MODE_RD));
+    uint8_t buf[1000];
+    uint32_t br;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&f, buf, sizeof(buf), &br));
+    TEST_ASSERT_EQUAL_UINT32(sizeof(buf), br);
+    assert_content(buf, 0, br);
+    TEST_ASSERT_EQUAL_UINT32(1, read_cnt);
+    lv_fs_close(&f);
+
+    /*Only with the drivers having read-ahead*/
+    counting_drv.read_ahead = false;
+    TEST_ASSERT_EQUAL(LV_FS_RES_NOT_IMP, lv_fs_prefetch("T:" TEST_FILE_PATH, 0, 4096));
+    TEST_ASSERT_EQUAL(LV_FS_RES_NOT_EX, lv_fs_prefetch("Q:" TEST_FILE_PATH, 0, 4096));
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_fs_read_ahead_sequential(void)
+{
+}
+
+void test_fs_read_ahead_random(void)
+{
+}
+
+void test_fs_read_ahead_prefetch(void)
+{
+}
+
+#endif
+
+#endif
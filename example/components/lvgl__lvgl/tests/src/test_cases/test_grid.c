@@ -86,4 +86,67 @@ void test_subgrid_col(void)
     TEST_ASSERT_EQUAL_SCREENSHOT("subgrid_col.png");
 }
 
+static void counting_layout_cb(lv_obj_t * cont, void * user_data)
+{
+    LV_UNUSED(cont);
+    uint32_t * cnt = user_data;
+    (*cnt)++;
+}
+
+void test_grid_update_dirty_subtree_only(void)
+{
+    const int32_t col_dsc[] = {LV_GRID_FR(1), LV_GRID_FR(2), LV_GRID_TEMPLATE_LAST};
+    const int32_t row_dsc[] = {LV_GRID_FR(1), LV_GRID_TEMPLATE_LAST};
+
+    lv_obj_t * cont_main = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(cont_main, 600, 300);
+    lv_obj_set_style_pad_all(cont_main, 0, 0);
+    lv_obj_set_style_pad_column(cont_main, 0, 0);
+    lv_obj_set_style_border_width(cont_main, 0, 0);
+    lv_obj_set_grid_dsc_array(cont_main, col_dsc, row_dsc);
+
+    lv_obj_t * cell1 = lv_obj_create(cont_main);
+    lv_obj_set_grid_cell(cell1, LV_GRID_ALIGN_STRETCH, 0, 1, LV_GRID_ALIGN_STRETCH, 0, 1);
+    lv_obj_t * label = lv_label_create(cell1);
+    lv_label_set_text(label, "A");
+
+    /*Count how many times the layout of the other cell is updated*/
+    uint32_t apply_cnt = 0;
+    lv_layout_t counting_layout = lv_layout_register(counting_layout_cb, &apply_cnt);
+    lv_obj_t * cell2 = lv_obj_create(cont_main);
+    lv_obj_set_grid_cell(cell2, LV_GRID_ALIGN_STRETCH, 1, 1, LV_GRID_ALIGN_STRETCH, 0, 1);
+    lv_obj_set_layout(cell2, counting_layout);
+    lv_obj_t * cell2_child = lv_obj_create(cell2);
+
+    lv_obj_update_layout(cont_main);
+    TEST_ASSERT_EQUAL_INT32(200, lv_obj_get_width(cell1));
+    TEST_ASSERT_EQUAL_INT32(400, lv_obj_get_width(cell2));
+    TEST_ASSERT_GREATER_THAN_UINT32(0, apply_cnt);
+
+    /*Only the path to the changed label is marked*/
+    lv_label_set_text(label, "A much longer text");
+    TEST_ASSERT_TRUE(label->layout_inv);
+    TEST_ASSERT_TRUE(cell1->layout_child_inv);
+    TEST_ASSERT_TRUE(cont_main->layout_child_inv);
+    TEST_ASSERT_TRUE(lv_screen_active()->layout_child_inv);
+    TEST_ASSERT_FALSE(cell2->layout_child_inv);
+    TEST_ASSERT_FALSE(cell2_child->layout_inv);
+
+    int32_t label_w = lv_obj_get_width(label);
+    apply_cnt = 0;
+    lv_obj_update_layout(cont_main);
+    TEST_ASSERT_GREATER_THAN_INT32(label_w, lv_obj_get_width(label));
+    TEST_ASSERT_EQUAL_UINT32(0, apply_cnt);
+    TEST_ASSERT_FALSE(label->layout_inv);
+    TEST_ASSERT_FALSE(cell1->layout_child_inv);
+    TEST_ASSERT_FALSE(lv_screen_active()->layout_child_inv);
+
+    /*A size change of the grid still reaches every cell*/
+    lv_obj_set_width(cont_main, 450);
+    lv_obj_update_layout(cont_main);
+    TEST_ASSERT_EQUAL_INT32(150, lv_obj_get_width(cell1));
+    TEST_ASSERT_EQUAL_INT32(300, lv_obj_get_width(cell2));
+    TEST_ASSERT_GREATER_THAN_UINT32(0, apply_cnt);
+}
+
 #endif
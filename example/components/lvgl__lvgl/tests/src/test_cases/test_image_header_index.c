@@ -0,0 +1,253 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_IMAGE_HEADER_INDEX
+
+#include <stdio.h>
+#include <sys/stat.h>
+
+#define INDEX_PATH      "A:image_header_index_test.bin"
+#define COPY_PATH       "image_header_index_test.png"
+#define ENTRY_CNT_OFFSET 8      /*`entry_cnt` in the header of the index file*/
+
+static const char * images[] = {
+    "src/test_assets/test_img_lvgl_logo.png",
+    "src/test_assets/test_img_lvgl_logo.jpg",
+    "src/test_assets/test_img_emoji_F600.png",
+};
+
+static lv_fs_drv_t counting_drv;
+static uint32_t open_cnt;
+
+static void * counting_open_cb(lv_fs_drv_t * drv, const char * path, lv_fs_mode_t mode)
+{
+    LV_UNUSED(drv);
+    LV_UNUSED(mode);
+    open_cnt++;
+    return fopen(path, "rb");
+}
+
+static lv_fs_res_t counting_close_cb(lv_fs_drv_t * drv, void * file_p)
+{
+    LV_UNUSED(drv);
+    fclose(file_p);
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t counting_read_cb(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+    LV_UNUSED(drv);
+    *br = (uint32_t)fread(buf, 1, btr, file_p);
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t counting_seek_cb(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence)
+{
+    LV_UNUSED(drv);
+    int w = whence == LV_FS_SEEK_SET ? SEEK_SET : whence == LV_FS_SEEK_CUR ? SEEK_CUR : SEEK_END;
+    return fseek(file_p, (long)pos, w) == 0 ? LV_FS_RES_OK : LV_FS_RES_FS_ERR;
+}
+
+static lv_fs_res_t counting_tell_cb(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p)
+{
+    LV_UNUSED(drv);
+    *pos_p = (uint32_t)ftell(file_p);
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t counting_stat_cb(lv_fs_drv_t * drv, const char * path, lv_fs_stat_t * stat_p)
+{
+    LV_UNUSED(drv);
+    struct stat st;
+    if(stat(path, &st) != 0) return LV_FS_RES_NOT_EX;
+    stat_p->size = (uint32_t)st.st_size;
+    stat_p->mtime = (uint32_t)st.st_mtime;
+    return LV_FS_RES_OK;
+}
+
+static void copy_file(const char * from, const char * to)
+{
+    FILE * in = fopen(from, "rb");
+    FILE * out = fopen(to, "wb");
+    TEST_ASSERT_NOT_NULL(in);
+    TEST_ASSERT_NOT_NULL(out);
+    int c;
+    while((c = fgetc(in)) != EOF) fputc(c, out);
+    fclose(in);
+    fclose(out);
+}
+
+/*Flip some bits of a byte of the saved index file*/
+static void corrupt_index(long pos, uint8_t mask)
+{
+    FILE * fp = fopen("image_header_index_test.bin", "r+b");
+    TEST_ASSERT_NOT_NULL(fp);
+    fseek(fp, pos, SEEK_SET);
+    int c = fgetc(fp);
+    TEST_ASSERT_NOT_EQUAL(EOF, c);
+    fseek(fp, pos, SEEK_SET);
+    fputc(c ^ mask, fp);
+    fclose(fp);
+}
+
+/*Get the headers through the counting driver and compare them with the headers read by the decoders*/
+static void get_headers(void)
+{
+    uint32_t i;
+    for(i = 0; i < sizeof(images) / sizeof(images[0]); i++) {
+        char path[128];
+        lv_snprintf(path, sizeof(path), "T:%s", images[i]);
+        lv_image_header_t header;
+        TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_get_info(path, &header));
+
+        /*The stdio driver of 'A' has no read counting but it has `stat_cb` so it's indexed too*/
+        lv_image_header_t ref;
+        lv_snprintf(path, sizeof(path), "A:%s", images[i]);
+        lv_image_header_index_drop(path);
+        TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_get_info(path, &ref));
+        TEST_ASSERT_EQUAL_MEMORY(&ref, &header, sizeof(lv_image_header_t));
+    }
+}
+
+void setUp(void)
+{
+    if(lv_fs_get_drv('T') == NULL) {
+        lv_fs_drv_init(&counting_drv);
+        counting_drv.letter = 'T';
+        counting_drv.open_cb = counting_open_cb;
+        counting_drv.close_cb = counting_close_cb;
+        counting_drv.read_cb = counting_read_cb;
+        counting_drv.seek_cb = counting_seek_cb;
+        counting_drv.tell_cb = counting_tell_cb;
+        lv_fs_drv_register(&counting_drv);
+    }
+    counting_drv.stat_cb = counting_stat_cb;
+
+    remove("image_header_index_test.bin");
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_header_index_load(INDEX_PATH));
+    open_cnt = 0;
+}
+
+void tearDown(void)
+{
+    lv_image_header_index_deinit();
+    remove("image_header_index_test.bin");
+    remove(COPY_PATH);
+}
+
+void test_image_header_index_reboot(void)
+{
+    /*Some decoders open the images more than once*/
+    get_headers();
+    uint32_t probe_open_cnt = open_cnt;
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(3, probe_open_cnt);
+
+    /*Only the file metadata is read*/
+    get_headers();
+    TEST_ASSERT_EQUAL_UINT32(probe_open_cnt, open_cnt);
+
+    /*Saved on deinit and loaded on the next boot*/
+    lv_image_header_index_deinit();
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_header_index_load(INDEX_PATH));
+    get_headers();
+    TEST_ASSERT_EQUAL_UINT32(probe_open_cnt, open_cnt);
+}
+
+void test_image_header_index_changed(void)
+{
+    copy_file(images[0], COPY_PATH);
+    lv_image_header_t header;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_get_info("T:" COPY_PATH, &header));
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_get_info("T:" COPY_PATH, &header));
+    TEST_ASSERT_EQUAL_UINT32(1, open_cnt);
+
+    /*A different image with a different size is probed again*/
+    copy_file(images[2], COPY_PATH);
+    lv_image_header_t ref;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_get_info("A:" "src/test_assets/test_img_emoji_F600.png", &ref));
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_get_info("T:" COPY_PATH, &header));
+    TEST_ASSERT_EQUAL_UINT32(2, open_cnt);
+    TEST_ASSERT_EQUAL_MEMORY(&ref, &header, sizeof(lv_image_header_t));
+
+    /*Invalidating the image drops it from the index too*/
+    lv_image_cache_drop("T:" COPY_PATH);
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_get_info("T:" COPY_PATH, &header));
+    TEST_ASSERT_EQUAL_UINT32(3, open_cnt);
+
+    /*Missing files are not found in the index*/
+    remove(COPY_PATH);
+    TEST_ASSERT_EQUAL(LV_RESULT_INVALID, lv_image_decoder_get_info("T:" COPY_PATH, &header));
+}
+
+void test_image_header_index_no_stat(void)
+{
+    /*It couldn't be known whether the images have changed so they are not indexed*/
+    counting_drv.stat_cb = NULL;
+    get_headers();
+    uint32_t probe_open_cnt = open_cnt;
+    get_headers();
+    TEST_ASSERT_EQUAL_UINT32(2 * probe_open_cnt, open_cnt);
+}
+
+void test_image_header_index_lazy_save(void)
+{
+    lv_fs_file_t f;
+    get_headers();
+    uint32_t probe_open_cnt = open_cnt;
+    TEST_ASSERT_NOT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, INDEX_PATH, LV_FS_MODE_RD));
+
+    /*Saved by a timer*/
+    lv_tick_inc(1000);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, INDEX_PATH, LV_FS_MODE_RD));
+    lv_fs_close(&f);
+
+    /*A corrupted index is ignored*/
+    lv_image_header_index_deinit();
+    corrupt_index(40, 0x55);
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_header_index_load(INDEX_PATH));
+    open_cnt = 0;
+    get_headers();
+    TEST_ASSERT_EQUAL_UINT32(probe_open_cnt, open_cnt);
+
+    /*The entry count is in the header, a huge count is rejected before allocating for it*/
+    lv_image_header_index_deinit();
+    corrupt_index(ENTRY_CNT_OFFSET + 3, 0x80);
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_header_index_load(INDEX_PATH));
+    open_cnt = 0;
+    get_headers();
+    TEST_ASSERT_EQUAL_UINT32(probe_open_cnt, open_cnt);
+
+    /*A count that would fit into the file is caught by the checksum*/
+    lv_image_header_index_deinit();
+    corrupt_index(ENTRY_CNT_OFFSET, 1);
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_header_index_load(INDEX_PATH));
+    open_cnt = 0;
+    get_headers();
+    TEST_ASSERT_EQUAL_UINT32(probe_open_cnt, open_cnt);
+}
+
+#else
+
+void test_image_header_index_reboot(void)
+{
+}
+
+void test_image_header_index_changed(void)
+{
+}
+
+void test_image_header_index_no_stat(void)
+{
+}
+
+void test_image_header_index_lazy_save(void)
+{
+}
+
+#endif
+
+#endif
@@ -0,0 +1,339 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+#include "lv_test_indev.h"
+
+#if LV_INDEV_HIT_INDEX_CELL_SIZE
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_layer_top());
+    lv_obj_clean(lv_screen_active());
+    lv_obj_set_scroll_dir(lv_screen_active(), LV_DIR_ALL);
+}
+
+static lv_obj_t * tree_search(lv_point_t * p)
+{
+    lv_display_t * disp = lv_display_get_default();
+    lv_obj_t * roots[4] = {lv_display_get_layer_sys(disp), lv_display_get_layer_top(disp),
+                           lv_display_get_screen_active(disp), lv_display_get_layer_bottom(disp)
+                          };
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        lv_obj_t * obj = lv_indev_search_obj(roots[i], p);
+        if(obj) return obj;
+    }
+
+    return NULL;
+}
+
+/*Compare the index with walking the object tree on a grid of points*/
+static void assert_index_matches_tree(void)
+{
+    lv_display_t * disp = lv_display_get_default();
+    int32_t hor_res = lv_display_get_horizontal_resolution(disp);
+    int32_t ver_res = lv_display_get_vertical_resolution(disp);
+
+    lv_point_t p;
+    for(p.y = 0; p.y < ver_res; p.y += 7) {
+        for(p.x = 0; p.x < hor_res; p.x += 7) {
+            lv_obj_t * indexed = NULL;
+            TEST_ASSERT_TRUE(lv_indev_hit_index_search(disp, &p, &indexed));
+            TEST_ASSERT_EQUAL_PTR(tree_search(&p), indexed);
+        }
+    }
+}
+
+static lv_obj_t * button_create(lv_obj_t * parent, int32_t x, int32_t y, int32_t w, int32_t h)
+{
+    lv_obj_t * btn = lv_button_create(parent);
+    lv_obj_set_pos(btn, x, y);
+    lv_obj_set_size(btn, w, h);
+    return btn;
+}
+
+void test_indev_hit_index_overlapping(void)
+{
+    lv_obj_t * cont = lv_obj_create(lv_screen_active());
+    lv_obj_set_pos(cont, 50, 40);
+    lv_obj_set_size(cont, 300, 250);
+
+    /*Partially out of the container*/
+    button_create(cont, 10, 10, 100, 60);
+    button_create(cont, 60, 40, 100, 60);
+    button_create(cont, 200, 150, 150, 150);
+
+    lv_obj_t * label = lv_label_create(cont);
+    lv_label_set_text(label, "not clickable");
+    lv_obj_set_pos(label, 20, 20);
+
+    button_create(lv_layer_top(), 300, 200, 80, 80);
+    assert_index_matches_tree();
+}
+
+void test_indev_hit_index_flags(void)
+{
+    lv_obj_t * cont = lv_obj_create(lv_screen_active());
+    lv_obj_set_pos(cont, 20, 20);
+    lv_obj_set_size(cont, 200, 200);
+    lv_obj_remove_flag(cont, LV_OBJ_FLAG_SCROLLABLE);
+
+    lv_obj_t * btn1 = button_create(cont, 0, 0, 80, 80);
+    lv_obj_t * btn2 = button_create(cont, 150, 150, 100, 100);
+    lv_obj_t * btn3 = button_create(lv_screen_active(), 250, 20, 60, 60);
+    lv_obj_update_layout(cont);
+    assert_index_matches_tree();
+
+    lv_obj_add_flag(btn1, LV_OBJ_FLAG_HIDDEN);
+    assert_index_matches_tree();
+
+    lv_obj_remove_flag(btn3, LV_OBJ_FLAG_CLICKABLE);
+    assert_index_matches_tree();
+
+    lv_obj_set_ext_click_area(btn3, 15);
+    lv_obj_add_flag(btn3, LV_OBJ_FLAG_CLICKABLE);
+    assert_index_matches_tree();
+
+    /*btn2 sticks out of the container*/
+    lv_obj_set_style_shadow_width(cont, 50, 0);
+    lv_obj_add_flag(cont, LV_OBJ_FLAG_OVERFLOW_VISIBLE);
+    assert_index_matches_tree();
+
+    lv_obj_move_to_index(btn2, 0);
+    assert_index_matches_tree();
+
+    lv_obj_delete(btn2);
+    assert_index_matches_tree();
+}
+
+void test_indev_hit_index_position(void)
+{
+    lv_obj_t * btn = button_create(lv_screen_active(), 10, 10, 50, 50);
+    lv_obj_update_layout(btn);
+    assert_index_matches_tree();
+
+    lv_obj_set_pos(btn, 200, 100);
+    lv_obj_update_layout(btn);
+    assert_index_matches_tree();
+
+    lv_obj_set_size(btn, 150, 150);
+    lv_obj_update_layout(btn);
+    assert_index_matches_tree();
+
+    /*Not visible on the display*/
+    lv_obj_set_pos(btn, 2000, 100);
+    lv_obj_update_layout(btn);
+    assert_index_matches_tree();
+}
+
+void test_indev_hit_index_scroll(void)
+{
+    lv_obj_t * cont = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(cont, 300, 200);
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_COLUMN);
+
+    uint32_t i;
+    for(i = 0; i < 20; i++) {
+        lv_obj_t * btn = lv_button_create(cont);
+        lv_obj_set_size(btn, lv_pct(100), 40);
+    }
+
+    lv_obj_update_layout(cont);
+    assert_index_matches_tree();
+
+    lv_obj_scroll_to_y(cont, 300, LV_ANIM_OFF);
+    assert_index_matches_tree();
+
+    lv_obj_scroll_by(cont, 0, 77, LV_ANIM_OFF);
+    lv_refr_now(NULL);
+    assert_index_matches_tree();
+}
+
+void test_indev_hit_index_transform(void)
+{
+    lv_obj_t * cont = lv_obj_create(lv_screen_active());
+    lv_obj_set_pos(cont, 100, 50);
+    lv_obj_set_size(cont, 250, 250);
+    lv_obj_set_style_transform_rotation(cont, 300, 0);
+    lv_obj_set_style_transform_pivot_x(cont, 125, 0);
+    lv_obj_set_style_transform_pivot_y(cont, 125, 0);
+
+    button_create(cont, 0, 0, 100, 100);
+    button_create(cont, 120, 120, 80, 80);
+    button_create(lv_screen_active(), 0, 0, 120, 120);
+    lv_obj_update_layout(cont);
+    assert_index_matches_tree();
+
+    lv_obj_set_style_transform_scale(cont, 400, 0);
+    assert_index_matches_tree();
+}
+
+void test_indev_hit_index_screen_load(void)
+{
+    lv_obj_t * scr_ori = lv_screen_active();
+    button_create(scr_ori, 0, 0, 100, 100);
+    assert_index_matches_tree();
+
+    lv_obj_t * scr = lv_obj_create(NULL);
+    button_create(scr, 100, 100, 100, 100);
+    lv_screen_load(scr);
+    assert_index_matches_tree();
+
+    lv_screen_load(scr_ori);
+    lv_obj_delete(scr);
+    assert_index_matches_tree();
+}
+
+void test_indev_hit_index_redraw(void)
+{
+    lv_display_t * disp = lv_display_get_default();
+    lv_obj_t * btn = button_create(lv_screen_active(), 10, 10, 100, 50);
+    lv_obj_t * label = lv_label_create(btn);
+    lv_obj_set_width(label, 80);
+    lv_label_set_text(label, "abc");
+    lv_obj_t * spinner = lv_spinner_create(lv_screen_active());
+    lv_obj_update_layout(btn);
+    assert_index_matches_tree();
+
+    /*Redrawing doesn't change where the objects are*/
+    lv_obj_set_style_bg_color(btn, lv_color_hex(0xff0000), 0);
+    lv_label_set_text(label, "xyz");
+    lv_obj_invalidate(lv_screen_active());
+
+    /*Run only the animations as e.g. the size of the system monitor's label can change*/
+    uint32_t i;
+    for(i = 0; i < 10; i++) {
+        lv_tick_inc(50);
+        lv_anim_refr_now();
+        lv_refr_now(NULL);
+    }
+    TEST_ASSERT_TRUE(disp->hit_index->valid);
+    TEST_ASSERT_EQUAL_UINT32(0, disp->hit_index->dirty_cnt);
+
+    /*Only the cells around the moved object are updated*/
+    lv_obj_set_x(spinner, 300);
+    lv_obj_update_layout(spinner);
+    TEST_ASSERT_TRUE(disp->hit_index->valid);
+    TEST_ASSERT_EQUAL_UINT32(2, disp->hit_index->dirty_cnt);
+    uint32_t dirty_cell_cnt = lv_area_get_size(&disp->hit_index->dirty_areas[0]) +
+                              lv_area_get_size(&disp->hit_index->dirty_areas[1]);
+    TEST_ASSERT_LESS_THAN_UINT32(disp->hit_index->col_cnt * disp->hit_index->row_cnt / 4, dirty_cell_cnt);
+    assert_index_matches_tree();
+}
+
+void test_indev_hit_index_random_moves(void)
+{
+    lv_obj_t * btns[30];
+    uint32_t i;
+    lv_rand_set_seed(1);
+    for(i = 0; i < 30; i++) {
+        lv_obj_t * parent = i >= 10 ? btns[i % 10] : lv_screen_active();
+        btns[i] = button_create(parent, lv_rand(0, 400), lv_rand(0, 300), lv_rand(10, 120), lv_rand(10, 120));
+    }
+    lv_obj_update_layout(lv_screen_active());
+    assert_index_matches_tree();
+
+    uint32_t round;
+    for(round = 0; round < 20; round++) {
+        /*A few changes between searches, sometimes more than the dirty areas*/
+        uint32_t change_cnt = round % 4 == 3 ? 3 * LV_INDEV_HIT_INDEX_DIRTY_MAX : 3;
+        for(i = 0; i < change_cnt; i++) {
+            lv_obj_t * btn = btns[lv_rand(0, 29)];
+            switch(lv_rand(0, 4)) {
+                case 0:
+                    lv_obj_set_pos(btn, lv_rand(0, 400), lv_rand(0, 300));
+                    break;
+                case 1:
+                    lv_obj_set_size(btn, lv_rand(10, 120), lv_rand(10, 120));
+                    break;
+                case 2:
+                    if(lv_obj_has_flag(btn, LV_OBJ_FLAG_HIDDEN)) lv_obj_remove_flag(btn, LV_OBJ_FLAG_HIDDEN);
+                    else lv_obj_add_flag(btn, LV_OBJ_FLAG_HIDDEN);
+                    break;
+                case 3:
+                    lv_obj_move_foreground(btn);
+                    break;
+                default:
+                    lv_obj_set_ext_click_area(btn, lv_rand(0, 20));
+                    break;
+            }
+            lv_obj_update_layout(btn);
+        }
+        assert_index_matches_tree();
+    }
+}
+
+static void click_event_cb(lv_event_t * e)
+{
+    uint32_t * cnt = lv_event_get_user_data(e);
+    (*cnt)++;
+}
+
+void test_indev_hit_index_click(void)
+{
+    uint32_t cnt1 = 0;
+    uint32_t cnt2 = 0;
+    lv_obj_t * btn1 = button_create(lv_screen_active(), 10, 10, 100, 100);
+    lv_obj_t * btn2 = button_create(lv_screen_active(), 60, 60, 100, 100);
+    lv_obj_add_event_cb(btn1, click_event_cb, LV_EVENT_CLICKED, &cnt1);
+    lv_obj_add_event_cb(btn2, click_event_cb, LV_EVENT_CLICKED, &cnt2);
+
+    lv_test_mouse_click_at(30, 30);
+    lv_test_mouse_click_at(80, 80);
+    TEST_ASSERT_EQUAL_UINT32(1, cnt1);
+    TEST_ASSERT_EQUAL_UINT32(1, cnt2);
+
+    lv_obj_move_foreground(btn1);
+    lv_test_mouse_click_at(80, 80);
+    TEST_ASSERT_EQUAL_UINT32(2, cnt1);
+    TEST_ASSERT_EQUAL_UINT32(1, cnt2);
+}
+
+#else
+
+void test_indev_hit_index_overlapping(void)
+{
+}
+
+void test_indev_hit_index_flags(void)
+{
+}
+
+void test_indev_hit_index_position(void)
+{
+}
+
+void test_indev_hit_index_scroll(void)
+{
+}
+
+void test_indev_hit_index_transform(void)
+{
+}
+
+void test_indev_hit_index_screen_load(void)
+{
+}
+
+void test_indev_hit_index_redraw(void)
+{
+}
+
+void test_indev_hit_index_random_moves(void)
+{
+}
+
+void test_indev_hit_index_click(void)
+{
+}
+
+#endif
+
+#endif
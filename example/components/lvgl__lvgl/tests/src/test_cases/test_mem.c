@@ -24,4 +24,123 @@ void test_mem_buf_realloc(void)
 #endif
 }
 
+#if LV_MEM_SLAB_SIZE
+
+static size_t slab_used_size(void)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.slab_used_size;
+}
+
+void test_mem_slab_alloc_free(void)
+{
+    size_t used_ori = slab_used_size();
+
+    uint8_t * bufs[200];
+    uint32_t i;
+    for(i = 0; i < 200; i++) {
+        bufs[i] = lv_malloc(40);
+        TEST_ASSERT_NOT_NULL(bufs[i]);
+        lv_memset(bufs[i], (uint8_t)i, 40);
+    }
+
+    /*Rounded up to the 48 bytes size class*/
+    TEST_ASSERT_EQUAL_size_t(used_ori + 200 * 48, slab_used_size());
+
+    /*Free every second one and allocate them again*/
+    for(i = 0; i < 200; i += 2) lv_free(bufs[i]);
+    TEST_ASSERT_EQUAL_size_t(used_ori + 100 * 48, slab_used_size());
+    for(i = 0; i < 200; i += 2) {
+        bufs[i] = lv_malloc_zeroed(33);
+        TEST_ASSERT_EACH_EQUAL_UINT8(0, bufs[i], 33);
+        lv_memset(bufs[i], (uint8_t)i, 40);
+    }
+
+    for(i = 0; i < 200; i++) {
+        TEST_ASSERT_EACH_EQUAL_UINT8((uint8_t)i, bufs[i], 40);
+        lv_free(bufs[i]);
+    }
+
+    TEST_ASSERT_EQUAL_size_t(used_ori, slab_used_size());
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_mem_test());
+}
+
+void test_mem_slab_large_alloc(void)
+{
+    size_t used_ori = slab_used_size();
+
+    void * buf = lv_malloc(257);
+    TEST_ASSERT_NOT_NULL(buf);
+    TEST_ASSERT_EQUAL_size_t(used_ori, slab_used_size());
+    lv_free(buf);
+
+    buf = lv_malloc(256);
+    TEST_ASSERT_EQUAL_size_t(used_ori + 256, slab_used_size());
+    lv_free(buf);
+    TEST_ASSERT_EQUAL_size_t(used_ori, slab_used_size());
+}
+
+void test_mem_slab_realloc(void)
+{
+    size_t used_ori = slab_used_size();
+
+    uint8_t * buf = lv_malloc(20);
+    lv_memset(buf, 0x5a, 20);
+
+    /*Stays in the same size class*/
+    TEST_ASSERT_EQUAL_PTR(buf, lv_realloc(buf, 32));
+    TEST_ASSERT_EQUAL_PTR(buf, lv_realloc(buf, 17));
+
+    /*Moved to another size class*/
+    buf = lv_realloc(buf, 100);
+    TEST_ASSERT_EACH_EQUAL_UINT8(0x5a, buf, 20);
+    TEST_ASSERT_EQUAL_size_t(used_ori + 112, slab_used_size());
+
+    /*Moved out of the slabs*/
+    lv_memset(buf, 0xa5, 100);
+    buf = lv_realloc(buf, 1000);
+    TEST_ASSERT_EACH_EQUAL_UINT8(0xa5, buf, 100);
+    TEST_ASSERT_EQUAL_size_t(used_ori, slab_used_size());
+
+    lv_free(buf);
+}
+
+void test_mem_slab_integrity(void)
+{
+    uint8_t * buf1 = lv_malloc(40);
+    uint8_t * buf2 = lv_malloc(40);
+    lv_free(buf1);
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_mem_test());
+
+    /*A write after free overwrites the link to the next free block*/
+    void * next = *(void **)buf1;
+    *(void **)buf1 = buf1 + 1;
+    TEST_ASSERT_EQUAL(LV_RESULT_INVALID, lv_mem_test());
+    *(void **)buf1 = next;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_mem_test());
+
+    lv_free(buf2);
+}
+
+#else
+
+void test_mem_slab_alloc_free(void)
+{
+}
+
+void test_mem_slab_large_alloc(void)
+{
+}
+
+void test_mem_slab_realloc(void)
+{
+}
+
+void test_mem_slab_integrity(void)
+{
+}
+
+#endif
+
 #endif
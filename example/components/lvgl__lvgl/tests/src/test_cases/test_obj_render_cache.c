@@ -0,0 +1,231 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#define CACHE_HOR_RES 240
+#define CACHE_VER_RES 160
+
+static lv_display_t * disp_ori;
+static lv_display_t * disp;
+static lv_draw_buf_t * buf;
+static uint8_t ref_img[CACHE_VER_RES * CACHE_HOR_RES * 4];
+static uint32_t label_draw_cnt;
+
+static void flush_cb(lv_display_t * d, const lv_area_t * area, uint8_t * px_map)
+{
+    LV_UNUSED(area);
+    LV_UNUSED(px_map);
+    lv_display_flush_ready(d);
+}
+
+static void draw_main_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+    label_draw_cnt++;
+}
+
+void setUp(void)
+{
+    disp_ori = lv_display_get_default();
+    disp = lv_display_create(CACHE_HOR_RES, CACHE_VER_RES);
+    buf = lv_draw_buf_create(CACHE_HOR_RES, CACHE_VER_RES, LV_COLOR_FORMAT_ARGB8888, 0);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_ARGB8888);
+    lv_display_set_draw_buffers(disp, buf, NULL);
+    lv_display_set_render_mode(disp, LV_DISPLAY_RENDER_MODE_DIRECT);
+    lv_display_set_flush_cb(disp, flush_cb);
+    lv_display_set_default(disp);
+    lv_obj_set_style_bg_opa(lv_screen_active(), LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(lv_screen_active(), lv_color_hex(0xdde4ee), 0);
+
+    lv_obj_render_cache_resize(512 * 1024, true);
+    label_draw_cnt = 0;
+}
+
+void tearDown(void)
+{
+    lv_display_delete(disp);
+    lv_draw_buf_destroy(buf);
+    lv_display_set_default(disp_ori);
+    lv_obj_render_cache_resize(0, true);
+}
+
+static lv_obj_t * card_create(int32_t x, int32_t y)
+{
+    lv_obj_t * card = lv_obj_create(lv_screen_active());
+    lv_obj_set_pos(card, x, y);
+    lv_obj_set_size(card, 100, 110);
+    lv_obj_set_style_radius(card, 15, 0);
+    lv_obj_set_style_shadow_width(card, 12, 0);
+    lv_obj_set_style_shadow_opa(card, LV_OPA_50, 0);
+    lv_obj_remove_flag(card, LV_OBJ_FLAG_SCROLLABLE);
+
+    lv_obj_t * label = lv_label_create(card);
+    lv_label_set_text(label, "BMI");
+    lv_obj_align(label, LV_ALIGN_TOP_RIGHT, 0, 0);
+    lv_obj_add_event_cb(label, draw_main_cb, LV_EVENT_DRAW_MAIN_BEGIN, NULL);
+
+    lv_obj_t * arc = lv_arc_create(card);
+    lv_obj_set_size(arc, 60, 60);
+    lv_obj_align(arc, LV_ALIGN_BOTTOM_MID, 0, 0);
+    lv_arc_set_value(arc, 40);
+
+    return card;
+}
+
+static void save_ref(void)
+{
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(disp);
+    int32_t y;
+    for(y = 0; y < CACHE_VER_RES; y++) {
+        lv_memcpy(&ref_img[y * CACHE_HOR_RES * 4], lv_draw_buf_goto_xy(buf, 0, y), CACHE_HOR_RES * 4);
+    }
+}
+
+/*Semi-transparent pixels are blended twice from the cache so allow some rounding difference*/
+static void assert_ref(void)
+{
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < CACHE_VER_RES; y++) {
+        const uint8_t * ref = &ref_img[y * CACHE_HOR_RES * 4];
+        const uint8_t * act = lv_draw_buf_goto_xy(buf, 0, y);
+        for(x = 0; x < CACHE_HOR_RES * 4; x++) {
+            TEST_ASSERT_INT_WITHIN(2, ref[x], act[x]);
+        }
+    }
+}
+
+static uint32_t cache_size(void)
+{
+    return lv_cache_get_size(LV_GLOBAL_DEFAULT()->obj_render_cache, NULL);
+}
+
+void test_obj_render_cache_draw(void)
+{
+    lv_obj_t * card = card_create(20, 20);
+    save_ref();
+
+    lv_obj_add_flag(card, LV_OBJ_FLAG_RENDER_CACHE);
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(disp);
+    TEST_ASSERT_NOT_EQUAL(0, cache_size());
+    assert_ref();
+
+    /*Redraw from the cache*/
+    label_draw_cnt = 0;
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(disp);
+    TEST_ASSERT_EQUAL(0, label_draw_cnt);
+    assert_ref();
+
+    lv_obj_remove_flag(card, LV_OBJ_FLAG_RENDER_CACHE);
+    TEST_ASSERT_EQUAL(0, cache_size());
+}
+
+void test_obj_render_cache_invalidate_child(void)
+{
+    lv_obj_t * card = card_create(20, 20);
+    lv_obj_add_flag(card, LV_OBJ_FLAG_RENDER_CACHE);
+    lv_refr_now(disp);
+
+    /*Drawing an object above the card shouldn't render it again*/
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_set_pos(obj, 60, 60);
+    lv_obj_set_size(obj, 100, 30);
+    label_draw_cnt = 0;
+    lv_refr_now(disp);
+    TEST_ASSERT_EQUAL(0, label_draw_cnt);
+
+    /*Changing a child should*/
+    lv_arc_set_value(lv_obj_get_child(card, 1), 80);
+    lv_refr_now(disp);
+    TEST_ASSERT_EQUAL(1, label_draw_cnt);
+
+    /*The cached image shows the new text*/
+    lv_label_set_text(lv_obj_get_child(card, 0), "SpO2");
+    lv_refr_now(disp);
+    save_ref();
+
+    lv_obj_remove_flag(card, LV_OBJ_FLAG_RENDER_CACHE);
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(disp);
+    assert_ref();
+}
+
+void test_obj_render_cache_scroll(void)
+{
+    /*The scrolled state of the default theme refreshes the style of the children*/
+    lv_obj_t * cont = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(cont);
+    lv_obj_set_size(cont, CACHE_HOR_RES, CACHE_VER_RES);
+    lv_obj_t * card = card_create(0, 0);
+    lv_obj_set_parent(card, cont);
+    lv_obj_t * filler = lv_obj_create(cont);
+    lv_obj_set_pos(filler, 0, 300);
+
+    lv_obj_add_flag(card, LV_OBJ_FLAG_RENDER_CACHE);
+    lv_refr_now(disp);
+
+    /*The cached image is reused when scrolled with the parent*/
+    label_draw_cnt = 0;
+    lv_obj_scroll_to_y(cont, 17, LV_ANIM_OFF);
+    lv_refr_now(disp);
+    TEST_ASSERT_EQUAL(0, label_draw_cnt);
+
+    lv_obj_scroll_to_y(cont, 23, LV_ANIM_OFF);
+    lv_refr_now(disp);
+    lv_obj_remove_flag(card, LV_OBJ_FLAG_RENDER_CACHE);
+    save_ref();
+    lv_obj_add_flag(card, LV_OBJ_FLAG_RENDER_CACHE);
+    lv_obj_scroll_to_y(cont, 0, LV_ANIM_OFF);
+    lv_refr_now(disp);
+    lv_obj_scroll_to_y(cont, 23, LV_ANIM_OFF);
+    lv_refr_now(disp);
+    assert_ref();
+}
+
+void test_obj_render_cache_evict(void)
+{
+    lv_obj_t * card1 = card_create(0, 0);
+    lv_obj_t * card2 = card_create(120, 0);
+    lv_obj_add_flag(card1, LV_OBJ_FLAG_RENDER_CACHE);
+    lv_obj_add_flag(card2, LV_OBJ_FLAG_RENDER_CACHE);
+    lv_refr_now(disp);
+    uint32_t two_cards = cache_size();
+
+    /*Only one card fits, the other is drawn normally*/
+    lv_obj_render_cache_resize(two_cards / 2 + 100, true);
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(disp);
+    TEST_ASSERT_EQUAL(two_cards / 2, cache_size());
+
+    label_draw_cnt = 0;
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(disp);
+    TEST_ASSERT_EQUAL(1, label_draw_cnt);
+
+    /*Free the image of the deleted object*/
+    lv_obj_delete(card1);
+    lv_obj_delete(card2);
+    TEST_ASSERT_EQUAL(0, cache_size());
+}
+
+void test_obj_render_cache_disabled(void)
+{
+    lv_obj_render_cache_resize(0, true);
+
+    lv_obj_t * card = card_create(20, 20);
+    lv_obj_add_flag(card, LV_OBJ_FLAG_RENDER_CACHE);
+    save_ref();
+
+    label_draw_cnt = 0;
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(disp);
+    TEST_ASSERT_EQUAL(1, label_draw_cnt);
+    assert_ref();
+}
+
+#endif
@@ -0,0 +1,260 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#define BLIT_HOR_RES 200
+#define BLIT_VER_RES 150
+#define PANEL_STRIDE (BLIT_HOR_RES * 4)
+
+static lv_display_t * disp_ori;
+static lv_display_t * disp;
+static lv_draw_buf_t * buf1;
+static lv_draw_buf_t * buf2;
+static uint8_t panel[BLIT_VER_RES * PANEL_STRIDE];
+static uint8_t ref_img[BLIT_VER_RES * PANEL_STRIDE];
+static uint8_t * last_buf;
+static uint32_t flushed_px_cnt;
+static uint32_t move_area_cnt;
+static lv_obj_t * cont;
+
+static void direct_flush_cb(lv_display_t * d, const lv_area_t * area, uint8_t * px_map)
+{
+    flushed_px_cnt += lv_area_get_size(area);
+    if(lv_display_flush_is_last(d)) last_buf = px_map;
+    lv_display_flush_ready(d);
+}
+
+static void partial_flush_cb(lv_display_t * d, const lv_area_t * area, uint8_t * px_map)
+{
+    flushed_px_cnt += lv_area_get_size(area);
+
+    uint32_t w = lv_area_get_width(area) * 4;
+    uint32_t stride = lv_draw_buf_width_to_stride(lv_area_get_width(area), LV_COLOR_FORMAT_ARGB8888);
+    int32_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_memcpy(&panel[y * PANEL_STRIDE + area->x1 * 4], px_map, w);
+        px_map += stride;
+    }
+    lv_display_flush_ready(d);
+}
+
+static void move_area_cb(lv_display_t * d, const lv_area_t * area, int32_t dx, int32_t dy)
+{
+    LV_UNUSED(d);
+    move_area_cnt++;
+
+    lv_area_t dest = *area;
+    lv_area_move(&dest, dx, dy);
+    TEST_ASSERT_TRUE(lv_area_intersect(&dest, &dest, area));
+
+    uint32_t w = lv_area_get_width(&dest) * 4;
+    int32_t h = lv_area_get_height(&dest);
+    int32_t i;
+    for(i = 0; i < h; i++) {
+        int32_t y = dy > 0 ? dest.y2 - i : dest.y1 + i;
+        lv_memmove(&panel[y * PANEL_STRIDE + dest.x1 * 4], &panel[(y - dy) * PANEL_STRIDE + (dest.x1 - dx) * 4], w);
+    }
+}
+
+static void create_display(lv_display_render_mode_t mode, bool double_buf)
+{
+    disp = lv_display_create(BLIT_HOR_RES, BLIT_VER_RES);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_ARGB8888);
+    if(mode == LV_DISPLAY_RENDER_MODE_PARTIAL) {
+        buf1 = lv_draw_buf_create(BLIT_HOR_RES, 20, LV_COLOR_FORMAT_ARGB8888, 0);
+        lv_display_set_draw_buffers(disp, buf1, NULL);
+        lv_display_set_flush_cb(disp, partial_flush_cb);
+        lv_display_set_move_area_cb(disp, move_area_cb);
+    }
+    else {
+        buf1 = lv_draw_buf_create(BLIT_HOR_RES, BLIT_VER_RES, LV_COLOR_FORMAT_ARGB8888, 0);
+        if(double_buf) buf2 = lv_draw_buf_create(BLIT_HOR_RES, BLIT_VER_RES, LV_COLOR_FORMAT_ARGB8888, 0);
+        lv_display_set_draw_buffers(disp, buf1, buf2);
+        lv_display_set_flush_cb(disp, direct_flush_cb);
+    }
+    lv_display_set_render_mode(disp, mode);
+    lv_display_set_scroll_blit(disp, true);
+    lv_display_set_default(disp);
+
+    lv_obj_t * scr = lv_screen_active();
+    lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x223344), 0);
+
+    /*Without the theme's styles to avoid redrawing on LV_STATE_SCROLLED*/
+    cont = lv_obj_create(scr);
+    lv_obj_remove_style_all(cont);
+    lv_obj_set_pos(cont, 10, 12);
+    lv_obj_set_size(cont, 150, 120);
+    lv_obj_set_style_bg_opa(cont, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(cont, lv_color_white(), 0);
+    lv_obj_set_style_border_width(cont, 2, 0);
+    lv_obj_set_style_border_color(cont, lv_color_hex(0x0000ff), 0);
+    lv_obj_set_style_radius(cont, 5, 0);
+    lv_obj_set_style_pad_all(cont, 4, 0);
+    lv_obj_set_style_width(cont, 4, LV_PART_SCROLLBAR);
+    lv_obj_set_style_pad_right(cont, 3, LV_PART_SCROLLBAR);
+    lv_obj_set_style_bg_opa(cont, LV_OPA_COVER, LV_PART_SCROLLBAR);
+    lv_obj_set_scrollbar_mode(cont, LV_SCROLLBAR_MODE_ON);
+
+    uint32_t i;
+    for(i = 0; i < 20; i++) {
+        lv_obj_t * item = lv_obj_create(cont);
+        lv_obj_remove_style_all(item);
+        lv_obj_set_style_bg_opa(item, LV_OPA_COVER, 0);
+        lv_obj_set_style_bg_color(item, lv_palette_main(i % LV_PALETTE_LAST), 0);
+        lv_obj_set_pos(item, (i * 13) % 60, i * 17);
+        lv_obj_set_size(item, 70, 14);
+    }
+
+    /*Doesn't move with the content*/
+    lv_obj_t * floating = lv_obj_create(cont);
+    lv_obj_remove_style_all(floating);
+    lv_obj_add_flag(floating, LV_OBJ_FLAG_FLOATING);
+    lv_obj_set_style_bg_opa(floating, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(floating, lv_color_black(), 0);
+    lv_obj_set_pos(floating, 100, 40);
+    lv_obj_set_size(floating, 20, 20);
+
+    /*Drawn on the scrolled area*/
+    lv_obj_t * above = lv_obj_create(scr);
+    lv_obj_remove_style_all(above);
+    lv_obj_set_style_bg_opa(above, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(above, lv_color_hex(0xff00ff), 0);
+    lv_obj_set_pos(above, 120, 80);
+    lv_obj_set_size(above, 40, 20);
+
+    /*Hide the performance and memory monitors*/
+    lv_obj_t * sys_layer = lv_display_get_layer_sys(disp);
+    for(i = 0; i < lv_obj_get_child_count(sys_layer); i++) {
+        lv_obj_add_flag(lv_obj_get_child(sys_layer, i), LV_OBJ_FLAG_HIDDEN);
+    }
+
+    lv_refr_now(disp);
+}
+
+static const uint8_t * get_image(void)
+{
+    if(disp->render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL) return panel;
+    return last_buf;
+}
+
+static void copy_image(uint8_t * dest)
+{
+    const uint8_t * src = get_image();
+    uint32_t stride = disp->render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL ? PANEL_STRIDE : buf1->header.stride;
+    int32_t y;
+    for(y = 0; y < BLIT_VER_RES; y++) {
+        lv_memcpy(&dest[y * PANEL_STRIDE], &src[y * stride], PANEL_STRIDE);
+    }
+}
+
+/*Scroll, compare with a full redraw and return the number of redrawn pixels*/
+static uint32_t scroll_and_check(int32_t dx, int32_t dy)
+{
+    static uint8_t img[BLIT_VER_RES * PANEL_STRIDE];
+
+    flushed_px_cnt = 0;
+    lv_obj_scroll_by(cont, dx, dy, LV_ANIM_OFF);
+    lv_refr_now(disp);
+    uint32_t px_cnt = flushed_px_cnt;
+    copy_image(img);
+
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(disp);
+    copy_image(ref_img);
+
+    TEST_ASSERT_EQUAL_MEMORY(ref_img, img, sizeof(img));
+    return px_cnt;
+}
+
+void setUp(void)
+{
+    disp_ori = lv_display_get_default();
+    buf1 = NULL;
+    buf2 = NULL;
+    move_area_cnt = 0;
+}
+
+void tearDown(void)
+{
+    lv_display_delete(disp);
+    lv_draw_buf_destroy(buf1);
+    if(buf2) lv_draw_buf_destroy(buf2);
+    lv_display_set_default(disp_ori);
+    lv_obj_render_cache_resize(0, true);
+}
+
+static void scroll_steps(void)
+{
+    /*Only the exposed area and what doesn't scroll with the content should be redrawn*/
+    uint32_t cont_size = lv_area_get_size(&cont->coords);
+    TEST_ASSERT_LESS_THAN(cont_size / 2, scroll_and_check(0, -7));
+    TEST_ASSERT_LESS_THAN(cont_size / 2, scroll_and_check(0, -13));
+    TEST_ASSERT_LESS_THAN(cont_size / 2, scroll_and_check(0, 5));
+    scroll_and_check(-9, -3);
+    scroll_and_check(0, -200);
+}
+
+void test_scroll_blit_direct(void)
+{
+    create_display(LV_DISPLAY_RENDER_MODE_DIRECT, false);
+    scroll_steps();
+}
+
+void test_scroll_blit_direct_double_buffered(void)
+{
+    create_display(LV_DISPLAY_RENDER_MODE_DIRECT, true);
+    scroll_steps();
+}
+
+void test_scroll_blit_partial(void)
+{
+    create_display(LV_DISPLAY_RENDER_MODE_PARTIAL, false);
+    scroll_steps();
+    TEST_ASSERT_NOT_EQUAL(0, move_area_cnt);
+}
+
+void test_scroll_blit_outdated_area(void)
+{
+    create_display(LV_DISPLAY_RENDER_MODE_DIRECT, false);
+
+    /*Change a child and scroll before refreshing*/
+    lv_obj_set_style_bg_color(lv_obj_get_child(cont, 3), lv_color_hex(0x00ff00), 0);
+    scroll_and_check(0, -11);
+}
+
+void test_scroll_blit_not_eligible(void)
+{
+    create_display(LV_DISPLAY_RENDER_MODE_PARTIAL, false);
+
+    lv_obj_set_style_bg_opa(cont, LV_OPA_50, 0);
+    scroll_and_check(0, -7);
+    TEST_ASSERT_EQUAL(0, move_area_cnt);
+}
+
+void test_scroll_blit_render_cache(void)
+{
+    create_display(LV_DISPLAY_RENDER_MODE_PARTIAL, false);
+
+    /*Nothing else is invalidated when the whole area is moved*/
+    lv_obj_set_style_border_width(cont, 0, 0);
+    lv_obj_set_style_radius(cont, 0, 0);
+    lv_obj_set_scrollbar_mode(cont, LV_SCROLLBAR_MODE_OFF);
+
+    /*The cached image of the parent would show the old scroll position*/
+    lv_obj_render_cache_resize(512 * 1024, true);
+    lv_obj_t * wrapper = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(wrapper);
+    lv_obj_set_size(wrapper, LV_PCT(100), LV_PCT(100));
+    lv_obj_add_flag(wrapper, LV_OBJ_FLAG_RENDER_CACHE);
+    lv_obj_move_to_index(wrapper, 0);
+    lv_obj_set_parent(cont, wrapper);
+    lv_refr_now(disp);
+
+    scroll_and_check(0, -7);
+    TEST_ASSERT_EQUAL(0, move_area_cnt);
+}
+
+#endif
@@ -5,6 +5,16 @@
 #include "unity/unity.h"
 #include <unistd.h>
 
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+    /*Some tests use styles from their stack so don't keep their objects*/
+    lv_obj_clean(lv_screen_active());
+}
+
 static void obj_set_height_helper(void * obj, int32_t height)
 {
     lv_obj_set_height((lv_obj_t *)obj, (int32_t)height);
@@ -141,4 +151,102 @@ void test_style_has_prop(void)
     lv_style_reset(&style);
 }
 
+void test_style_resolved_state_change(void)
+{
+    lv_style_t style_pr;
+    lv_style_init(&style_pr);
+    lv_style_set_bg_color(&style_pr, lv_color_hex(0xff0000));
+
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_style_bg_color(obj, lv_color_hex(0x00ff00), LV_PART_MAIN);
+    lv_obj_add_style(obj, &style_pr, LV_PART_MAIN | LV_STATE_PRESSED);
+
+    /*Get the same properties several times in each state*/
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x00ff00), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+        TEST_ASSERT_EQUAL(0, lv_obj_get_style_border_width(obj, LV_PART_MAIN));
+    }
+
+    lv_obj_add_state(obj, LV_STATE_PRESSED);
+    for(i = 0; i < 2; i++) {
+        TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0xff0000), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+    }
+    TEST_ASSERT_TRUE(lv_obj_has_style_prop(obj, LV_PART_MAIN | LV_STATE_DEFAULT, LV_STYLE_BG_COLOR));
+    TEST_ASSERT_FALSE(lv_obj_has_style_prop(obj, LV_PART_MAIN | LV_STATE_FOCUSED, LV_STYLE_BORDER_WIDTH));
+
+    lv_obj_remove_state(obj, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x00ff00), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+
+#if LV_OBJ_STYLE_RESOLVED_CACHE_SIZE
+    TEST_ASSERT_NOT_NULL(obj->style_resolved);
+#endif
+
+    lv_obj_delete(obj);
+    lv_style_reset(&style_pr);
+}
+
+void test_style_resolved_style_change(void)
+{
+    lv_style_t style;
+    lv_style_init(&style);
+    lv_style_set_radius(&style, 5);
+
+    lv_obj_t * parent = lv_obj_create(lv_screen_active());
+    lv_obj_t * obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_add_style(obj, &style, LV_PART_MAIN);
+    lv_obj_set_style_text_color(parent, lv_color_hex(0x0000ff), LV_PART_MAIN);
+    TEST_ASSERT_EQUAL(5, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x0000ff), lv_obj_get_style_text_color(obj, LV_PART_MAIN));
+
+    /*Shared style modified and reported*/
+    lv_style_set_radius(&style, 8);
+    lv_obj_report_style_change(&style);
+    TEST_ASSERT_EQUAL(8, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+
+    /*Local style*/
+    lv_obj_set_style_radius(obj, 3, LV_PART_MAIN);
+    TEST_ASSERT_EQUAL(3, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+    lv_obj_remove_local_style_prop(obj, LV_STYLE_RADIUS, LV_PART_MAIN);
+    TEST_ASSERT_EQUAL(8, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+
+    /*Inherited from the parent*/
+    lv_obj_set_style_text_color(parent, lv_color_hex(0xff00ff), LV_PART_MAIN);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0xff00ff), lv_obj_get_style_text_color(obj, LV_PART_MAIN));
+
+    lv_obj_remove_style(obj, &style, LV_PART_MAIN);
+    TEST_ASSERT_EQUAL(0, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+
+    lv_obj_delete(parent);
+    lv_style_reset(&style);
+}
+
+void test_style_resolved_transition(void)
+{
+    static const lv_style_prop_t props[] = {LV_STYLE_BG_OPA, 0};
+    static lv_style_transition_dsc_t tr;
+    lv_style_transition_dsc_init(&tr, props, lv_anim_path_linear, 100, 0, NULL);
+
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_set_style_bg_opa(obj, LV_OPA_0, LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, LV_PART_MAIN | LV_STATE_PRESSED);
+    lv_obj_set_style_transition(obj, &tr, LV_PART_MAIN | LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL(LV_OPA_0, lv_obj_get_style_bg_opa(obj, LV_PART_MAIN));
+
+    lv_obj_add_state(obj, LV_STATE_PRESSED);
+    lv_tick_inc(50);
+    lv_timer_handler();
+    lv_opa_t opa = lv_obj_get_style_bg_opa(obj, LV_PART_MAIN);
+    TEST_ASSERT_GREATER_THAN(LV_OPA_0, opa);
+    TEST_ASSERT_LESS_THAN(LV_OPA_COVER, opa);
+
+    lv_tick_inc(100);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(LV_OPA_COVER, lv_obj_get_style_bg_opa(obj, LV_PART_MAIN));
+
+    lv_obj_delete(obj);
+}
+
 #endif
@@ -0,0 +1,210 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#define OTHER_TIMER_MAX 16
+
+/*The timers of LVGL are paused to have only the timers of the tests*/
+static lv_timer_t * other_timers[OTHER_TIMER_MAX];
+static uint32_t other_timer_cnt;
+
+static uint32_t run_cnt[4];
+static lv_timer_t * timers[4];
+static lv_timer_t * created_timer;
+static uint32_t run_order[8];
+static uint32_t run_order_cnt;
+
+void setUp(void)
+{
+    other_timer_cnt = 0;
+    lv_timer_t * timer = lv_timer_get_next(NULL);
+    while(timer) {
+        if(!lv_timer_get_paused(timer)) {
+            TEST_ASSERT_LESS_THAN(OTHER_TIMER_MAX, other_timer_cnt);
+            other_timers[other_timer_cnt++] = timer;
+            lv_timer_pause(timer);
+        }
+        timer = lv_timer_get_next(timer);
+    }
+
+    lv_memzero(run_cnt, sizeof(run_cnt));
+    lv_memzero(timers, sizeof(timers));
+    created_timer = NULL;
+    run_order_cnt = 0;
+}
+
+void tearDown(void)
+{
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        if(timers[i]) lv_timer_delete(timers[i]);
+    }
+    if(created_timer) lv_timer_delete(created_timer);
+
+    for(i = 0; i < other_timer_cnt; i++) {
+        lv_timer_resume(other_timers[i]);
+    }
+}
+
+static void count_cb(lv_timer_t * timer)
+{
+    uint32_t id = (uint32_t)(uintptr_t)lv_timer_get_user_data(timer);
+    run_cnt[id]++;
+    if(run_order_cnt < 8) run_order[run_order_cnt++] = id;
+}
+
+static void delete_other_cb(lv_timer_t * timer)
+{
+    count_cb(timer);
+    lv_timer_delete(timers[1]);
+    timers[1] = NULL;
+}
+
+static void delete_self_cb(lv_timer_t * timer)
+{
+    count_cb(timer);
+    lv_timer_delete(timer);
+    timers[0] = NULL;
+}
+
+static void create_cb(lv_timer_t * timer)
+{
+    count_cb(timer);
+    if(created_timer == NULL) created_timer = lv_timer_create(count_cb, 0, (void *)(uintptr_t)3);
+}
+
+void test_timer_period(void)
+{
+    timers[0] = lv_timer_create(count_cb, 10, (void *)(uintptr_t)0);
+    timers[1] = lv_timer_create(count_cb, 25, (void *)(uintptr_t)1);
+
+    uint32_t i;
+    for(i = 0; i < 100; i++) {
+        lv_tick_inc(1);
+        lv_timer_handler();
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(10, run_cnt[0]);
+    TEST_ASSERT_EQUAL_UINT32(4, run_cnt[1]);
+
+    /*Paused timers don't run*/
+    lv_timer_pause(timers[0]);
+    for(i = 0; i < 100; i++) {
+        lv_tick_inc(1);
+        lv_timer_handler();
+    }
+    TEST_ASSERT_EQUAL_UINT32(10, run_cnt[0]);
+    TEST_ASSERT_EQUAL_UINT32(8, run_cnt[1]);
+
+    /*The new period is applied*/
+    lv_timer_resume(timers[0]);
+    lv_timer_set_period(timers[1], 200);
+    for(i = 0; i < 100; i++) {
+        lv_tick_inc(1);
+        lv_timer_handler();
+    }
+    TEST_ASSERT_EQUAL_UINT32(20, run_cnt[0]);
+    TEST_ASSERT_EQUAL_UINT32(8, run_cnt[1]);
+}
+
+void test_timer_order(void)
+{
+    /*The earlier deadline first, the newer timer first if they are due at the same time*/
+    timers[0] = lv_timer_create(count_cb, 10, (void *)(uintptr_t)0);
+    timers[1] = lv_timer_create(count_cb, 10, (void *)(uintptr_t)1);
+    lv_tick_inc(5);
+    timers[2] = lv_timer_create(count_cb, 1, (void *)(uintptr_t)2);
+    lv_tick_inc(20);
+    lv_timer_handler();
+
+    TEST_ASSERT_EQUAL_UINT32(3, run_order_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, run_order[0]);
+    TEST_ASSERT_EQUAL_UINT32(1, run_order[1]);
+    TEST_ASSERT_EQUAL_UINT32(0, run_order[2]);
+}
+
+void test_timer_time_until_next(void)
+{
+    timers[0] = lv_timer_create(count_cb, 30, (void *)(uintptr_t)0);
+    timers[1] = lv_timer_create(count_cb, 12, (void *)(uintptr_t)1);
+    TEST_ASSERT_EQUAL_UINT32(12, lv_timer_handler());
+
+    lv_tick_inc(5);
+    TEST_ASSERT_EQUAL_UINT32(7, lv_timer_handler());
+
+    lv_timer_pause(timers[1]);
+    TEST_ASSERT_EQUAL_UINT32(25, lv_timer_handler());
+
+    lv_timer_ready(timers[0]);
+    TEST_ASSERT_EQUAL_UINT32(30, lv_timer_handler());
+    TEST_ASSERT_EQUAL_UINT32(1, run_cnt[0]);
+
+    lv_timer_pause(timers[0]);
+    TEST_ASSERT_EQUAL_UINT32(LV_NO_TIMER_READY, lv_timer_handler());
+}
+
+void test_timer_delete_in_callback(void)
+{
+    /*Both are due but the first deletes the second*/
+    timers[0] = lv_timer_create(count_cb, 10, (void *)(uintptr_t)0);
+    timers[1] = lv_timer_create(count_cb, 10, (void *)(uintptr_t)1);
+    timers[2] = lv_timer_create(delete_other_cb, 10, (void *)(uintptr_t)2);
+    lv_tick_inc(10);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(1, run_cnt[0]);
+    TEST_ASSERT_EQUAL_UINT32(0, run_cnt[1]);
+    TEST_ASSERT_EQUAL_UINT32(1, run_cnt[2]);
+    lv_timer_delete(timers[2]);
+    timers[2] = NULL;
+
+    /*Delete itself*/
+    lv_timer_set_cb(timers[0], delete_self_cb);
+    lv_tick_inc(10);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(2, run_cnt[0]);
+    TEST_ASSERT_NULL(timers[0]);
+}
+
+void test_timer_create_in_callback(void)
+{
+    timers[0] = lv_timer_create(create_cb, 10, (void *)(uintptr_t)0);
+    lv_tick_inc(10);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(1, run_cnt[0]);
+    TEST_ASSERT_NOT_NULL(created_timer);
+
+    /*A timer with 0 period runs once in every call*/
+    TEST_ASSERT_EQUAL_UINT32(0, lv_timer_handler());
+    TEST_ASSERT_EQUAL_UINT32(1, run_cnt[3]);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(2, run_cnt[3]);
+}
+
+void test_timer_repeat_count(void)
+{
+    timers[0] = lv_timer_create(count_cb, 10, (void *)(uintptr_t)0);
+    lv_timer_set_repeat_count(timers[0], 3);
+    lv_timer_set_auto_delete(timers[0], false);
+
+    uint32_t i;
+    for(i = 0; i < 10; i++) {
+        lv_tick_inc(10);
+        lv_timer_handler();
+    }
+    TEST_ASSERT_EQUAL_UINT32(3, run_cnt[0]);
+    TEST_ASSERT_TRUE(lv_timer_get_paused(timers[0]));
+
+    /*A timer with 0 repeat count is deleted in the next call*/
+    timers[1] = lv_timer_create(count_cb, 1000, (void *)(uintptr_t)1);
+    lv_timer_set_repeat_count(timers[1], 0);
+    lv_timer_t * timer = lv_timer_get_next(NULL);
+    TEST_ASSERT_EQUAL_PTR(timers[1], timer);
+    lv_timer_handler();
+    timers[1] = NULL;
+    TEST_ASSERT_NOT_EQUAL(timer, lv_timer_get_next(NULL));
+    TEST_ASSERT_EQUAL_UINT32(0, run_cnt[1]);
+}
+
+#endif
@@ -615,4 +615,87 @@ void test_label_max_width(void)
     TEST_ASSERT_EQUAL_SCREENSHOT("widgets/label_max_width.png");
 }
 
+#if LV_LABEL_LINE_CACHE
+static void assert_layout_matches_text(lv_obj_t * obj)
+{
+    lv_label_t * l = (lv_label_t *)obj;
+    const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+    int32_t letter_space = lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN);
+    int32_t line_space = lv_obj_get_style_text_line_space(obj, LV_PART_MAIN);
+    int32_t max_w = lv_obj_get_content_width(obj);
+    lv_text_flag_t flag = l->layout.flag;
+
+    TEST_ASSERT_TRUE(l->layout.valid);
+    TEST_ASSERT_EQUAL_PTR(l->text, l->layout.text);
+    TEST_ASSERT_EQUAL_PTR(font, l->layout.font);
+
+    /*The lines are the same as the ones found by the text module*/
+    uint32_t line_start = 0;
+    uint32_t i = 0;
+    while(l->text[line_start] != '\0') {
+        uint32_t line_end = line_start + lv_text_get_next_line(&l->text[line_start], font, letter_space, max_w, NULL, flag);
+        const lv_text_line_t * line = lv_text_layout_get_line(&l->layout, i);
+        TEST_ASSERT_EQUAL_UINT32(line_start, line->start);
+        TEST_ASSERT_EQUAL_INT32(lv_text_get_width(&l->text[line_start], line_end - line_start, font, letter_space),
+                                line->width);
+        line_start = line_end;
+        i++;
+    }
+    TEST_ASSERT_EQUAL_UINT32(i, lv_text_layout_get_line_count(&l->layout));
+
+    lv_point_t size_ref;
+    lv_point_t size;
+    lv_text_get_size(&size_ref, l->text, font, letter_space, line_space, max_w, flag);
+    lv_text_layout_get_size(&l->layout, line_space, &size);
+    TEST_ASSERT_EQUAL_INT32(size_ref.x, size.x);
+    TEST_ASSERT_EQUAL_INT32(size_ref.y, size.y);
+}
+
+void test_label_line_cache(void)
+{
+    lv_obj_set_width(long_label, 150);
+    lv_obj_set_width(long_label_multiline, 150);
+    lv_refr_now(NULL);
+
+    assert_layout_matches_text(long_label);
+    assert_layout_matches_text(long_label_multiline);
+    assert_layout_matches_text(empty_label);
+
+    /*The layout is updated when the text, the font or the width changes*/
+    lv_label_set_text(long_label, "Short text");
+    lv_refr_now(NULL);
+    assert_layout_matches_text(long_label);
+
+    lv_obj_set_style_text_font(long_label_multiline, &lv_font_montserrat_24, LV_PART_MAIN);
+    lv_refr_now(NULL);
+    assert_layout_matches_text(long_label_multiline);
+
+    lv_obj_set_width(long_label_multiline, 80);
+    lv_refr_now(NULL);
+    assert_layout_matches_text(long_label_multiline);
+}
+
+void test_label_line_cache_dot_mode(void)
+{
+    lv_obj_set_size(long_label_multiline, 150, 60);
+    lv_label_set_long_mode(long_label_multiline, LV_LABEL_LONG_DOT);
+    lv_refr_now(NULL);
+
+    /*The layout belongs to the text with the dots*/
+    assert_layout_matches_text(long_label_multiline);
+
+    lv_obj_set_height(long_label_multiline, 100);
+    lv_refr_now(NULL);
+    assert_layout_matches_text(long_label_multiline);
+}
+#else
+void test_label_line_cache(void)
+{
+}
+
+void test_label_line_cache_dot_mode(void)
+{
+}
+#endif
+
 #endif
@@ -183,4 +183,90 @@ void test_obj_move_to_index_no_operation_when_requested_negative_index_is_greate
     TEST_ASSERT_EQUAL(1, lv_obj_get_index(child2));
 }
 
+void test_obj_tree_child_array_growth(void)
+{
+    lv_obj_t * parent = lv_obj_create(lv_screen_active());
+    lv_obj_t * children[9];
+    uint32_t i;
+    for(i = 0; i < 9; i++) {
+        children[i] = lv_obj_create(parent);
+    }
+
+    /*Grows geometrically*/
+    TEST_ASSERT_EQUAL_UINT32(16, parent->spec_attr->child_size);
+
+    /*Shrinks only when less than quarter full*/
+    for(i = 8; i >= 4; i--) lv_obj_delete(children[i]);
+    TEST_ASSERT_EQUAL_UINT32(16, parent->spec_attr->child_size);
+    lv_obj_delete(children[3]);
+    TEST_ASSERT_EQUAL_UINT32(8, parent->spec_attr->child_size);
+
+    /*The order is kept*/
+    lv_obj_delete(children[1]);
+    TEST_ASSERT_EQUAL_UINT32(2, lv_obj_get_child_count(parent));
+    TEST_ASSERT_EQUAL_PTR(children[0], lv_obj_get_child(parent, 0));
+    TEST_ASSERT_EQUAL_PTR(children[2], lv_obj_get_child(parent, 1));
+
+    lv_obj_set_parent(children[0], lv_screen_active());
+    lv_obj_set_parent(children[2], lv_screen_active());
+    TEST_ASSERT_EQUAL_UINT32(0, parent->spec_attr->child_size);
+    TEST_ASSERT_NULL(parent->spec_attr->children);
+
+    lv_obj_clean(lv_screen_active());
+}
+
+void test_obj_tree_create_children(void)
+{
+    lv_obj_t * parent = lv_obj_create(lv_screen_active());
+    lv_obj_create(parent);
+
+    lv_obj_t * buttons[300];
+    TEST_ASSERT_EQUAL_UINT32(300, lv_obj_create_children(parent, lv_button_create, 300, buttons));
+    TEST_ASSERT_EQUAL_UINT32(301, lv_obj_get_child_count(parent));
+    TEST_ASSERT_EQUAL_UINT32(301, parent->spec_attr->child_size);
+
+    uint32_t i;
+    for(i = 0; i < 300; i++) {
+        TEST_ASSERT_EQUAL_PTR(buttons[i], lv_obj_get_child(parent, i + 1));
+        TEST_ASSERT_TRUE(lv_obj_check_type(buttons[i], &lv_button_class));
+    }
+
+    /*Reserving less than the current size does nothing*/
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_obj_reserve_children(parent, 10));
+    TEST_ASSERT_EQUAL_UINT32(301, parent->spec_attr->child_size);
+
+    lv_obj_clean(parent);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_obj_get_child_count(parent));
+    TEST_ASSERT_EQUAL_UINT32(0, parent->spec_attr->child_size);
+
+    lv_obj_delete(parent);
+}
+
+static uint32_t delete_order_cnt;
+static void delete_order_event_cb(lv_event_t * e)
+{
+    uint32_t * order = lv_event_get_user_data(e);
+    *order = delete_order_cnt;
+    delete_order_cnt++;
+}
+
+void test_obj_tree_clean_from_the_last_child(void)
+{
+    lv_obj_t * parent = lv_obj_create(lv_screen_active());
+    uint32_t order[3];
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        lv_obj_t * obj = lv_obj_create(parent);
+        lv_obj_add_event_cb(obj, delete_order_event_cb, LV_EVENT_DELETE, &order[i]);
+    }
+
+    delete_order_cnt = 0;
+    lv_obj_clean(parent);
+    TEST_ASSERT_EQUAL_UINT32(2, order[0]);
+    TEST_ASSERT_EQUAL_UINT32(1, order[1]);
+    TEST_ASSERT_EQUAL_UINT32(0, order[2]);
+
+    lv_obj_delete(parent);
+}
+
 #endif
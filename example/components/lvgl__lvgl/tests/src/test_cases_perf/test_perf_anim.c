@@ -0,0 +1,107 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+
+#include <stdio.h>
+
+#define ANIM_CNT    1000
+#define TICK_CNT    1000
+
+static int32_t vars[ANIM_CNT];
+
+static void exec_cb(void * var, int32_t v)
+{
+    int32_t * var_i32 = var;
+    *var_i32 = v;
+}
+
+static void set_y_anim(void * obj, int32_t v)
+{
+    lv_obj_set_y(obj, v);
+}
+
+static void anim_create(void * var, lv_anim_exec_xcb_t cb, lv_anim_path_cb_t path_cb, uint32_t i)
+{
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, var);
+    lv_anim_set_exec_cb(&a, cb);
+    lv_anim_set_path_cb(&a, path_cb);
+    lv_anim_set_values(&a, 0, 100 + (int32_t)(i % 50));
+    lv_anim_set_duration(&a, 300 + (i % 7) * 100);
+    lv_anim_set_playback_duration(&a, 300);
+    lv_anim_set_repeat_count(&a, LV_ANIM_REPEAT_INFINITE);
+    lv_anim_start(&a);
+}
+
+/*Step the animations by 1 ms and return the average time of a step*/
+static uint64_t measure_ticks(void)
+{
+    uint64_t sum = 0;
+    uint32_t i;
+    for(i = 0; i < TICK_CNT; i++) {
+        lv_tick_inc(1);
+        uint64_t t = lv_test_perf_get_time_ns();
+        lv_anim_refr_now();
+        sum += lv_test_perf_get_time_ns() - t;
+
+        /*Forget the invalidated areas as the rendering is not measured*/
+        lv_display_t * disp = lv_display_get_default();
+        lv_memzero(disp->inv_area_joined, sizeof(disp->inv_area_joined));
+        disp->inv_p = 0;
+    }
+
+    return sum / TICK_CNT;
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+    lv_anim_delete(NULL, NULL);
+    lv_obj_clean(lv_screen_active());
+}
+
+void test_perf_anim_values(void)
+{
+    uint32_t i;
+    for(i = 0; i < ANIM_CNT; i++) anim_create(&vars[i], exec_cb, lv_anim_path_ease_in_out, i);
+
+    printf("%d animations with the same path: %" LV_PRIu32 " ns/tick\n", ANIM_CNT, (uint32_t)measure_ticks());
+}
+
+void test_perf_anim_values_mixed_paths(void)
+{
+    static lv_anim_path_cb_t paths[] = {lv_anim_path_linear, lv_anim_path_ease_in, lv_anim_path_ease_out,
+                                        lv_anim_path_ease_in_out, lv_anim_path_overshoot, lv_anim_path_bounce
+                                       };
+
+    uint32_t i;
+    for(i = 0; i < ANIM_CNT; i++) anim_create(&vars[i], exec_cb, paths[i % 6], i);
+
+    printf("%d animations with mixed paths: %" LV_PRIu32 " ns/tick\n", ANIM_CNT, (uint32_t)measure_ticks());
+}
+
+void test_perf_anim_objects(void)
+{
+    /*Move many small objects like lv_demo_stress*/
+    uint32_t i;
+    for(i = 0; i < ANIM_CNT; i++) {
+        lv_obj_t * obj = lv_obj_create(lv_screen_active());
+        lv_obj_remove_style_all(obj);
+        lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+        lv_obj_set_size(obj, 10, 10);
+        lv_obj_set_x(obj, (int32_t)(i % 40) * 20);
+        anim_create(obj, set_y_anim, lv_anim_path_ease_in_out, i);
+    }
+    lv_refr_now(NULL);
+
+    printf("%d object animations: %" LV_PRIu32 " ns/tick\n", ANIM_CNT, (uint32_t)measure_ticks());
+}
+
+#endif
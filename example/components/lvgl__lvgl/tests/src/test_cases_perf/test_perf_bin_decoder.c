@@ -0,0 +1,137 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+
+#include <stdio.h>
+
+#define LOAD_CNT        1000
+#define ROW_BLOCK_H     16
+
+/*Saved on 'B' which maps the files to the memory*/
+#define PATH_RAW        "perf_bin_decoder_raw.bin"
+#define PATH_LZ4        "perf_bin_decoder_lz4.bin"
+#define PATH_LZ4_ROWS   "perf_bin_decoder_lz4_rows.bin"
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+    remove(PATH_RAW);
+    remove(PATH_LZ4);
+    remove(PATH_LZ4_ROWS);
+}
+
+#if LV_USE_LZ4_INTERNAL
+
+#include "../../src/libs/lz4/lz4.h"
+
+/*Compress the whole image with LZ4 like LVGLImage.py with `--compress LZ4`*/
+static void compress_lz4(const lv_image_dsc_t * src, lv_image_dsc_t * dst)
+{
+    uint32_t max_size = 12 + LZ4_compressBound(src->data_size);
+    uint8_t * data = lv_malloc(max_size);
+    uint32_t * info = (uint32_t *)data;
+    info[0] = LV_IMAGE_COMPRESS_LZ4;
+    info[1] = LZ4_compress_default((const char *)src->data, (char *)data + 12, src->data_size, max_size - 12);
+    info[2] = src->data_size;
+
+    lv_memzero(dst, sizeof(*dst));
+    dst->header = src->header;
+    dst->header.magic = LV_IMAGE_HEADER_MAGIC;
+    dst->header.flags |= LV_IMAGE_FLAGS_COMPRESSED;
+    dst->data = data;
+    dst->data_size = 12 + info[1];
+}
+
+static void save_image(const lv_image_dsc_t * img, const char * path)
+{
+    char full_path[64];
+    lv_snprintf(full_path, sizeof(full_path), "B:%s", path);
+
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, full_path, LV_FS_MODE_WR));
+    lv_fs_write(&f, &img->header, sizeof(img->header), NULL);
+    lv_fs_write(&f, img->data, img->data_size, NULL);
+    lv_fs_close(&f);
+}
+
+/*Open the image and decode a 16 px high band if `band`, else all of it. Return the average time in ns.*/
+static uint32_t measure_load(const char * path, bool band)
+{
+    char full_path[64];
+    lv_snprintf(full_path, sizeof(full_path), "B:%s", path);
+
+    lv_image_decoder_args_t args = {.no_cache = true, .partial = band};
+    uint64_t sum = 0;
+    uint32_t i;
+    for(i = 0; i < LOAD_CNT; i++) {
+        lv_image_decoder_dsc_t dsc;
+        uint64_t t = lv_test_perf_get_time_ns();
+        TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, full_path, &args));
+        if(band) {
+            lv_area_t full_area = {0, 40, dsc.header.w - 1, 55};
+            lv_area_t decoded_area = {LV_COORD_MIN, LV_COORD_MIN, LV_COORD_MIN, LV_COORD_MIN};
+            while(lv_image_decoder_get_area(&dsc, &full_area, &decoded_area) == LV_RESULT_OK);
+        }
+        lv_image_decoder_close(&dsc);
+        sum += lv_test_perf_get_time_ns() - t;
+    }
+
+    return (uint32_t)(sum / LOAD_CNT);
+}
+
+static void measure_image(const char * name, const lv_image_dsc_t * ref)
+{
+    lv_image_dsc_t raw = *ref;
+    raw.header.magic = LV_IMAGE_HEADER_MAGIC;
+    save_image(&raw, PATH_RAW);
+
+    lv_image_dsc_t lz4;
+    compress_lz4(ref, &lz4);
+    save_image(&lz4, PATH_LZ4);
+
+    lv_image_dsc_t lz4_rows;
+    lv_test_image_compress_lz4_rows(ref, &lz4_rows, ROW_BLOCK_H);
+    save_image(&lz4_rows, PATH_LZ4_ROWS);
+
+    printf("%s raw: %" LV_PRIu32 " bytes, load %" LV_PRIu32 " ns\n",
+           name, raw.data_size, measure_load(PATH_RAW, false));
+    printf("%s LZ4: %" LV_PRIu32 " bytes, load %" LV_PRIu32 " ns\n",
+           name, lz4.data_size, measure_load(PATH_LZ4, false));
+    printf("%s LZ4 row blocks: %" LV_PRIu32 " bytes, load %" LV_PRIu32 " ns, load a 16 px band %" LV_PRIu32 " ns\n",
+           name, lz4_rows.data_size, measure_load(PATH_LZ4_ROWS, false), measure_load(PATH_LZ4_ROWS, true));
+
+    lv_free((void *)lz4.data);
+    lv_free((void *)lz4_rows.data);
+}
+
+void test_perf_bin_decoder_argb8888(void)
+{
+    LV_IMAGE_DECLARE(test_image_cogwheel_argb8888);
+    measure_image("ARGB8888", &test_image_cogwheel_argb8888);
+}
+
+void test_perf_bin_decoder_rgb565a8(void)
+{
+    LV_IMAGE_DECLARE(test_image_cogwheel_rgb565a8);
+    measure_image("RGB565A8", &test_image_cogwheel_rgb565a8);
+}
+
+#else
+
+void test_perf_bin_decoder_argb8888(void)
+{
+}
+
+void test_perf_bin_decoder_rgb565a8(void)
+{
+}
+
+#endif /*LV_USE_LZ4_INTERNAL*/
+
+#endif
@@ -0,0 +1,118 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+
+#include <stdio.h>
+
+/*Draw threads looking up the same few hundred images like the draw units do*/
+#define KEY_CNT         256
+#define ACCESS_CNT      200000
+#define THREAD_MAX      8
+#define SHARD_CNT       8
+
+typedef struct {
+    lv_cache_slot_size_t slot;
+    int32_t id;
+} test_data;
+
+typedef struct {
+    lv_thread_t thread;
+    lv_cache_t * cache;
+    uint32_t seed;
+} access_thread_t;
+
+static lv_cache_compare_res_t compare_cb(const test_data * lhs, const test_data * rhs)
+{
+    if(lhs->id != rhs->id) {
+        return lhs->id > rhs->id ? 1 : -1;
+    }
+    return 0;
+}
+
+static bool create_cb(test_data * node, void * user_data)
+{
+    LV_UNUSED(node);
+    LV_UNUSED(user_data);
+    return true;
+}
+
+static void free_cb(test_data * node, void * user_data)
+{
+    LV_UNUSED(node);
+    LV_UNUSED(user_data);
+}
+
+static uint32_t hash_cb(const test_data * key)
+{
+    return (uint32_t)key->id;
+}
+
+static void access_thread_cb(void * user_data)
+{
+    access_thread_t * t = user_data;
+    uint32_t seed = t->seed;
+    uint32_t i;
+    for(i = 0; i < ACCESS_CNT; i++) {
+        seed = seed * 1103515245u + 12345u;
+        test_data key = {.id = (int32_t)((seed >> 16) % KEY_CNT)};
+        lv_cache_entry_t * entry = lv_cache_acquire_or_create(t->cache, &key, NULL);
+        if(entry) lv_cache_release(t->cache, entry, NULL);
+    }
+}
+
+/*Run the threads on a cache with all keys fitting in and return the average time of an access*/
+static uint32_t measure_access(uint32_t shard_cnt, uint32_t thread_cnt)
+{
+    lv_cache_ops_t ops = {
+        .compare_cb = (lv_cache_compare_cb_t)compare_cb,
+        .create_cb = (lv_cache_create_cb_t)create_cb,
+        .free_cb = (lv_cache_free_cb_t)free_cb,
+        .hash_cb = (lv_cache_hash_cb_t)hash_cb,
+    };
+    lv_cache_t * cache = lv_cache_create_sharded(&lv_cache_class_lru_rb_count, sizeof(test_data), KEY_CNT, ops,
+                                                 shard_cnt);
+    access_thread_t threads[THREAD_MAX];
+
+    uint64_t t = lv_test_perf_get_time_ns();
+
+    uint32_t i;
+    for(i = 0; i < thread_cnt; i++) {
+        threads[i].cache = cache;
+        threads[i].seed = i + 1;
+        lv_thread_init(&threads[i].thread, LV_THREAD_PRIO_MID, access_thread_cb, 64 * 1024, &threads[i]);
+    }
+    for(i = 0; i < thread_cnt; i++) lv_thread_delete(&threads[i].thread);
+
+    t = lv_test_perf_get_time_ns() - t;
+
+    lv_cache_stats_t stats;
+    lv_cache_get_stats(cache, &stats);
+    TEST_ASSERT_EQUAL_UINT32(thread_cnt * ACCESS_CNT, stats.hit_cnt + stats.miss_cnt);
+    lv_cache_destroy(cache, NULL);
+
+    return (uint32_t)(t / ((uint64_t)thread_cnt * ACCESS_CNT));
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_perf_cache_sharded_contention(void)
+{
+    uint32_t thread_cnt;
+    for(thread_cnt = 1; thread_cnt <= THREAD_MAX; thread_cnt *= 2) {
+        uint32_t single_ns = measure_access(0, thread_cnt);
+        uint32_t sharded_ns = measure_access(SHARD_CNT, thread_cnt);
+        printf("%" LV_PRIu32 " threads: 1 lock %" LV_PRIu32 " ns/access, %d shards %" LV_PRIu32 " ns/access\n",
+               thread_cnt, single_ns, SHARD_CNT, sharded_ns);
+    }
+}
+
+#endif
@@ -97,6 +97,7 @@ static void create_bmi_section(lv_obj_t * parent)
     lv_obj_set_style_bg_color(bmi_cont, lv_color_white(), 0);
     lv_obj_set_style_radius(bmi_cont, 15, 0);
     lv_obj_set_style_pad_all(bmi_cont, 15, 0);
+    lv_obj_add_flag(bmi_cont, LV_OBJ_FLAG_RENDER_CACHE);
     
     lv_obj_t * bmi_icon = lv_label_create(bmi_cont);
     lv_label_set_text(bmi_icon, LV_SYMBOL_CHARGE);
@@ -144,6 +145,7 @@ static void create_spo2_section(lv_obj_t * parent)
     lv_obj_set_style_bg_color(spo2_cont, lv_color_white(), 0);
     lv_obj_set_style_radius(spo2_cont, 15, 0);
     lv_obj_set_style_pad_all(spo2_cont, 15, 0);
+    lv_obj_add_flag(spo2_cont, LV_OBJ_FLAG_RENDER_CACHE);
     
     lv_obj_t * spo2_icon = lv_label_create(spo2_cont);
     lv_label_set_text(spo2_icon, LV_SYMBOL_WIFI);
@@ -186,6 +188,7 @@ static void create_temperature_section(lv_obj_t * parent)
     lv_obj_set_style_bg_color(temp_cont, lv_color_white(), 0);
     lv_obj_set_style_radius(temp_cont, 15, 0);
     lv_obj_set_style_pad_all(temp_cont, 15, 0);
+    lv_obj_add_flag(temp_cont, LV_OBJ_FLAG_RENDER_CACHE);
     
     lv_obj_t * temp_icon = lv_label_create(temp_cont);
     lv_label_set_text(temp_icon, LV_SYMBOL_WARNING);
@@ -226,6 +229,7 @@ static void create_heart_rate_section(lv_obj_t * parent)
     lv_obj_set_style_bg_color(hr_cont, lv_color_white(), 0);
     lv_obj_set_style_radius(hr_cont, 15, 0);
     lv_obj_set_style_pad_all(hr_cont, 15, 0);
+    lv_obj_add_flag(hr_cont, LV_OBJ_FLAG_RENDER_CACHE);
     
     lv_obj_t * hr_icon = lv_label_create(hr_cont);
     lv_label_set_text(hr_icon, LV_SYMBOL_PLUS);